@@ -93,21 +93,33 @@
 #include "constants.h"                // Griduino constants, colors, typedefs
 #include "hardware.h"                 // Griduino pin definitions
 #include "logger.h"                   // conditional printing to Serial port
+#include "tracer.h"                   // software tracer for performance measurements
+#include "perf_counters.h"            // loop latency histogram and performance counters
+#include "memory_monitor.h"           // RAM usage and stack high-water mark
+#include "gps_rate.h"                 // optional 5 or 10 Hz GPS fixes
+#include "gnss_stats.h"               // satellite systems and per-constellation statistics
+#include "warm_start.h"               // give receiver our last known position at power-up
 #include "grid_helper.h"              // lat/long conversion routines
+#include "format_helper.h"            // number to text without the heap
+#include "touch_events.h"             // touchscreen sampled on a fixed schedule, into gestures
+#include "nmea_reader.h"              // optional: GPS serial port read by the RP2040's second core
 
 #include "view.h"                     // Griduino screens base class, followed by derived classes in alphabetical order
+#include "view_registry.h"            // build only the active view, in a shared arena
 #include "view_altimeter.h"           // altimeter
 #include "view_battery.h"             // coin battery
 #include "view_baro.h"                // barometric pressure graph
 #include "view_events.h"              // counting days to/from calendar events
 #include "view_grid_crossings.h"      // list of time spent in each grid
 #include "view_help.h"                // help screen
+#include "view_map.h"                 // breadcrumb trail at several zoom levels
 #include "view_sat_count.h"           // show number of satellites acquired
 #include "view_screen1.h"             // starting screen animation
 #include "view_splash.h"              // splash screen
 #include "view_status.h"              // status screen 
 #include "view_ten_mile_alert.h"      // microwave rover screen
 #include "view_time.h"                // GMT time screen 
+#include "view_trips.h"               // summary of each trip
 
 #include "cfg_audio_type.h"           // config audio Morse/speech
 #include "cfg_crossing.h"             // config 4/6 digit crossing
@@ -141,6 +153,8 @@ Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
 // ---------- Touch Screen
 Resistive_Touch_Screen tsn(PIN_XP, PIN_YP, PIN_XM, PIN_YM, XP_XM_OHMS);
 
+TouchEvents touchEvents;   // tap, long press and swipe, see "show touch" command
+
 // to select a different SPI bus speed, use this instead:
 // -----------------------------------------------
 //    #include <Adafruit_SPIDevice.h>           // from library Adafruit_BusIO, file Adafruit_SPIDevice.h
@@ -160,8 +174,23 @@ Resistive_Touch_Screen tsn(PIN_XP, PIN_YP, PIN_XM, PIN_YM, XP_XM_OHMS);
 // Hardware serial port for USB
 Logger logger = Logger();
 
+// Performance measurements, see "trace dump" and "show perf" commands
+Tracer tracer;
+PerfCounters perf;
+MemoryMonitor memoryMonitor;   // see "show memory" command
+
 // Hardware serial port for GPS
 Adafruit_GPS GPS(&Serial1);           // https://github.com/adafruit/Adafruit_GPS
+GpsRate gpsRate;                      // fixes per second, see "set gps 10hz" command
+GnssStats gnss;                       // satellite systems, see "show gnss" command
+WarmStart warmStart;                  // position hint for faster first fix
+#if defined(DUAL_CORE)
+#if !defined(ARDUINO_ADAFRUIT_FEATHER_RP2040)
+#error DUAL_CORE needs the second core of an RP2040
+#endif
+NmeaReader nmeaReader;                // core 1 reads the GPS, see "show cores" command
+bool core0Ready = false;              // core 1 waits until setup() has opened Serial1
+#endif
 /* "Ultimate GPS" pin wiring is connected to a dedicated hardware serial port
     available on an Arduino Mega, Arduino Feather and others.
 
@@ -228,7 +257,7 @@ void showDefaultTouchTargets() {
   }
 }
 
-void showWhereTouched(ScreenPoint touch) {
+void showWhereTouched(Point touch) {
   if (showTouchTargets) {
     const int radius = 1;     // debug
     tft.fillCircle(touch.x, touch.y, radius, cTOUCHTARGET);  // debug - show dot
@@ -237,8 +266,7 @@ void showWhereTouched(ScreenPoint touch) {
 
 // ============== helpers ======================================
 void floatToCharArray(char* result, int maxlen, double fValue, int decimalPlaces) {
-  String temp = String(fValue, decimalPlaces);
-  temp.toCharArray(result, maxlen);
+  fixedToChars(result, maxlen, fValue, decimalPlaces);   // same text as String(fValue, decimalPlaces) but no heap
 }
 
 //==============================================================
@@ -260,26 +288,45 @@ void floatToCharArray(char* result, int maxlen, double fValue, int decimalPlaces
 //    with very specific functionality and interfaces.
 //==============================================================
 #include "model_gps.h"                // Model of a GPS for model-view-controller
+#include "model_replay.h"             // Model that replays a recorded NMEA log
 
 // create an instance of the GPS model
 Model modelGPS;                       // normal: use real GPS hardware
 MockModel modelSimulator;             // test: simulated travel (see model_gps.h)
+ReplayModel modelReplay;              // test: recorded travel (see model_replay.h)
 
 // at power-on, we choose to always start with real GPS receiver hardware 
 // because I don't want to bother saving/restoring this selection right now
 Model* model = &modelGPS;
 
+// a new data source has its own clock and position, so the fix validator
+// must not compare its first fix against the previous source's last one
 void fSetReceiver() {
+  modelReplay.stop();                 // let go of the replay file
+  trail.validator.restart();
   model = &modelGPS;                  // use "class Model" for GPS receiver hardware
 }
 void fSetSimulated() {
+  modelReplay.stop();
+  trail.validator.restart();
   model = &modelSimulator;            // use "class MockModel" for simulated track
 }
+int fSetReplay(float speedup) {
+  // returns 1=success, 0=failure
+  if (modelReplay.beginFile(REPLAY_FILE, speedup)) {
+    trail.validator.restart();
+    model = &modelReplay;             // use "class ReplayModel" for recorded track
+    return 1;
+  }
+  return 0;
+}
 int fGetDataSource() {
   // this function allows the user interface to display which one is active
   // returns: enum
   if (model == &modelGPS) {
     return eGPSRECEIVER;
+  } else if (model == &modelReplay) {
+    return eGPSREPLAY;
   } else {
     return eGPSSIMULATOR;
   }
@@ -293,6 +340,16 @@ bool waitingForRTC = true;   // true=waiting for GPS hardware to give us the fir
 #include "model_breadcrumbs.h"
 Breadcrumbs trail;
 
+#include "model_trips.h"              // trips and their statistics
+TripEngine trips;                     // see "dump trips" command
+
+void observeTrip(const Location &rec) {   // trail.onRemember
+  trips.observe(rec);
+}
+
+#include "model_geofence.h"           // county lines, contest areas and exclusion zones
+Geofence geofence;                    // see "show fences" command
+
 //==============================================================
 //    Coin Battery Voltage model
 //==============================================================
@@ -318,6 +375,15 @@ BatteryVoltage gpsBattery;
 #include "model_baro.h"     // a barometer that can also store history
 BarometerModel baroModel;   // create instance of the model
 
+#include "model_altitude.h"   // barometer and GPS altitude, fused
+AltitudeFusion altFusion;     // see "show baro" command
+
+// breadcrumb for where we are now, with the fused altitude and climb rate
+void makeBreadcrumb(Location *loc) {
+  model->makeLocation(loc);
+  altFusion.annotate(loc);
+}
+
 //==============================================================
 //
 //      Views
@@ -345,16 +411,19 @@ enum VIEW_INDEX {
   GRID_VIEW,             // 13 <-- this is the primary navigation view
   GRID_CROSSINGS_VIEW,   // 14 log of time in each grid
   HELP_VIEW,             // 15 hints at startup
-  SAT_COUNT_VIEW,        // 16 number of satellites acquired
-  SCREEN1_VIEW,          // 17 first bootup screen
-  SPLASH_VIEW,           // 18 startup
-  STATUS_VIEW,           // 19 size and scale of this grid
-  TEN_MILE_ALERT_VIEW,   // 20 microwave rover view
-  TIME_VIEW,             // 21
-  CFG_VOLUME,            // 22
-  GOTO_SETTINGS,         // 23 command the state machine to show control panel
-  GOTO_NEXT_VIEW,        // 24 command the state machine to show next screen
-  MAX_VIEWS,             // 25 sentinel at end of list
+  MAP_VIEW,              // 16 breadcrumb trail at several zoom levels
+  SAT_COUNT_VIEW,        // 17 number of satellites acquired
+  SCREEN1_VIEW,          // 18 first bootup screen
+  SPLASH_VIEW,           // 19 startup
+  STATUS_VIEW,           // 20 size and scale of this grid
+  TEN_MILE_ALERT_VIEW,   // 21 microwave rover view
+  TIME_VIEW,             // 22
+  TRIPS_VIEW,            // 23 distance, time and speed of each trip
+  CFG_VOLUME,            // 24
+  GOTO_SETTINGS,         // 25 command the state machine to show control panel
+  GOTO_NEXT_VIEW,        // 26 command the state machine to show next screen
+  GOTO_PREV_VIEW,        // 27 command the state machine to show previous screen
+  MAX_VIEWS,             // 28 sentinel at end of list
 };
 /*const*/ int help_view      = HELP_VIEW;
 /*const*/ int sat_count_view = SAT_COUNT_VIEW;
@@ -367,137 +436,123 @@ enum VIEW_INDEX {
 /*const*/ int goto_next_view = GOTO_NEXT_VIEW;
 /*const*/ int goto_next_cfg  = GOTO_SETTINGS;
 
-// list of objects derived from "class View", in alphabetical order
+// ----- settings that outlive their view, in alphabetical order
+AudioSetting audioSetting;         // Morse/speech/none, cfg_audio_type.h
+MapSetting mapSetting;             // zoom level of the map, view_map.h
+NmeaSetting nmeaSetting;           // NMEA broadcast on/off, cfg_nmea.h
+RotationSetting rotationSetting;   // which edge is up, cfg_rotation.h
+SatCountHistory satCountHistory;   // graph of satellites acquired, view_sat_count.h
+VolumeSetting volumeSetting;       // speaker volume and mute, cfg_volume.h
+
+// ----- every view, with its place in the navigation rings
+//       Only the active view exists, in the arena below. See view_registry.h
+#if defined(ARDUINO_ADAFRUIT_FEATHER_RP2040)
+#define AFTER_ROTATION CFG_REBOOT   // settings ring continues to the reboot view
+#else
+#define AFTER_ROTATION GRID_VIEW    // at end of settings views, return to normal view
+#endif
+
 // clang-format off
-View* pView;      // pointer to a derived class
-// vvv sort vvv
-ViewAltimeter     altimeterView(&tft, ALTIMETER_VIEW);  // alphabetical order by class name
-ViewBaro          baroView(&tft, BARO_VIEW);            // instantiate derived classes
-ViewBattery       batteryView(&tft, BATTERY_VIEW);
-ViewCfgAudioType  cfgAudioType(&tft, CFG_AUDIO_TYPE);
-ViewCfgCrossing   cfgCrossing(&tft, CFG_CROSSING);
-ViewCfgGPS        cfgGPS(&tft, CFG_GPS);
-ViewCfgGpsReset   cfgGpsReset(&tft, CFG_GPS_RESET);
-ViewCfgNMEA       cfgNMEA(&tft, CFG_NMEA);
-ViewCfgReboot     cfgReboot(&tft, CFG_REBOOT);
-ViewCfgReformat   cfgReformat(&tft, CFG_REFORMAT);
-ViewCfgRotation   cfgRotation(&tft, CFG_ROTATION);
-ViewCfgUnits      cfgUnits(&tft, CFG_UNITS);
-ViewEvents        eventsView(&tft, EVENTS_VIEW);
-ViewGrid          gridView(&tft, GRID_VIEW);
-ViewGridCrossings gridCrossingsView(&tft, GRID_CROSSINGS_VIEW);
-ViewHelp          helpView(&tft, HELP_VIEW);
-ViewSatCount      satCountView(&tft, SAT_COUNT_VIEW);
-ViewScreen1       screen1View(&tft, SCREEN1_VIEW);
-ViewSplash        splashView(&tft, SPLASH_VIEW);
-ViewStatus        statusView(&tft, STATUS_VIEW);
-ViewTenMileAlert  tenMileAlertView(&tft, TEN_MILE_ALERT_VIEW);
-ViewTime          timeView(&tft, TIME_VIEW);
-ViewVolume        volumeView(&tft, CFG_VOLUME);
+constexpr ViewEntry viewTable[] = {
+  // vvv same order as enum vvv
+  // factory                        size                         next view             next settings view
+  {makeView<ViewAltimeter>,     sizeof(ViewAltimeter),     STATUS_VIEW,          CFG_VOLUME},       // [ALTIMETER_VIEW]
+  {makeView<ViewBaro>,          sizeof(ViewBaro),          ALTIMETER_VIEW,       CFG_VOLUME},       // [BARO_VIEW]
+  {makeView<ViewBattery>,       sizeof(ViewBattery),       TEN_MILE_ALERT_VIEW,  CFG_VOLUME},       // [BATTERY_VIEW]
+  {makeView<ViewCfgAudioType>,  sizeof(ViewCfgAudioType),  GRID_VIEW,            CFG_CROSSING},     // [CFG_AUDIO_TYPE]
+  {makeView<ViewCfgCrossing>,   sizeof(ViewCfgCrossing),   GRID_VIEW,            CFG_GPS},          // [CFG_CROSSING]
+  {makeView<ViewCfgGPS>,        sizeof(ViewCfgGPS),        GRID_VIEW,            CFG_NMEA},         // [CFG_GPS]
+  {makeView<ViewCfgGpsReset>,   sizeof(ViewCfgGpsReset),   GRID_VIEW,            CFG_REFORMAT},     // [CFG_GPS_RESET]
+  {makeView<ViewCfgNMEA>,       sizeof(ViewCfgNMEA),       GRID_VIEW,            CFG_GPS_RESET},    // [CFG_NMEA]
+  {makeView<ViewCfgReboot>,     sizeof(ViewCfgReboot),     GRID_VIEW,            CFG_VOLUME},       // [CFG_REBOOT]
+  {makeView<ViewCfgReformat>,   sizeof(ViewCfgReformat),   GRID_VIEW,            CFG_UNITS},        // [CFG_REFORMAT]
+  {makeView<ViewCfgRotation>,   sizeof(ViewCfgRotation),   GRID_VIEW,            AFTER_ROTATION},   // [CFG_ROTATION]
+  {makeView<ViewCfgUnits>,      sizeof(ViewCfgUnits),      GRID_VIEW,            CFG_ROTATION},     // [CFG_UNITS]
+  {makeView<ViewEvents>,        sizeof(ViewEvents),        GRID_VIEW,            CFG_VOLUME},       // [EVENTS_VIEW] skipped, nobody uses it
+  {makeView<ViewGrid>,          sizeof(ViewGrid),          MAP_VIEW,             CFG_VOLUME},       // [GRID_VIEW]
+  {makeView<ViewGridCrossings>, sizeof(ViewGridCrossings), GRID_VIEW,            CFG_VOLUME},       // [GRID_CROSSINGS_VIEW] skipped, not ready for prime time
+  {makeView<ViewHelp>,          sizeof(ViewHelp),          GRID_VIEW,            CFG_VOLUME},       // [HELP_VIEW]
+  {makeView<ViewMap>,           sizeof(ViewMap),           TRIPS_VIEW,           CFG_VOLUME},       // [MAP_VIEW]
+  {makeView<ViewSatCount>,      sizeof(ViewSatCount),      BARO_VIEW,            CFG_VOLUME},       // [SAT_COUNT_VIEW]
+  {makeView<ViewScreen1>,       sizeof(ViewScreen1),       HELP_VIEW,            CFG_VOLUME},       // [SCREEN1_VIEW] skip SPLASH_VIEW, animated logo shows version number
+  {makeView<ViewSplash>,        sizeof(ViewSplash),        GRID_VIEW,            CFG_VOLUME},       // [SPLASH_VIEW]
+  {makeView<ViewStatus>,        sizeof(ViewStatus),        BATTERY_VIEW,         CFG_VOLUME},       // [STATUS_VIEW]
+  {makeView<ViewTenMileAlert>,  sizeof(ViewTenMileAlert),  GRID_VIEW,            CFG_VOLUME},       // [TEN_MILE_ALERT_VIEW]
+  {makeView<ViewTime>,          sizeof(ViewTime),          SAT_COUNT_VIEW,       CFG_VOLUME},       // [TIME_VIEW]
+  {makeView<ViewTrips>,         sizeof(ViewTrips),         TIME_VIEW,            CFG_VOLUME},       // [TRIPS_VIEW]
+  {makeView<ViewVolume>,        sizeof(ViewVolume),        GRID_VIEW,            CFG_AUDIO_TYPE},   // [CFG_VOLUME]
+};
 // clang-format on
+const int numViews = sizeof(viewTable) / sizeof(viewTable[0]);
+static_assert(numViews == GOTO_SETTINGS, "viewTable needs one row per VIEW_INDEX");
+static_assert(numViews <= REGISTRY_MAX_VIEWS, "ViewRegistry counts text fields for at most REGISTRY_MAX_VIEWS views");
+
+alignas(8) uint8_t viewArena[largestView(viewTable, numViews)];   // 8 = alignment of double, the largest member type
+ViewRegistry views(viewTable, numViews, viewArena, sizeof(viewArena));
+View *pView = nullptr;   // the active view, constructed in viewArena
 
 void selectNewView(int cmd) {
-  // cmd = GOTO_NEXT_VIEW | GOTO_SETTINGS
+  // cmd = GOTO_NEXT_VIEW | GOTO_PREV_VIEW | GOTO_SETTINGS | a specific view
   // this is a state machine to select next view, given current view and type of command
-  View *viewTable[] = {
-      // vvv same order as enum vvv
-      &altimeterView,       // [ALTIMETER_VIEW]
-      &baroView,            // [BARO_VIEW]
-      &batteryView,         // [BATTERY_VIEW]
-      &cfgAudioType,        // [CFG_AUDIO_TYPE]
-      &cfgCrossing,         // [CFG_CROSSING]
-      &cfgGPS,              // [CFG_GPS]
-      &cfgGpsReset,         // [CFG_GPS_RESET]
-      &cfgNMEA,             // [CFG_NMEA]
-      &cfgReboot,           // [CFG_REBOOT]
-      &cfgReformat,         // [CFG_REFORMAT]
-      &cfgRotation,         // [CFG_ROTATION]
-      &cfgUnits,            // [CFG_UNITS]
-      &eventsView,          // [EVENTS_VIEW]
-      &gridView,            // [GRID_VIEW]
-      &gridCrossingsView,   // [GRID_CROSSINGS_VIEW]
-      &helpView,            // [HELP_VIEW]
-      &satCountView,        // [SAT_COUNT_VIEW]
-      &screen1View,         // [SCREEN1_VIEW]
-      &splashView,          // [SPLASH_VIEW]
-      &statusView,          // [STATUS_VIEW]
-      &tenMileAlertView,    // [TEN_MILE_ALERT_VIEW]
-      &timeView,            // [TIME_VIEW]
-      &volumeView,          // [CFG_VOLUME]
-  };
-
-  int currentView = pView->screenID;
-  int nextView;
-  // clang-format off
+  int currentView = pView ? pView->screenID : NO_VIEW_REQUEST;
+  int nextView    = currentView;
   if (cmd == GOTO_NEXT_VIEW) {
     // operator requested the next NORMAL user view
-    switch (currentView) {
-      case SCREEN1_VIEW:   nextView = HELP_VIEW; break;   // skip SPLASH_VIEW (simplify startup, now that animated logo shows version number)
-      case SPLASH_VIEW:    nextView = GRID_VIEW; break;
-      case GRID_VIEW:      nextView = TIME_VIEW; break;
-      case GRID_CROSSINGS_VIEW: nextView= GRID_VIEW; break;   // skip GRID_CROSSINGS_VIEW (not ready for prime time)
-      case TIME_VIEW:      nextView = SAT_COUNT_VIEW; break;
-      case SAT_COUNT_VIEW: nextView = BARO_VIEW; break;
-      case BARO_VIEW:      nextView = ALTIMETER_VIEW; break;
-      case ALTIMETER_VIEW: nextView = STATUS_VIEW; break;
-      case STATUS_VIEW:    nextView = BATTERY_VIEW; break;
-      case BATTERY_VIEW:   nextView = TEN_MILE_ALERT_VIEW; break;
-      case TEN_MILE_ALERT_VIEW: nextView = GRID_VIEW; break;
-      case EVENTS_VIEW:    nextView = GRID_VIEW; break;   // skip EVENTS_VIEW (nobody uses it)
-      // none of above: we must be showing some settings view, so go to the first normal user view
-      default:             nextView = GRID_VIEW; break;
-    }
+    nextView = views.nextView(currentView);
+  } else if (cmd == GOTO_PREV_VIEW) {
+    // operator swiped back to the previous NORMAL user view
+    nextView = views.prevView(currentView);
   } else if (cmd == GOTO_SETTINGS) {
     // operator requested the next SETTINGS view
-    switch (currentView) {
-      case CFG_VOLUME:     nextView = CFG_AUDIO_TYPE; break;
-      //se VOLUME2_VIEW:   nextView = CFG_AUDIO_TYPE; break;
-      case CFG_AUDIO_TYPE: nextView = CFG_CROSSING; break;
-      case CFG_CROSSING:   nextView = CFG_GPS; break;
-      case CFG_GPS:        nextView = CFG_NMEA; break;
-      case CFG_NMEA:       nextView = CFG_GPS_RESET; break;
-      case CFG_GPS_RESET:  nextView = CFG_REFORMAT; break;
-      case CFG_REFORMAT:   nextView = CFG_UNITS; break;
-      case CFG_UNITS:      nextView = CFG_ROTATION; break;
-#if defined(ARDUINO_ADAFRUIT_FEATHER_RP2040)
-      case CFG_ROTATION:   nextView = CFG_REBOOT; break;
-#else
-      case CFG_ROTATION:   nextView = GRID_VIEW; break;   // at end of settings views, return to normal view
-#endif
-      case CFG_REBOOT:     nextView = CFG_VOLUME; break;
-      // none of above: we must be showing some normal user view, so go to the first settings view
-      default:             nextView = CFG_VOLUME; break;
-    }
-  } else if (cmd < MAX_VIEWS) {
+    nextView = views.nextSetting(currentView);
+  } else if (cmd >= 0 && cmd < numViews) {
     // a specific view was requested, such as HELP_VIEW via a USB command
     nextView = cmd;
   } else {
     logger.log(CONFIG, ERROR, "Requested view is out of range: %d where maximum is %d", cmd, MAX_VIEWS);
   }
-  // clang-format on
   logger.log(CONFIG, INFO, "selectNewView() from %d to %d", currentView, nextView);
-  if (currentView != nextView) {
-    pView->endScreen();                   // a goodbye-kiss to the departing view
-    pView = viewTable[ nextView ];
+  if (currentView != nextView && nextView != NO_VIEW_REQUEST) {
+    if (pView) {
+      pView->endScreen();   // a goodbye-kiss to the departing view, then it's destroyed
+    }
+    pView = views.activate(nextView, &tft);
 
     // Every view has an initial setup to prepare its layout
     // After initial setup the view can assume it "owns" the screen
     // and thereafter safely repaint only the parts that change
+    TraceScope trace(eTraceViewStart, pView->screenID);
     pView->startScreen();
+
+    int requested = views.takeRequest();
+    if (requested != NO_VIEW_REQUEST) {
+      selectNewView(requested);   // the new view declined, e.g. battery view without a sensor
+      return;
+    }
     pView->updateScreen();
+    perf.countViewUpdate(pView->screenID);
   }
 }
 
+// ----- a view calls this to leave itself, since it must not destroy itself while running
+void requestNewView(int cmd) {
+  views.request(cmd);
+}
+
 // ----- console Serial port helper AND animated splash screen
 void waitForSerial(int howLong) {
   // Adafruit Feather M4 Express takes awhile to restore its USB connection to the PC
   // and the operator takes awhile to restart the IDE console (Tools > Serial Monitor)
   // so give them a few seconds for this to settle before sending messages to IDE
 
-  pView = &screen1View;   // select very first screen shown at startup
-  screen1View.startScreen();
-  while (pView == &screen1View) {
-    screen1View.updateScreen();
+  selectNewView(SCREEN1_VIEW);   // select very first screen shown at startup
+  while (pView->screenID == SCREEN1_VIEW) {
+    pView->updateScreen();
+
+    int requested = views.takeRequest();
+    if (requested != NO_VIEW_REQUEST) {
+      selectNewView(requested);   // screen 1 is finished, or was touched
+    }
   }
 }
 
@@ -540,7 +595,44 @@ void adjustBrightness() {
 }
 #endif
 
+// ----- one gesture from the touchscreen queue
+void handleTouchEvent(const TouchEvent &event) {
+  switch (event.gesture) {
+  case eTap:
+  case eLongPress:   // a slow press on a button is still a press
+    if (showTouchTargets) {
+      showWhereTouched(event.at);   // debug: show where touched
+    }
+    if (!pView->onTouch(event.at)) {
+      // not handled by one of the views, so run our default action
+      if (areaGear.contains(event.at)) {
+        selectNewView(GOTO_SETTINGS);   // advance to next settings view
+      } else if (areaArrow.contains(event.at)) {
+        selectNewView(GOTO_NEXT_VIEW);   // advance to next normal user view
+      } else if (areaBrite.contains(event.at)) {
+        adjustBrightness();   // change brightness
+      } else {
+        // nothing to do
+      }
+    }
+    break;
+  case eSwipeLeft:
+    selectNewView(GOTO_NEXT_VIEW);   // page forward, same as the arrow
+    break;
+  case eSwipeRight:
+    selectNewView(GOTO_PREV_VIEW);   // page back
+    break;
+  case eSwipeDown:
+    selectNewView(GOTO_SETTINGS);   // pull down the settings, same as the gear
+    break;
+  case eSwipeUp:
+  default:
+    break;
+  }
+}
+
 void sendMorseLostSignal() {
+  TraceScope trace(eTraceAudio);
   String msg(PROSIGN_AS);             // "wait" symbol
   dacMorse.setMessage(msg);
   dacMorse.sendBlocking();            // TODO - use non-blocking
@@ -548,6 +640,7 @@ void sendMorseLostSignal() {
 
 void announceGrid(const String gridName, int length) {
   // todo: change "String" class parameter into "char*" type
+  TraceScope trace(eTraceAudio);
   char grid[7];
   strncpy(grid, gridName.c_str(), sizeof(grid));
   grid[length] = 0;   // null-terminate string to requested 4- or 6-character length
@@ -557,12 +650,12 @@ void announceGrid(const String gridName, int length) {
   // todo - for now, RP2040 has no DAC, no audio, no speech
   logger.log(AUDIO, ERROR, "Unsupported audio in line ", __LINE__ );
 #else
-  switch (cfgAudioType.selectedAudio) {
-    case ViewCfgAudioType::MORSE: 
+  switch (audioSetting.selectedAudio) {
+    case AudioSetting::MORSE: 
       logger.fencepost("Griduino.ino", __LINE__);   // debug
       sendMorseGrid6( grid );
       break;
-    case ViewCfgAudioType::SPEECH:
+    case AudioSetting::SPEECH:
       for (int ii=0; ii<strlen(grid); ii++) {
 
         char myfile[32];
@@ -575,7 +668,7 @@ void announceGrid(const String gridName, int length) {
         }
       }
       break;
-    case ViewCfgAudioType::NO_AUDIO:
+    case AudioSetting::NO_AUDIO:
       // do nothing
       break;
     default:
@@ -586,6 +679,26 @@ void announceGrid(const String gridName, int length) {
 #endif
 }
 
+void announceFence(const char *name, bool entered) {
+  // Morse code for both Morse and speech settings, because there are no spoken words on flash
+  TraceScope trace(eTraceAudio);
+  logger.log(AUDIO, INFO, entered ? "Entered geofence: %s" : "Left geofence: %s", name);
+
+#if defined(ARDUINO_ADAFRUIT_FEATHER_RP2040)
+  // todo - for now, RP2040 has no DAC, no audio, no speech
+  logger.log(AUDIO, ERROR, "Unsupported audio in line ", __LINE__ );
+#else
+  if (audioSetting.selectedAudio != AudioSetting::NO_AUDIO) {
+    char msg[GEOFENCE_NAME_SIZE + 8];
+    snprintf(msg, sizeof(msg), "%s %s", entered ? "in" : "out", name);
+    for (char *pp = msg; *pp; pp++) {
+      *pp = tolower(*pp);
+    }
+    dacMorse.sendBlocking(msg);   // no String, so nothing on the heap
+  }
+#endif
+}
+
 void sendMorseGrid4(const String gridName) {
   // announce new grid by Morse code
   logger.fencepost("Griduino.ino", __LINE__);   // debug
@@ -659,6 +772,9 @@ uint viewHelpTimeout = 10;            // seconds to show Help screen at startup
 //=========== setup ============================================
 void setup() {
 
+  memoryMonitor.paintStack();   // first, so the stack high-water mark includes all of setup()
+  tracer.begin();   // start cycle counter for performance measurements
+
   // ----- init TFT backlight
   pinMode(TFT_BL, OUTPUT);
   analogWrite(TFT_BL, 255);   // set backlight to full brightness
@@ -669,7 +785,7 @@ void setup() {
   tft.fillScreen(ILI9341_BLACK);      // note that "begin()" did not clear screen
 
   // ----- init screen orientation
-  cfgRotation.loadConfig();           // restore previous screen orientation
+  rotationSetting.loadConfig(&tft);   // restore previous screen orientation
 
   // ----- init touchscreen
   tsn.setScreenSize(tft.width(), tft.height());                                         // required
@@ -687,10 +803,10 @@ void setup() {
   waitForSerial(howLongToWait);       // display very first screen, an animation splash at startup
                                       // AND wait for developer to connect debugging console
 
-  pView = &helpView;                  // select very second screen shown at startup
+  if (pView->screenID != HELP_VIEW) {
+    selectNewView(HELP_VIEW);         // select very second screen shown at startup
+  }
   viewHelpTimer = 0;                  // start counting time for user to read the hint screen
-  pView->startScreen();
-  pView->updateScreen();
 
   // now that Serial is ready and connected (or we gave up)...
   logger.log(CONFIG, INFO,"NeoPixel initialized and turned off");
@@ -699,8 +815,8 @@ void setup() {
   logger.log(CONFIG, INFO, __FILE__);                           // Report our source code file name
 
   // ----- init NMEA broadcasting on/off
-  logger.log(CONFIG, INFO, "Starting cfgNMEA.loadConfig()...");
-  cfgNMEA.loadConfig();
+  logger.log(CONFIG, INFO, "Starting nmeaSetting.loadConfig()...");
+  nmeaSetting.loadConfig();
 
   // ----- init GPS
   GPS.begin(9600);   // 9600 NMEA is the default baud rate for Adafruit MTK GPS's
@@ -726,10 +842,9 @@ void setup() {
   delay(50);
   ***** */
 
-  // init Quectel L86 chip to improve USA satellite acquisition
-  logger.log(GPS_SETUP, INFO, "$PMTK353,1,0,0,0,0*2A");
-  GPS.sendCommand("$PMTK353,1,0,0,0,0*2A");   // search American GPS satellites only (not Russian GLONASS satellites)
-  delay(50);
+  // init Quectel L86 chip: which satellite systems to search, default is American GPS satellites only
+  gnss.loadConfig();
+  gnss.apply(gnss.mode);
 
   logger.log(GPS_SETUP, INFO, "Turn on RMC (recommended minimum) and GGA (fix data) including altitude: ");
   logger.log(GPS_SETUP, INFO, PMTK_SET_NMEA_OUTPUT_RMCGGA);
@@ -775,6 +890,14 @@ void setup() {
   GPS.sendCommand(PMTK_SENTENCE_FREQUENCIES);   // Send command to GPS unit
   delay(50);
 
+  // ----- optional high-rate GPS replaces the baud rate, sentences and update rate above
+  gpsRate.loadConfig();
+  if (gpsRate.isHighRate()) {
+    gpsRate.apply(gpsRate.hz);
+  } else {
+    gpsRate.check();   // log UART and CPU budget
+  }
+
   // ----- report on our memory hogs
   char temp[200];
   logger.log(CONFIG, INFO, "Large resources:");
@@ -802,9 +925,10 @@ void setup() {
   volume.setToZero();                 // set digipot hardware to match its ctor (wiper=0) because the chip cannot be read
                                       // and all "setWiper" commands are really incr/decr pulses. This gets it sync.
   volume.setWiperPosition( gWiper );  // set default volume in digital pot
-  volumeView.loadConfig();            // restore volume setting from non-volatile RAM
+  volumeSetting.loadConfig();         // restore volume setting from non-volatile RAM
 #endif
-  cfgAudioType.loadConfig();          // restore Morse-vs-Speech setting from non-volatile RAM
+  audioSetting.loadConfig();          // restore Morse-vs-Speech setting from non-volatile RAM
+  mapSetting.loadConfig();            // restore map zoom level from non-volatile RAM
 
   // ----- init DAC for audio/morse code
   #if defined(SAMD_SERIES)
@@ -824,11 +948,17 @@ void setup() {
   // ----- restore GPS driving track breadcrumb trail
   trail.restoreGPSBreadcrumbTrail();  // this takes noticeable time (~0.2 sec)
   model->restore();                   //
+  warmStart.begin(model->gLatitude, model->gLongitude, model->gAltitude, model->gTimestamp);
   model->gHaveGPSfix = false;         // assume no satellite signal yet
   model->gSatellites = 0;
-  trail.rememberPUP();                // log a "power up" event
+  trips.loadConfig();                 // restored crumbs are not replayed, their trips are already in the table
+  trail.onRemember = observeTrip;     // every breadcrumb from here on goes to the trip engine
+  trail.rememberPUP();                // log a "power up" event, and end any open trip
   trail.saveGPSBreadcrumbTrail();     // ensure its saved for posterity
 
+  // ----- load geofences, if the user has any
+  geofence.loadFences();
+
   // ----- restore barometric pressure history
   if (baroModel.loadHistory()) {
     logger.log(CONFIG, INFO, "Successfully restored barometric pressure log");
@@ -854,6 +984,11 @@ void setup() {
   // ----- init ADC to read GPS coin battery
   gpsBattery.begin();
 
+#if defined(DUAL_CORE)
+  // ----- GPS serial port is ready, let core 1 start reading it
+  __atomic_store_n(&core0Ready, true, __ATOMIC_RELEASE);
+#endif
+
   // ----- all done with setup, show opening view screen
   // at this point, we finished showing the splash screen
   // next up is the Help screen which is already in progress
@@ -861,6 +996,28 @@ void setup() {
 }
 
 //=========== main work loop ===================================
+#if defined(DUAL_CORE)
+// ----- core 1: the GPS serial port and the fix snapshot, see nmea_reader.h
+void setup1() {
+  while (!__atomic_load_n(&core0Ready, __ATOMIC_ACQUIRE)) {
+    delay(1);
+  }
+}
+void loop1() {
+  nmeaReader.poll(Serial1);
+}
+#endif
+
+// ----- next complete NMEA sentence from the receiver, or nullptr
+char *nextNmeaSentence() {
+#if defined(DUAL_CORE)
+  static NmeaLine line;   // only core 0 calls this
+  return nmeaReader.nextSentence(&line) ? line.text : nullptr;
+#else
+  GPS.read();   // if you can, read the GPS serial port every millisecond
+  return GPS.newNMEAreceived() ? GPS.lastNMEA() : nullptr;   // lastNMEA() clears the newNMEAreceived() flag
+#endif
+}
 // "millis()" is number of milliseconds since the Arduino began running the current program.
 // This number will overflow after about 50 days.
 //uint32_t prevTimeGPS = millis();
@@ -893,19 +1050,25 @@ const int  LOG_COIN_BATTERY_INTERVAL = 10 * SECS_PER_1MIN;      // seconds betwe
 
 void loop() {
 
-  GPS.read();   // if you can, read the GPS serial port every millisecond
+  perf.startLoop();   // loop latency histogram, see "show perf"
 
-  if (GPS.newNMEAreceived()) {
+#if defined(SERIAL_BUFFER_SIZE) && !defined(DUAL_CORE)
+  if (Serial1.available() >= SERIAL_BUFFER_SIZE - 1) {
+    perf.nmeaBufferFull++;   // receive buffer is full, characters may be lost; perf.nmeaFixesLost counts the damage
+  }
+#endif
+
+  char *sentence = nextNmeaSentence();
+  if (sentence) {
     // optionally send NMEA sentences to Serial port, possibly for NMEATime2
     // Note: Adafruit parser doesn't handle $GPGSV (satellites in vieW) so we send all sentences regardless of content
     // But first, our GPS sends several NMEA sentences in a row, so let's flag the start of each group in the log
-    char firstNMEA[7] = "$GPGGA";
-    if (strncmp(GPS.lastNMEA(), firstNMEA, sizeof(firstNMEA)-1) == 0) {
+    if (Nmea::isType(sentence, "GGA")) {   // $GPGGA or $GNGGA
       // insert divider into log for readability
       char divider[5] = "----";
       logger.log(NMEA, INFO, divider);
     }
-    logger.log(NMEA, INFO, GPS.lastNMEA());
+    logger.log(NMEA, INFO, sentence);
 
     // sentence received -- verify checksum, parse it
     // a tricky thing here is if we print the NMEA sentence, or data
@@ -913,11 +1076,39 @@ void loop() {
     // so be very wary if using OUTPUT_ALLDATA, which generates loads of sentences,
     // since trying to print them all out is time-consuming
     // GPS parsing: https://learn.adafruit.com/adafruit-ultimate-gps/parsed-data-output
-    if (!GPS.parse(GPS.lastNMEA())) {
+    bool parsed;
+    {
+      TraceScope trace(eTraceGpsParse);
+      bool satellites = gnss.parse(sentence);   // GSV and GSA, which the Adafruit library ignores
+      parsed          = GPS.parse(sentence) || satellites;
+    }
+    if (!parsed) {
       // parsing failed -- restart main loop to wait for another sentence
-      // this also sets the newNMEAreceived() flag to false
+      perf.nmeaFailed++;
       return;
     }
+    perf.nmeaParsed++;
+
+    if (Nmea::isType(sentence, "RMC")) {
+      uint32_t lostBefore = gpsRate.fixesDropped;
+      gpsRate.onFix(GPS);   // count fixes and gaps, see "show gps rate"
+      perf.nmeaFixesLost += gpsRate.fixesDropped - lostBefore;
+      if (gpsRate.isHighRate() && model == &modelGPS) {
+        // high-rate mode: every fix goes straight into the model, so the
+        // grid crossing detectors below run on each fix
+        // (not for simulated or replayed data, which must keep their own pace)
+        TraceScope trace(eTraceModelUpdate);
+        model->getGPS();
+      }
+    }
+  }
+
+  // time to first fix is about the receiver hardware, not the simulator, so this is the one place to use GPS.fix
+  if (gnss.checkFirstFix(GPS.fix)) {
+    TimeElements tm{GPS.seconds, GPS.minute, GPS.hour, 0, GPS.day, GPS.month, (byte)(2000-1970+GPS.year)};
+    PointGPS firstFix{GPS.latitudeDegrees, GPS.longitudeDegrees};
+    trail.rememberTFF(firstFix, makeTime(tm), GPS.satellites, gnss.firstFixSeconds(), warmStart.sent);
+    trail.saveGPSBreadcrumbTrail();   // ensure its saved for posterity
   }
 
   // look for the first "setTime()" to begin the datalogger
@@ -939,6 +1130,9 @@ void loop() {
     time_t firstTime = makeTime(tm);
     trail.rememberFirstValidTime(firstTime, GPS.satellites);
     trail.saveGPSBreadcrumbTrail();   // ensure its saved for posterity
+
+    // receiver's RTC is running, so now it can use our last position
+    warmStart.onFirstValidTime(firstTime, GPS.fix);
   }
 
   // every 1 second update the realtime clock
@@ -951,7 +1145,12 @@ void loop() {
       setTime(GPS.hour, GPS.minute, GPS.seconds, GPS.day, GPS.month, GPS.year);
       // adjustTime(offset * SECS_PER_HOUR);  // todo - adjust to local time zone. for now, we only do GMT
     }
+    TraceScope trace(eTraceViewUpdate, pView->screenID);
     pView->updateScreen();                   // update time on current view
+    perf.countViewUpdate(pView->screenID);
+    if (perf.overlay) {
+      perf.showOverlay();                    // optional loop statistics, see "show perf overlay"
+    }
   }
 
   // periodically save the number of satellites acquired for later analysis
@@ -960,7 +1159,7 @@ void loop() {
   if (satCountTimer > SAT_SAVE_INTERVAL) {
     satCountTimer = 0;
 
-    satCountView.push(now(), model->gSatellites);
+    satCountHistory.push(now(), model->gSatellites, gnss.current());
   }
 
   // send RTC to a (possible) Windows program, e.g. https://github.com/barry-ha/Laptop-Griduino
@@ -976,6 +1175,12 @@ void loop() {
     prevTimeRTC = rtc;
   }
 
+  // read the barometer on its own schedule, views use the cached reading
+  if (baroModel.update()) {
+    altFusion.update(baroModel.gPressure, baroModel.sampledAt,
+                     model->gHaveGPSfix, model->gAltitude, model->gHDOP, model->gSatellites);
+  }
+
   // every 15 minutes read barometric pressure and save it in nonvolatile RAM
   // synchronize showReadings() on exactly 15-minute marks 
   // so the user can more easily predict when the next update will occur
@@ -997,10 +1202,15 @@ void loop() {
 //  if (millis() - prevTimeGPS > GPS_PROCESS_INTERVAL) {
 //    prevTimeGPS = millis();           // restart another interval
 
-    model->processGPS();               // update model
+    {
+      TraceScope trace(eTraceModelUpdate);
+      model->processGPS();             // update model
+    }
 
     // update View
+    TraceScope trace(eTraceViewUpdate, pView->screenID);
     pView->updateScreen();             // update current view, eg, updateGridScreen()
+    perf.countViewUpdate(pView->screenID);
   }
 
   //if (!spkrMorse.continueSending()) {
@@ -1018,13 +1228,17 @@ void loop() {
   grid.calcLocator(newGrid6, model->gLatitude, model->gLongitude, 6);
 
   if (model->enteredNewGrid4()) {
-    pView->startScreen();          // update display so they can see new grid while listening to audible announcement
-    pView->updateScreen();
+    {
+      TraceScope trace(eTraceViewStart, pView->screenID);
+      pView->startScreen();          // update display so they can see new grid while listening to audible announcement
+      pView->updateScreen();
+      perf.countViewUpdate(pView->screenID);
+    }
     announceGrid(newGrid6, 4);     // announce with Morse code or speech, according to user's config
 
     Location whereAmI;
-    model->makeLocation(&whereAmI);
-    trail.rememberGPS(whereAmI);
+    makeBreadcrumb(&whereAmI);
+    trail.rememberGPS(whereAmI, model->gHDOP);
     logger.fencepost("Griduino.ino new grid4",__LINE__);  // debug
     trail.saveGPSBreadcrumbTrail();   // entered new 4-digit grid
 
@@ -1035,8 +1249,8 @@ void loop() {
       announceGrid(newGrid6, 6);   // announce with Morse code or speech, according to user's config
     }
     Location whereAmI;
-    model->makeLocation(&whereAmI);
-    trail.rememberGPS(whereAmI);    // when we enter a new 6-digit grid, save it in breadcrumb trail
+    makeBreadcrumb(&whereAmI);
+    trail.rememberGPS(whereAmI, model->gHDOP);    // when we enter a new 6-digit grid, save it in breadcrumb trail
     logger.fencepost("Griduino.ino new grid6",__LINE__);  // debug
     trail.saveGPSBreadcrumbTrail();   // entered new 6-digit grid 
     // one user's home was barely in the next grid6
@@ -1051,8 +1265,8 @@ void loop() {
   PointGPS currentGPS{model->gLatitude, model->gLongitude};
   if (grid.isVisibleDistance(prevRememberedGPS, currentGPS)) {
     Location whereAmI;
-    model->makeLocation(&whereAmI);
-    trail.rememberGPS(whereAmI);
+    makeBreadcrumb(&whereAmI);
+    trail.rememberGPS(whereAmI, model->gHDOP);
     prevRememberedGPS = currentGPS;
 
     if (0 == (trail.getHistoryCount() % trail.saveInterval)) {
@@ -1061,6 +1275,18 @@ void loop() {
     }
   }
 
+  // if we crossed a geofence, announce it and add it to the breadcrumb trail
+  if (model->gHaveGPSfix) {
+    geofence.check(currentGPS);   // returns at once unless we moved
+    Geofence::Event event;
+    while (geofence.nextEvent(event)) {
+      announceFence(geofence.fence(event.fence).name, event.entered);
+      Location whereAmI;
+      makeBreadcrumb(&whereAmI);
+      trail.rememberFence(whereAmI, event.fence, event.entered);
+    }
+  }
+
   // if we lost GPS signal for a long time, issue audible announcement
   if (model->gHaveGPSfix) {
     // satellites are in view, business as usual, restart LOS timer
@@ -1074,19 +1300,14 @@ void loop() {
     }
   }
 
-  // periodically log the coin battery's voltage 
+  // average the coin battery's voltage on its own slow schedule, views use the cached value
   // todo: sensor exists only on PCB v7+
+  gpsBattery.update((timeStatus() == timeSet) ? now() : 0);   // keeps its own history, see "show battery"
+
+  // periodically log the coin battery's voltage 
   if (batteryTimer > LOG_COIN_BATTERY_INTERVAL) {
     batteryTimer = 0;
-
-    const float analogRef     = 3.3;    // analog reference voltage
-    const uint16_t analogBits = 1024;   // ADC resolution is 10 bits
-
-    int coin_adc       = analogRead(BATTERY_ADC);
-    float coin_voltage = (float)coin_adc * analogRef / analogBits;
-    logger.logFloat(BATTERY, INFO, "Coin battery = %sv", coin_voltage, 3);
-
-    trail.rememberBAT(coin_voltage);
+    logger.logFloat(BATTERY, INFO, "Coin battery = %sv", gpsBattery.readCoinBatteryVoltage(), 3);
   }
 
   // log GPS position every few minutes, to keep track of lingering in one spot
@@ -1094,10 +1315,10 @@ void loop() {
     autoLogTimer = 0;
 
     Location whereAmI;
-    model->makeLocation(&whereAmI);
+    makeBreadcrumb(&whereAmI);
     logger.log(GPS_SETUP, DEBUG, "Griduino.ino autolog timer (line %d)", __LINE__);  // debug
     //whereAmI.printLocation();                                 // debug
-    trail.rememberGPS(whereAmI);
+    trail.rememberGPS(whereAmI, model->gHDOP);
     trail.saveGPSBreadcrumbTrail();   // autosave timer
   }
 
@@ -1106,28 +1327,17 @@ void loop() {
   }
 
   // if there's touchscreen input, handle it
-  ScreenPoint screenLoc;
-  if (tsn.newScreenTap(&screenLoc, tft.getRotation())) {
-
-    if (showTouchTargets) {
-      showWhereTouched(screenLoc);   // debug: show where touched
-    }
-
-    Point touch = {screenLoc.x, screenLoc.y};
-    bool touchHandled = pView->onTouch(touch);
+  // the panel is sampled here when a sample is due, never during blocking work, see touch_events.h
+  touchEvents.update(tsn, tft.width(), tft.height(), tft.getRotation());
+  TouchEvent event;
+  while (touchEvents.pop(&event)) {
+    handleTouchEvent(event);
+  }
 
-    if (!touchHandled) {
-      // not handled by one of the views, so run our default action
-      if (areaGear.contains(touch)) {
-        selectNewView(GOTO_SETTINGS);   // advance to next settings view
-      } else if (areaArrow.contains(touch)) {
-        selectNewView(GOTO_NEXT_VIEW);   // advance to next normal user view
-      } else if (areaBrite.contains(touch)) {
-        adjustBrightness();   // change brightness
-      } else {
-        // nothing to do
-      }
-    }
+  // if a view asked to leave, switch now that none of its code is running
+  int requestedView = views.takeRequest();
+  if (requestedView != NO_VIEW_REQUEST) {
+    selectNewView(requestedView);
   }
 
   // if there's text from the USB port, handle it
@@ -1142,4 +1352,7 @@ void loop() {
   // small activity bar crawls along bottom edge to give
   // a sense of how frequently the main loop is executing
   showActivityBar(tft.height()-1, ILI9341_RED, pView->background);
+
+  // send deferred log messages, now that time-critical work is done
+  logger.drain();
 }
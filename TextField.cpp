@@ -19,37 +19,38 @@ extern Logger logger;                // Griduino.ino
 extern Adafruit_ILI9341 tft;         // Griduino.ino  TODO: eliminate this global
 extern void setFontSize(int font);   // Griduino.ino  TODO: eliminate this extern
 
-uint16_t TextField::cBackground;   // background color
+uint16_t TextFieldState::cBackground;   // background color
+uint16_t TextFieldState::constructed;   // fields built since power-up
 
 // ========== TextField ===============================
-void TextField::eraseOld() {
+void TextFieldState::eraseOld() {
   // we remember the area to erase from the previous print()
   tft.fillRect(xPrev, yPrev, wPrev, hPrev, cBackground);   // erase the requested width of old text
   // tft.drawRect(xPrev-2, yPrev-2, wPrev+4, hPrev+4, ILI9341_RED); // debug: show what area was erased
 }
-void TextField::printNew(const char *pText) {
+void TextFieldState::printNew(const TextLayout &where, const char *pText) {
   int16_t x1, y1;
   uint16_t w, h;
 
-  if (fontsize != eFONTUNSPEC) {
-    setFontSize(fontsize);
+  if (where.fontsize != eFONTUNSPEC) {
+    setFontSize(where.fontsize);
   }
 
-  int leftedge = x;
-  if (align == ALIGNCENTER) {
+  int leftedge = where.x;
+  if (where.align == ALIGNCENTER) {
     // centered text left-right (ignore any given x-coordinate)
-    tft.getTextBounds(pText, 0, y, &x1, &y1, &w, &h);
+    tft.getTextBounds(pText, 0, where.y, &x1, &y1, &w, &h);
     leftedge = (tft.width() - w) / 2;
-  } else if (align == ALIGNRIGHT) {
-    tft.getTextBounds(pText, 0, y, &x1, &y1, &w, &h);
-    leftedge = x - w;   // move text origin by width of text
+  } else if (where.align == ALIGNRIGHT) {
+    tft.getTextBounds(pText, 0, where.y, &x1, &y1, &w, &h);
+    leftedge = where.x - w;   // move text origin by width of text
   }
-  tft.setCursor(leftedge, y);
-  tft.setTextColor(color);
+  tft.setCursor(leftedge, where.y);
+  tft.setTextColor(color);   // not where.color, since a view may have changed it
   tft.print(pText);
 
   // remember region so it can be erased next time
-  tft.getTextBounds(pText, leftedge, y, &xPrev, &yPrev, &wPrev, &hPrev);
+  tft.getTextBounds(pText, leftedge, where.y, &xPrev, &yPrev, &wPrev, &hPrev);
 }
 
 void TextButton::print() {   // override base class: buttons draw their own outline
@@ -63,7 +64,7 @@ void TextButton::print() {   // override base class: buttons draw their own outl
   // center text horizontally and vertically withing visible button boundary
   int16_t x1, y1;
   uint16_t w1, h1;
-  tft.getTextBounds(text, buttonArea.ul.x, buttonArea.ul.y, &x1, &y1, &w1, &h1);
+  tft.getTextBounds(label, buttonArea.ul.x, buttonArea.ul.y, &x1, &y1, &w1, &h1);
 
   int leftEdge = buttonArea.ul.x + buttonArea.size.x / 2 - 1 / 2;
   int topEdge  = buttonArea.ul.y + buttonArea.size.y / 2;
@@ -71,16 +72,16 @@ void TextButton::print() {   // override base class: buttons draw their own outl
   x = leftEdge;
   y = topEdge;
 
-  logger.log(SCREEN, DEBUG, "Placement of text: %s", this->text);
+  logger.log(SCREEN, DEBUG, "Placement of text: %s", this->label);
 
-  char temp[255];
+  char temp[80];
   snprintf(temp, sizeof(temp),
            ". button outline (%d,%d,%d,%d), text posn(%d,%d)",
            buttonArea.ul.x, buttonArea.ul.y, buttonArea.size.x, buttonArea.size.y, leftEdge, topEdge);
   logger.log(SCREEN, DEBUG, temp);
 
   // base class will draw text
-  TextField::print(text);
+  TextField::print(label);
 }
 
 // ========== font management helpers ==========================
@@ -128,6 +129,23 @@ void setFontSize(int font) {
   }
 }
 
+const GFXfont *getFont(int font) {
+  // input: "font" = point size, same as setFontSize()
+  // returns nullptr for the built-in system font
+  switch (font) {
+  case 36:   // eFONTGIANT
+    return &FreeSans18pt7b;
+  case 24:   // eFONTBIG
+    return &FreeSansBold24pt7b;
+  case 12:   // eFONTSMALL
+    return &FreeSans12pt7b;
+  case 9:   // eFONTSMALLEST
+    return &FreeSans9pt7b;
+  default:
+    return nullptr;
+  }
+}
+
 int getOffsetToCenterText(String text) {
   // measure width of given text in current font and
   // calculate X-offset to make it centered left-right on screen
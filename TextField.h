@@ -28,6 +28,8 @@
 //  THE SOFTWARE.
 //------------------------------------------------------------------------------
 
+#include "format_helper.h"   // number to text without the heap
+
 #define ALIGNLEFT        0        // align text toward left, using x=left edge of string
 #define ALIGNRIGHT       1        // align text toward right, using x=right edge of string
 #define ALIGNCENTER      2        // center text left-right, should set x=-1
@@ -35,10 +37,91 @@
 
 // utilities in TextField.cpp
 void setFontSize(int font);
+const GFXfont *getFont(int font);
 int getOffsetToCenterText(String text);
 int getOffsetToCenterTextOnButton(String text, int leftEdge, int width);
 
-class TextField {
+// ========== struct TextLayout ================================
+// The parts of a text field that never change. A table of these declared
+// constexpr stays in flash, and FixedTextField keeps only a pointer to its row.
+//      constexpr TextLayout gridLayout[] = {
+//        // text    x,y     color      align      font
+//        {"N",    156,47, cCOMPASS, ALIGNLEFT, eFONTUNSPEC},
+//      };
+//      FixedTextField txtGrid[] = {gridLayout[0]};
+struct TextLayout {
+  const char *label;   // static text for print()
+  int16_t x, y;        // screen coordinates
+  uint16_t color;      // text color when the field is built
+  uint8_t align;       // ALIGNLEFT | ALIGNRIGHT | ALIGNCENTER
+  int8_t fontsize;     // eFONTGIANT | eFONTBIG | eFONTSMALL | eFONTSMALLEST | eFONTSYSTEM | eFONTUNSPEC
+};
+
+// ========== class TextFieldState =============================
+// What every text field keeps in RAM: its color, which a view may change,
+// and just enough to know when to redraw and what to erase.
+class TextFieldState {
+public:
+  uint16_t color;   // text color
+  bool dirty;       // true=force reprint even if old=new
+
+  static uint16_t constructed;   // count of fields built since power-up, see ViewRegistry
+
+  template <class Field>
+  static void setTextDirty(Field *pTable, int count) {
+    // Mark all text fields "dirty" to force reprinting them at next usage
+    for (int ii = 0; ii < count; ii++) {
+      pTable[ii].dirty = true;
+    }
+  }
+  void setColor(uint16_t fgd) {
+    if (this->color != fgd) {
+      this->color = fgd;
+      this->dirty = true;
+    }
+  }
+  void setBackground(uint16_t bkg) {
+    // Set ALL text fields background color - this is a single static var
+    cBackground = bkg;
+  }
+
+protected:
+  static uint16_t cBackground;   // background color
+  uint32_t hashPrev;             // hash of the text on screen, instead of a copy of it
+  int16_t xPrev, yPrev;          // remember previous text area for next erasure
+  uint16_t wPrev, hPrev;
+
+  void initState(const char *vtxt, uint16_t vcc) {
+    color    = vcc;
+    dirty    = true;
+    hashPrev = hash(vtxt);
+    xPrev = yPrev = wPrev = hPrev = 0;
+    constructed++;
+  }
+  void show(const TextLayout &where, const char *pText) {
+    // main central print routine
+    uint32_t hashNew = hash(pText);
+    if (dirty || hashNew != hashPrev) {
+      eraseOld();
+      printNew(where, pText);
+      hashPrev = hashNew;
+      dirty    = false;
+    }
+  }
+  void eraseOld();
+  void printNew(const TextLayout &where, const char *pText);
+  static uint32_t hash(const char *pText) {
+    // FNV-1a, enough to tell whether the text changed
+    uint32_t h = 2166136261UL;
+    while (*pText) {
+      h = (h ^ (uint8_t)*pText++) * 16777619UL;
+    }
+    return h;
+  }
+};
+
+// ========== class TextField ==================================
+class TextField : public TextFieldState {
   // Write dynamic text to the TFT display and optimize
   // redrawing text in proportional fonts to reduce flickering
   //
@@ -58,19 +141,28 @@ class TextField {
   //      1. Text origin is bottom left corner
   //      2. Rect origin is upper left corner
   //      3. Printing text in proportional font does not clear its own background
+  //
+  // Note about RAM:
+  //      The label is a pointer to a string constant, which stays in flash.
+  //      The field does not keep a copy of its text; it remembers only a hash
+  //      of what is on the screen and the box to erase. The label constructor
+  //      accepts only a char array, so a temporary buffer can't be stored by mistake.
+  //      Since nothing remembers the last value, print() always draws the label;
+  //      a field showing a value is redrawn by printing the value again.
+  //      When the position never changes, FixedTextField keeps even less in RAM.
 
 public:
-  char text[42];    // new text to draw (max 40 chars on screen, at size eFONTSMALL
-  int x, y;         // screen coordinates
-  uint16_t color;   // text color
-  int align;        // ALIGNLEFT | ALIGNRIGHT | ALIGNCENTER
-  int fontsize;     // eFONTGIANT | eFONTBIG | eFONTSMALL | eFONTSMALLEST | eFONTSYSTEM | eFONTUNSPEC
-  bool dirty;       // true=force reprint even if old=new
+#define TEXTFIELD_MAX_LABEL 42   // max 40 chars on screen, at size eFONTSMALL
+
+  const char *label;   // static text for print(), in flash
+  int16_t x, y;        // screen coordinates
+  uint8_t align;       // ALIGNLEFT | ALIGNRIGHT | ALIGNCENTER
+  int8_t fontsize;     // eFONTGIANT | eFONTBIG | eFONTSMALL | eFONTSMALLEST | eFONTSYSTEM | eFONTUNSPEC
 
   void dump() {
     // dump the state of this object to the console for debug
     char buf[128];
-    snprintf(buf, sizeof(buf), "TextField('%s') x,y(%d,%d)", text, x, y);
+    snprintf(buf, sizeof(buf), "TextField('%s') x,y(%d,%d)", label, x, y);
     Serial.print(buf);   // use Serial (not logger) so TextField is more reusable
     snprintf(buf, sizeof(buf), ". Erase x,y,w,h(%d,%d, %d,%d)", xPrev, yPrev, wPrev, hPrev);
     Serial.println(buf);
@@ -80,47 +172,27 @@ public:
     init("", vxx, vyy, vcc, valign, vsize);
   }
   // ctor - text field including its content
-  TextField(const char vtxt[26], int vxx, int vyy, uint16_t vcc, int valign = ALIGNLEFT, int vsize = eFONTUNSPEC) {
+  template <size_t N>
+  TextField(const char (&vtxt)[N], int vxx, int vyy, uint16_t vcc, int valign = ALIGNLEFT, int vsize = eFONTUNSPEC) {
+    static_assert(N <= TEXTFIELD_MAX_LABEL, "TextField label is too long for the screen");
     init(vtxt, vxx, vyy, vcc, valign, vsize);
   }
-  // ctor - numeric field
-  TextField(const int vnum, int vxx, int vyy, uint16_t vcc, int valign = ALIGNLEFT, int vsize = eFONTUNSPEC) {
-    char temp[sizeof(text)];
-    snprintf(temp, sizeof(temp), "%d", vnum);
-    init(temp, vxx, vyy, vcc, valign, vsize);
-  }
-  // ctor - text field content specified by a "class String"
-  TextField(const String vstr, int vxx, int vyy, uint16_t vcc, int valign = ALIGNLEFT, int vsize = eFONTUNSPEC) {
-    char temp[vstr.length() + 1];
-    vstr.toCharArray(temp, sizeof(temp));
-    init(temp, vxx, vyy, vcc, valign, vsize);
-  }
   // common ctor for all data field types
-  void init(const char vtxt[26], int vxx, int vyy, uint16_t vcc, int valign, int vsize) {
-    strncpy(textPrev, vtxt, sizeof(textPrev) - 1);
-    strncpy(text, vtxt, sizeof(text) - 1);
+  void init(const char *vtxt, int vxx, int vyy, uint16_t vcc, int valign, int vsize) {
+    label    = vtxt;
     x        = vxx;
     y        = vyy;
-    color    = vcc;
     align    = valign;
     fontsize = vsize;
-    dirty    = true;
-    xPrev = yPrev = wPrev = hPrev = 0;
+    initState(vtxt, vcc);
   }
 
   void print(const char *pText) {   // dynamic text
-    // main central print routine
-    if (dirty || strcmp(textPrev, pText)) {
-      eraseOld();
-      printNew(pText);
-      strncpy(text, pText, sizeof(text));
-      strncpy(textPrev, pText, sizeof(textPrev));
-      dirty = false;
-    }
+    show(TextLayout{label, x, y, color, align, fontsize}, pText);
   }
   void print() {   // static text
     // delegate to this->print(char*)
-    print(text);
+    print(label);
   }
   void print(const int d) {   // dynamic integer
     // format integer and delegate to this->print(char*)
@@ -130,40 +202,59 @@ public:
   }
   void print(const String str) {   // dynamic String
     // format String object and delegate to this->print(char*)
-    char temp[str.length() + 1];
+    char temp[TEXTFIELD_MAX_LABEL];
     str.toCharArray(temp, sizeof(temp));
     print(temp);   // delegate to this->print(char*)
   }
   void print(const float f, const int digits) {   // float
-    String sFloat = String(f, digits);
+    char sFloat[TEXTFIELD_MAX_LABEL];
+    fixedToChars(sFloat, sizeof(sFloat), f, digits);
     print(sFloat);
   }
-  static void setTextDirty(TextField *pTable, int count) {
-    // Mark all text fields "dirty" to force reprinting them at next usage
-    for (int ii = 0; ii < count; ii++) {
-      pTable[ii].dirty = true;
-    }
+};
+
+// ========== class FixedTextField =============================
+// A TextField whose label, position and font are a row of a constexpr
+// TextLayout table in flash. Only the color and the redraw state are in RAM.
+class FixedTextField : public TextFieldState {
+public:
+  const TextLayout *layout;   // in flash
+
+  FixedTextField(const TextLayout &vlayout) {
+    layout = &vlayout;
+    initState(vlayout.label, vlayout.color);
   }
-  void setColor(uint16_t fgd) {
-    if (this->color != fgd) {
-      this->color = fgd;
-      this->dirty = true;
-    }
+
+  void print(const char *pText) {   // dynamic text
+    show(*layout, pText);
   }
-  void setBackground(uint16_t bkg) {
-    // Set ALL text fields background color - this is a single static var
-    cBackground = bkg;
+  void print() {   // static text
+    print(layout->label);
+  }
+  void print(const int d) {   // dynamic integer
+    char sInteger[8];
+    snprintf(sInteger, sizeof(sInteger), "%d", d);
+    print(sInteger);
+  }
+  void print(const float f, const int digits) {   // float
+    char sFloat[TEXTFIELD_MAX_LABEL];
+    fixedToChars(sFloat, sizeof(sFloat), f, digits);
+    print(sFloat);
   }
+};
 
-protected:
-  static uint16_t cBackground;   // background color
-  int16_t xPrev, yPrev;          // remember previous text area for next erasure
+// ----- the members TextField had when it copied its text into RAM, kept
+// only so "show views" reports the saving as measured on this processor
+struct TextFieldBefore {
+  char text[42];
+  int x, y;
+  uint16_t color;
+  int align;
+  int fontsize;
+  bool dirty;
+  int16_t xPrev, yPrev;
   uint16_t wPrev, hPrev;
-  char textPrev[32];   // old text to be erased
-
-protected:
-  void eraseOld();
-  void printNew(const char *pText);
+  char textPrev[32];
 };
 
 class TextButton : public TextField {
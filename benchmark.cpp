@@ -0,0 +1,332 @@
+// Please format this file with clang before check-in to GitHub
+/*
+  File:     benchmark.cpp - micro-benchmarks for the hot paths
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Measure the code that runs every second or on every breadcrumb,
+            so that releases can be compared against each other.
+            Run it with the console command "run benchmark".
+
+            Results are CSV lines starting with "BENCH," so they are easy to
+            grep out of a saved console log and paste into a spreadsheet:
+                BENCH,version,test,crumbs,iterations,ns/op,heap bytes
+                BENCH,v1.14.4,calcLocator6,0,1000,11843,0
+
+            "heap bytes" is the net change in heap in use after the test,
+            so a nonzero value means the code under test keeps memory.
+
+            Fixture trails in RAM are 100, 1000 and a full trail (trail.capacity).
+            CSV save and restore are measured on the user's own trail, which is
+            saved first, so the file is never replaced by a fixture. The pressure
+            history is also saved first and restored afterward, and geofences
+            are loaded again from their file. This makes it safe to run in the field.
+
+            The trail lives in RAM and holds trail.capacity crumbs, so that is
+            the largest size measured here. The desktop build in extras/host_test
+            runs this same list with "make bench", then adds 10k and 100k crumb
+            fixtures for parsing, restoring and the trip engine. Desktop times
+            are for a different CPU and a display that draws nothing, so compare
+            them only with other desktop runs.
+*/
+
+#include <Arduino.h>             // for Serial
+#include <malloc.h>              // for mallinfo()
+#include <Adafruit_ILI9341.h>    // TFT color display library
+#include "constants.h"           // Griduino constants, colors and typedefs
+#include "hardware.h"            // Griduino pin definitions
+#include "logger.h"              // conditional printing to Serial port
+#include "grid_helper.h"         // lat/long conversion routines
+#include "date_helper.h"         // date/time conversions
+#include "model_breadcrumbs.h"   // breadcrumb trail
+#include "model_trips.h"         // trips and their statistics
+#include "model_geofence.h"      // county lines, contest areas and exclusion zones
+#include "model_baro.h"          // Model of a barometer that stores 3-day history
+#include "TextField.h"           // Optimize TFT display text for proportional fonts
+#include "glyph_atlas.h"         // giant grid name drawn as horizontal runs
+#include "view.h"                // Base class for all views
+
+// ========== extern ===========================================
+extern Logger logger;                                                                    // Griduino.ino
+extern Grids grid;                                                                       // grid_helper.h
+extern Dates date;                                                                       // date_helper.h
+extern Breadcrumbs trail;                                                                // Griduino.ino
+extern BarometerModel baroModel;                                                         // Griduino.ino
+extern Adafruit_ILI9341 tft;                                                             // Griduino.ino
+extern int grid_view;                                                                    // Griduino.ino
+extern void floatToCharArray(char *result, int maxlen, double fValue, int decimalPlaces);   // Griduino.ino
+extern void setFontSize(int font);                                                       // TextField.cpp
+extern void plotRoute(Breadcrumbs *trail, const PointGPS origin);                        // view_grid.cpp
+
+// ----- results
+static volatile double sink;   // keeps the compiler from optimizing away the code under test
+
+static int heapInUse() {
+  struct mallinfo mi = mallinfo();
+  return mi.uordblks;
+}
+
+static void report(const char *test, int crumbs, int iterations, unsigned long usec, int heapBefore) {
+  unsigned long nsPerOp = (unsigned long)((uint64_t)usec * 1000 / iterations);
+  char msg[100];
+  snprintf(msg, sizeof(msg), "BENCH,%s,%s,%d,%d,%lu,%d\n",
+           PROGRAM_VERSION, test, crumbs, iterations, nsPerOp, heapInUse() - heapBefore);
+  logger.print(msg);
+}
+
+// ----- fixture
+static void makeTrail(int numCrumbs) {
+  // fill breadcrumb trail with a zigzag across CN87
+  const TimeElements start{0, 0, 12, 0, 1, 6, (2023 - 1970)};   // June 1, 2023
+  time_t stamp = makeTime(start);
+
+  trail.clearHistory();
+  for (int ii = 0; ii < numCrumbs; ii++) {
+    PointGPS loc{47.2 + (ii % 50) * 0.01, -123.9 + (ii % 1000) * 0.0015};
+    trail.rememberGPS(loc, stamp + ii, 7, 55.0, 90.0, 120.0);
+  }
+}
+
+// ----- benchmarks for pure computation
+static void benchLocator(const char *test, int precision) {
+  const int n = 1000;
+  char grid6[12];
+  int heap            = heapInUse();
+  unsigned long start = micros();
+  for (int ii = 0; ii < n; ii++) {
+    grid.calcLocator(grid6, 47.0 + ii * 0.001, -124.0 + ii * 0.002, precision);
+  }
+  unsigned long elapsed = micros() - start;
+  sink                  = grid6[0];
+  report(test, 0, n, elapsed, heap);
+}
+
+static void benchDistance() {
+  const int n         = 1000;
+  double total        = 0.0;
+  int heap            = heapInUse();
+  unsigned long start = micros();
+  for (int ii = 0; ii < n; ii++) {
+    total += grid.calcDistance(47.5, -122.5, 47.5 + ii * 0.001, -122.5 - ii * 0.001, false);
+  }
+  unsigned long elapsed = micros() - start;
+  sink                  = total;
+  report("calcDistance", 0, n, elapsed, heap);
+}
+
+static void benchFloatToChar() {
+  const int n = 1000;
+  char result[16];
+  int heap            = heapInUse();
+  unsigned long start = micros();
+  for (int ii = 0; ii < n; ii++) {
+    floatToCharArray(result, sizeof(result), 101325.0 + ii * 0.37, 2);
+  }
+  unsigned long elapsed = micros() - start;
+  sink                  = result[0];
+  report("floatToCharArray", 0, n, elapsed, heap);
+}
+
+static void benchStringFloat() {
+  // the old floatToCharArray(), kept here as a baseline for comparison
+  const int n = 1000;
+  char result[16];
+  int heap            = heapInUse();
+  unsigned long start = micros();
+  for (int ii = 0; ii < n; ii++) {
+    String temp = String(101325.0 + ii * 0.37, 2);
+    temp.toCharArray(result, sizeof(result));
+  }
+  unsigned long elapsed = micros() - start;
+  sink                  = result[0];
+  report("String(double)", 0, n, elapsed, heap);
+}
+
+static void benchDateToString() {
+  const int n = 1000;
+  char sDate[24];
+  time_t stamp        = now();
+  int heap            = heapInUse();
+  unsigned long start = micros();
+  for (int ii = 0; ii < n; ii++) {
+    date.datetimeToString(sDate, sizeof(sDate), stamp + ii * 61);   // new time every call, defeats TimeLib's cache
+  }
+  unsigned long elapsed = micros() - start;
+  sink                  = sDate[0];
+  report("datetimeToString", 0, n, elapsed, heap);
+}
+
+static void benchRememberPressure() {
+  const int n         = 1000;
+  time_t stamp        = now();
+  int heap            = heapInUse();
+  unsigned long start = micros();
+  for (int ii = 0; ii < n; ii++) {
+    baroModel.testRememberPressure(101325.0 + ii, stamp + ii * 900);
+  }
+  unsigned long elapsed = micros() - start;
+  report("rememberPressure", 0, n, elapsed, heap);
+}
+
+static void benchGeofence(int numFences) {
+  // fences on a lattice across several grid squares, and a drive through them
+  geofence.reserve(numFences, 0);
+  for (int ii = 0; ii < numFences; ii++) {
+    PointGPS center{46.6 + (ii % 10) * 0.3, -124.4 + (ii / 10) * 0.5};
+    geofence.addCircle("BENCH", center, 8.0);
+  }
+  geofence.buildIndex();   // allocates, so do it before measuring the heap
+  Geofence::Event event;
+  const int n         = 1000;
+  int heap            = heapInUse();
+  unsigned long start = micros();
+  for (int ii = 0; ii < n; ii++) {
+    geofence.check(PointGPS{46.6 + ii * 0.0023, -124.4 + ii * 0.0105});
+    while (geofence.nextEvent(event)) {
+      sink = event.fence;
+    }
+  }
+  unsigned long elapsed = micros() - start;
+  report("geofence.check", numFences, n, elapsed, heap);
+}
+
+static void benchTextField() {
+  const int n = 100;
+  TextField txtBench("Bench 12345", 10, 120, cVALUE, ALIGNLEFT, eFONTSMALL);
+  int heap            = heapInUse();
+  unsigned long start = micros();
+  for (int ii = 0; ii < n; ii++) {
+    txtBench.print(ii);   // number changes, so text is erased and redrawn every time
+  }
+  unsigned long elapsed = micros() - start;
+  report("TextField.print", 0, n, elapsed, heap);
+}
+
+static void benchGridName() {
+  // redraw the giant grid name as if crossing a grid line every time
+  // on the real screen, same place as the grid view, old way and new way
+  const int n             = 20;
+  const char *names[2][2] = {{"CN87", "us"}, {"CN88", "ab"}};
+  TextField oldGrid4("CN77", 101, 101, cGRIDNAME);
+  TextField oldGrid6("tt", 138, 141, cGRIDNAME);
+  int heap            = heapInUse();
+  unsigned long start = micros();
+  for (int ii = 0; ii < n; ii++) {
+    setFontSize(eFONTBIG);
+    oldGrid4.print(names[ii % 2][0]);   // erase, then rasterize pixel by pixel
+    oldGrid6.print(names[ii % 2][1]);
+  }
+  unsigned long elapsed = micros() - start;
+  report("gridName.TextField", 0, n, elapsed, heap);
+
+  GlyphAtlas atlas(getFont(eFONTBIG));
+  GlyphField newGrid4(atlas, "CN77", 101, 101, cGRIDNAME);
+  GlyphField newGrid6(atlas, "tt", 138, 141, cGRIDNAME);
+  heap  = heapInUse();
+  start = micros();
+  for (int ii = 0; ii < n; ii++) {
+    newGrid4.print(names[ii % 2][0]);   // horizontal runs, background included
+    newGrid6.print(names[ii % 2][1]);
+  }
+  elapsed = micros() - start;
+  report("gridName.GlyphAtlas", 0, n, elapsed, heap);
+}
+
+// ----- benchmarks that depend on trail size
+static void benchTrail(int numCrumbs) {
+  int heap            = heapInUse();
+  unsigned long start = micros();
+  makeTrail(numCrumbs);
+  unsigned long elapsed = micros() - start;
+  report("trail.remember", numCrumbs, numCrumbs, elapsed, heap);
+
+  heap          = heapInUse();
+  start         = micros();
+  int count     = 0;
+  Location *loc = trail.begin();
+  while (loc) {
+    sink = loc->loc.lat;
+    count++;
+    loc = trail.next();
+  }
+  elapsed = micros() - start;
+  report("trail.iterate", numCrumbs, count, elapsed, heap);
+
+  // same cost per crumb for any trail length, it never looks back
+  static TripEngine benchTrips;   // static, to keep its table off the stack
+  benchTrips.autosave = false;
+  benchTrips.clear();
+  heap  = heapInUse();
+  start = micros();
+  for (loc = trail.begin(); loc; loc = trail.next()) {
+    benchTrips.observe(*loc);
+  }
+  elapsed = micros() - start;
+  report("trips.observe", numCrumbs, count, elapsed, heap);
+
+  heap  = heapInUse();
+  start = micros();
+  plotRoute(&trail, PointGPS{47.0, -124.0});   // CN87
+  elapsed = micros() - start;
+  report("plotRoute", numCrumbs, 1, elapsed, heap);
+}
+
+static void benchKML(int numCrumbs) {
+  // KML goes to the console, so keep this one small
+  makeTrail(numCrumbs);
+  int heap            = heapInUse();
+  unsigned long start = micros();
+  trail.dumpHistoryKML();
+  unsigned long elapsed = micros() - start;
+  report("trail.exportKML", numCrumbs, 1, elapsed, heap);
+}
+
+// ================ main benchmark =============================
+void runBenchmark() {
+  logger.fencepost("benchmark.cpp", "Start Benchmark", __LINE__);
+  trail.saveGPSBreadcrumbTrail();   // keep user's trail safe from our tests
+  baroModel.saveHistory();          // keep user's pressure history safe too
+  auto observer    = trail.onRemember;   // fixture crumbs are not a real trip
+  trail.onRemember = nullptr;
+  ViewGrid gridView(&tft, grid_view);   // only 32 bytes, its text fields are in view_grid.cpp
+  gridView.startScreen();               // plotRoute and TextField draw on the grid view
+
+  logger.print("BENCH,version,test,crumbs,iterations,ns/op,heap bytes\n");
+  benchLocator("calcLocator4", 4);
+  benchLocator("calcLocator6", 6);
+  benchLocator("calcLocator8", 8);
+  benchDistance();
+  benchFloatToChar();
+  benchStringFloat();
+  benchDateToString();
+  benchRememberPressure();
+  benchTextField();
+  benchGridName();
+  benchGeofence(10);
+  benchGeofence(GEOFENCE_MAX_FENCES);
+  geofence.loadFences();   // bring back user's fences
+
+  benchTrail(100);
+  benchTrail(1000);
+  benchTrail(trail.capacity);
+  benchKML(100);
+
+  // this also brings back the user's trail
+  int heap            = heapInUse();
+  unsigned long start = micros();
+  trail.restoreGPSBreadcrumbTrail();
+  unsigned long elapsed = micros() - start;
+  int numCrumbs         = trail.getHistoryCount();
+  report("trail.restoreCSV", numCrumbs, 1, elapsed, heap);
+
+  heap  = heapInUse();
+  start = micros();
+  trail.saveGPSBreadcrumbTrail();
+  elapsed = micros() - start;
+  report("trail.saveCSV", numCrumbs, 1, elapsed, heap);
+
+  baroModel.loadHistory();   // bring back user's pressure history
+  trail.onRemember = observer;
+  logger.fencepost("benchmark.cpp", "End Benchmark", __LINE__);
+}
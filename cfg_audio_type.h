@@ -38,6 +38,23 @@ extern Model *model;    // "model" portion of model-view-controller
 extern void showDefaultTouchTargets();                // Griduino.ino
 extern void announceGrid(String gridName, int len);   // Griduino.ino
 
+// ========== class AudioSetting ==============================
+// The setting outlives the view, which exists only while it's on screen
+class AudioSetting {
+public:
+  enum functionID {
+    MORSE = 0,
+    SPEECH,
+    NO_AUDIO,
+  };
+  functionID selectedAudio = MORSE;   // default to Morse code (until we read setting from Flash)
+
+  void loadConfig();
+  void saveConfig();
+};   // end class AudioSetting
+
+extern AudioSetting audioSetting;   // Griduino.ino
+
 // ========== class ViewCfgAudioType ==============================
 class ViewCfgAudioType : public View {
 public:
@@ -45,8 +62,7 @@ public:
   // This derived class must implement the public interface:
   ViewCfgAudioType(Adafruit_ILI9341 *vtft, int vid)   // ctor
       : View{vtft, vid} {
-    background    = cBACKGROUND;   // every view can have its own background color
-    selectedAudio = MORSE;         // default to Morse code (until we read setting from Flash)
+    background = cBACKGROUND;   // every view can have its own background color
   }
   void updateScreen();
   void startScreen();
@@ -55,12 +71,12 @@ public:
   void loadConfig();
   void saveConfig();
 
+  // same names as AudioSetting, for the buttons
   enum functionID {
-    MORSE = 0,
-    SPEECH,
-    NO_AUDIO,
+    MORSE    = AudioSetting::MORSE,
+    SPEECH   = AudioSetting::SPEECH,
+    NO_AUDIO = AudioSetting::NO_AUDIO,
   };
-  functionID selectedAudio;   // <-- this is the whole reason for this module's existence
 
 protected:
   // ---------- local data for this derived class ----------
@@ -110,7 +126,7 @@ protected:
   // ---------- local functions for this derived class ----------
   void setMorse() {
     logger.log(CONFIG, INFO, "->->-> Clicked MORSE CODE button.");
-    selectedAudio = MORSE;
+    audioSetting.selectedAudio = AudioSetting::MORSE;
     updateScreen();   // update UI before the long pause to send sample audio
 
     // announce grid name for an audible example of this selection
@@ -121,7 +137,7 @@ protected:
 
   void setSpeech() {
     logger.log(CONFIG, INFO, "->->-> Clicked SPEECH button.");
-    selectedAudio = MORSE;   // 2024-01-03 disabled "SPEECH" temporarily because it's a crasher
+    audioSetting.selectedAudio = AudioSetting::MORSE;   // 2024-01-03 disabled "SPEECH" temporarily because it's a crasher
     updateScreen();          // update UI before the long pause to send sample audio
 
     // announce grid square for an audible example of this selection
@@ -131,7 +147,7 @@ protected:
   }
   void setNone() {
     logger.log(CONFIG, INFO, "->->-> Clicked NO AUDIO button.");
-    selectedAudio = NO_AUDIO;
+    audioSetting.selectedAudio = AudioSetting::NO_AUDIO;
     updateScreen();   // update UI before the long pause to send sample audio
   }
 
@@ -148,13 +164,7 @@ void ViewCfgAudioType::updateScreen() {
     int yCenter         = item.y + (item.h / 2);
     int buttonFillColor = cBACKGROUND;
 
-    if (ii == MORSE && selectedAudio == MORSE) {
-      buttonFillColor = cLABEL;
-    }
-    if (ii == SPEECH && selectedAudio == SPEECH) {
-      buttonFillColor = cLABEL;
-    }
-    if (ii == NO_AUDIO && selectedAudio == NO_AUDIO) {
+    if (ii == audioSetting.selectedAudio) {
       buttonFillColor = cLABEL;
     }
     tft->fillCircle(xCenter, yCenter, 4, buttonFillColor);
@@ -252,7 +262,7 @@ bool ViewCfgAudioType::onTouch(Point touch) {
 #define AUDIO_CONFIG_VERSION "Audio Announce v01"
 
 // ----- load from SDRAM -----
-void ViewCfgAudioType::loadConfig() {
+void AudioSetting::loadConfig() {
   SaveRestore config(AUDIO_CONFIG_FILE, AUDIO_CONFIG_VERSION);
   functionID tempAudioOutputType;
   int result = config.readConfig((byte *)&tempAudioOutputType, sizeof(tempAudioOutputType));
@@ -265,7 +275,14 @@ void ViewCfgAudioType::loadConfig() {
   }
 }
 // ----- save to SDRAM -----
-void ViewCfgAudioType::saveConfig() {
+void AudioSetting::saveConfig() {
   SaveRestore config(AUDIO_CONFIG_FILE, AUDIO_CONFIG_VERSION);
   int rc = config.writeConfig((byte *)&selectedAudio, sizeof(selectedAudio));
 }
+
+void ViewCfgAudioType::loadConfig() {
+  audioSetting.loadConfig();
+}
+void ViewCfgAudioType::saveConfig() {
+  audioSetting.saveConfig();
+}
@@ -18,7 +18,7 @@
             | Route             (o)[ GPS Receiver ]     |
             |                   ( )[  Simulator   ]     |
             |                                           |
-            |                                           |
+            | Satellites           [ GPS only     ]     |
             | v1.12, Feb 10 2021                        |... yRow9
             +-------------------------------------------+
 */
@@ -28,6 +28,7 @@
 #include "logger.h"              // conditional printing to Serial port
 #include "model_breadcrumbs.h"   // breadcrumb trail
 #include "model_gps.h"           // Model of a GPS for model-view-controller
+#include "gnss_stats.h"          // satellite systems
 #include "TextField.h"           // Optimize TFT display text for proportional fonts
 #include "view.h"                // Base class for all views
 
@@ -59,10 +60,11 @@ protected:
   // color scheme: see constants.h
 
   // vertical placement of text rows   ---label---         ---button---
-  const int yRow1 = 74;                   // "Breadcrumb trail", "Clear"
+  const int yRow1 = 64;                   // "Breadcrumb trail", "Clear"
   const int yRow2 = yRow1 + 20;           // "%d of %d"
-  const int yRow3 = yRow2 + 52;           // "Route",            "GPS Receiver"
-  const int yRow4 = yRow3 + 48;           //                     "Simulator"
+  const int yRow3 = yRow2 + 38;           // "Route",            "GPS Receiver"
+  const int yRow4 = yRow3 + 40;           //                     "Simulator"
+  const int yRow5 = yRow4 + 42;           // "Satellites",       "GPS only"
   const int yRow9 = gScreenHeight - 10;   // "v1.14, Jan 22 2024"
 
 #define col1    10    // left-adjusted column of text
@@ -74,18 +76,20 @@ protected:
     TRAIL,
     TRAILCOUNT,
     GPSTYPE,
+    SATELLITES,
     COMPILED,
     PANEL,
   };
 
   // clang-format off
-  #define nTextGPS 5
+  #define nTextGPS 6
   TextField txtSettings2[nTextGPS] = {
       //  text                x, y      color
       {"GPS",                -1, 20,    cHIGHLIGHT, ALIGNCENTER},   // [SETTINGS]
       {"Breadcrumb trail", col1, yRow1, cVALUE},                    // [TRAIL]
       {"%d crumbs",        col1, yRow2, cLABEL},                    // [TRAILCOUNT]
       {"Route",            col1, yRow3, cVALUE},                    // [GPSTYPE]
+      {"Satellites",       col1, yRow5, cVALUE},                    // [SATELLITES]
       {PROGRAM_VERDATE,      -1, yRow9, cLABEL, ALIGNCENTER},       // [COMPILED]
   };
   // clang-format on
@@ -94,16 +98,18 @@ protected:
     eCLEAR,
     eRECEIVER,
     eSIMULATOR,
+    eCONSTELLATION,
     eFACTORYRESET,
   };
   // clang-format off
-  #define nButtonsGPS 3
+  #define nButtonsGPS 4
   FunctionButton settings2Buttons[nButtonsGPS] = {
       // label              origin             size      touch-target
       // text                 x,y               w,h        x,y       w,h  radius  color   functionID
-      {"Clear",        xButton, yRow1 - 14,   130, 40,  {158, 58,  136,42}, 4, cVALUE, eCLEAR},      // [eCLEAR] Clear track history
-      {"GPS Receiver", xButton, yRow3 - 26,   130, 40,  {128,112,  180,50}, 4, cVALUE, eRECEIVER},   // [eRECEIVER] Satellite receiver
-      {"Simulator",    xButton, yRow4 - 26,   130, 40,  {130,164,  180,60}, 4, cVALUE, eSIMULATOR},  // [eSIMULATOR] Simulated track
+      {"Clear",        xButton, yRow1 - 22,   130, 34,  {158, 40,  136,40}, 4, cVALUE, eCLEAR},         // [eCLEAR] Clear track history
+      {"GPS Receiver", xButton, yRow3 - 22,   130, 34,  {128, 98,  180,38}, 4, cVALUE, eRECEIVER},      // [eRECEIVER] Satellite receiver
+      {"Simulator",    xButton, yRow4 - 22,   130, 34,  {130,138,  180,40}, 4, cVALUE, eSIMULATOR},     // [eSIMULATOR] Simulated track
+      {"GPS only",     xButton, yRow5 - 22,   130, 34,  {130,180,  180,40}, 4, cVALUE, eCONSTELLATION}, // [eCONSTELLATION] tap for next mode
     //{"Factory Reset",xButton, 180,          130,30,   {138,174,  180,50}, 4,  cVALUE,  fFactoryReset},// [eFACTORYRESET] Factory Reset
   };
   // clang-format on
@@ -127,6 +133,28 @@ protected:
     logger.log(CONFIG, INFO, "->->-> Clicked GPS SIMULATOR button.");
     fSetSimulated();   // use "class MockModel" for simulated track
   }
+  void fConstellation() {
+    // step through GPS only -> GPS+GLONASS -> GPS+GLO+GAL
+    logger.log(CONFIG, INFO, "->->-> Clicked SATELLITES button.");
+    gnss.apply((gnss.mode + 1) % GNSS_MODES);
+    gnss.saveConfig();   // time to first fix for this mode is measured at next power-up
+    drawButton(settings2Buttons[eCONSTELLATION]);
+  }
+  void drawButton(FunctionButton &item) {
+    if (item.functionIndex == eCONSTELLATION) {
+      item.text = GnssStats::modeName(gnss.mode);   // points to a string constant
+    }
+    tft->fillRoundRect(item.x, item.y, item.w, item.h, item.radius, cBUTTONFILL);
+    tft->drawRoundRect(item.x, item.y, item.w, item.h, item.radius, cBUTTONOUTLINE);
+
+    // ----- label on top of button
+    setFontSize(eFONTSMALLEST);
+    int xx = getOffsetToCenterTextOnButton(item.text, item.x, item.w);
+
+    tft->setCursor(xx, item.y + item.h / 2 + 5);   // place text centered inside button
+    tft->setTextColor(item.color);
+    tft->print(item.text);
+  }
   void fFactoryReset() {
     // todo: clear all settings, erase all saved files
     logger.log(CONFIG, INFO, "->->-> Clicked FACTORY RESET button.");
@@ -179,18 +207,8 @@ void ViewCfgGPS::startScreen() {
   }
 
   // ----- draw buttons
-  setFontSize(eFONTSMALLEST);
   for (int ii = 0; ii < nButtonsGPS; ii++) {
-    FunctionButton item = settings2Buttons[ii];
-    tft->fillRoundRect(item.x, item.y, item.w, item.h, item.radius, cBUTTONFILL);
-    tft->drawRoundRect(item.x, item.y, item.w, item.h, item.radius, cBUTTONOUTLINE);
-
-    // ----- label on top of button
-    int xx = getOffsetToCenterTextOnButton(item.text, item.x, item.w);
-
-    tft->setCursor(xx, item.y + item.h / 2 + 5);   // place text centered inside button
-    tft->setTextColor(item.color);
-    tft->print(item.text);
+    drawButton(settings2Buttons[ii]);
   }
 
   // ----- draw outlines of radio buttons
@@ -228,6 +246,9 @@ bool ViewCfgGPS::onTouch(Point touch) {
       case eSIMULATOR:
         fSimulated();
         break;
+      case eCONSTELLATION:
+        fConstellation();
+        break;
       default:
         logger.log(CONFIG, ERROR, "unknown function %d", item.functionIndex);
         break;
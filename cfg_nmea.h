@@ -36,6 +36,22 @@ extern Model *model;    // "model" portion of model-view-controller
 extern void start_nmea();   // commands.cpp
 extern void stop_nmea();    // commands.cpp
 
+// ========== class NmeaSetting ===============================
+// The setting outlives the view, which exists only while it's on screen
+class NmeaSetting {
+public:
+  enum functionID {
+    SILENT = 0,
+    SEND_NMEA,
+  };
+  functionID selectedOption = SILENT;   // SEND_NMEA;     // power-on default [NMEA]: assume a program like NMEATime2 is listening
+
+  void loadConfig();
+  void saveConfig();
+};   // end class NmeaSetting
+
+extern NmeaSetting nmeaSetting;   // Griduino.ino
+
 // ========== class ViewCfgNMEA ===================================
 class ViewCfgNMEA : public View {
 public:
@@ -43,8 +59,7 @@ public:
   // This derived class must implement the public interface:
   ViewCfgNMEA(Adafruit_ILI9341 *vtft, int vid)   // ctor
       : View{vtft, vid} {
-    background     = cBACKGROUND;   // every view can have its own background color
-    selectedOption = SILENT;        // SEND_NMEA;     // power-on default [NMEA]: assume a program like NMEATime2 is listening
+    background = cBACKGROUND;   // every view can have its own background color
   }
   void updateScreen();
   void startScreen();
@@ -53,12 +68,6 @@ public:
   void loadConfig();
   void saveConfig();
 
-  enum functionID {
-    SILENT = 0,
-    SEND_NMEA,
-  };
-  functionID selectedOption;   // <-- this is the whole reason for this module's existence
-
 protected:
   // ---------- local data for this derived class ----------
   // color scheme: see constants.h
@@ -109,13 +118,13 @@ protected:
 
   // ---------- local functions for this derived class ----------
   void fStartNMEA() {
-    selectedOption = SEND_NMEA;
+    nmeaSetting.selectedOption = NmeaSetting::SEND_NMEA;
     start_nmea();   // start sending nmea sentences
     this->updateScreen();
   }
 
   void fStopNMEA() {
-    selectedOption = SILENT;
+    nmeaSetting.selectedOption = NmeaSetting::SILENT;
     stop_nmea();   // stop nmea
     this->updateScreen();
   }
@@ -228,7 +237,7 @@ bool ViewCfgNMEA::onTouch(Point touch) {
 #define NMEA_CONFIG_VERSION "NMEA Broadcast v01"
 
 // ----- load from SDRAM -----
-void ViewCfgNMEA::loadConfig() {
+void NmeaSetting::loadConfig() {
   // Load NMEA on/off setting from NVR, and do minimal amount of work
   // Since this is called first thing during setup, we can't use
   // resource-heavy functions like updateScreen()
@@ -264,9 +273,16 @@ void ViewCfgNMEA::loadConfig() {
   }
 }
 // ----- save to SDRAM -----
-void ViewCfgNMEA::saveConfig() {
+void NmeaSetting::saveConfig() {
   SaveRestore config(NMEA_CONFIG_FILE, NMEA_CONFIG_VERSION);
   logger.log(NMEA, INFO, "Saving value: %d", selectedOption);
   int rc = config.writeConfig((byte *)&selectedOption, sizeof(selectedOption));
   logger.log(NMEA, DEBUG, "Finished ViewCfgRotation::saveConfig(%d) with rc = %d", selectedOption, rc);   // debug
 }
+
+void ViewCfgNMEA::loadConfig() {
+  nmeaSetting.loadConfig();
+}
+void ViewCfgNMEA::saveConfig() {
+  nmeaSetting.saveConfig();
+}
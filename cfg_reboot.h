@@ -43,7 +43,7 @@ extern "C" {
 #endif
 extern Logger logger;                    // Griduino.ino
 extern void showDefaultTouchTargets();   // Griduino.ino
-extern void selectNewView(int cmd);      // Griduino.ino
+extern void requestNewView(int cmd);     // Griduino.ino
 extern int goto_next_cfg;                // Griduino.ino
 
 // ========== class ViewCfgReboot ================================
@@ -160,7 +160,7 @@ enum buttonID {
   }
   void fCancel() {
     logger.log(CONFIG, INFO, "->->-> Clicked CANCEL button.");
-    selectNewView(goto_next_cfg);
+    requestNewView(goto_next_cfg);
   }
   void fReboot() {
     logger.log(CONFIG, INFO, "->->-> Clicked REBOOT button.");
@@ -35,6 +35,18 @@ extern Model *model;    // "model" portion of model-view-controller
 
 extern void showDefaultTouchTargets();   // Griduino.ino
 
+// ========== class RotationSetting ===========================
+// The setting outlives the view, which exists only while it's on screen
+class RotationSetting {
+public:
+  int screenRotation = LANDSCAPE;   // 1=landscape, 3=landscape 180-degrees
+
+  void loadConfig(Adafruit_ILI9341 *tft);
+  void saveConfig();
+};   // end class RotationSetting
+
+extern RotationSetting rotationSetting;   // Griduino.ino
+
 // ========== class ViewCfgRotation ==============================
 class ViewCfgRotation : public View {
 public:
@@ -42,7 +54,8 @@ public:
   // This derived class must implement the public interface:
   ViewCfgRotation(Adafruit_ILI9341 *vtft, int vid)   // ctor
       : View{vtft, vid} {
-    background = cBACKGROUND;   // every view can have its own background color
+    background     = cBACKGROUND;                     // every view can have its own background color
+    screenRotation = rotationSetting.screenRotation;   // current orientation, restored at power-up
   }
   void updateScreen();
   void startScreen();
@@ -222,7 +235,7 @@ bool ViewCfgRotation::onTouch(Point touch) {
 #define CONFIG_SCREEN_VERSION "Screen Orientation v04"
 
 // ----- load from SDRAM -----
-void ViewCfgRotation::loadConfig() {
+void RotationSetting::loadConfig(Adafruit_ILI9341 *tft) {
   // Load screen orientation from NVR, and do minimal amount of work
   // Since this is called first thing during setup, we can't use
   // resource-heavy functions like "this->setScreenRotation(int rot)"
@@ -259,8 +272,17 @@ void ViewCfgRotation::loadConfig() {
   }
 }
 // ----- save to SDRAM -----
-void ViewCfgRotation::saveConfig() {
+void RotationSetting::saveConfig() {
   SaveRestore config(SCREEN_CONFIG_FILE, CONFIG_SCREEN_VERSION);
   int rc = config.writeConfig((byte *)&screenRotation, sizeof(screenRotation));
   logger.log(CONFIG, DEBUG, "Finished ViewCfgNMEA::saveConfig() with rc = %d", rc);   // debug
 }
+
+void ViewCfgRotation::loadConfig() {
+  rotationSetting.loadConfig(tft);
+  screenRotation = rotationSetting.screenRotation;
+}
+void ViewCfgRotation::saveConfig() {
+  rotationSetting.screenRotation = screenRotation;
+  rotationSetting.saveConfig();
+}
@@ -47,6 +47,53 @@ extern DS1804 volume;                                 // digital potentiometer
 extern AudioQSPI dacSpeech;   // spoken word (so we can play speech sample)
 #endif
 
+// ========== class VolumeSetting =============================
+// The setting outlives the view, which exists only while it's on screen
+class VolumeSetting {
+public:
+  int volIndex = 5;       // init to middle value
+  int mute     = false;   // true=muted, false=UNmuted (not saved in NVR)
+
+#define numLevels 11
+  void setVolume(int vIndex) {
+    // set digital potentiometer
+    // @param vIndex = 0..10
+    static const int volLevel[numLevels] = {
+        // Digital potentiometer settings, about 2 dB steps = ratio 1.585
+        0,    // [0] mute, lowest allowed wiper position
+        1,    // [1] lowest possible position with non-zero output
+        2,    // [2] next lowest poss
+        4,    // [3]  2.000 * 1.585 =  4.755
+        7,    // [4]  4.755 * 1.585 =  7.513
+        12,   // [5]  7.513 * 1.585 = 11.908
+        19,   // [6] 11.908 * 1.585 = 18.874
+        29,   // [7] 18.874 * 1.585 = 29.916
+        47,   // [8] 29.916 * 1.585 = 47.417
+        75,   // [9] 47.417 * 1.585 = 75.155
+        99,   // [10] max allowed wiper position
+    };
+    int wiperPosition = volLevel[vIndex];
+
+#if defined(ARDUINO_ADAFRUIT_FEATHER_RP2040)
+    // todo - add code to control new I2C volume control chip
+#else
+#define PIN_VCS A1   // chip select pin for DS1804 volume control via SPI
+    pinMode(PIN_VCS, OUTPUT);   // fix bug that somehow forgets this is an output pin
+    volume.unlock();            // enable (set low)
+    volume.setWiperPosition(wiperPosition);
+#endif
+
+    char msg[256];
+    snprintf(msg, 256, "Set volume index %d, wiper position %d", vIndex, wiperPosition);   // debug
+    logger.log(CONFIG, INFO, msg);
+  }
+
+  void loadConfig();
+  void saveConfig();
+};   // end class VolumeSetting
+
+extern VolumeSetting volumeSetting;   // Griduino.ino
+
 // ========== class ViewVolume =================================
 class ViewVolume : public View {
 public:
@@ -62,10 +109,6 @@ public:
   void saveConfig();
 
 protected:
-  // ----- 'globals' -----
-  int gVolIndex = 5;       // init to middle value
-  int gMute     = false;   // true=muted, false=UNmuted (not saved in NVR)
-
   // ---------- local data for this derived class ----------
   // color scheme: see constants.h
 
@@ -115,56 +158,21 @@ protected:
   };
   // clang-format on
 
-#define numLevels 11
-  const int volLevel[numLevels] = {
-      // Digital potentiometer settings, about 2 dB steps = ratio 1.585
-      0,    // [0] mute, lowest allowed wiper position
-      1,    // [1] lowest possible position with non-zero output
-      2,    // [2] next lowest poss
-      4,    // [3]  2.000 * 1.585 =  4.755
-      7,    // [4]  4.755 * 1.585 =  7.513
-      12,   // [5]  7.513 * 1.585 = 11.908
-      19,   // [6] 11.908 * 1.585 = 18.874
-      29,   // [7] 18.874 * 1.585 = 29.916
-      47,   // [8] 29.916 * 1.585 = 47.417
-      75,   // [9] 47.417 * 1.585 = 75.155
-      99,   // [10] max allowed wiper position
-  };
-
-  // ---------- local functions for this derived class ----------
-  void setVolume(int volIndex) {
-    // set digital potentiometer
-    // @param volIndex = 0..10
-    int wiperPosition = volLevel[volIndex];
-
-#if defined(ARDUINO_ADAFRUIT_FEATHER_RP2040)
-    // todo - add code to control new I2C volume control chip
-#else
-#define PIN_VCS A1   // chip select pin for DS1804 volume control via SPI
-    pinMode(PIN_VCS, OUTPUT);   // fix bug that somehow forgets this is an output pin
-    volume.unlock();            // enable (set low)
-    volume.setWiperPosition(wiperPosition);
-#endif
-
-    char msg[256];
-    snprintf(msg, 256, "Set volume index %d, wiper position %d", volIndex, wiperPosition);   // debug
-    logger.log(CONFIG, INFO, msg);
-  }
   void changeVolume(int diff) {
-    gVolIndex += diff;
-    gVolIndex = constrain(gVolIndex, 0, numLevels - 1);
-    setVolume(gVolIndex);
+    volumeSetting.volIndex += diff;
+    volumeSetting.volIndex = constrain(volumeSetting.volIndex, 0, numLevels - 1);
+    volumeSetting.setVolume(volumeSetting.volIndex);
     this->updateScreen();   // update screen _before_ playing lengthy morse code
   }
   void volumeUp() {
-    if (gMute) {
+    if (volumeSetting.mute) {
       unmuteVolume();
     } else {
       changeVolume(+1);   // increase volume
     }
   }
   void volumeDown() {
-    if (gMute) {
+    if (volumeSetting.mute) {
       unmuteVolume();
     } else {
       changeVolume(-1);   // decrease volume
@@ -172,28 +180,28 @@ protected:
   }
   void volumeMute() {   // mute
     // we keep track of "mute" status separately from "volume" level
-    if (gMute) {
+    if (volumeSetting.mute) {
       // already muted, so UN mute
       unmuteVolume();
     } else {
       // mute volume
-      gMute = true;
+      volumeSetting.mute = true;
       txtVolume[BIGVOLUME].setColor(cDISABLED);
       txtVolume[BIGVOLUME].setBackground(cBACKGROUND);
 
       txtVolume[MUTELABEL].setBackground(cBUTTONFILL);
       txtVolume[MUTELABEL].print("Unmute");
-      setVolume(0);
+      volumeSetting.setVolume(0);
     }
   }
   void unmuteVolume() {
-    gMute = false;
+    volumeSetting.mute = false;
     txtVolume[BIGVOLUME].setColor(cVALUE);
     txtVolume[BIGVOLUME].setBackground(cBACKGROUND);
 
     txtVolume[MUTELABEL].setBackground(cBUTTONFILL);
     txtVolume[MUTELABEL].print("  Mute");   // leading blanks to align it on top of "Unmute"
-    setVolume(gVolIndex);
+    volumeSetting.setVolume(volumeSetting.volIndex);
   }
 
 };   // end class ViewVolume
@@ -204,10 +212,10 @@ void ViewVolume::updateScreen() {
 
   // ----- fill in replacment string text
   txtVolume[BIGVOLUME].setBackground(cBACKGROUND);
-  txtVolume[BIGVOLUME].print(gVolIndex);
+  txtVolume[BIGVOLUME].print(volumeSetting.volIndex);
 
   txtVolume[MUTELABEL].setBackground(cBUTTONFILL);
-  txtVolume[MUTELABEL].print();
+  txtVolume[MUTELABEL].print(volumeSetting.mute ? "Unmute" : "  Mute");   // leading blanks to align it on top of "Unmute"
 }   // end updateScreen
 
 void ViewVolume::startScreen() {
@@ -238,11 +246,17 @@ void ViewVolume::startScreen() {
 
   // ----- draw text fields
   // draw text AFTER buttons because the MUTE text is on top of a button
+  if (volumeSetting.mute) {
+    txtVolume[BIGVOLUME].setColor(cDISABLED);   // this view is new each time, but mute is remembered
+  }
   for (int ii = 0; ii < numVolFields; ii++) {
     int bkg = (ii == MUTELABEL) ? cBUTTONFILL : cBACKGROUND;   // TODO:
     txtVolume[ii].setBackground(bkg);
     txtVolume[ii].print();
   }
+  if (volumeSetting.mute) {
+    txtVolume[MUTELABEL].print("Unmute");
+  }
 
   // ----- icons on buttons
   int ht = 24;                                      // height of triangle
@@ -292,7 +306,7 @@ bool ViewVolume::onTouch(Point touch) {
         break;
       }
       updateScreen();   // update UI immediately, don't wait for laggy mainline loop
-      if (!gMute) {
+      if (!volumeSetting.mute) {
         // audible example
         announceGrid("hi", 4);
         /*
@@ -318,21 +332,28 @@ bool ViewVolume::onTouch(Point touch) {
 #define CONFIG_VOLUME_VERSION "Volume v02"
 
 // ----- load from SDRAM -----
-void ViewVolume::loadConfig() {
+void VolumeSetting::loadConfig() {
   SaveRestore config(VOLUME_CONFIG_FILE, CONFIG_VOLUME_VERSION);
   int tempVolIndex = 0;
   int result       = config.readConfig((byte *)&tempVolIndex, sizeof(tempVolIndex));
   if (result) {
-    gVolIndex = constrain(tempVolIndex, 0, 10);   // global volume index
-    setVolume(gVolIndex);                         // set the hardware to this volume index
-    logger.log(CONFIG, INFO, "Loaded volume setting from NVR: ", gVolIndex);
+    volIndex = constrain(tempVolIndex, 0, 10);   // global volume index
+    setVolume(volIndex);                         // set the hardware to this volume index
+    logger.log(CONFIG, INFO, "Loaded volume setting from NVR: ", volIndex);
   } else {
     logger.log(CONFIG, ERROR, "Failed to load Volume control settings, re-initializing file");
     saveConfig();
   }
 }
 // ----- save to SDRAM -----
-void ViewVolume::saveConfig() {
+void VolumeSetting::saveConfig() {
   SaveRestore config(VOLUME_CONFIG_FILE, CONFIG_VOLUME_VERSION);
-  config.writeConfig((byte *)&gVolIndex, sizeof(gVolIndex));
+  config.writeConfig((byte *)&volIndex, sizeof(volIndex));
+}
+
+void ViewVolume::loadConfig() {
+  volumeSetting.loadConfig();
+}
+void ViewVolume::saveConfig() {
+  volumeSetting.saveConfig();
 }
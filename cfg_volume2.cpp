@@ -64,11 +64,14 @@ const int yRow2 = yRow1 + 30;   // text:  "of 10"
 int gVolIndex2     = 5;    // init to middle value
 int gPrevVolIndex2 = -1;   // remembers previous volume setting to avoid erase/write the same value
 
-TextField txtVolume2[] = {
-    //        text             x,y      color
-    TextField("Audio Volume", 98, yRow1, cLABEL),   // normal size text labels
+constexpr TextLayout volume2Layout[] = {
+    // text          x,y        color   align      font
+    {"Audio Volume", 98, yRow1, cLABEL, ALIGNLEFT, eFONTUNSPEC},   // normal size text labels
 };
-const int numVolFields = sizeof(txtVolume2) / sizeof(TextField);
+FixedTextField txtVolume2[] = {
+    volume2Layout[0],
+};
+const int numVolFields = sizeof(txtVolume2) / sizeof(txtVolume2[0]);
 
 const int margin     = 10;   // slight margin between button border and edge of screen
 const int radius     = 10;   // rounded corners
@@ -15,10 +15,24 @@
 #include "constants.h"           // Griduino constants and colors
 #include <elapsedMillis.h>       // Scheduling intervals in main loop
 #include "logger.h"              // conditional printing to Serial port
+#include "tracer.h"              // software tracer
+#include "perf_counters.h"       // performance counters
+#include "memory_monitor.h"      // RAM usage
 #include "model_breadcrumbs.h"   // breadcrumb trail
+#include "model_trips.h"         // trips and their statistics
+#include "model_geofence.h"      // county lines, contest areas and exclusion zones
 #include "model_gps.h"           // Model of a GPS for model-view-controller
+#include "model_replay.h"        // Model that replays a recorded NMEA log
+#include "gps_rate.h"            // optional 5 or 10 Hz GPS fixes
+#include "gnss_stats.h"          // satellites per constellation
 #include "model_baro.h"          // Model of a barometer that stores 3-day history
+#include "model_altitude.h"      // barometer and GPS altitude, fused
+#include "model_adc.h"           // coin battery voltage and its trend
+#include "format_helper.h"       // removeCRLF()
+#include "touch_events.h"        // touchscreen gestures
+#include "nmea_reader.h"         // GPS serial port read by core 1
 #include "view.h"                // View base class, public interface
+#include "view_registry.h"       // only the active view is in RAM
 
 // ========== extern ===========================================
 extern Logger logger;                 // Griduino.ino
@@ -26,29 +40,47 @@ extern bool showTouchTargets;         // Griduino.ino
 extern Model *model;                  // "model" portion of model-view-controller
 extern Breadcrumbs trail;             // model of breadcrumb trail
 extern BarometerModel baroModel;      // singleton instance of the barometer model
+extern BatteryVoltage gpsBattery;     // Griduino.ino
+#if defined(DUAL_CORE)
+extern NmeaReader nmeaReader;         // Griduino.ino
+#endif
 extern void selectNewView(int cmd);   // Griduino.ino
 extern View *pView;                   // Griduino.ino
+extern int runModelTest();            // unit_test.cpp
+extern int runFuzzTest();             // unit_test.cpp
+extern ReplayModel modelReplay;       // Griduino.ino
+extern void fSetReceiver();           // Griduino.ino
+extern int fSetReplay(float speed);   // Griduino.ino
 
 // ----- forward references
 void help(), version();
-void dump_kml(), dump_gps_history(), erase_gps_history(), list_files(), type_gpshistory();
+void dump_kml(), dump_gps_history(), erase_gps_history(), list_files(), type_gpshistory(), show_rejects();
+void dump_trips(), erase_trips();
+void show_fences(), load_fences();
 void start_nmea(), stop_nmea(), start_gmt(), stop_gmt();
+void start_replay(), start_replay_fast(), stop_replay();
+void set_gps_1hz(), set_gps_5hz(), set_gps_10hz(), show_gps_rate(), show_cores();
+void show_gnss(), show_baro(), show_battery();
 void show_help(), show_screen1(), show_splash(), show_crossings(), show_events(), show_reformat();
 void show_touch(), hide_touch();
 void show_centerline(), hide_centerline();
-void run_unittest();
+void run_unittest(), run_modeltest(), run_fuzztest(), run_benchmark();
 void enable_console_log(), disable_console_log();
 void log_level_debug(), log_level_fence(), log_level_info(), log_level_warning(), log_level_error();
+void log_mode_direct(), log_mode_deferred(), log_mode_binary();
 void show_logging_status();
+void trace_dump(), trace_clear();
+void show_perf(), show_perf_overlay(), hide_perf_overlay(), clear_perf();
+void show_memory(), show_views();
 
 // ----- table of commands
 #define Newline true   // use this to insert a CRLF before listing this command in help text
 struct Command {
   bool crlf;
-  char text[20];
+  const char *text;
   simpleFunction function;
 };
-Command cmdList[] = {
+const Command cmdList[] = {   // const, so the table stays in flash
     {0, "help", help},
     {0, "version", version},
 
@@ -56,6 +88,11 @@ Command cmdList[] = {
     {0, "dump gps", dump_gps_history},
     {0, "type gpshistory", type_gpshistory},
     {0, "erase history", erase_gps_history},
+    {0, "show rejects", show_rejects},
+    {0, "dump trips", dump_trips},
+    {0, "erase trips", erase_trips},
+    {0, "show fences", show_fences},
+    {0, "load fences", load_fences},
 
     {Newline, "start nmea", start_nmea},
     {0, "stop nmea", stop_nmea},
@@ -63,6 +100,19 @@ Command cmdList[] = {
     {Newline, "start gmt", start_gmt},
     {0, "stop gmt", stop_gmt},
 
+    {Newline, "start replay", start_replay},
+    {0, "start replay fast", start_replay_fast},
+    {0, "stop replay", stop_replay},
+
+    {Newline, "set gps 1hz", set_gps_1hz},
+    {0, "set gps 5hz", set_gps_5hz},
+    {0, "set gps 10hz", set_gps_10hz},
+    {0, "show gps rate", show_gps_rate},
+    {0, "show cores", show_cores},
+    {0, "show gnss", show_gnss},
+    {0, "show baro", show_baro},
+    {0, "show battery", show_battery},
+
     {Newline, "show touch", show_touch},
     {0, "hide touch", hide_touch},
 
@@ -80,6 +130,9 @@ Command cmdList[] = {
     {0, "list files", list_files},
 
     {Newline, "run unittest", run_unittest},
+    {0, "run modeltest", run_modeltest},
+    {0, "run fuzztest", run_fuzztest},
+    {0, "run benchmark", run_benchmark},
 
     {Newline, "enable console log", enable_console_log},
     {0, "disable console log", disable_console_log},
@@ -90,7 +143,22 @@ Command cmdList[] = {
     {0, "log level warning", log_level_warning},
     {0, "log level error", log_level_error},
 
+    {Newline, "log mode direct", log_mode_direct},
+    {0, "log mode deferred", log_mode_deferred},
+    {0, "log mode binary", log_mode_binary},
+
     {Newline, "show logging", show_logging_status},
+
+    {Newline, "trace dump", trace_dump},
+    {0, "trace clear", trace_clear},
+
+    {Newline, "show perf", show_perf},
+    {0, "show perf overlay", show_perf_overlay},
+    {0, "hide perf overlay", hide_perf_overlay},
+    {0, "clear perf", clear_perf},
+
+    {Newline, "show memory", show_memory},
+    {0, "show views", show_views},
 };
 const int numCmds = sizeof(cmdList) / sizeof(cmdList[0]);
 
@@ -139,6 +207,30 @@ void erase_gps_history() {
   trail.deleteFile();               // out with the old history file
   trail.saveGPSBreadcrumbTrail();   // start over with new history file
 }
+void show_rejects() {
+  logger.log(COMMAND, CONSOLE, "show rejects, GPS fixes kept out of breadcrumb trail");
+  trail.validator.report();
+}
+
+void dump_trips() {
+  logger.log(COMMAND, CONSOLE, "dump trips, save this as a .csv file");
+  trips.dump();
+}
+
+void erase_trips() {
+  logger.log(COMMAND, CONSOLE, "erase trips");
+  trips.clear();
+}
+
+void show_fences() {
+  logger.log(COMMAND, CONSOLE, "show fences");
+  geofence.report();
+}
+
+void load_fences() {
+  logger.log(COMMAND, CONSOLE, "load fences from " GEOFENCE_FILE);
+  geofence.loadFences();
+}
 
 void list_files() {
   logger.log(COMMAND, CONSOLE, "list files");
@@ -218,6 +310,7 @@ void show_touch() {
   showTouchTargets = true;
   pView->startScreen();
   pView->updateScreen();
+  touchEvents.report();
 }
 
 void hide_touch() {
@@ -246,6 +339,21 @@ void run_unittest() {
   void runUnitTest();   // extern declaration
   runUnitTest();        // see "unit_test.cpp"
 }
+void run_modeltest() {
+  logger.log(COMMAND, CONSOLE, "running model test suite, no display");
+  runModelTest();   // see "unit_test.cpp"
+}
+void run_fuzztest() {
+  logger.log(COMMAND, CONSOLE, "running fuzz test, a reboot means a parser crashed");
+  runFuzzTest();   // see "unit_test.cpp"
+}
+void run_benchmark() {
+  logger.log(COMMAND, CONSOLE, "running benchmarks, save console log to compare releases");
+  void runBenchmark();   // extern declaration
+  runBenchmark();        // see "benchmark.cpp"
+  pView->startScreen();
+  pView->updateScreen();
+}
 
 void enable_console_log() {
   logger.log(COMMAND, CONSOLE, "enabling logging to console");
@@ -260,7 +368,9 @@ void disable_console_log() {
 void show_logging_status() {
   logger.log(COMMAND, CONSOLE, "subsystems being logged are:");
   for (int ii = 0; ii < numSystems; ii++) {
-    if (logger.printSystem[ii].enabled) {
+    if (!(LOG_BUILD_SYSTEMS & LOG_SYSTEM(ii))) {
+      logger.log(COMMAND, CONSOLE, "%s = removed at build time", logger.printSystem[ii].name);
+    } else if (logger.printSystem[ii].enabled) {
       logger.log(COMMAND, CONSOLE, "%s = true", logger.printSystem[ii].name);
     } else {
       logger.log(COMMAND, CONSOLE, "%s = .", logger.printSystem[ii].name);
@@ -271,12 +381,19 @@ void show_logging_status() {
   char str[20];
   for (int ii = 0; ii < numLevels; ii++) {
     snprintf(str, sizeof(str), "%c = %s", logger.printLevel[ii].abbr, logger.printLevel[ii].name);
-    if (logger.printLevel[ii].enabled) {
+    if (ii < LOG_BUILD_LEVEL && ii != CONSOLE) {
+      logger.log(COMMAND, CONSOLE, "%s = removed at build time", str);
+    } else if (logger.printLevel[ii].enabled) {
       logger.log(COMMAND, CONSOLE, "%s = true", str);
     } else {
       logger.log(COMMAND, CONSOLE, "%s = .", str);
     }
   }
+
+  const char *modeName[] = {"direct", "deferred", "binary"};   // must be in same order as enum LogMode
+  logger.log(COMMAND, CONSOLE, "log mode is %s", modeName[logger.logMode]);
+  logger.log(COMMAND, CONSOLE, "records deferred = %d, dropped = %d", logger.recordsLogged, logger.recordsDropped);
+  logger.log(COMMAND, CONSOLE, "ring high water = %d of %d bytes", logger.ringHighWater, LOG_DEFERRED_BUILD ? LOG_RING_SIZE : 0);
 }
 // ----- log severity levels
 void log_level_debug() {
@@ -300,15 +417,125 @@ void log_level_error() {
   logger.setLevel(ERROR);
 }
 
-void removeCRLF(char *pBuffer) {
-  // remove 0x0d and 0x0a from character arrays, shortening the array in-place
-  const char key[] = "\r\n";
-  char *pch        = strpbrk(pBuffer, key);
-  while (pch != NULL) {
-    strcpy(pch, pch + 1);
-    pch = strpbrk(pBuffer, key);
+// ----- log delivery
+void log_mode_direct() {
+  logger.log(COMMAND, CONSOLE, "setting log mode direct, messages are sent immediately");
+  logger.setMode(LOG_DIRECT);
+}
+void log_mode_deferred() {
+  logger.log(COMMAND, CONSOLE, "setting log mode deferred, messages are sent when idle");
+  if (!logger.setMode(LOG_DEFERRED)) {
+    logger.log(COMMAND, CONSOLE, "log mode deferred is not in this build, see LOG_DEFERRED_BUILD in logger.h");
+  }
+}
+void log_mode_binary() {
+  logger.log(COMMAND, CONSOLE, "setting log mode binary, messages are sent as binary frames when idle");
+  if (!logger.setMode(LOG_BINARY)) {
+    logger.log(COMMAND, CONSOLE, "log mode binary is not in this build, see LOG_DEFERRED_BUILD in logger.h");
+  }
+}
+
+// ----- NMEA replay
+void start_replay() {
+  logger.log(COMMAND, CONSOLE, "start replay of %s in real time", REPLAY_FILE);
+  fSetReplay(1.0);
+}
+void start_replay_fast() {
+  logger.log(COMMAND, CONSOLE, "start replay of %s at 100x", REPLAY_FILE);
+  fSetReplay(100.0);
+}
+void stop_replay() {
+  logger.log(COMMAND, CONSOLE, "stop replay, back to GPS receiver");
+  modelReplay.report();
+  fSetReceiver();
+}
+
+// ----- GPS fix rate
+void set_gps_rate(int hz) {
+  if (gpsRate.apply(hz)) {
+    gpsRate.saveConfig();
   }
 }
+void set_gps_1hz() {
+  logger.log(COMMAND, CONSOLE, "set gps 1hz, normal rate");
+  set_gps_rate(1);
+}
+void set_gps_5hz() {
+  logger.log(COMMAND, CONSOLE, "set gps 5hz, high rate");
+  set_gps_rate(5);
+}
+void set_gps_10hz() {
+  logger.log(COMMAND, CONSOLE, "set gps 10hz, high rate");
+  set_gps_rate(10);
+}
+void show_gps_rate() {
+  logger.log(COMMAND, CONSOLE, "show gps rate");
+  gpsRate.report();
+}
+void show_gnss() {
+  logger.log(COMMAND, CONSOLE, "show gnss");
+  gnss.report();
+}
+
+void show_cores() {
+  logger.log(COMMAND, CONSOLE, "show cores");
+#if defined(DUAL_CORE)
+  nmeaReader.report();
+#else
+  logger.log(COMMAND, CONSOLE, "Single core. On an RP2040, define DUAL_CORE in constants.h to read the GPS on core 1");
+#endif
+}
+
+void show_baro() {
+  logger.log(COMMAND, CONSOLE, "show baro");
+  baroModel.report();
+  altFusion.report();
+}
+
+void show_battery() {
+  logger.log(COMMAND, CONSOLE, "show battery");
+  gpsBattery.report();
+}
+
+// ----- performance tracing
+void trace_dump() {
+  logger.log(COMMAND, CONSOLE, "trace dump, save this as a .json file for chrome://tracing");
+  tracer.dump();
+}
+void trace_clear() {
+  logger.log(COMMAND, CONSOLE, "trace clear");
+  tracer.clear();
+}
+
+// ----- performance counters
+void show_perf() {
+  logger.log(COMMAND, CONSOLE, "show perf");
+  perf.report();
+}
+void show_perf_overlay() {
+  logger.log(COMMAND, CONSOLE, "show perf overlay, loop statistics at bottom of screen");
+  perf.overlay = true;
+}
+void hide_perf_overlay() {
+  logger.log(COMMAND, CONSOLE, "hide perf overlay");
+  perf.overlay = false;
+  pView->startScreen();   // erase overlay by redrawing the whole screen
+  pView->updateScreen();
+}
+void clear_perf() {
+  logger.log(COMMAND, CONSOLE, "clear perf");
+  perf.clear();
+}
+
+// ----- memory usage
+void show_memory() {
+  logger.log(COMMAND, CONSOLE, "show memory");
+  memoryMonitor.report();
+}
+void show_views() {
+  logger.log(COMMAND, CONSOLE, "show views");
+  views.reportViews();
+}
 
 // do the thing
 void processCommand(char *cmd) {
@@ -325,6 +552,7 @@ void processCommand(char *cmd) {
   bool found = false;
   for (int ii = 0; ii < numCmds; ii++) {        // loop through table of commands
     if (strcmp(cmd, cmdList[ii].text) == 0) {   // look for it
+      TraceScope trace(eTraceCommand, ii);      //
       cmdList[ii].function();                   // found it! call the subroutine
       found = true;
       break;
@@ -16,9 +16,10 @@
 #define PROGRAM_GITHUB   "https://github.com/barry-ha/Griduino"
 
 // ------- Select testing features ---------
-// #define SCOPE_OUTPUT  A0            // use this for performance measurements with oscilloscope
+// #define SCOPE_OUTPUT  A0            // copy traced view updates to this pin for an oscilloscope (see tracer.h)
 // #define SHOW_SCREEN_BORDER          // use this to outline the screen's displayable area
 // #define SHOW_IGNORED_PRESSURE       // use this to see barometric pressure readings that are out of range and therefore ignored
+// #define DUAL_CORE                   // RP2040 only: core 1 reads the GPS serial port, see nmea_reader.h
 
 // ------- TFT screen definitions ---------
 #define gScreenWidth  320   // screen pixels wide
@@ -39,6 +40,7 @@ const double minLat  = gridHeightDegrees / gBoxHeight;   // latitude degrees fro
 #define feetPerMeters         (3.28084)       // altitude conversion
 #define mphPerKnots           (1.15078)       // speed conversion
 #define mphPerMetersPerSecond (0.44704)       // speed conversion
+#define kmPerMile             (1.609344)      // distance conversion
 const double degreesPerRadian = 57.2957795;   // conversion factor = (360 degrees)/(2 pi radians)
 
 #define SECS_PER_1MIN  ((time_t)(60UL))
@@ -70,6 +72,7 @@ enum Rotation {
 enum {
   eGPSRECEIVER = 1,   // use the GPS receiver hardware
   eGPSSIMULATOR,      // use a GPS simulator
+  eGPSREPLAY,         // replay a recorded NMEA log
 };
 
 // ----- alias names for setFontSize()
@@ -170,14 +173,14 @@ struct Route {   // screen coordinates
 };
 
 struct Label {
-  char text[26];
+  const char *text;
   int x, y;
   uint16_t color;
 };
 
 typedef void (*simpleFunction)();
 struct Button {
-  char text[26];
+  const char *text;
   int x, y;
   int w, h;
   int radius;
@@ -188,7 +191,7 @@ struct Button {
 struct TimeButton {
   // TimeButton is like Button, but has a larger specifiable hit target
   // This allows very small buttons with a large sensitive area to make it easy to press
-  char text[26];
+  const char *text;
   int x, y;
   int w, h;
   Rect hitTarget;
@@ -201,7 +204,7 @@ struct FunctionButton {
   // FunctionButton is like Button, but has a larger specifiable hit target
   // It's also like TimeButton, but specifies the function by enum, rather than pointer to function
   // and this allows its usage in classes derived from "class View"
-  char text[26];       // one line of text, centered
+  const char *text;    // one line of text, centered, in flash
   int x, y;            // fillRoundRect ul corner
   int w, h;            // fillRoundRect size
   Rect hitTarget;      // touch-sensitive area
@@ -218,8 +221,11 @@ struct FunctionButton {
 #define rLOSSOFSIGNAL        "LOS"
 #define rACQUISITIONOFSIGNAL "AOS"
 #define rCOINBATTERYVOLTAGE  "BAT"
+#define rTIMETOFIRSTFIX      "TFF"
+#define rFENCEENTER          "FIN"
+#define rFENCEEXIT           "FOT"
 #define rRESET               "\0\0\0"
-#define rVALIDATE            rGPS rPOWERUP rPOWERDOWN rFIRSTVALIDTIME rLOSSOFSIGNAL rACQUISITIONOFSIGNAL rCOINBATTERYVOLTAGE
+#define rVALIDATE            rGPS rPOWERUP rPOWERDOWN rFIRSTVALIDTIME rLOSSOFSIGNAL rACQUISITIONOFSIGNAL rCOINBATTERYVOLTAGE rTIMETOFIRSTFIX rFENCEENTER rFENCEEXIT
 
 // Breadcrumb data definition for circular buffer
 class Location {
@@ -228,6 +234,7 @@ public:
   PointGPS loc;            // has-a lat/long, degrees
   time_t timestamp;        // has-a GMT time
   uint8_t numSatellites;   // number of satellites in use (not the same as in view)
+  int16_t climbRate;       // vertical speed, cm/sec, from the altitude filter
   float speed;             // current speed over ground in MPH (or coin battery voltage)
   float direction;         // direction of travel, degrees from true north
   float altitude;          // altitude, meters above MSL
@@ -237,6 +244,7 @@ public:
     loc.lat = loc.lng = 0.0;
     timestamp         = 0;
     numSatellites     = 0;
+    climbRate         = 0;
     speed             = 0.0;
     direction = altitude = 0.0;
   }
@@ -248,11 +256,17 @@ public:
 
   static bool isValidRecordType(const char *rec) {
     // check for "should not happen" situations
-    if (strstr(rVALIDATE, rec)) {
-      return true;
-    } else {
+    // compare against each 3-char record type in turn, so that "" or "SPU" cannot match
+    if (strlen(rec) != 3) {
       return false;
     }
+    const char valid[] = rVALIDATE;
+    for (unsigned int ii = 0; ii + 3 < sizeof(valid); ii += 3) {
+      if (strncmp(&valid[ii], rec, 3) == 0) {
+        return true;
+      }
+    }
+    return false;
   }
 
   bool isGPS() const {
@@ -279,6 +293,15 @@ public:
     return (strncmp(recordType, rCOINBATTERYVOLTAGE, sizeof(recordType)) == 0);
   }
 
+  bool isTimeToFirstFix() const {
+    return (strncmp(recordType, rTIMETOFIRSTFIX, sizeof(recordType)) == 0);
+  }
+
+  bool isFenceCrossing() const {
+    return (strncmp(recordType, rFENCEENTER, sizeof(recordType)) == 0) ||
+           (strncmp(recordType, rFENCEEXIT, sizeof(recordType)) == 0);
+  }
+
   // print ourself - a sanity check
   void printLocation(const char *comment = NULL) {   // debug
     // note: must use Serial.print (not logger) because the logger.h cannot be included at this level
@@ -13,8 +13,9 @@
             rewritten into other programming languages.
 */
 
-#include "constants.h"   // Griduino constants and colors
-#include "logger.h"      // conditional printing to Serial port
+#include "constants.h"       // Griduino constants and colors
+#include "logger.h"          // conditional printing to Serial port
+#include "format_helper.h"   // number to text without the heap
 
 // ========== class Grids =========================================
 class Dates {
@@ -34,10 +35,17 @@ public:
     //      logger.print("The current date is ");
     //      logger.print( datetimeToString(sDate, sizeof(sDate), now()) );
     //      logger.println(" GMT");
-    snprintf(msg, len, "%04d-%d-%d %02d:%02d:%02d",
-             year(tm), month(tm), day(tm),
-             hour(tm), minute(tm), second(tm));
-    return msg;
+    TimeElements tt;
+    breakTime(tm, tt);   // once for all six fields
+    char buf[24];
+    char *pp = putDigits(buf, tt.Year + 1970, 4);
+    *pp++    = '-';
+    pp       = putDigits(pp, tt.Month, 0);
+    *pp++    = '-';
+    pp       = putDigits(pp, tt.Day, 0);
+    *pp++    = ' ';
+    pp       = putTime(pp, tt);
+    return copyOut(msg, len, buf, pp);
   }
   char *datetimeToString(char *msg, int len, time_t tm, const char *suffix) {
     datetimeToString(msg, len, tm);
@@ -46,8 +54,16 @@ public:
   }
 
   char *dateToString(char *msg, int len, time_t tm) {
-    snprintf(msg, len, "%04d-%02d-%02d", year(tm), month(tm), day(tm));
-    return msg;
+    // "2022-12-03"
+    TimeElements tt;
+    breakTime(tm, tt);
+    char buf[12];
+    char *pp = putDigits(buf, tt.Year + 1970, 4);
+    *pp++    = '-';
+    pp       = putDigits(pp, tt.Month, 2);
+    *pp++    = '-';
+    pp       = putDigits(pp, tt.Day, 2);
+    return copyOut(msg, len, buf, pp);
   }
   char *dateToString(char *msg, int len, time_t tm, const char *suffix) {
     dateToString(msg, len, tm);
@@ -56,8 +72,12 @@ public:
   }
 
   char *timeToString(char *msg, int len, time_t tm) {
-    snprintf(msg, len, "%02d:%02d:%02d", hour(tm), minute(tm), second(tm));
-    return msg;
+    // "08:07:06"
+    TimeElements tt;
+    breakTime(tm, tt);
+    char buf[12];
+    char *pp = putTime(buf, tt);
+    return copyOut(msg, len, buf, pp);
   }
   char *timeToString(char *msg, int len, time_t tm, const char *suffix) {
     timeToString(msg, len, tm);
@@ -99,4 +119,33 @@ public:
     return ((timestamp + 1 + SECS_PER_15MIN) / SECS_PER_15MIN) * SECS_PER_15MIN;
   }
 
+protected:
+  // ----- formatting without snprintf, output is the same as "%d" or "%0*d"
+  char *putDigits(char *pp, int value, int width) {
+    char digits[8];
+    int nn = intToChars(digits, sizeof(digits), value);
+    for (int ii = nn; ii < width; ii++) {
+      *pp++ = '0';
+    }
+    memcpy(pp, digits, nn);
+    return pp + nn;
+  }
+  char *putTime(char *pp, const TimeElements &tt) {
+    // "hh:mm:ss"
+    pp    = putDigits(pp, tt.Hour, 2);
+    *pp++ = ':';
+    pp    = putDigits(pp, tt.Minute, 2);
+    *pp++ = ':';
+    return putDigits(pp, tt.Second, 2);
+  }
+  char *copyOut(char *msg, int len, char *buf, char *end) {
+    // copy to caller's buffer, truncated like snprintf
+    *end = 0;
+    if (len > 0) {
+      strncpy(msg, buf, len - 1);
+      msg[len - 1] = 0;
+    }
+    return msg;
+  }
+
 };   // end class Dates
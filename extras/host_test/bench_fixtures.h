@@ -0,0 +1,48 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     bench_fixtures.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Breadcrumb fixtures of 10,000 and 100,000 crumbs for the desktop
+            benchmark. They are generated instead of stored, since the larger
+            one is 7 MB of CSV, but crumb number ii is always the same: the
+            zigzag across CN87 that benchmark.cpp uses on the device, one
+            second apart, starting June 1, 2023.
+
+            fixtureCrumb() is the crumb as it is in RAM, and fixtureCSV() is
+            the same crumb as a line of the breadcrumb file.
+*/
+
+#include <Arduino.h>
+#include <TimeLib.h>             // time_t=seconds since Jan 1, 1970, https://github.com/PaulStoffregen/Time
+#include "grid_helper.h"         // lat/long conversion routines
+#include "model_breadcrumbs.h"   // breadcrumb trail
+
+const int benchFixtureSizes[] = {10000, 100000};
+
+inline PointGPS fixturePoint(int ii) {
+  return PointGPS{47.2 + (ii % 50) * 0.01, -123.9 + (ii % 1000) * 0.0015};
+}
+
+inline time_t fixtureTime(int ii) {
+  const TimeElements start{0, 0, 12, 0, 1, 6, (2023 - 1970)};   // June 1, 2023
+  return makeTime(start) + ii;
+}
+
+inline Location fixtureCrumb(int ii) {
+  return Location{rGPS, fixturePoint(ii), fixtureTime(ii), 7, 0, 55.0, 90.0, 120.0};
+}
+
+// same columns as saveGPSBreadcrumbTrail()
+inline void fixtureCSV(char *line, int size, int ii) {
+  PointGPS where = fixturePoint(ii);
+  TimeElements tm;
+  breakTime(fixtureTime(ii), tm);
+  char sGrid6[7];
+  grid.calcLocator(sGrid6, where.lat, where.lng, 6);
+  snprintf(line, size, "%s,%04d-%02d-%02d,%02d:%02d:%02d,%s,%.5f,%.5f,%.1f,%.1f,%.1f,%d,%d",
+           rGPS, tmYearToCalendar(tm.Year), tm.Month, tm.Day, tm.Hour, tm.Minute, tm.Second,
+           sGrid6, where.lat, where.lng, 120.0, 55.0, 90.0, 7, 0);
+}
@@ -0,0 +1,130 @@
+// Please format this file with clang before check-in to GitHub
+/*
+  File:     benchmark_host.cpp
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Desktop runner for the benchmarks. It first runs the same tests
+            as "run benchmark" on the device (benchmark.cpp), then the ones
+            that need more crumbs than the device can hold, on the 10k and
+            100k crumb fixtures in bench_fixtures.h:
+
+              cd extras/host_test && make bench
+
+            The output is the same "BENCH," CSV as on the device. These times
+            are for the desktop CPU with a display that draws nothing, so
+            compare them with other desktop runs, never with the device.
+            They do show how each step grows with the number of crumbs: the
+            trail is a ring of trail.capacity crumbs, so remember and restore
+            keep only the newest ones, but every crumb is still parsed and
+            every crumb still goes through the trip engine.
+*/
+
+#include <Arduino.h>
+#include <malloc.h>              // for mallinfo()
+#include <vector>
+#include "constants.h"           // Griduino constants, colors and typedefs
+#include "logger.h"              // conditional printing to Serial port
+#include "save_restore.h"        // Configuration data in nonvolatile RAM
+#include "model_breadcrumbs.h"   // breadcrumb trail
+#include "model_trips.h"         // trips and their statistics
+#include "bench_fixtures.h"      // 10k and 100k crumb fixtures
+
+// ========== extern ===========================================
+extern Breadcrumbs trail;     // host_globals.cpp
+extern void runBenchmark();   // benchmark.cpp
+
+// same file as model_breadcrumbs.cpp, which restoreGPSBreadcrumbTrail() reads
+const char FIXTURE_FILE[25]    = CONFIG_FOLDER "/gpshistory.csv";
+const char FIXTURE_VERSION[25] = "GPS Breadcrumb Trail v2";
+
+// ----- results, the same columns as benchmark.cpp
+static volatile double sink;   // keeps the compiler from optimizing away the code under test
+
+static int heapInUse() {
+  struct mallinfo mi = mallinfo();
+  return mi.uordblks;
+}
+
+static void report(const char *test, int crumbs, int iterations, unsigned long usec, int heapBefore) {
+  unsigned long nsPerOp = (unsigned long)((uint64_t)usec * 1000 / iterations);
+  printf("BENCH,%s,%s,%d,%d,%lu,%d\n", PROGRAM_VERSION, test, crumbs, iterations, nsPerOp, heapInUse() - heapBefore);
+}
+
+// ----- benchmarks on the fixtures
+static void benchRemember(int numCrumbs) {
+  trail.clearHistory();
+  int heap            = heapInUse();
+  unsigned long start = micros();
+  for (int ii = 0; ii < numCrumbs; ii++) {
+    trail.rememberGPS(fixturePoint(ii), fixtureTime(ii), 7, 55.0, 90.0, 120.0);
+  }
+  unsigned long elapsed = micros() - start;
+  report("trail.remember", numCrumbs, numCrumbs, elapsed, heap);
+}
+
+static void benchTrips(int numCrumbs) {
+  static TripEngine benchTrips;   // static, to keep its table off the stack
+  benchTrips.autosave = false;
+  benchTrips.clear();
+  int heap            = heapInUse();
+  unsigned long start = micros();
+  for (int ii = 0; ii < numCrumbs; ii++) {
+    benchTrips.observe(fixtureCrumb(ii));
+  }
+  unsigned long elapsed = micros() - start;
+  report("trips.observe", numCrumbs, numCrumbs, elapsed, heap);
+}
+
+static void benchParse(int numCrumbs) {
+  std::vector<std::string> lines(numCrumbs);
+  for (int ii = 0; ii < numCrumbs; ii++) {
+    char line[128];
+    fixtureCSV(line, sizeof(line), ii);
+    lines[ii] = line;
+  }
+  int accepted        = 0;
+  int heap            = heapInUse();
+  unsigned long start = micros();
+  for (int ii = 0; ii < numCrumbs; ii++) {
+    char csv_line[256];   // parseBreadcrumb() modifies its input, like restoreGPSBreadcrumbTrail()
+    strncpy(csv_line, lines[ii].c_str(), sizeof(csv_line));
+    Location loc;
+    accepted += trail.parseBreadcrumb(csv_line, &loc);
+  }
+  unsigned long elapsed = micros() - start;
+  sink                  = accepted;
+  report("parseBreadcrumb", numCrumbs, numCrumbs, elapsed, heap);
+}
+
+static void benchRestore(int numCrumbs) {
+  SaveRestoreStrings config(FIXTURE_FILE, FIXTURE_VERSION);
+  config.open(FIXTURE_FILE, "w");
+  for (int ii = 0; ii < numCrumbs; ii++) {
+    char line[128];
+    fixtureCSV(line, sizeof(line), ii);
+    config.writeLine(line);
+  }
+  config.close();
+
+  int heap            = heapInUse();
+  unsigned long start = micros();
+  trail.restoreGPSBreadcrumbTrail();
+  unsigned long elapsed = micros() - start;
+  report("trail.restoreCSV", numCrumbs, 1, elapsed, heap);
+}
+
+int main() {
+  runBenchmark();   // the device's own list, up to a full trail
+
+  printf("BENCH,version,test,crumbs,iterations,ns/op,heap bytes\n");
+  for (int numCrumbs : benchFixtureSizes) {
+    benchRemember(numCrumbs);
+    benchTrips(numCrumbs);
+    benchParse(numCrumbs);
+    benchRestore(numCrumbs);
+  }
+  trail.clearHistory();
+  return 0;
+}
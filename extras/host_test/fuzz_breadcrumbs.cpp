@@ -0,0 +1,92 @@
+// Please format this file with clang before check-in to GitHub
+/*
+  File:     fuzz_breadcrumbs.cpp
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Coverage-guided fuzz target for Breadcrumbs::parseBreadcrumb(),
+            the parser that reads the breadcrumb CSV file at every boot.
+            A damaged file must never crash it, and a line it accepts must
+            hold a valid record type and a valid lat/long.
+
+            With clang, libFuzzer drives it under AddressSanitizer, starting
+            from the seed lines in corpus/breadcrumbs:
+
+              make fuzz                  60 seconds, or FUZZ_SECONDS=600
+
+            AFL and the other engines can use the same entry point.
+            With gcc, which has no libFuzzer, FUZZ_REPLAY adds a main() that
+            runs each file named on the command line once, or stdin if none.
+            "make test" uses that to replay the seed corpus and any crash
+            files saved in it, so a crash found once stays fixed.
+
+            fuzzBreadcrumbs() in unit_test.cpp is the fixed-budget version of
+            this that runs on the device with "run fuzz".
+*/
+
+#include <Arduino.h>
+#include <Adafruit_ILI9341.h>    // TFT color display library
+#include "hardware.h"            // Griduino pin definitions
+#include "logger.h"              // conditional printing to Serial port
+#include "tracer.h"              // software tracer
+#include "perf_counters.h"       // performance counters
+#include "grid_helper.h"         // lat/long conversion routines
+#include "date_helper.h"         // date/time conversions
+#include "format_helper.h"       // number to text without the heap
+#include "model_breadcrumbs.h"   // breadcrumb trail
+#include "model_gps.h"           // Model::isValidLatLong()
+
+// ========== globals, the same as Griduino.ino ================
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+Logger logger        = Logger();
+Tracer tracer;
+PerfCounters perf;
+Grids grid = Grids();
+Dates date = Dates();
+Breadcrumbs trail;
+void floatToCharArray(char *result, int maxlen, double fValue, int decimalPlaces) {
+  fixedToChars(result, maxlen, fValue, decimalPlaces);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  // same buffer as restoreGPSBreadcrumbTrail(), which reads at most one line of 255 characters
+  char csv_line[256];
+  size_t len = size < sizeof(csv_line) - 1 ? size : sizeof(csv_line) - 1;
+  memcpy(csv_line, data, len);
+  csv_line[len] = 0;
+
+  Location loc;
+  if (trail.parseBreadcrumb(csv_line, &loc)) {
+    if (!Model::isValidLatLong(loc.loc.lat, loc.loc.lng) || !Location::isValidRecordType(loc.recordType)) {
+      abort();   // accepted a line it should have refused
+    }
+  }
+  return 0;
+}
+
+#ifdef FUZZ_REPLAY
+static int replay(FILE *input, const char *name) {
+  uint8_t data[4096];
+  size_t size = fread(data, 1, sizeof(data), input);
+  LLVMFuzzerTestOneInput(data, size);
+  printf("%s: %d bytes\n", name, (int)size);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    return replay(stdin, "stdin");
+  }
+  for (int ii = 1; ii < argc; ii++) {
+    FILE *input = fopen(argv[ii], "rb");
+    if (!input) {
+      perror(argv[ii]);
+      return 1;
+    }
+    replay(input, argv[ii]);
+    fclose(input);
+  }
+  return 0;
+}
+#endif
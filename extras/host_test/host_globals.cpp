@@ -0,0 +1,50 @@
+// Please format this file with clang before check-in to GitHub
+/*
+  File:     host_globals.cpp
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  The global objects that Griduino.ino owns on the device, for the
+            desktop programs in this folder: unit_tests and benchmark.
+*/
+
+#include <Arduino.h>
+#include "hardware.h"            // Griduino pin definitions
+#include "constants.h"           // Griduino constants and colors
+#include "logger.h"              // conditional printing to Serial port
+#include "tracer.h"              // software tracer
+#include "perf_counters.h"       // performance counters
+#include "grid_helper.h"         // lat/long conversion routines
+#include "date_helper.h"         // date/time conversions
+#include "format_helper.h"       // number to text without the heap
+#include "morse_dac.h"           // Morse code
+#include "model_breadcrumbs.h"   // breadcrumb trail
+#include "model_gps.h"           // Class Model (for model-view-controller)
+#include "model_geofence.h"      // county lines, contest areas and exclusion zones
+#include "model_baro.h"          // Model of a barometer that stores 3-day history
+#include "model_adc.h"           // coin battery voltage and its trend
+
+// ========== globals, the same as Griduino.ino ================
+Adafruit_ILI9341 tft = Adafruit_ILI9341(TFT_CS, TFT_DC);
+Logger logger        = Logger();
+Tracer tracer;
+PerfCounters perf;
+Adafruit_GPS GPS(&Serial1);
+Grids grid = Grids();
+Dates date = Dates();
+int gFrequency      = 1100;
+int gWordsPerMinute = 18;
+DACMorseSender dacMorse(DAC_PIN, gFrequency, gWordsPerMinute);
+Model modelGPS;
+Model *model = &modelGPS;
+Breadcrumbs trail;
+Geofence geofence;
+BatteryVoltage gpsBattery;
+BarometerModel baroModel;
+int grid_view = 13;   // GRID_VIEW in Griduino.ino
+
+void showDefaultTouchTargets() {}
+void floatToCharArray(char *result, int maxlen, double fValue, int decimalPlaces) {
+  fixedToChars(result, maxlen, fValue, decimalPlaces);
+}
@@ -0,0 +1,96 @@
+// Please format this file with clang before check-in to GitHub
+/*
+  File:     inter_core_stress.cpp
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Desktop stress test of SpscQueue and Seqlock (inter_core.h), with
+            a producer and a consumer thread standing in for the RP2040's
+            two cores. "make test" builds and runs it with ThreadSanitizer.
+
+            It checks that
+              1. every queued item arrives once, in order, and unchanged
+              2. a Seqlock reader never sees half of one write and half of another
+            and ThreadSanitizer checks the memory ordering between the threads.
+            Returns 0 if everything passed.
+
+            This is not part of the sketch; the Arduino IDE does not compile
+            files under extras/. The on-device version is verifyInterCore()
+            in unit_test.cpp.
+*/
+
+#include <stdio.h>
+#include <thread>
+#include "inter_core.h"   // SpscQueue and Seqlock
+
+// ----- same shapes as NmeaLine and NmeaReaderStats in nmea_reader.h
+struct Line {
+  uint32_t sequence;   //
+  char text[80];       // filled from the sequence number, so a torn copy shows
+};
+struct Stats {
+  uint32_t words[7];   // every word is a multiple of the first
+};
+
+static SpscQueue<Line, 32> lines;   // producer --> consumer
+static Seqlock<Stats> published;    // producer --> consumer
+
+static void fill(Line *line, uint32_t seq) {
+  line->sequence = seq;
+  for (int ii = 0; ii < (int)sizeof(line->text); ii++) {
+    line->text[ii] = (char)('A' + (seq + ii) % 26);
+  }
+}
+static bool isIntact(const Line &line) {
+  Line expected;
+  fill(&expected, line.sequence);
+  return memcmp(&expected, &line, sizeof(line)) == 0;
+}
+
+int main() {
+  const uint32_t numItems = 200000;
+  uint32_t torn = 0, outOfOrder = 0, damaged = 0, snapshots = 0;
+
+  std::thread producer([&] {
+    Line line;
+    for (uint32_t seq = 1; seq <= numItems;) {
+      fill(&line, seq);
+      if (lines.push(line)) {
+        seq++;   // full: try again, the consumer will catch up
+      }
+      Stats stats;
+      for (int ii = 0; ii < 7; ii++) {
+        stats.words[ii] = seq * (ii + 1);
+      }
+      published.write(stats);
+    }
+  });
+
+  std::thread consumer([&] {
+    Line line;
+    for (uint32_t expected = 1; expected <= numItems;) {
+      if (lines.pop(&line)) {
+        outOfOrder += (line.sequence != expected);
+        damaged += !isIntact(line);
+        expected++;
+      }
+      Stats stats;
+      if (published.read(&stats)) {
+        snapshots++;
+        for (int ii = 1; ii < 7; ii++) {
+          if (stats.words[ii] != stats.words[0] * (ii + 1)) {
+            torn++;
+            break;
+          }
+        }
+      }
+    }
+  });
+
+  producer.join();
+  consumer.join();
+  printf("%u items, %u out of order, %u damaged; %u snapshots, %u torn; %u pushes refused while full\n",
+         numItems, outOfOrder, damaged, snapshots, torn, lines.dropped());
+  return (outOfOrder || damaged || torn || lines.depth() != 0) ? 1 : 0;
+}
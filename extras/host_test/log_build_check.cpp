@@ -0,0 +1,48 @@
+// Please format this file with clang before check-in to GitHub
+/*
+  File:     log_build_check.cpp
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Build-time check of the compile-time log filter in logger.h.
+            This is compiled like a release build that keeps INFO and up,
+            without NMEA, and at -Os like the Arduino IDE. It is never run.
+
+            The static_asserts check logBuildEnabled() itself. The Makefile
+            then looks inside the object file: the format strings of the
+            filtered messages must not be there, since a call would have to
+            pass them, and the string of the message that is kept must be
+            there, which shows that the check can fail.
+
+              cd extras/host_test && make log-check
+*/
+
+#define LOG_BUILD_LEVEL   INFO
+#define LOG_BUILD_SYSTEMS (LOG_ALL_SYSTEMS & ~LOG_SYSTEM(NMEA))
+
+#include <Arduino.h>
+#include "logger.h"   // conditional printing to Serial port
+
+static_assert(!logBuildEnabled(GPS_SETUP, DEBUG), "DEBUG is below LOG_BUILD_LEVEL");
+static_assert(!logBuildEnabled(GPS_SETUP, POST), "POST is below LOG_BUILD_LEVEL");
+static_assert(logBuildEnabled(GPS_SETUP, INFO), "INFO is at LOG_BUILD_LEVEL");
+static_assert(!logBuildEnabled(NMEA, ERROR), "NMEA is not in LOG_BUILD_SYSTEMS");
+static_assert(logBuildEnabled(NMEA, CONSOLE), "CONSOLE is always kept");
+
+// every overload, so that none of them can keep a call by mistake
+void filteredMessages(Logger &log) {
+  log.log(GPS_SETUP, DEBUG, "LOG_BUILD_CHECK filtered text");
+  log.log(GPS_SETUP, DEBUG, "LOG_BUILD_CHECK filtered %s", "LOG_BUILD_CHECK filtered arg");
+  log.log(GPS_SETUP, POST, "LOG_BUILD_CHECK filtered %s %s", "a", "b");
+  log.log(GPS_SETUP, DEBUG, "LOG_BUILD_CHECK filtered %d", 1);
+  log.log(GPS_SETUP, DEBUG, "LOG_BUILD_CHECK filtered %d %d", 1, 2);
+  log.logFloat(GPS_SETUP, DEBUG, "LOG_BUILD_CHECK filtered %s", 1.5, 1);
+  log.logTwoFloats(GPS_SETUP, DEBUG, "LOG_BUILD_CHECK filtered %s %s", 1.5, 1, 2.5, 1);
+  log.log(NMEA, ERROR, "LOG_BUILD_CHECK filtered system");
+  log.fencepost("LOG_BUILD_CHECK filtered module", "LOG_BUILD_CHECK filtered subroutine", __LINE__);
+}
+
+void keptMessage(Logger &log) {
+  log.log(GPS_SETUP, INFO, "LOG_BUILD_CHECK kept");
+}
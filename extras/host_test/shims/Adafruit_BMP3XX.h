@@ -0,0 +1,39 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     Adafruit_BMP3XX.h
+
+  Purpose:  Desktop stand-in for the BMP388 barometer. There is no sensor,
+            so begin() and performReading() fail the way a missing chip does.
+*/
+
+#include <SPI.h>
+#include <Wire.h>
+
+#define BMP3_NO_OVERSAMPLING    0
+#define BMP3_OVERSAMPLING_2X    1
+#define BMP3_OVERSAMPLING_4X    2
+#define BMP3_OVERSAMPLING_8X    3
+#define BMP3_OVERSAMPLING_16X   4
+#define BMP3_OVERSAMPLING_32X   5
+#define BMP3_IIR_FILTER_DISABLE 0
+#define BMP3_IIR_FILTER_COEFF_1 1
+#define BMP3_IIR_FILTER_COEFF_3 2
+#define BMP3_IIR_FILTER_COEFF_7 3
+#define BMP3_ODR_50_HZ          2
+#define BMP3_ODR_25_HZ          3
+#define BMP3_ODR_12_5_HZ        4
+
+class Adafruit_BMP3XX {
+public:
+  bool begin_I2C(uint8_t addr = 0x77, TwoWire *theWire = &Wire) { return false; }
+  bool begin_SPI(uint8_t cs_pin, SPIClass *theSPI = &SPI) { return false; }
+  bool setTemperatureOversampling(uint8_t os) { return true; }
+  bool setPressureOversampling(uint8_t os) { return true; }
+  bool setIIRFilterCoeff(uint8_t fs) { return true; }
+  bool setOutputDataRate(uint8_t odr) { return true; }
+  bool performReading(void) { return false; }
+  float readTemperature(void) { return temperature; }
+  float readPressure(void) { return pressure; }
+  double temperature = 0.0;
+  double pressure    = 0.0;
+};
@@ -0,0 +1,98 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     Adafruit_GFX.h
+
+  Purpose:  Desktop stand-in for the Adafruit graphics library. Drawing does
+            nothing; the cursor, colors and screen size are remembered so the
+            views' layout arithmetic still runs. Text is measured as the
+            library's built-in 6x8 font, whatever font is selected.
+*/
+
+#include <Arduino.h>
+
+typedef struct {
+  uint16_t bitmapOffset;
+  uint8_t width;
+  uint8_t height;
+  uint8_t xAdvance;
+  int8_t xOffset;
+  int8_t yOffset;
+} GFXglyph;
+
+typedef struct {
+  uint8_t *bitmap;
+  GFXglyph *glyph;
+  uint16_t first;
+  uint16_t last;
+  uint8_t yAdvance;
+} GFXfont;
+
+class Adafruit_GFX : public Print {
+public:
+  Adafruit_GFX(int16_t w, int16_t h)
+      : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+  size_t write(uint8_t c) override {
+    cursor_x += 6 * textsize;
+    return 1;
+  }
+  using Print::write;
+
+  void startWrite() {}
+  void endWrite() {}
+  void drawPixel(int16_t x, int16_t y, uint16_t color) {}
+  void writePixel(int16_t x, int16_t y, uint16_t color) {}
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {}
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {}
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {}
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {}
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {}
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {}
+  void fillScreen(uint16_t color) {}
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {}
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {}
+  void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {}
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {}
+  void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {}
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {}
+  void drawRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h, int16_t radius, uint16_t color) {}
+  void fillRoundRect(int16_t x0, int16_t y0, int16_t w, int16_t h, int16_t radius, uint16_t color) {}
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color) {}
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg) {}
+  void drawRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[], int16_t w, int16_t h) {}
+
+  void setCursor(int16_t x, int16_t y) {
+    cursor_x = x;
+    cursor_y = y;
+  }
+  int16_t getCursorX(void) const { return cursor_x; }
+  int16_t getCursorY(void) const { return cursor_y; }
+  void setTextColor(uint16_t c) {}
+  void setTextColor(uint16_t c, uint16_t bg) {}
+  void setTextSize(uint8_t s) { textsize = s ? s : 1; }
+  void setTextWrap(bool w) {}
+  void setFont(const GFXfont *f = NULL) {}
+  void getTextBounds(const char *string, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h) {
+    *x1 = x;
+    *y1 = y;
+    *w  = strlen(string) * 6 * textsize;
+    *h  = 8 * textsize;
+  }
+  void getTextBounds(const String &str, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h) {
+    getTextBounds(str.c_str(), x, y, x1, y1, w, h);
+  }
+  void setRotation(uint8_t r) {
+    rotation = r & 3;
+    _width   = (rotation & 1) ? HEIGHT : WIDTH;
+    _height  = (rotation & 1) ? WIDTH : HEIGHT;
+  }
+  uint8_t getRotation(void) const { return rotation; }
+  int16_t width(void) const { return _width; }
+  int16_t height(void) const { return _height; }
+
+protected:
+  const int16_t WIDTH, HEIGHT;   // this is the 'raw' display w/h - never changes
+  int16_t _width, _height;       // display w/h as modified by current rotation
+  int16_t cursor_x = 0, cursor_y = 0;
+  uint8_t textsize = 1;
+  uint8_t rotation = 0;
+};
@@ -0,0 +1,21 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     Adafruit_SPIFlash.h
+
+  Purpose:  Desktop stand-in for the flash chip under the file system.
+            The files themselves are in SdFat.h.
+*/
+
+#include <SdFat.h>
+
+class Adafruit_FlashTransport {};
+class Adafruit_FlashTransport_QSPI : public Adafruit_FlashTransport {};
+class Adafruit_FlashTransport_RP2040_CPY : public Adafruit_FlashTransport {};
+
+class Adafruit_SPIFlash {
+public:
+  Adafruit_SPIFlash(Adafruit_FlashTransport *transport) {}
+  bool begin(void *flash_devs = 0, size_t count = 1) { return true; }
+  uint32_t getJEDECID() { return 0xC84015; }   // GD25Q16C, same as the Feather M4
+  uint32_t size() { return 2 * 1024 * 1024; }
+};
@@ -0,0 +1,236 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     Arduino.h
+
+  Purpose:  Just enough of the Arduino core to compile Griduino's models,
+            helpers and unit tests on a desktop. Serial goes to stdout,
+            millis() and micros() come from the host clock, and the pins
+            do nothing. The implementations are in arduino.cpp.
+
+            This is not the real core; add to it only what the sketch needs.
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+#include <ctype.h>
+#include <malloc.h>
+#include <string>
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef unsigned int uint;
+
+#define HIGH         1
+#define LOW          0
+#define INPUT        0
+#define OUTPUT       1
+#define INPUT_PULLUP 2
+#define A0           14
+#define A1           15
+#define A2           16
+#define A3           17
+#define A4           18
+#define A5           19
+#define DAC0         14
+#define LED_BUILTIN  13
+#define PIN_LED      13
+#define PIN_NEOPIXEL 8
+#define DEC          10
+#define HEX          16
+#define BIN          2
+#define AR_DEFAULT   0
+#define F_CPU        120000000L
+
+#define PI         3.1415926535897932384626433832795
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define F(s) (s)
+#define PROGMEM
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define radians(deg)              ((deg) * DEG_TO_RAD)
+#define degrees(rad)              ((rad) * RAD_TO_DEG)
+#define bitRead(value, bit)       (((value) >> (bit)) & 0x01)
+
+// functions rather than the core's macros, which would break the C++ library headers
+template <typename T, typename U>
+inline auto min(const T &a, const U &b) -> decltype(a < b ? a : b) {
+  return a < b ? a : b;
+}
+template <typename T, typename U>
+inline auto max(const T &a, const U &b) -> decltype(a > b ? a : b) {
+  return a > b ? a : b;
+}
+
+// ========== time and pins ====================================
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+inline void yield() {}
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+inline void pinMode(int, int) {}
+inline void digitalWrite(int, int) {}
+inline int digitalRead(int) { return LOW; }
+inline int analogRead(int) { return 0; }
+inline void analogWrite(int, int) {}
+inline void analogReadResolution(int) {}
+inline void analogWriteResolution(int) {}
+inline void analogReference(int) {}
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// ========== String ===========================================
+// Only the parts the sketch uses. Numbers are formatted like the SAMD core's,
+// which is dtostrf(value, places + 2, places), i.e. printf("%*.*f").
+class String {
+public:
+  String(const char *s = "")
+      : text(s ? s : "") {}
+  String(char c)
+      : text(1, c) {}
+  String(int value, unsigned char base = 10) { fromLong(value, base); }
+  String(unsigned int value, unsigned char base = 10) { fromLong(value, base); }
+  String(long value, unsigned char base = 10) { fromLong(value, base); }
+  String(unsigned long value, unsigned char base = 10) { fromLong((long)value, base); }
+  String(float value, unsigned char places = 2) { fromDouble(value, places); }
+  String(double value, unsigned char places = 2) { fromDouble(value, places); }
+
+  String &operator+=(const String &rhs) {
+    text += rhs.text;
+    return *this;
+  }
+  friend String operator+(const String &lhs, const String &rhs) {
+    String result(lhs);
+    return result += rhs;
+  }
+  bool operator==(const String &rhs) const { return text == rhs.text; }
+  bool operator!=(const String &rhs) const { return text != rhs.text; }
+  char operator[](unsigned int index) const { return index < text.size() ? text[index] : 0; }
+  unsigned int length() const { return text.size(); }
+  const char *c_str() const { return text.c_str(); }
+  String substring(unsigned int from, unsigned int to = 0xFFFF) const {
+    return String(text.substr(from, to - from).c_str());
+  }
+  void toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const {
+    if (bufsize) {
+      strncpy(buf, text.c_str() + min(index, (unsigned int)text.size()), bufsize - 1);
+      buf[bufsize - 1] = 0;
+    }
+  }
+  int indexOf(char c) const {
+    size_t pos = text.find(c);
+    return pos == std::string::npos ? -1 : (int)pos;
+  }
+  long toInt() const { return atol(text.c_str()); }
+  float toFloat() const { return atof(text.c_str()); }
+
+private:
+  std::string text;
+  void fromLong(long value, unsigned char base) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), base == 16 ? "%lX" : "%ld", value);
+    text = buf;
+  }
+  void fromDouble(double value, unsigned char places) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%*.*f", places + 2, places, value);
+    text = buf;
+  }
+};
+
+// ========== Print, Stream and Serial =========================
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+      n += write(*buffer++);
+    }
+    return n;
+  }
+  size_t write(const char *str) { return write((const uint8_t *)str, strlen(str)); }
+
+  size_t print(const String &s) { return write(s.c_str()); }
+  size_t print(const char *s) { return write(s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned char n, int base = DEC) { return print((unsigned long)n, base); }
+  size_t print(int n, int base = DEC) { return print((long)n, base); }
+  size_t print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+  size_t print(long n, int base = DEC) { return printf(base == HEX ? "%lX" : "%ld", n); }
+  size_t print(unsigned long n, int base = DEC) { return printf(base == HEX ? "%lX" : "%lu", n); }
+  size_t print(double n, int places = 2) { return printf("%.*f", places, n); }
+
+  template <typename T>
+  size_t println(T value) {
+    size_t n = print(value);
+    return n + println();
+  }
+  template <typename T>
+  size_t println(T value, int format) {
+    size_t n = print(value, format);
+    return n + println();
+  }
+  size_t println(void) { return write("\r\n"); }
+
+  size_t printf(const char *format, ...) {
+    char buf[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    return write(buf);
+  }
+  void flush() {}
+};
+
+class Stream : public Print {
+public:
+  virtual int available() { return 0; }
+  virtual int read() { return -1; }
+  virtual int peek() { return -1; }
+  using Print::write;
+  void setTimeout(unsigned long) {}
+};
+
+class HardwareSerial : public Stream {
+public:
+  size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+  using Print::write;
+  void begin(unsigned long) {}
+  void end() {}
+  operator bool() { return true; }
+};
+extern HardwareSerial Serial;    // stdout
+extern HardwareSerial Serial1;   // the GPS receiver, which never answers
+
+#define SERIAL_BUFFER_SIZE 350   // same as the SAMD core
+inline void NVIC_SystemReset() { exit(0); }
+
+// ========== Cortex-M4 ========================================
+// The desktop build is a Feather M4 (SAMD_SERIES, see the Makefile), so
+// hardware.h picks its pins. Its cycle counter does not count here.
+struct DWT_Type {
+  uint32_t CTRL, CYCCNT;
+};
+struct CoreDebug_Type {
+  uint32_t DEMCR;
+};
+extern DWT_Type *DWT;
+extern CoreDebug_Type *CoreDebug;
+#define DWT_CTRL_CYCCNTENA_Msk     (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
@@ -0,0 +1,4 @@
+#pragma once
+// Desktop stand-in: a font with no glyphs, since the shim measures all text as 6x8
+#include "../Adafruit_GFX.h"
+const GFXfont FreeSans9pt7b = {nullptr, nullptr, 1, 0, 8};   // last < first: no characters
@@ -0,0 +1,16 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+// Desktop stand-in for the touchscreen; nobody ever touches it.
+#include <Arduino.h>
+
+class TSPoint {
+public:
+  TSPoint(int16_t x = 0, int16_t y = 0, int16_t z = 0)
+      : x(x), y(y), z(z) {}
+  int16_t x, y, z;   // z is pressure
+};
+
+class Resistive_Touch_Screen {
+public:
+  Resistive_Touch_Screen(uint8_t xp, uint8_t yp, uint8_t xm, uint8_t ym, uint16_t rx) {}
+  TSPoint getPoint(void) { return TSPoint(); }
+};
@@ -0,0 +1,9 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+// Desktop stand-in for the SPI bus; nothing is attached to it.
+#include <Arduino.h>
+
+class SPIClass {
+public:
+  void begin() {}
+};
+extern SPIClass SPI;
@@ -0,0 +1,156 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     SdFat.h
+
+  Purpose:  Desktop stand-in for Adafruit's fork of SdFat, backed by POSIX
+            files. Every path on the "flash chip" lives under the directory
+            HOST_FLASH_ROOT, so "/Griduino/gpsmodel.cfg" is the desktop file
+            "host_flash/Griduino/gpsmodel.cfg". The Makefile empties that
+            directory before each run.
+
+            Like SdFat, a File32 is a handle that can be copied; it is closed
+            only by close(), never by the destructor.
+*/
+
+#include <Arduino.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifndef HOST_FLASH_ROOT
+#define HOST_FLASH_ROOT "host_flash"
+#endif
+
+#define O_RDONLY   0x00
+#define O_WRONLY   0x01
+#define O_RDWR     0x02
+#define O_CREAT    0x40
+#define O_TRUNC    0x200
+#define O_APPEND   0x400
+#define O_READ     O_RDONLY
+#define O_WRITE    O_WRONLY
+#define FILE_READ  O_RDONLY
+#define FILE_WRITE (O_RDWR | O_CREAT | O_APPEND)
+
+inline std::string hostPath(const char *path) {
+  return std::string(HOST_FLASH_ROOT) + (*path == '/' ? "" : "/") + path;
+}
+
+class File32 : public Stream {
+public:
+  File32() {}
+  operator bool() { return fp || dir; }
+  bool isOpen() const { return fp || dir; }
+  bool isDirectory() { return dir != nullptr; }
+  bool isDir() const { return dir != nullptr; }
+  bool isFile() const { return fp != nullptr; }
+  bool close() {
+    if (fp) {
+      fclose(fp);
+    }
+    if (dir) {
+      closedir(dir);
+    }
+    fp  = nullptr;
+    dir = nullptr;
+    return true;
+  }
+
+  // ----- files
+  int available() override { return fp ? (int)(size() - position()) : 0; }
+  int read() override { return fp ? fgetc(fp) : -1; }
+  int peek() override {
+    int c = read();
+    if (c != EOF) {
+      ungetc(c, fp);
+    }
+    return c;
+  }
+  int read(void *buf, size_t count) { return fp ? (int)fread(buf, 1, count, fp) : -1; }
+  size_t write(uint8_t c) override { return fp ? (fputc(c, fp) == EOF ? 0 : 1) : 0; }
+  size_t write(const void *buf, size_t count) { return fp ? fwrite(buf, 1, count, fp) : 0; }
+  using Print::write;
+  uint32_t size() {
+    struct stat st;
+    return (fp && fstat(fileno(fp), &st) == 0) ? st.st_size : 0;
+  }
+  uint32_t fileSize() { return size(); }
+  uint64_t position() { return fp ? ftell(fp) : 0; }
+  bool seek(uint64_t pos) { return fp && fseek(fp, pos, SEEK_SET) == 0; }
+  bool seekSet(uint64_t pos) { return seek(pos); }
+  bool sync() { return fp && fflush(fp) == 0; }
+  int getError() { return fp ? ferror(fp) : 0; }
+  // SdFat's fgets(): keeps the newline, returns the length, 0 at end of file, -1 on error
+  int fgets(char *str, int num, char *delim = 0) {
+    if (!fp || !::fgets(str, num, fp)) {
+      return fp ? 0 : -1;
+    }
+    return strlen(str);
+  }
+
+  // ----- directories
+  File32 openNextFile(int mode = O_RDONLY) {
+    File32 child;
+    struct dirent *entry;
+    while (dir && (entry = readdir(dir))) {
+      if (strcmp(entry->d_name, ".") && strcmp(entry->d_name, "..")) {
+        child = open(path + "/" + entry->d_name, mode);
+        break;
+      }
+    }
+    return child;
+  }
+  size_t getName(char *name, size_t count) {
+    size_t slash = path.rfind('/');
+    strncpy(name, path.c_str() + (slash == std::string::npos ? 0 : slash + 1), count - 1);
+    name[count - 1] = 0;
+    return strlen(name);
+  }
+  void rewindDirectory() {
+    if (dir) {
+      rewinddir(dir);
+    }
+  }
+
+  static File32 open(const std::string &fullPath, int oflag) {
+    File32 file;
+    file.path = fullPath;
+    struct stat st;
+    if (stat(fullPath.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+      file.dir = opendir(fullPath.c_str());
+    } else if (oflag & O_TRUNC) {
+      file.fp = fopen(fullPath.c_str(), "w+b");
+    } else if (oflag & O_APPEND) {
+      file.fp = fopen(fullPath.c_str(), "a+b");
+    } else if (oflag & O_CREAT) {
+      file.fp = fopen(fullPath.c_str(), "r+b");
+      if (!file.fp) {
+        file.fp = fopen(fullPath.c_str(), "w+b");
+      }
+    } else {
+      file.fp = fopen(fullPath.c_str(), (oflag & (O_WRONLY | O_RDWR)) ? "r+b" : "rb");
+    }
+    return file;
+  }
+
+private:
+  FILE *fp = nullptr;
+  DIR *dir = nullptr;
+  std::string path;
+};
+typedef File32 File;
+
+class FatVolume {
+public:
+  bool begin(void *dev = 0) {
+    ::mkdir(HOST_FLASH_ROOT, 0755);
+    return true;
+  }
+  File32 open(const char *path, int oflag = O_RDONLY) { return File32::open(hostPath(path), oflag); }
+  bool exists(const char *path) { return access(hostPath(path).c_str(), F_OK) == 0; }
+  bool mkdir(const char *path, bool pFlag = true) { return ::mkdir(hostPath(path).c_str(), 0755) == 0; }
+  bool remove(const char *path) { return ::remove(hostPath(path).c_str()) == 0; }
+  bool rmdir(const char *path) { return ::rmdir(hostPath(path).c_str()) == 0; }
+  bool rename(const char *from, const char *to) { return ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0; }
+};
+typedef FatVolume FatFileSystem;
@@ -0,0 +1,73 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     TimeLib.h
+
+  Purpose:  Desktop stand-in for Paul Stoffregen's Time library,
+            https://github.com/PaulStoffregen/Time
+            makeTime() and breakTime() give the same answers as the real
+            library for 1970..2105; the clock starts at zero like the
+            device's and runs only when setTime() or adjustTime() move it.
+*/
+
+#include <Arduino.h>
+#include <time.h>
+
+typedef struct {
+  uint8_t Second;
+  uint8_t Minute;
+  uint8_t Hour;
+  uint8_t Wday;    // day of week, sunday is day 1
+  uint8_t Day;     //
+  uint8_t Month;   //
+  uint8_t Year;    // offset from 1970
+} tmElements_t, TimeElements;
+
+typedef enum { timeNotSet,
+               timeNeedsSync,
+               timeSet } timeStatus_t;
+
+#define tmYearToCalendar(Y) ((Y) + 1970)
+#define CalendarYrToTm(Y)   ((Y)-1970)
+#define tmYearToY2k(Y)      ((Y)-30)
+#define y2kYearToTm(Y)      ((Y) + 30)
+
+#define SECS_PER_MIN  ((time_t)(60UL))
+#define SECS_PER_HOUR ((time_t)(3600UL))
+#define SECS_PER_DAY  ((time_t)(SECS_PER_HOUR * 24UL))
+#define DAYS_PER_WEEK ((time_t)(7UL))
+#define SECS_PER_WEEK ((time_t)(SECS_PER_DAY * DAYS_PER_WEEK))
+#define SECS_PER_YEAR ((time_t)(SECS_PER_DAY * 365UL))
+#define SECS_YR_2000  ((time_t)(946684800UL))
+
+#define numberOfSeconds(_time_)  ((_time_) % SECS_PER_MIN)
+#define numberOfMinutes(_time_)  (((_time_) / SECS_PER_MIN) % SECS_PER_MIN)
+#define numberOfHours(_time_)    (((_time_) % SECS_PER_DAY) / SECS_PER_HOUR)
+#define dayOfWeek(_time_)        ((((_time_) / SECS_PER_DAY + 4) % DAYS_PER_WEEK) + 1)
+#define elapsedDays(_time_)      ((_time_) / SECS_PER_DAY)
+#define elapsedSecsToday(_time_) ((_time_) % SECS_PER_DAY)
+#define previousMidnight(_time_) (((_time_) / SECS_PER_DAY) * SECS_PER_DAY)
+#define nextMidnight(_time_)     (previousMidnight(_time_) + SECS_PER_DAY)
+
+time_t makeTime(const tmElements_t &tm);
+void breakTime(time_t time, tmElements_t &tm);
+
+time_t now();
+void setTime(time_t t);
+void setTime(int hr, int min, int sec, int day, int month, int yr);
+void adjustTime(long adjustment);
+timeStatus_t timeStatus();
+
+int second(time_t t);
+int minute(time_t t);
+int hour(time_t t);
+int day(time_t t);
+int weekday(time_t t);
+int month(time_t t);
+int year(time_t t);
+inline int second() { return second(now()); }
+inline int minute() { return minute(now()); }
+inline int hour() { return hour(now()); }
+inline int day() { return day(now()); }
+inline int weekday() { return weekday(now()); }
+inline int month() { return month(now()); }
+inline int year() { return year(now()); }
@@ -0,0 +1,9 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+// Desktop stand-in for the I2C bus; nothing is attached to it.
+#include <Arduino.h>
+
+class TwoWire {
+public:
+  void begin() {}
+};
+extern TwoWire Wire;
@@ -0,0 +1,130 @@
+// Please format this file with clang before check-in to GitHub
+/*
+  File:     arduino.cpp
+
+  Purpose:  Desktop implementations behind the shims in this folder:
+            the serial ports, the clock, random() and the Time library.
+*/
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <Wire.h>
+#include <TimeLib.h>
+#include <chrono>
+#include <thread>
+
+HardwareSerial Serial;
+HardwareSerial Serial1;
+SPIClass SPI;
+TwoWire Wire;
+
+static DWT_Type dwt;
+static CoreDebug_Type coreDebug;
+DWT_Type *DWT             = &dwt;
+CoreDebug_Type *CoreDebug = &coreDebug;
+
+// ========== clock ============================================
+static const std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+
+unsigned long micros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - bootTime).count();
+}
+unsigned long millis() {
+  return micros() / 1000;
+}
+void delay(unsigned long ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+void delayMicroseconds(unsigned int us) {
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+// ========== random ===========================================
+// same as the Arduino core: a repeatable sequence for a given seed
+long random(long howbig) {
+  return howbig ? rand() % howbig : 0;
+}
+long random(long howsmall, long howbig) {
+  return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall);
+}
+void randomSeed(unsigned long seed) {
+  if (seed) {
+    srand(seed);
+  }
+}
+
+// ========== Time library =====================================
+static time_t sysTime = 0;   // seconds since 1970, like the device before its first GPS fix
+static timeStatus_t status = timeNotSet;
+
+time_t makeTime(const tmElements_t &tm) {
+  struct tm utc = {};
+  utc.tm_sec    = tm.Second;
+  utc.tm_min    = tm.Minute;
+  utc.tm_hour   = tm.Hour;
+  utc.tm_mday   = tm.Day;
+  utc.tm_mon    = tm.Month - 1;
+  utc.tm_year   = tm.Year + 70;
+  return timegm(&utc);
+}
+void breakTime(time_t time, tmElements_t &tm) {
+  struct tm utc;
+  gmtime_r(&time, &utc);
+  tm.Second = utc.tm_sec;
+  tm.Minute = utc.tm_min;
+  tm.Hour   = utc.tm_hour;
+  tm.Wday   = utc.tm_wday + 1;   // sunday is day 1
+  tm.Day    = utc.tm_mday;
+  tm.Month  = utc.tm_mon + 1;
+  tm.Year   = utc.tm_year - 70;
+}
+
+time_t now() {
+  return sysTime;
+}
+void setTime(time_t t) {
+  sysTime = t;
+  status  = timeSet;
+}
+void setTime(int hr, int min, int sec, int dy, int mnth, int yr) {
+  if (yr > 99) {
+    yr = yr - 1970;
+  } else {
+    yr += 30;
+  }
+  tmElements_t tm{(uint8_t)sec, (uint8_t)min, (uint8_t)hr, 0, (uint8_t)dy, (uint8_t)mnth, (uint8_t)yr};
+  setTime(makeTime(tm));
+}
+void adjustTime(long adjustment) {
+  sysTime += adjustment;
+}
+timeStatus_t timeStatus() {
+  return status;
+}
+
+static tmElements_t broken(time_t t) {
+  tmElements_t tm;
+  breakTime(t, tm);
+  return tm;
+}
+int second(time_t t) {
+  return broken(t).Second;
+}
+int minute(time_t t) {
+  return broken(t).Minute;
+}
+int hour(time_t t) {
+  return broken(t).Hour;
+}
+int day(time_t t) {
+  return broken(t).Day;
+}
+int weekday(time_t t) {
+  return broken(t).Wday;
+}
+int month(time_t t) {
+  return broken(t).Month;
+}
+int year(time_t t) {
+  return tmYearToCalendar(broken(t).Year);
+}
@@ -0,0 +1,29 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+// Desktop stand-in for Paul Stoffregen's elapsedMillis library, on the shim's millis()
+#include <Arduino.h>
+
+class elapsedMillis {
+public:
+  elapsedMillis(unsigned long val = 0) { ms = millis() - val; }
+  operator unsigned long() const { return millis() - ms; }
+  elapsedMillis &operator=(unsigned long val) {
+    ms = millis() - val;
+    return *this;
+  }
+
+private:
+  unsigned long ms;
+};
+
+class elapsedSeconds {
+public:
+  elapsedSeconds(unsigned long val = 0) { s = millis() / 1000 - val; }
+  operator unsigned long() const { return millis() / 1000 - s; }
+  elapsedSeconds &operator=(unsigned long val) {
+    s = millis() / 1000 - val;
+    return *this;
+  }
+
+private:
+  unsigned long s;
+};
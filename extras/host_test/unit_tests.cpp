@@ -0,0 +1,30 @@
+// Please format this file with clang before check-in to GitHub
+/*
+  File:     unit_tests.cpp
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Desktop runner for the unit tests in unit_test.cpp. It stands in
+            for Griduino.ino, with the same global objects in host_globals.cpp,
+            and runs every test that needs no hardware and no GPS parser
+            (logicSuites[]) and the save/restore tests on a scratch folder
+            (flashSuites[]).
+            Exits with 1 if anything failed, so "make test" fails too.
+
+              cd extras/host_test && make test
+
+            The tests that need the real Adafruit_GPS parser, the barometer or
+            the display still run only on the device, with "run modeltest"
+            and "run unittest".
+*/
+
+#include <stdio.h>
+
+extern int runHostSuites();   // unit_test.cpp, the globals it needs are in host_globals.cpp
+
+int main() {
+  int fails = runHostSuites();
+  printf("%d failures\n", fails);
+  return fails ? 1 : 0;
+}
@@ -0,0 +1,194 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     fix_validator.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Plausibility checks on each GPS fix before it goes into the
+            breadcrumb trail.
+
+            A GPS buffer overrun can produce a fix that parses correctly but
+            is nonsense: a date in the year 2000, latitude equal to longitude,
+            or a position hundreds of miles away. Once in the trail, it's saved
+            to flash and drawn as a stray pixel forever. So every fix is checked:
+              1. Timestamp is after Griduino's first release
+              2. Latitude/longitude are on Earth, and not lat==long
+              3. Enough satellites and a small enough HDOP, when the receiver reports them
+              4. Not a duplicate of, or older than, the previous accepted fix
+              5. The implied speed and acceleration from the previous accepted fix
+                 are possible for a car, or for an airliner
+
+            The simulator (MockModel) drives at up to 900 mph, so the speed limit
+            is generous; real buffer overruns jump much farther than that.
+
+            A long gap, such as a tunnel or a parked car, restarts the motion checks.
+            So does a run of stale or motion rejections, in case the previous
+            accepted fix was itself bad or the receiver's clock stepped backward,
+            so one bad fix can never lock out all the good ones.
+
+            Console command "show rejects" reports the counters.
+*/
+
+#include <Arduino.h>          //
+#include <TimeLib.h>          // time_t=seconds since Jan 1, 1970, https://github.com/PaulStoffregen/Time
+#include "constants.h"        // Griduino constants, colors, typedefs
+#include "logger.h"           // conditional printing to Serial port
+#include "grid_helper.h"      // lat/long conversion routines
+
+// ========== extern ===========================================
+extern Logger logger;   // Griduino.ino
+extern Grids grid;      // grid_helper.h
+
+// ========== constants ========================================
+enum FixReason {
+  eFixAccepted = 0,
+  eFixBeforeRelease,   // timestamp before Griduino existed, e.g. year 2000
+  eFixBadLatLong,      // off the Earth, NaN, or lat==long
+  eFixFewSatellites,   // too few satellites in use
+  eFixHighHDOP,        // poor geometry
+  eFixRepeated,        // same time and place as previous fix
+  eFixStale,           // older than previous fix
+  eFixTooFast,         // implied speed is impossible
+  eFixAcceleration,    // implied change in speed is impossible
+  FIX_REASONS,         // number of reasons, must be last
+};
+
+// ========== class FixValidator ===============================
+class FixValidator {
+public:
+#define FIX_MIN_SATELLITES 3        // fewest satellites for a 2D fix
+#define FIX_MAX_HDOP       10.0     // "poor" or worse
+#define FIX_MAX_SPEED      536.0    // meters/sec, 1200 mph
+#define FIX_MAX_ACCEL      25.0     // meters/sec/sec, about 2.5 g
+#define FIX_ACCEL_SECS     2        // shortest interval for a meaningful acceleration
+#define FIX_RESTART_SECS   600      // after this gap, don't compare with previous fix
+#define FIX_MAX_REJECTS    3        // after this many stale or motion rejections in a row, start over
+
+  uint32_t accepted            = 0;     // fixes that passed every check
+  uint32_t rejected[FIX_REASONS] = {0};   // fixes that failed, by reason
+
+  static const char *reasonName(int reason) {
+    static const char *const names[FIX_REASONS] = {
+        "accepted", "before release", "bad lat/long", "few satellites", "high HDOP",
+        "repeated", "stale", "too fast", "acceleration"};
+    return (reason >= 0 && reason < FIX_REASONS) ? names[reason] : "?";
+  }
+
+  // check one fix, and if accepted, it becomes the reference for the next one
+  // vHDOP = 0 and vLoc.numSatellites = 0 mean "not reported", e.g. the simulator
+  FixReason check(const Location &vLoc, float vHDOP, time_t cutoff) {
+    FixReason reason = validate(vLoc, vHDOP, cutoff);
+    if (reason == eFixAccepted) {
+      accepted++;
+      referenceRejects = 0;
+    } else {
+      rejected[reason]++;
+      if (reason == eFixStale || reason == eFixTooFast || reason == eFixAcceleration) {
+        if (++referenceRejects >= FIX_MAX_REJECTS) {
+          // the reference fix may have been the bad one, or the clock went backward
+          logger.log(GPS_SETUP, WARNING, "Fix validator restarted after %d rejections", referenceRejects);
+          restart();
+        }
+      }
+    }
+    return reason;
+  }
+
+  // forget the reference fix, e.g. after clearing the trail or changing the data source
+  void restart() {
+    havePrev         = false;
+    prevSpeed        = -1.0;
+    referenceRejects = 0;
+  }
+
+  void resetCounters() {
+    accepted = 0;
+    memset(rejected, 0, sizeof(rejected));
+  }
+
+  uint32_t totalRejected() const {
+    uint32_t total = 0;
+    for (int ii = 0; ii < FIX_REASONS; ii++) {
+      total += rejected[ii];
+    }
+    return total;
+  }
+
+  void report() {
+    char msg[64];
+    snprintf(msg, sizeof(msg), "Breadcrumbs: %lu accepted, %lu rejected",
+             (unsigned long)accepted, (unsigned long)totalRejected());
+    logger.log(GPS_SETUP, CONSOLE, msg);
+    for (int ii = 1; ii < FIX_REASONS; ii++) {
+      if (rejected[ii]) {
+        snprintf(msg, sizeof(msg), ". %-15s %lu", reasonName(ii), (unsigned long)rejected[ii]);
+        logger.log(GPS_SETUP, CONSOLE, msg);
+      }
+    }
+  }
+
+protected:
+  bool havePrev        = false;   // true = prev is a trustworthy reference
+  Location prev;                  // most recent accepted fix
+  float prevSpeed      = -1.0;    // implied speed arriving at prev, meters/sec, or -1 if unknown
+  int referenceRejects = 0;       // consecutive rejections measured against prev: stale, speed or acceleration
+
+  FixReason validate(const Location &vLoc, float vHDOP, time_t cutoff) {
+    if (vLoc.timestamp <= cutoff) {
+      return eFixBeforeRelease;
+    }
+    // written so that NaN fails the test
+    if (!(fabs(vLoc.loc.lat) <= 90.0 && fabs(vLoc.loc.lng) <= 180.0) || vLoc.loc.lat == vLoc.loc.lng) {
+      return eFixBadLatLong;
+    }
+    if (vLoc.numSatellites > 0 && vLoc.numSatellites < FIX_MIN_SATELLITES) {
+      return eFixFewSatellites;
+    }
+    if (vHDOP > FIX_MAX_HDOP) {
+      return eFixHighHDOP;
+    }
+    if (!havePrev) {
+      accept(vLoc, -1.0);
+      return eFixAccepted;
+    }
+
+    if (vLoc.timestamp == prev.timestamp && vLoc.loc.lat == prev.loc.lat && vLoc.loc.lng == prev.loc.lng) {
+      return eFixRepeated;
+    }
+    if (vLoc.timestamp < prev.timestamp) {
+      return eFixStale;
+    }
+    time_t elapsed = vLoc.timestamp - prev.timestamp;
+    if (elapsed > FIX_RESTART_SECS) {
+      accept(vLoc, -1.0);   // too long ago to compare, e.g. after a tunnel
+      return eFixAccepted;
+    }
+
+    // time_t has whole seconds, and at 5 or 10 Hz several fixes share the same second,
+    // so a one-second interval may really be anything up to two seconds
+    float seconds = (elapsed < 1) ? 1.0 : (float)elapsed;
+    float meters  = grid.calcDistance(prev.loc.lat, prev.loc.lng, vLoc.loc.lat, vLoc.loc.lng, true) * 1000.0;
+    float speed   = meters / seconds;
+    if (speed > FIX_MAX_SPEED) {
+      return eFixTooFast;
+    }
+    if (elapsed < FIX_ACCEL_SECS) {
+      accept(vLoc, -1.0);   // too short to measure speed well
+      return eFixAccepted;
+    }
+    // allow for the same whole-second rounding in the speed itself
+    if (prevSpeed >= 0.0 && fabs(speed - prevSpeed) > FIX_MAX_ACCEL * seconds + speed / seconds) {
+      return eFixAcceleration;
+    }
+    accept(vLoc, speed);
+    return eFixAccepted;
+  }
+
+  void accept(const Location &vLoc, float vSpeed) {
+    prev      = vLoc;
+    prevSpeed = vSpeed;
+    havePrev  = true;
+  }
+
+};   // end class FixValidator
@@ -0,0 +1,125 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     format_helper.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Number to text conversion without the heap, and a line-ending
+            trim shared by the console commands and the unit tests.
+
+            Arduino's String(value, places) allocates on every call, and we
+            format numbers six times per breadcrumb when saving the trail and
+            again on every screen update. These write into the caller's buffer
+            instead, and never call malloc. This is about heap churn, not about
+            the size of the sketch, which was not measured.
+
+            The output is character-for-character the same as String(value, places),
+            which is dtostrf() underneath, i.e. printf("%*.*f", places+2, places, value).
+            That means correctly rounded (ties to even on the exact binary value),
+            "-0.0" for small negative numbers, and a leading space on one-digit
+            numbers with zero decimal places, e.g. " 5".
+
+            Values too large for 64-bit integer arithmetic, and NaN and infinity,
+            are rare enough that they simply fall back to snprintf().
+
+            verifyFormatting() compares the output with String() and snprintf(),
+            and requires the heap in use to be unchanged after 10,000 calls.
+            It runs on the device with "run modeltest" and on the desktop in
+            extras/host_test. "run benchmark" and "make bench" time
+            floatToCharArray against the old String version.
+*/
+
+#include <Arduino.h>   // for uint64_t
+#include <math.h>      // for fma(), floor()
+
+// ----- integer to text, like snprintf("%ld")
+// Returns the number of characters written, excluding the null.
+// Output is truncated (but always null-terminated) if maxlen is too small.
+inline int intToChars(char *result, int maxlen, long value) {
+  char digits[12];   // "-2147483648" plus null
+  int nn            = 0;
+  unsigned long mag = (value < 0) ? 0UL - (unsigned long)value : (unsigned long)value;
+  do {
+    digits[nn++] = '0' + (mag % 10);
+    mag /= 10;
+  } while (mag);
+  if (value < 0) {
+    digits[nn++] = '-';
+  }
+
+  int len = 0;
+  while (nn > 0 && len < maxlen - 1) {
+    result[len++] = digits[--nn];
+  }
+  if (maxlen > 0) {
+    result[len] = 0;
+  }
+  return len;
+}
+
+// ----- fixed-point decimal to text, same as String(value, places).toCharArray(result, maxlen)
+inline char *fixedToChars(char *result, int maxlen, double value, int places) {
+  static const uint64_t pow10[] = {1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL,
+                                   100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL};
+  if (maxlen <= 0) {
+    return result;
+  }
+  if (places < 0) {
+    places = 0;
+  }
+
+  char buf[34];   // same as the buffer inside String(double)
+  double mag     = fabs(value);
+  bool fastPath  = (places <= 9) && isfinite(value) && (mag < 9.0e15 / pow10[places]);
+  if (!fastPath) {
+    snprintf(buf, sizeof(buf), "%*.*f", places + 2, places, value);
+  } else {
+    // scale to an integer, then round exactly like printf does
+    double scale   = (double)pow10[places];
+    double product = mag * scale;                  // rounded product
+    double error   = fma(mag, scale, -product);    // exact product = product + error
+    double whole   = floor(product);
+    double excess  = (product - whole) - 0.5;      // both steps are exact
+    uint64_t nn    = (uint64_t)whole;
+    if (excess > -error || (excess == -error && (nn & 1))) {
+      nn++;   // above one-half, or exactly one-half and odd
+    }
+
+    // digits are written backwards from the end of buf
+    char *pp = buf + sizeof(buf) - 1;
+    *pp      = 0;
+    for (int ii = 0; ii < places; ii++) {
+      *--pp = '0' + (nn % 10);
+      nn /= 10;
+    }
+    if (places > 0) {
+      *--pp = '.';
+    }
+    do {
+      *--pp = '0' + (nn % 10);
+      nn /= 10;
+    } while (nn);
+    if (signbit(value)) {
+      *--pp = '-';
+    }
+    while ((buf + sizeof(buf) - 1) - pp < places + 2) {
+      *--pp = ' ';   // minimum field width, as in dtostrf()
+    }
+    memmove(buf, pp, (buf + sizeof(buf)) - pp);
+  }
+
+  strncpy(result, buf, maxlen - 1);
+  result[maxlen - 1] = 0;
+  return result;
+}
+
+// ----- remove 0x0d and 0x0a from character arrays, shortening the array in-place
+inline void removeCRLF(char *pBuffer) {
+  const char key[] = "\r\n";
+  char *pch        = strpbrk(pBuffer, key);
+  while (pch != NULL) {
+    memmove(pch, pch + 1, strlen(pch));   // strings overlap, so strcpy is not allowed
+    pch = strpbrk(pBuffer, key);
+  }
+}
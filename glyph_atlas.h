@@ -0,0 +1,173 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     glyph_atlas.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Draw the giant grid name ("CN87" and "us") as horizontal runs.
+
+            TextField erases the old text with fillRect, then Adafruit_GFX
+            draws the new text one pixel at a time. At 24 pt that is thousands
+            of single-pixel SPI transactions, and the erase makes it flicker.
+
+            GlyphAtlas reads the same glyph bitmaps (already in flash) one row
+            at a time, across the whole string, and writes each row as runs
+            of foreground and background color with writeFastHLine. The
+            background runs cover the previous text, so there is no erase pass.
+
+            The cell height is the tallest of A-X, a-x and 0-9, which is every
+            character a grid name can have, so every redraw covers the last one.
+            The width covers the wider of the old and new text.
+
+            Example:
+              GlyphAtlas bigFont(getFont(eFONTBIG));
+              GlyphField txtGrid4(bigFont, "CN77", 101, 101, cGRIDNAME);
+              txtGrid4.print("CN87");
+
+            "run benchmark" compares this with TextField on the real screen.
+*/
+
+#include <Arduino.h>            //
+#include <Adafruit_ILI9341.h>   // TFT color display library
+#include "constants.h"          // Griduino constants, colors, typedefs
+#include "TextField.h"          // Optimize TFT display text for proportional fonts
+
+// ========== extern ===========================================
+extern Adafruit_ILI9341 tft;   // Griduino.ino
+
+// ========== class GlyphAtlas =================================
+class GlyphAtlas {
+public:
+  const GFXfont *font;   // bitmaps and metrics, in flash
+  int8_t top;            // rows above the baseline (negative), tallest grid character
+  int8_t bottom;         // rows below the baseline, deepest grid character
+  uint32_t runs = 0;     // writeFastHLine calls since power-up
+
+  GlyphAtlas(const GFXfont *vFont)
+      : font(vFont), top(0), bottom(0) {
+    // measure every character a grid name can have
+    const char *ranges[] = {"AX", "ax", "09"};
+    for (const char *range : ranges) {
+      for (char cc = range[0]; cc <= range[1]; cc++) {
+        const GFXglyph *glyph = getGlyph(cc);
+        if (glyph) {
+          top    = min((int)top, (int)glyph->yOffset);
+          bottom = max((int)bottom, glyph->yOffset + glyph->height);
+        }
+      }
+    }
+  }
+
+  const GFXglyph *getGlyph(char cc) const {
+    if (!font || (uint8_t)cc < font->first || (uint8_t)cc > font->last) {
+      return nullptr;
+    }
+    return &font->glyph[(uint8_t)cc - font->first];
+  }
+
+  int textWidth(const char *pText) const {
+    int width = 0;
+    for (; *pText; pText++) {
+      const GFXglyph *glyph = getGlyph(*pText);
+      if (glyph) {
+        width += glyph->xAdvance;
+      }
+    }
+    return width;
+  }
+
+  // draw text with its left edge at x0, covering at least minWidth pixels
+  // returns the width of the text
+  int blit(const char *pText, int x0, int baseline, int minWidth, uint16_t fg, uint16_t bg) {
+    int width = textWidth(pText);
+    int right = x0 + max(width, minWidth);   // one past the last column to write
+
+    tft.startWrite();
+    for (int row = top; row < bottom; row++) {
+      RunWriter out{this, baseline + row, x0, x0, false, fg, bg};
+      int cursor = x0;
+      for (const char *pc = pText; *pc; pc++) {
+        const GFXglyph *glyph = getGlyph(*pc);
+        if (!glyph) {
+          continue;
+        }
+        int glyphRow = row - glyph->yOffset;
+        if (glyphRow >= 0 && glyphRow < glyph->height) {
+          const uint8_t *bits = font->bitmap + glyph->bitmapOffset;
+          int bit             = glyphRow * glyph->width;
+          for (int col = 0; col < glyph->width; col++, bit++) {
+            int xx = cursor + glyph->xOffset + col;
+            if (xx < out.next || xx >= right) {
+              continue;   // overlaps the previous glyph, or outside the cell
+            }
+            out.extendTo(xx, false);   // background between glyphs
+            out.extendTo(xx + 1, bits[bit >> 3] & (0x80 >> (bit & 7)));
+          }
+        }
+        cursor += glyph->xAdvance;
+      }
+      out.extendTo(right, false);   // background to the end of the old text
+      out.flush();
+    }
+    tft.endWrite();
+    return width;
+  }
+
+protected:
+  // collects pixels of one row into runs of the same color
+  struct RunWriter {
+    GlyphAtlas *atlas;
+    int yy;
+    int start;   // first column of the current run
+    int next;    // first column not yet in a run
+    bool ink;    // color of the current run
+    uint16_t fg, bg;
+
+    void extendTo(int xx, bool vInk) {
+      if (xx <= next) {
+        return;
+      }
+      if (vInk != ink) {
+        flush();
+        start = next;
+        ink   = vInk;
+      }
+      next = xx;
+    }
+    void flush() {
+      if (next > start) {
+        tft.writeFastHLine(start, yy, next - start, ink ? fg : bg);
+        atlas->runs++;
+      }
+      start = next;
+    }
+  };
+};   // end class GlyphAtlas
+
+// ========== class GlyphField =================================
+// A TextField that draws through a GlyphAtlas, left aligned
+class GlyphField : public TextField {
+public:
+  GlyphAtlas &atlas;
+
+  template <size_t N>
+  GlyphField(GlyphAtlas &vAtlas, const char (&vtxt)[N], int vxx, int vyy, uint16_t vcc)
+      : TextField(vtxt, vxx, vyy, vcc), atlas(vAtlas) {}
+
+  void print(const char *pText) {
+    uint32_t hashNew = hash(pText);
+    if (dirty || hashNew != hashPrev) {
+      int width = atlas.blit(pText, x, y, wPrev, color, cBackground);
+      xPrev     = x;
+      yPrev     = y + atlas.top;
+      wPrev     = width;
+      hPrev     = atlas.bottom - atlas.top;
+      hashPrev  = hashNew;
+      dirty     = false;
+    }
+  }
+  void print() {
+    print(label);
+  }
+};   // end class GlyphField
@@ -0,0 +1,318 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     gnss_stats.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Multi-constellation GNSS: which satellite systems the receiver
+            searches, and statistics for each system.
+
+            The Quectel L86 can use GPS, GLONASS, Galileo and QZSS together,
+            which gives faster fixes and better geometry in urban canyons and
+            mountain passes. Griduino has always searched GPS only, so that
+            is still the default. Select the mode on the GPS settings screen.
+
+            The Adafruit_GPS library parses RMC and GGA from any talker
+            ($GP, $GN, $GL, $GA...) but ignores GSV and GSA. This parses those
+            two for each constellation:
+              GSV = satellites in view, with signal-to-noise ratio (SNR)
+              GSA = satellites used in the fix
+
+            Time to first fix (TTFF) is measured from power-up and saved for
+            each mode, so the modes can be compared across several power-ups.
+
+            Console command "show gnss" reports everything.
+*/
+
+#include <Arduino.h>          //
+#include <Adafruit_GPS.h>     // "Ultimate GPS" library
+#include "constants.h"        // Griduino constants, colors, typedefs
+#include "logger.h"           // conditional printing to Serial port
+#include "nmea_helper.h"      // NMEA sentence checksums
+#include "save_restore.h"     // Configuration data in nonvolatile RAM
+
+// ========== extern ===========================================
+extern Adafruit_GPS GPS;   // Griduino.ino
+extern Logger logger;      // Griduino.ino
+
+// ========== constants ========================================
+enum GnssSystem {
+  eGNSS_GPS = 0,
+  eGNSS_GLONASS,
+  eGNSS_GALILEO,
+  eGNSS_BEIDOU,
+  eGNSS_QZSS,
+  GNSS_SYSTEMS,   // number of systems, must be last
+};
+
+enum GnssMode {
+  eGNSS_GPS_ONLY = 0,   // power-on default, same as earlier releases
+  eGNSS_GPS_GLONASS,    //
+  eGNSS_ALL,            // GPS + GLONASS + Galileo
+  GNSS_MODES,           // number of modes, must be last
+};
+
+// ========== struct GnssCounts ================================
+// one snapshot of per-constellation statistics, small enough to keep a history
+struct GnssCounts {
+  uint8_t inView[GNSS_SYSTEMS] = {0};   // satellites in view
+  uint8_t used[GNSS_SYSTEMS]   = {0};   // satellites used in fix
+  uint8_t snr[GNSS_SYSTEMS]    = {0};   // average SNR of satellites in view, dB-Hz
+};
+
+// ========== class GnssStats ==================================
+class GnssStats {
+public:
+#define GNSS_CONFIG_FILE    CONFIG_FOLDER "/gnss.cfg"   // must be 8.3 filename
+#define GNSS_CONFIG_VERSION "GNSS v1"
+#define GNSS_STALE_MSEC     5000   // forget a system that hasn't reported in this long
+#define GNSS_MAX_FIELDS     24     // GSA has 18 or 19 fields, GSV has up to 21
+
+  GnssMode mode = eGNSS_GPS_ONLY;
+  uint16_t ttffSeconds[GNSS_MODES] = {0};   // most recent time to first fix in each mode, 0 = never measured
+
+  static const char *systemName(int sys) {
+    static const char *const names[GNSS_SYSTEMS] = {"GPS", "GLONASS", "Galileo", "BeiDou", "QZSS"};
+    return (sys >= 0 && sys < GNSS_SYSTEMS) ? names[sys] : "?";
+  }
+  static const char *modeName(int vMode) {
+    static const char *const names[GNSS_MODES] = {"GPS only", "GPS+GLONASS", "GPS+GLO+GAL"};
+    return (vMode >= 0 && vMode < GNSS_MODES) ? names[vMode] : "?";
+  }
+
+  // tell the receiver which systems to search, returns 1=success, 0=unknown mode
+  int apply(int vMode) {
+    if (vMode < 0 || vMode >= GNSS_MODES) {
+      return 0;
+    }
+    mode = (GnssMode)vMode;
+    //                                   GPS, GLONASS, Galileo, Galileo full, BeiDou
+    static const char *const pmtk353[GNSS_MODES] = {"PMTK353,1,0,0,0,0",
+                                                    "PMTK353,1,1,0,0,0",
+                                                    "PMTK353,1,1,1,0,0"};
+    char cmd[NMEA_MAX_LENGTH];
+    Nmea::makeSentence(cmd, sizeof(cmd), "%s", pmtk353[mode]);
+    logger.log(GPS_SETUP, INFO, "Search satellites: %s", modeName(mode));
+    logger.log(GPS_SETUP, INFO, cmd);   // echo command to console
+    GPS.sendCommand(cmd);
+    delay(50);
+    return 1;
+  }
+
+  // parse GSV and GSA, returns true if the sentence was one of ours
+  bool parse(const char *nmea) {
+    bool isGSV = Nmea::isType(nmea, "GSV");
+    bool isGSA = Nmea::isType(nmea, "GSA");
+    if ((!isGSV && !isGSA) || !Nmea::isChecksumValid(nmea)) {
+      return false;
+    }
+    char buf[NMEA_MAX_LENGTH];
+    strncpy(buf, nmea, sizeof(buf) - 1);
+    buf[sizeof(buf) - 1] = 0;
+    char *fields[GNSS_MAX_FIELDS];
+    int count = splitFields(buf, fields, GNSS_MAX_FIELDS);
+    return isGSV ? parseGSV(nmea, fields, count) : parseGSA(nmea, fields, count);
+  }
+
+  // snapshot of current statistics, systems that stopped reporting are zero
+  GnssCounts current() {
+    GnssCounts result;
+    uint32_t nowMillis = millis();
+    for (int ii = 0; ii < GNSS_SYSTEMS; ii++) {
+      if (nowMillis - inViewStamp[ii] < GNSS_STALE_MSEC) {
+        result.inView[ii] = latest.inView[ii];
+        result.snr[ii]    = latest.snr[ii];
+      }
+      if (nowMillis - usedStamp[ii] < GNSS_STALE_MSEC) {
+        result.used[ii] = latest.used[ii];
+      }
+    }
+    return result;
+  }
+
+  // call on every pass through loop(), returns true once, at the first fix
+  bool checkFirstFix(bool haveFix) {
+    if (ttffDone || !haveFix) {
+      return false;
+    }
+    ttffDone = true;
+    int seconds = millis() / 1000;   // since power-up
+    int prev    = ttffSeconds[mode];
+    ttffSeconds[mode] = seconds;
+    saveConfig();
+
+    char msg[100];
+    snprintf(msg, sizeof(msg), "Time to first fix %d sec with %s (previous %d sec)", seconds, modeName(mode), prev);
+    logger.log(GPS_SETUP, INFO, msg);
+    reportTTFF(INFO);
+    return true;
+  }
+  int firstFixSeconds() const {
+    return ttffSeconds[mode];
+  }
+
+  void report() {
+    GnssCounts counts = current();
+    char msg[100];
+    snprintf(msg, sizeof(msg), "Searching %s", modeName(mode));
+    logger.log(GPS_SETUP, CONSOLE, msg);
+    for (int ii = 0; ii < GNSS_SYSTEMS; ii++) {
+      if (counts.inView[ii] || counts.used[ii]) {
+        snprintf(msg, sizeof(msg), "%-8s %2d in view, %2d used, average SNR %2d dB-Hz",
+                 systemName(ii), counts.inView[ii], counts.used[ii], counts.snr[ii]);
+        logger.log(GPS_SETUP, CONSOLE, msg);
+      }
+    }
+    reportTTFF(CONSOLE);
+  }
+
+  // ----- persistence, same as other settings
+  void loadConfig() {
+    SaveRestore config(GNSS_CONFIG_FILE, GNSS_CONFIG_VERSION);
+    uint16_t saved[1 + GNSS_MODES];   // mode, then TTFF of each mode
+    if (config.readConfig((byte *)saved, sizeof(saved))) {
+      if (saved[0] < GNSS_MODES) {
+        mode = (GnssMode)saved[0];
+        memcpy(ttffSeconds, saved + 1, sizeof(ttffSeconds));
+      }
+    }
+  }
+  void saveConfig() {
+    SaveRestore config(GNSS_CONFIG_FILE, GNSS_CONFIG_VERSION);
+    uint16_t saved[1 + GNSS_MODES];
+    saved[0] = mode;
+    memcpy(saved + 1, ttffSeconds, sizeof(ttffSeconds));
+    config.writeConfig((byte *)saved, sizeof(saved));
+  }
+
+protected:
+  GnssCounts latest;                       // most recent complete report of each system
+  uint32_t inViewStamp[GNSS_SYSTEMS] = {0};   // millis() of latest GSV group
+  uint32_t usedStamp[GNSS_SYSTEMS]   = {0};   // millis() of latest GSA
+  uint16_t snrSum[GNSS_SYSTEMS]      = {0};   // GSV group in progress
+  uint8_t snrCount[GNSS_SYSTEMS]     = {0};   //
+  bool ttffDone                      = false;
+
+  void reportTTFF(LogLevel level) {
+    for (int ii = 0; ii < GNSS_MODES; ii++) {
+      if (ttffSeconds[ii]) {
+        char msg[48];
+        snprintf(msg, sizeof(msg), "TTFF %s = %d sec", modeName(ii), ttffSeconds[ii]);
+        logger.log(GPS_SETUP, level, msg);
+      }
+    }
+  }
+
+  // split "$GPGSV,3,1,11,...*hh" in place, empty fields are kept
+  static int splitFields(char *buf, char *fields[], int maxFields) {
+    char *star = strchr(buf, '*');
+    if (star) {
+      *star = 0;
+    }
+    int count = 0;
+    char *pp  = buf + 1;   // skip '$'
+    while (count < maxFields) {
+      fields[count++] = pp;
+      pp              = strchr(pp, ',');
+      if (!pp) {
+        break;
+      }
+      *pp++ = 0;
+    }
+    return count;
+  }
+
+  // which system sent this sentence, from its talker ID, or -1 for "GN" (combined)
+  static int systemFromTalker(const char *nmea) {
+    static const char talkers[] = "GPGLGAGBGQ";   // same order as GnssSystem
+    for (int ii = 0; ii < GNSS_SYSTEMS; ii++) {
+      if (nmea[1] == talkers[ii * 2] && nmea[2] == talkers[ii * 2 + 1]) {
+        return ii;
+      }
+    }
+    if (strncmp(nmea + 1, "BD", 2) == 0) {
+      return eGNSS_BEIDOU;
+    }
+    return -1;
+  }
+
+  // NMEA satellite ID ranges, for "$GN" sentences without a system ID field
+  static int systemFromPRN(int prn) {
+    if (prn >= 1 && prn <= 64) {
+      return eGNSS_GPS;   // including SBAS 33-64
+    } else if (prn >= 65 && prn <= 96) {
+      return eGNSS_GLONASS;
+    } else if (prn >= 193 && prn <= 200) {
+      return eGNSS_QZSS;
+    } else if (prn >= 201 && prn <= 263) {
+      return eGNSS_BEIDOU;
+    } else if (prn >= 301 && prn <= 336) {
+      return eGNSS_GALILEO;
+    }
+    return -1;
+  }
+
+  bool parseGSV(const char *nmea, char *fields[], int count) {
+    // GSV,total messages,message number,satellites in view,{PRN,elevation,azimuth,SNR}...
+    if (count < 4) {
+      return false;
+    }
+    int total = atoi(fields[1]);
+    int msgNo = atoi(fields[2]);
+    int sys   = systemFromTalker(nmea);
+    if (sys < 0 && count >= 5) {
+      sys = systemFromPRN(atoi(fields[4]));
+    }
+    if (sys < 0 || msgNo < 1 || msgNo > total) {
+      return false;
+    }
+    if (msgNo == 1) {
+      snrSum[sys]   = 0;
+      snrCount[sys] = 0;
+    }
+    for (int ii = 4; ii + 3 < count; ii += 4) {
+      int snr = atoi(fields[ii + 3]);   // empty = not tracking
+      if (fields[ii][0] && snr > 0) {
+        snrSum[sys] += snr;
+        snrCount[sys]++;
+      }
+    }
+    if (msgNo == total) {
+      latest.inView[sys] = constrain(atoi(fields[3]), 0, 255);
+      latest.snr[sys]    = snrCount[sys] ? snrSum[sys] / snrCount[sys] : 0;
+      inViewStamp[sys]   = millis();
+    }
+    return true;
+  }
+
+  bool parseGSA(const char *nmea, char *fields[], int count) {
+    // GSA,mode,fix type,12 x PRN,PDOP,HDOP,VDOP[,system ID]
+    if (count < 15) {
+      return false;
+    }
+    int sys = systemFromTalker(nmea);
+    if (sys < 0 && count >= 19 && fields[18][0]) {
+      sys = atoi(fields[18]) - 1;   // NMEA 4.1: 1=GPS, 2=GLONASS, 3=Galileo, 4=BeiDou, 5=QZSS
+    }
+    int used = 0;
+    for (int ii = 3; ii < 15; ii++) {
+      if (fields[ii][0]) {
+        if (sys < 0) {
+          sys = systemFromPRN(atoi(fields[ii]));
+        }
+        used++;
+      }
+    }
+    if (sys < 0 || sys >= GNSS_SYSTEMS) {
+      return used == 0;   // "$GNGSA,A,1,,,,..." is valid but says nothing
+    }
+    latest.used[sys] = used;
+    usedStamp[sys]   = millis();
+    return true;
+  }
+
+};   // end class GnssStats
+
+// ========== extern ===========================================
+extern GnssStats gnss;   // Griduino.ino
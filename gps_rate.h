@@ -0,0 +1,242 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     gps_rate.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Optional high-rate GPS mode, 5 or 10 fixes per second.
+
+            At 1 Hz and highway speed, the position can be 30 meters stale exactly
+            when a grid line matters on a microwave rove. In high-rate mode:
+            1. The receiver sends RMC and GGA at 5 or 10 Hz (PMTK314, PMTK220, PMTK300).
+               GSA and GSV go out only every GPS_SATELLITE_DIVISOR fixes, so the
+               satellite view still updates once or twice a second.
+            2. The baud rate is the slowest that keeps the UART under half full (PMTK251).
+            3. Every RMC goes straight from the parser into the model, so the grid
+               crossing detectors in loop() see every fix instead of one per 13 seconds.
+               This applies only to the live receiver; the simulator and replay
+               models keep their own pace.
+            4. Gaps in the fix timestamps are counted as dropped fixes.
+
+            At startup, check() logs the UART byte budget, how many msec of NMEA
+            the serial receive buffer can hold, and the CPU time needed to parse
+            every fix, so an impossible configuration shows up in the log.
+
+            The Quectel L86 (MediaTek) receiver keeps its baud rate while the
+            coin battery lasts, so changing baud rate is sent at both 9600 and
+            our previous baud rate.
+
+            Console commands: "set gps 1hz", "set gps 5hz", "set gps 10hz", "show gps rate"
+*/
+
+#include <Arduino.h>          //
+#include <Adafruit_GPS.h>     // "Ultimate GPS" library
+#include "constants.h"        // Griduino constants, colors, typedefs
+#include "logger.h"           // conditional printing to Serial port
+#include "grid_helper.h"      // lat/long conversion routines
+#include "nmea_helper.h"      // NMEA sentence checksums
+#include "save_restore.h"     // Configuration data in nonvolatile RAM
+
+// ========== extern ===========================================
+extern Adafruit_GPS GPS;   // Griduino.ino
+extern Logger logger;      // Griduino.ino
+extern Grids grid;         // grid_helper.h
+
+// ========== class GpsRate ====================================
+class GpsRate {
+public:
+#define GPS_RATE_CONFIG_FILE    CONFIG_FOLDER "/gpsrate.cfg"   // must be 8.3 filename
+#define GPS_RATE_CONFIG_VERSION "GPS Rate v1"
+#define NMEA_BYTES_PER_FIX      150   // RMC + GGA with CRLF, about 72 + 78 bytes
+#define NMEA_BYTES_SATELLITES   350   // GSA + 3 or 4 GSV, one complete set
+#define GPS_SATELLITE_DIVISOR   5     // GSA and GSV every 5th fix, the most PMTK314 allows
+
+  // ----- configuration
+  int hz   = 1;      // fixes per second: 1, 5 or 10
+  int baud = 9600;   // serial port to receiver
+
+  // ----- statistics
+  uint32_t fixes        = 0;   // RMC sentences parsed
+  uint32_t fixesDropped = 0;   // missing timestamps between consecutive fixes
+  uint32_t maxGapMillis = 0;   // longest interval between fixes
+
+  bool isHighRate() const {
+    return hz > 1;
+  }
+
+  // NMEA traffic from the receiver
+  static int bytesPerSecond(int vHz) {
+    int satelliteSets = (vHz > 1) ? vHz / GPS_SATELLITE_DIVISOR : 1;
+    return vHz * NMEA_BYTES_PER_FIX + satelliteSets * NMEA_BYTES_SATELLITES;
+  }
+
+  // slowest standard baud rate that keeps the UART under 50% busy
+  static int chooseBaud(int vHz) {
+    static const int rates[] = {9600, 19200, 38400, 57600, 115200};
+    if (vHz <= 1) {
+      return 9600;   // receiver's power-on default, as always
+    }
+    int bytesPerSec = bytesPerSecond(vHz);
+    for (unsigned int ii = 0; ii < sizeof(rates) / sizeof(rates[0]); ii++) {
+      if (bytesPerSec * 10 * 2 <= rates[ii]) {   // 10 bits per byte on the wire
+        return rates[ii];
+      }
+    }
+    return 115200;
+  }
+
+  // configure the receiver, returns 1=success, 0=unsupported rate
+  int apply(int vHz) {
+    if (vHz != 1 && vHz != 5 && vHz != 10) {
+      logger.log(GPS_SETUP, ERROR, "GPS rate %d Hz is not supported", vHz);
+      return 0;
+    }
+    int prevBaud = baud;
+    hz           = vHz;
+    baud         = chooseBaud(hz);
+    char cmd[NMEA_MAX_LENGTH];
+
+#if defined(DUAL_CORE)
+    rp2040.idleOtherCore();   // core 1 must not read the serial port while it changes speed
+#endif
+    // ----- baud rate first, sent at both the power-on rate and our previous rate
+    Nmea::makeSentence(cmd, sizeof(cmd), "PMTK251,%d", baud);
+    GPS.begin(9600);
+    delay(50);
+    send(cmd);
+    if (prevBaud != 9600) {
+      GPS.begin(prevBaud);
+      delay(50);
+      send(cmd);
+    }
+    GPS.begin(baud);
+    delay(50);
+#if defined(DUAL_CORE)
+    rp2040.resumeOtherCore();
+#endif
+
+    // ----- sentences: at high rate, satellites less often than fixes
+    if (isHighRate()) {
+      Nmea::makeSentence(cmd, sizeof(cmd), "PMTK314,0,1,0,1,%d,%d,0,0,0,0,0,0,0,0,0,0,0,0,0",
+                         GPS_SATELLITE_DIVISOR, GPS_SATELLITE_DIVISOR);
+    } else {
+      Nmea::makeSentence(cmd, sizeof(cmd), "PMTK314,0,1,0,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0");   // same as PMTK_SENTENCE_FREQUENCIES
+    }
+    send(cmd);
+
+    // ----- position fix interval, then NMEA output interval
+    int msec = 1000 / hz;
+    Nmea::makeSentence(cmd, sizeof(cmd), "PMTK300,%d,0,0,0,0", msec);
+    send(cmd);
+    Nmea::makeSentence(cmd, sizeof(cmd), "PMTK220,%d", msec);
+    send(cmd);
+
+    resetStats();
+    check();
+    return 1;
+  }
+
+  // log the byte budget and CPU budget for the current rate
+  void check() {
+    char msg[100];
+    int bytesPerSec = bytesPerSecond(hz);
+    int uartPercent = bytesPerSec * 10 * 100 / baud;
+    snprintf(msg, sizeof(msg), "GPS %d Hz at %d baud: %d bytes/sec, UART %d%% busy",
+             hz, baud, bytesPerSec, uartPercent);
+    logger.log(GPS_SETUP, INFO, msg);
+
+#ifdef SERIAL_BUFFER_SIZE
+    int bufferMillis = SERIAL_BUFFER_SIZE * 10 * 1000 / baud;
+    snprintf(msg, sizeof(msg), "Serial buffer holds %d msec of NMEA, a slower loop() drops sentences", bufferMillis);
+    logger.log(GPS_SETUP, INFO, msg);
+#endif
+
+    int usecPerFix = measureFixMicros();
+    snprintf(msg, sizeof(msg), "Parse + grid detector = %d usec/fix, %d.%d%% CPU at %d Hz",
+             usecPerFix, usecPerFix * hz / 10000, (usecPerFix * hz / 1000) % 10, hz);
+    logger.log(GPS_SETUP, INFO, msg);
+    if (uartPercent > 50 || usecPerFix * hz > 200000) {
+      logger.log(GPS_SETUP, WARNING, "GPS rate exceeds budget, fixes will be dropped");
+    }
+  }
+
+  // call for every RMC sentence, with its timestamp in msec since midnight
+  void onFix(uint32_t msecOfDay) {
+    if (fixes > 0) {
+      uint32_t gap = (msecOfDay + SECS_PER_DAY * 1000 - prevFixMsec) % (SECS_PER_DAY * 1000);   // survives midnight
+      uint32_t period = 1000 / hz;
+      if (gap > maxGapMillis) {
+        maxGapMillis = gap;
+      }
+      if (gap > period + period / 2) {
+        fixesDropped += (gap + period / 2) / period - 1;   // e.g. 300 msec gap at 10 Hz = 2 dropped
+      }
+    }
+    prevFixMsec = msecOfDay;
+    fixes++;
+  }
+  void onFix(const Adafruit_GPS &source) {
+    onFix(((source.hour * 60UL + source.minute) * 60UL + source.seconds) * 1000UL + source.milliseconds);
+  }
+
+  void resetStats() {
+    fixes        = 0;
+    fixesDropped = 0;
+    maxGapMillis = 0;
+  }
+
+  void report() {
+    char msg[100];
+    snprintf(msg, sizeof(msg), "GPS %d Hz at %d baud: %lu fixes, %lu dropped, longest gap %lu msec",
+             hz, baud, (unsigned long)fixes, (unsigned long)fixesDropped, (unsigned long)maxGapMillis);
+    logger.log(GPS_SETUP, CONSOLE, msg);
+  }
+
+  // ----- persistence, same as other settings
+  void loadConfig() {
+    SaveRestore config(GPS_RATE_CONFIG_FILE, GPS_RATE_CONFIG_VERSION);
+    int saved[2] = {1, 9600};   // hz, baud
+    if (config.readConfig((byte *)saved, sizeof(saved))) {
+      if ((saved[0] == 1 || saved[0] == 5 || saved[0] == 10) && saved[1] >= 9600 && saved[1] <= 115200) {
+        hz   = saved[0];
+        baud = saved[1];   // receiver may still be at this rate, see apply()
+      }
+    }
+  }
+  void saveConfig() {
+    SaveRestore config(GPS_RATE_CONFIG_FILE, GPS_RATE_CONFIG_VERSION);
+    int saved[2] = {hz, baud};
+    config.writeConfig((byte *)saved, sizeof(saved));
+  }
+
+protected:
+  uint32_t prevFixMsec = 0;
+
+  void send(const char *cmd) {
+    logger.log(GPS_SETUP, INFO, cmd);   // echo command to console
+    GPS.sendCommand(cmd);
+    delay(50);
+  }
+
+  // time to parse one RMC and one GGA and run both grid detectors
+  int measureFixMicros() {
+    const int n = 20;
+    Adafruit_GPS parser;   // parse-only, does not touch the serial port
+    char rmc[] = "$GPRMC,123456.000,A,4745.6000,N,12215.0360,W,87.0,90.0,010623,,,A*7F";
+    char gga[] = "$GPGGA,123456.000,4745.6000,N,12215.0360,W,1,08,0.9,100.0,M,-20.0,M,,*62";
+    char grid6[7];
+    unsigned long start = micros();
+    for (int ii = 0; ii < n; ii++) {
+      parser.parse(rmc);
+      parser.parse(gga);
+      grid.calcLocator(grid6, parser.latitudeDegrees, parser.longitudeDegrees, 4);
+      grid.calcLocator(grid6, parser.latitudeDegrees, parser.longitudeDegrees, 6);
+    }
+    return (micros() - start) / n;
+  }
+
+};   // end class GpsRate
+
+// ========== extern ===========================================
+extern GpsRate gpsRate;   // Griduino.ino
@@ -79,6 +79,14 @@ public:
     return;
   }
 
+  static uint16_t squareIndex(double lat, double lon) {
+    // 4-char grid square as a number 0..32399, for lookup tables and sets
+    // column = 2 degrees of longitude, row = 1 degree of latitude
+    int col = constrain((int)floor((lon + 180.0) / 2.0), 0, 179);
+    int row = constrain((int)floor(lat + 90.0), 0, 179);
+    return col * 180 + row;
+  }
+
   //=========== distance helpers =============================
   bool isVisibleDistance(const PointGPS from, const PointGPS to) {
     // has the vehicle moved some minimum amount, enough to be visible?
@@ -0,0 +1,126 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     inter_core.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Lock-free ways to pass data between the two cores of an RP2040.
+
+            SpscQueue<T, N>   one core adds items, the other core takes them,
+                              in order. Neither core ever waits for the other.
+            Seqlock<T>        one core publishes a struct, the other reads a
+                              consistent copy of the latest version. The reader
+                              retries if it overlapped a write.
+
+            There are no mutexes, so a core that is busy or paused (e.g. while
+            the other core writes to flash) never blocks its partner.
+            Each item is copied in and out, so keep T small and plain: numbers,
+            arrays and structs, no pointers to memory that might change.
+
+            Written with the GCC __atomic built-ins, rather than <atomic>,
+            so it compiles the same on SAMD51 and RP2040. Only loads and
+            stores are used, which the Cortex-M0+ can do atomically.
+
+            No Arduino headers, so extras/host_test/inter_core_stress.cpp can
+            run both sides on two desktop threads under ThreadSanitizer.
+*/
+
+#include <stdint.h>   // uint32_t
+#include <string.h>   // memcpy
+
+// ========== class SpscQueue ==================================
+// single producer, single consumer, N-1 items fit since one slot is always empty
+template <typename T, int N>
+class SpscQueue {
+public:
+  // ----- producer side
+  bool push(const T &item) {
+    int head = __atomic_load_n(&headIndex, __ATOMIC_RELAXED);   // only the producer writes head
+    int next = (head + 1) % N;
+    if (next == __atomic_load_n(&tailIndex, __ATOMIC_ACQUIRE)) {
+      __atomic_store_n(&droppedCount, droppedCount + 1, __ATOMIC_RELAXED);   // only the producer writes it
+      return false;   // full, keep the older items
+    }
+    slots[head] = item;
+    __atomic_store_n(&headIndex, next, __ATOMIC_RELEASE);   // publish the item
+    return true;
+  }
+
+  // ----- consumer side
+  bool pop(T *item) {
+    int tail = __atomic_load_n(&tailIndex, __ATOMIC_RELAXED);   // only the consumer writes tail
+    if (tail == __atomic_load_n(&headIndex, __ATOMIC_ACQUIRE)) {
+      return false;   // empty
+    }
+    *item = slots[tail];
+    __atomic_store_n(&tailIndex, (tail + 1) % N, __ATOMIC_RELEASE);   // free the slot
+    return true;
+  }
+
+  // ----- either side, only a snapshot since the other core keeps going
+  int depth() const {
+    int head = __atomic_load_n(&headIndex, __ATOMIC_ACQUIRE);
+    int tail = __atomic_load_n(&tailIndex, __ATOMIC_ACQUIRE);
+    return (head - tail + N) % N;
+  }
+  uint32_t dropped() const {
+    return __atomic_load_n(&droppedCount, __ATOMIC_RELAXED);   // items lost to a full queue
+  }
+
+protected:
+  T slots[N];                  //
+  int headIndex         = 0;   // next slot to fill, written by the producer
+  int tailIndex         = 0;   // next slot to take, written by the consumer
+  uint32_t droppedCount = 0;   // written by the producer
+};   // end class SpscQueue
+
+// ========== class Seqlock ====================================
+// single writer, any number of readers
+template <typename T>
+class Seqlock {
+public:
+#define SEQLOCK_READ_TRIES 100   // give up instead of spinning forever on a stalled writer
+
+  // ----- writer side
+  void write(const T &value) {
+    uint32_t copy[words] = {0};
+    memcpy(copy, &value, sizeof(T));
+    uint32_t seq = __atomic_load_n(&sequence, __ATOMIC_RELAXED);
+    __atomic_store_n(&sequence, seq + 1, __ATOMIC_RELAXED);   // odd = write in progress
+    for (int ii = 0; ii < words; ii++) {
+      __atomic_store_n(&data[ii], copy[ii], __ATOMIC_RELEASE);   // a reader that sees this word also sees the odd sequence
+    }
+    __atomic_store_n(&sequence, seq + 2, __ATOMIC_RELEASE);   // even = finished
+  }
+
+  // ----- reader side
+  // returns false if it never got a clean copy, and then *value is unchanged
+  bool read(T *value) const {
+    uint32_t copy[words];
+    for (int tries = 0; tries < SEQLOCK_READ_TRIES; tries++) {
+      uint32_t before = __atomic_load_n(&sequence, __ATOMIC_ACQUIRE);
+      if (before & 1) {
+        continue;   // writer is busy
+      }
+      for (int ii = 0; ii < words; ii++) {
+        copy[ii] = __atomic_load_n(&data[ii], __ATOMIC_ACQUIRE);
+      }
+      if (__atomic_load_n(&sequence, __ATOMIC_RELAXED) == before) {
+        memcpy(value, copy, sizeof(T));
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // number of writes so far, 0 = never written
+  uint32_t version() const {
+    return __atomic_load_n(&sequence, __ATOMIC_ACQUIRE) / 2;
+  }
+
+protected:
+  static const int words = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+  uint32_t data[words] = {0};   // T, stored as words so each one is read and written atomically
+  uint32_t sequence    = 0;     // even = stable, odd = write in progress
+};   // end class Seqlock
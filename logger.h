@@ -16,6 +16,21 @@
                 void logGlobalOn();
                 void logGlobalOff();
 
+            Or the logging can be deferred. In deferred mode, each log() call
+            copies its format string address, timestamp and raw arguments into
+            a small RAM ring and returns immediately. The main loop calls
+            drain() when it is idle to format and send the records.
+
+            Binary mode also defers, but sends each record as a frame instead
+            of text. The format-ID is the address of the format string in flash,
+            so a host tool can decode the stream using the .elf from the same build.
+                0xA5, length, system, severity, kind, format-ID (4 bytes),
+                millis (4 bytes), raw arguments (length - 12 bytes)
+            The length byte counts the whole record after the sync byte, including itself.
+
+            The RAM ring costs LOG_RING_SIZE bytes, so it is only built when
+            LOG_DEFERRED_BUILD is 1. Otherwise log() always sends directly.
+
  ******************************************************************************
   Licensed under the GNU General Public License v3.0
 
@@ -63,11 +78,56 @@ enum LogSystem {
 };
 
 #include <Arduino.h>   // for "strncpy" and others
+#include <stdarg.h>    // for "va_list"
 #include "logger.h"    // conditional printing to Serial port
 
 // extern
 void floatToCharArray(char *result, int maxlen, double fValue, int decimalPlaces);   // Griduino.ino
 
+// ----- Delivery of log messages
+enum LogMode {
+  LOG_DIRECT = 0,   // format and send to Serial during the call (original behavior)
+  LOG_DEFERRED,     // save raw record in RAM ring, format it later in drain()
+  LOG_BINARY,       // save raw record in RAM ring, send it later as a binary frame
+};
+
+// ----- Deferred and binary modes need a RAM ring of LOG_RING_SIZE bytes.
+// Direct mode is the default at power-up, so the ring is left out unless asked for:
+//     #define LOG_DEFERRED_BUILD 1
+#ifndef LOG_DEFERRED_BUILD
+#define LOG_DEFERRED_BUILD 0
+#endif
+
+#define LOG_RING_SIZE   2048   // bytes, must be a power of two
+#define LOG_RECORD_SIZE 255    // bytes, largest possible record
+#define LOG_HEADER_SIZE 12     // bytes
+#define LOG_FRAME_SYNC  0xA5   // first byte of each binary frame
+
+// ----- Compile-time filtering
+// Messages below LOG_BUILD_LEVEL, or from a subsystem that is not in LOG_BUILD_SYSTEMS,
+// are removed by the compiler along with their format strings. The runtime switches
+// in printLevel[] and printSystem[] only apply to the messages that remain.
+// CONSOLE messages are always kept. Example for a release build:
+//     #define LOG_BUILD_LEVEL   INFO
+//     #define LOG_BUILD_SYSTEMS (LOG_ALL_SYSTEMS & ~LOG_SYSTEM(NMEA))
+// extras/host_test/log_build_check.cpp builds this example and checks that the
+// filtered messages leave nothing in the object file.
+#define LOG_SYSTEM(sys) (1UL << (sys))
+#define LOG_ALL_SYSTEMS ((1UL << numSystems) - 1)
+
+#ifndef LOG_BUILD_LEVEL
+#define LOG_BUILD_LEVEL DEBUG   // keep everything
+#endif
+#ifndef LOG_BUILD_SYSTEMS
+#define LOG_BUILD_SYSTEMS LOG_ALL_SYSTEMS
+#endif
+
+#define LOG_INLINE inline __attribute__((always_inline))
+
+constexpr bool logBuildEnabled(LogSystem system, LogLevel severity) {
+  return (severity == CONSOLE) || ((severity >= LOG_BUILD_LEVEL) && (LOG_BUILD_SYSTEMS & LOG_SYSTEM(system)));
+}
+
 struct systemDef {
   bool enabled;
   char name[5];
@@ -152,58 +212,61 @@ public:
   }
 
   // ----- general log: text-only
-  void log(LogSystem system, LogLevel severity, const char *pText) {
-    if (ok_to_log(system, severity)) {
-
-      printPrefix(system, severity);
-      if (strlen(pText) < 4) {
-        // allow caller to send up to this many newlines together
-        Serial.print(pText);
-      } else {
-        if (pText[strlen(pText) - 1] == '\n') {
-          // use the trailing newline from NEMA sentences from the GPS module
-          Serial.print(pText);
-        } else {
-          // add our own newline
-          Serial.println(pText);
-        }
-      }
+  LOG_INLINE void log(LogSystem system, LogLevel severity, const char *pText) {
+    if (logBuildEnabled(system, severity)) {
+      send(system, severity, pText);
     }
   }
 
   // ----- general log: text + text
-  void log(LogSystem system, LogLevel severity, const char *pFormat, const char *pStr) {
-    if (ok_to_log(system, severity)) {
-
-      printPrefix(system, severity);
-      char msg[256];
-      snprintf(msg, sizeof(msg), pFormat, pStr);
-      Serial.println(msg);
+  LOG_INLINE void log(LogSystem system, LogLevel severity, const char *pFormat, const char *pStr) {
+    if (logBuildEnabled(system, severity)) {
+      send(system, severity, pFormat, pStr);
     }
   }
 
   // ----- general log: text + text + text
-  void log(LogSystem system, LogLevel severity, const char *pFormat, const char *pStr1, const char *pStr2) {
-    if (ok_to_log(system, severity)) {
-
-      printPrefix(system, severity);
-      char msg[256];
-      snprintf(msg, sizeof(msg), pFormat, pStr1, pStr2);
-      Serial.println(msg);
+  LOG_INLINE void log(LogSystem system, LogLevel severity, const char *pFormat, const char *pStr1, const char *pStr2) {
+    if (logBuildEnabled(system, severity)) {
+      send(system, severity, pFormat, pStr1, pStr2);
     }
   }
 
   // ----- general log: text + number
-  void log(LogSystem system, LogLevel severity, const char *pFormat, const int value) {
-    if (ok_to_log(system, severity)) {
+  LOG_INLINE void log(LogSystem system, LogLevel severity, const char *pFormat, const int value) {
+    if (logBuildEnabled(system, severity)) {
+      send(system, severity, pFormat, value);
+    }
+  }
 
-      printPrefix(system, severity);
-      char msg[256];
-      snprintf(msg, sizeof(msg), pFormat, value);
-      Serial.println(msg);
+  // ----- general log: text + int + int
+  LOG_INLINE void log(LogSystem system, LogLevel severity, const char *pFormat, const int value1, const int value2) {
+    if (logBuildEnabled(system, severity)) {
+      send(system, severity, pFormat, value1, value2);
+    }
+  }
+
+  // ----- general log: text + float
+  LOG_INLINE void logFloat(LogSystem system, LogLevel severity, const char *pFormat, const float value1, const int decimalPlaces) {
+    if (logBuildEnabled(system, severity)) {
+      sendFloat(system, severity, pFormat, value1, decimalPlaces);
+    }
+  }
+
+  // ----- general log: text + float
+  LOG_INLINE void logTwoFloats(LogSystem system, LogLevel severity, const char *pFormat, const float value1, const int places1, const float value2, const int places2) {
+    if (logBuildEnabled(system, severity)) {
+      sendTwoFloats(system, severity, pFormat, value1, places1, value2, places2);
     }
   }
 
+  // ----- guard for code that prepares a message before logging it
+  // Example:  if (logger.enabled(GPS_SETUP, DEBUG)) { ...expensive formatting...; logger.log(GPS_SETUP, DEBUG, msg); }
+  // The compiler removes the whole block when the message is filtered out at build time.
+  LOG_INLINE bool enabled(LogSystem system, LogLevel severity) {
+    return logBuildEnabled(system, severity) && ok_to_log(system, severity);
+  }
+
   // ----- general log: text + hexadecimal
   /*
   void logHex(LogSystem system, LogLevel severity, const char *pFormat, const int value) {
@@ -222,6 +285,9 @@ public:
     if (severity == CONSOLE) {
       return true;
     }
+    if (!logBuildEnabled(system, severity)) {
+      return false;   // removed at build time, the runtime switches can't turn it back on
+    }
 
     if (log_enabled) {
       // check that this severity level AND system component is enabled
@@ -234,48 +300,56 @@ public:
     return false;
   }
 
-  // ----- general log: text + int + int
-  void log(LogSystem system, LogLevel severity, const char *pFormat, const int value1, const int value2) {
-    if (ok_to_log(system, severity)) {
-
-      printPrefix(system, severity);
-      char msg[256];
-      snprintf(msg, sizeof(msg), pFormat, value1, value2);
-      Serial.println(msg);
+  // ---------- deferred logging ----------
+  LogMode logMode         = LOG_DIRECT;
+  uint32_t recordsLogged  = 0;   // records accepted into ring
+  uint32_t recordsDropped = 0;   // records discarded because the ring was full
+  uint16_t ringHighWater  = 0;   // most bytes ever waiting in ring
+
+  // returns false if this build has no ring for deferred or binary mode
+  bool setMode(LogMode mode) {
+    flush();   // send anything already waiting in the old format
+    if (mode != LOG_DIRECT && !LOG_DEFERRED_BUILD) {
+      return false;
     }
+    logMode = mode;
+    return true;
   }
 
-  // ----- general log: text + float
-  void logFloat(LogSystem system, LogLevel severity, const char *pFormat, const float value1, const int decimalPlaces) {
-    if (ok_to_log(system, severity)) {
+  int pending() {
+#if LOG_DEFERRED_BUILD
+    return (ringHead - ringTail) & (LOG_RING_SIZE - 1);
+#else
+    return 0;
+#endif
+  }
 
-      // print 'error' and 'warning' if needed
-      printPrefix(system, severity);
+  // Format and send up to this many waiting records.
+  // Called from the main loop when there's nothing more urgent to do.
+  void drain(int maxRecords = 4) {
+#if LOG_DEFERRED_BUILD
+    for (int ii = 0; ii < maxRecords && pending() > 0; ii++) {
+      uint8_t rec[LOG_RECORD_SIZE];
+      int len = ringPeek(0);
+      for (int jj = 0; jj < len; jj++) {
+        rec[jj] = ringPeek(jj);
+      }
+      ringTail = (ringTail + len) & (LOG_RING_SIZE - 1);
 
-      // print the given text and value
-      char msg[256];
-      char sFloat[8];
-      floatToCharArray(sFloat, sizeof(sFloat), value1, decimalPlaces);
-      snprintf(msg, sizeof(msg), pFormat, sFloat);
-      Serial.println(msg);
+      if (logMode == LOG_BINARY) {
+        Serial.write((uint8_t)LOG_FRAME_SYNC);
+        Serial.write(rec, len);
+      } else {
+        emitRecord(rec, len);
+      }
     }
+#endif
   }
 
-  // ----- general log: text + float
-  void logTwoFloats(LogSystem system, LogLevel severity, const char *pFormat, const float value1, const int places1, const float value2, const int places2) {
-    if (ok_to_log(system, severity)) {
-
-      // print 'error' and 'warning' if needed
-      printPrefix(system, severity);
-
-      // print the given text and value
-      char sFloat1[8], sFloat2[8];
-      floatToCharArray(sFloat1, sizeof(sFloat1), value1, places1);
-      floatToCharArray(sFloat2, sizeof(sFloat2), value2, places2);
-
-      char msg[256];
-      snprintf(msg, sizeof(msg), pFormat, sFloat1, sFloat2);
-      Serial.println(msg);
+  // Send everything that is waiting
+  void flush() {
+    while (pending() > 0) {
+      drain(LOG_RING_SIZE);
     }
   }
 
@@ -295,24 +369,19 @@ public:
   }
 
   // ----- debug statements to confirm a certain line of code is executed
-  void fencepost(const char *pModule, const int lineno) {
-    // const LogSystem sys = FENCE;
-    // const LogLevel sev = POST;
-    // if (ok_to_log(sys, sev)) {
-    //   printPrefix(sys, sev);
-    //  example output: "Griduino.ino[123]"
-    char msg[128];
-    snprintf(msg, sizeof(msg), "%s[%d]", pModule, lineno);
-    log(FENCE, POST, msg);
-    //}
+  // The message is only formatted if fenceposts are enabled.
+  LOG_INLINE void fencepost(const char *pModule, const int lineno) {
+    if (enabled(FENCE, POST)) {
+      sendFencepost(pModule, lineno);
+    }
   }
-  void fencepost(const char *pModule, const char *pSubroutine, const int lineno) {
+  LOG_INLINE void fencepost(const char *pModule, const char *pSubroutine, const int lineno) {
     // This is used extensively in unittest.cpp
     // example input:  logger.fencepost("unittest.cpp", "subroutineName()", __LINE__);
     // example output: "----- subroutineName(), unit_test.cpp[123]"
-    char msg[128];
-    snprintf(msg, sizeof(msg), "----- %s, %s[%d] ", pSubroutine, pModule, lineno);
-    log(FENCE, POST, msg);
+    if (enabled(FENCE, POST)) {
+      sendFencepost(pModule, pSubroutine, lineno);
+    }
   }
 
   // ---------- print direct to console
@@ -321,29 +390,346 @@ public:
   // then we must reply by printing to the console, no matter what.
   // Note: This function does not send \n newline.
   //       logger.print() is a direct replacement for Serial.print()
+  // Anything waiting in the deferred ring is sent first, to keep messages in order.
   void print(const char *pText) {
+    flush();
     Serial.print(pText);
   }
   void print(int value) {
+    flush();
     Serial.print(value);
   }
   void print(long value) {
+    flush();
     Serial.print(value);
   }
   void print(float f, int places) {
+    flush();
     Serial.print(f, places);
   }
   void println() {
+    flush();
     Serial.println();
   }
   void println(long value) {
+    flush();
     Serial.println(value);
   }
   void println(const char *pText) {
+    flush();
     Serial.println(pText);
   }
 
 protected:
+  // ---------- messages that passed the build-time filter ----------
+  void sendFencepost(const char *pModule, const int lineno) {
+    //  example output: "Griduino.ino[123]"
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%s[%d]", pModule, lineno);
+    send(FENCE, POST, msg);
+  }
+  void sendFencepost(const char *pModule, const char *pSubroutine, const int lineno) {
+    char msg[128];
+    snprintf(msg, sizeof(msg), "----- %s, %s[%d] ", pSubroutine, pModule, lineno);
+    send(FENCE, POST, msg);
+  }
+
+  // ----- send: text-only
+  void send(LogSystem system, LogLevel severity, const char *pText) {
+    if (ok_to_log(system, severity)) {
+      if (isDeferred(severity)) {
+        LogRecord rec(system, severity, eRecText, nullptr);
+        rec.addText(pText);
+        push(rec);
+      } else {
+        emitText(system, severity, pText);
+      }
+    }
+  }
+
+  // ----- send: text + text
+  void send(LogSystem system, LogLevel severity, const char *pFormat, const char *pStr) {
+    if (ok_to_log(system, severity)) {
+      if (isDeferred(severity)) {
+        LogRecord rec(system, severity, eRecStr, pFormat);
+        rec.addText(pStr);
+        push(rec);
+      } else {
+        emit(system, severity, pFormat, pStr);
+      }
+    }
+  }
+
+  // ----- send: text + text + text
+  void send(LogSystem system, LogLevel severity, const char *pFormat, const char *pStr1, const char *pStr2) {
+    if (ok_to_log(system, severity)) {
+      if (isDeferred(severity)) {
+        LogRecord rec(system, severity, eRecStr2, pFormat);
+        rec.addText(pStr1);
+        rec.addText(pStr2);
+        push(rec);
+      } else {
+        emit(system, severity, pFormat, pStr1, pStr2);
+      }
+    }
+  }
+
+  // ----- send: text + number
+  void send(LogSystem system, LogLevel severity, const char *pFormat, const int value) {
+    if (ok_to_log(system, severity)) {
+      if (isDeferred(severity)) {
+        LogRecord rec(system, severity, eRecInt, pFormat);
+        rec.addRaw(&value, sizeof(value));
+        push(rec);
+      } else {
+        emit(system, severity, pFormat, value);
+      }
+    }
+  }
+
+  // ----- send: text + int + int
+  void send(LogSystem system, LogLevel severity, const char *pFormat, const int value1, const int value2) {
+    if (ok_to_log(system, severity)) {
+      if (isDeferred(severity)) {
+        LogRecord rec(system, severity, eRecInt2, pFormat);
+        rec.addRaw(&value1, sizeof(value1));
+        rec.addRaw(&value2, sizeof(value2));
+        push(rec);
+      } else {
+        emit(system, severity, pFormat, value1, value2);
+      }
+    }
+  }
+
+  // ----- send: text + float
+  void sendFloat(LogSystem system, LogLevel severity, const char *pFormat, const float value1, const int decimalPlaces) {
+    if (ok_to_log(system, severity)) {
+      if (isDeferred(severity)) {
+        // floats are saved raw, the expensive conversion happens later in drain()
+        LogRecord rec(system, severity, eRecFloat, pFormat);
+        rec.addRaw(&value1, sizeof(value1));
+        rec.addByte(decimalPlaces);
+        push(rec);
+      } else {
+        emitFloats(system, severity, pFormat, value1, decimalPlaces, 0.0, -1);
+      }
+    }
+  }
+
+  // ----- send: text + float
+  void sendTwoFloats(LogSystem system, LogLevel severity, const char *pFormat, const float value1, const int places1, const float value2, const int places2) {
+    if (ok_to_log(system, severity)) {
+      if (isDeferred(severity)) {
+        LogRecord rec(system, severity, eRecFloat2, pFormat);
+        rec.addRaw(&value1, sizeof(value1));
+        rec.addByte(places1);
+        rec.addRaw(&value2, sizeof(value2));
+        rec.addByte(places2);
+        push(rec);
+      } else {
+        emitFloats(system, severity, pFormat, value1, places1, value2, places2);
+      }
+    }
+  }
+
+
+  // ---------- deferred logging ----------
+  // The ring holds variable-length records, each one starting with its own length:
+  //     [0] length, [1] system, [2] severity, [3] kind, [4..7] format-ID, [8..11] millis,
+  //     [12..] raw arguments: int32, float32 + places, or nul-terminated strings
+  enum LogRecordKind {
+    eRecText = 0,   // preformatted text
+    eRecStr,        // format + string
+    eRecStr2,       // format + string + string
+    eRecInt,        // format + int
+    eRecInt2,       // format + int + int
+    eRecFloat,      // format + float
+    eRecFloat2,     // format + float + float
+  };
+
+  // one record is assembled on the stack, then copied into the ring in one piece
+  struct LogRecord {
+    uint8_t data[LOG_RECORD_SIZE];
+    int len;
+
+    LogRecord(LogSystem system, LogLevel severity, LogRecordKind kind, const char *pFormat) {
+      data[1]     = system;
+      data[2]     = severity;
+      data[3]     = kind;
+      uint32_t id = (uint32_t)(uintptr_t)pFormat;
+      uint32_t ms = millis();
+      memcpy(&data[4], &id, sizeof(id));
+      memcpy(&data[8], &ms, sizeof(ms));
+      len = LOG_HEADER_SIZE;
+    }
+    void addByte(int value) {
+      if (len < LOG_RECORD_SIZE) {
+        data[len++] = (uint8_t)value;
+      }
+    }
+    void addRaw(const void *pValue, int size) {
+      if (len + size <= LOG_RECORD_SIZE) {
+        memcpy(&data[len], pValue, size);
+        len += size;
+      }
+    }
+    void addText(const char *pText) {
+      // copy the string, because caller's buffer is long gone by the time we format it
+      // long strings are truncated, leaving room for a second string argument,
+      // and end in "..." so the reader knows something is missing
+      const int maxText = (LOG_RECORD_SIZE - LOG_HEADER_SIZE) / 2;
+      int count         = strnlen(pText, maxText);
+      if (count < maxText) {
+        addRaw(pText, count);
+      } else {
+        addRaw(pText, maxText - 4);
+        addRaw("...", 3);
+      }
+      addByte(0);
+    }
+  };
+
+#if LOG_DEFERRED_BUILD
+  uint8_t ring[LOG_RING_SIZE];
+  uint16_t ringHead = 0;   // next byte to write
+  uint16_t ringTail = 0;   // next byte to read
+#endif
+
+  bool isDeferred(LogLevel severity) {
+    if (logMode == LOG_DIRECT) {
+      return false;
+    }
+    if (severity == CONSOLE) {
+      // required output is sent immediately, after everything before it
+      flush();
+      return false;
+    }
+    return true;
+  }
+
+#if LOG_DEFERRED_BUILD
+  uint8_t ringPeek(int offset) {
+    return ring[(ringTail + offset) & (LOG_RING_SIZE - 1)];
+  }
+#endif
+
+  void push(LogRecord &rec) {
+#if LOG_DEFERRED_BUILD
+    rec.data[0] = rec.len;
+    int avail   = LOG_RING_SIZE - 1 - pending();
+    if (rec.len > avail) {
+      recordsDropped++;   // never block the caller, just count the loss
+      return;
+    }
+    for (int ii = 0; ii < rec.len; ii++) {
+      ring[ringHead] = rec.data[ii];
+      ringHead       = (ringHead + 1) & (LOG_RING_SIZE - 1);
+    }
+    recordsLogged++;
+    if (pending() > ringHighWater) {
+      ringHighWater = pending();
+    }
+#endif
+  }
+
+  // reconstruct the original arguments and format them exactly like direct mode
+  void emitRecord(const uint8_t *rec, int len) {
+    LogSystem system   = (LogSystem)rec[1];
+    LogLevel severity  = (LogLevel)rec[2];
+    const char *pFormat;
+    uint32_t id;
+    memcpy(&id, &rec[4], sizeof(id));
+    pFormat         = (const char *)(uintptr_t)id;
+    const char *arg = (const char *)&rec[LOG_HEADER_SIZE];
+    int argBytes    = len - LOG_HEADER_SIZE;
+    int32_t i1, i2;
+    float f1, f2;
+
+    // a record too short for its kind was damaged in the ring, so don't read past its end
+    int strings = (rec[3] == eRecStr2) ? 2 : (rec[3] <= eRecStr) ? 1 : 0;
+    int nuls    = 0;
+    for (int ii = 0; ii < argBytes; ii++) {
+      nuls += (arg[ii] == 0);
+    }
+    const int rawBytes[] = {0, 0, 0, 4, 8, 5, 10};   // must be in same order as enum LogRecordKind
+    if (argBytes < 0 || rec[3] > eRecFloat2 || nuls < strings || argBytes < rawBytes[rec[3]]) {
+      Serial.println("(log record?)");
+      return;
+    }
+
+    switch (rec[3]) {
+    case eRecText:
+      emitText(system, severity, arg);
+      break;
+    case eRecStr:
+      emit(system, severity, pFormat, arg);
+      break;
+    case eRecStr2:
+      emit(system, severity, pFormat, arg, arg + strlen(arg) + 1);
+      break;
+    case eRecInt:
+      memcpy(&i1, arg, sizeof(i1));
+      emit(system, severity, pFormat, i1);
+      break;
+    case eRecInt2:
+      memcpy(&i1, arg, sizeof(i1));
+      memcpy(&i2, arg + sizeof(i1), sizeof(i2));
+      emit(system, severity, pFormat, i1, i2);
+      break;
+    case eRecFloat:
+      memcpy(&f1, arg, sizeof(f1));
+      emitFloats(system, severity, pFormat, f1, arg[4], 0.0, -1);
+      break;
+    case eRecFloat2:
+      memcpy(&f1, arg, sizeof(f1));
+      memcpy(&f2, arg + 5, sizeof(f2));
+      emitFloats(system, severity, pFormat, f1, arg[4], f2, arg[9]);
+      break;
+    default:
+      Serial.println("(log record?)");
+      break;
+    }
+  }
+
+  // ---------- formatting and sending ----------
+  void emitText(LogSystem system, LogLevel severity, const char *pText) {
+    printPrefix(system, severity);
+    if (strlen(pText) < 4) {
+      // allow caller to send up to this many newlines together
+      Serial.print(pText);
+    } else {
+      if (pText[strlen(pText) - 1] == '\n') {
+        // use the trailing newline from NEMA sentences from the GPS module
+        Serial.print(pText);
+      } else {
+        // add our own newline
+        Serial.println(pText);
+      }
+    }
+  }
+
+  void emit(LogSystem system, LogLevel severity, const char *pFormat, ...) {
+    printPrefix(system, severity);
+    char msg[256];
+    va_list args;
+    va_start(args, pFormat);
+    vsnprintf(msg, sizeof(msg), pFormat, args);
+    va_end(args);
+    Serial.println(msg);
+  }
+
+  // print 'error' and 'warning' if needed, then the given text and one or two values
+  void emitFloats(LogSystem system, LogLevel severity, const char *pFormat, float value1, int places1, float value2, int places2) {
+    char sFloat1[8], sFloat2[8];
+    floatToCharArray(sFloat1, sizeof(sFloat1), value1, places1);
+    if (places2 < 0) {
+      emit(system, severity, pFormat, sFloat1);
+    } else {
+      floatToCharArray(sFloat2, sizeof(sFloat2), value2, places2);
+      emit(system, severity, pFormat, sFloat1, sFloat2);
+    }
+  }
+
   // helper: issue prefix for warnings and errors
   void printPrefix(LogSystem system, LogLevel severity) {
     char pfx[32];
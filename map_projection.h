@@ -0,0 +1,150 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     map_projection.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Lat/long to screen pixels, at any scale.
+
+            MapProjection maps an area of lat/long onto a rectangle on the
+            screen. The grid view uses one for its 2x1 degree square, and
+            the map view uses one for each zoom level.
+
+            MapTrail is a copy of the breadcrumb trail in small integers, for
+            drawing. It walks the trail once, finds its bounding box, and keeps
+            at most MAP_TRAIL_POINTS of the crumbs (every Nth one for a long
+            trail). Each point is stored as 16-bit offsets within the bounding
+            box. Changing the zoom only changes the scale and offset applied to
+            these points, so the trail is not walked and no doubles are used.
+            The copy is rebuilt only when the trail changes.
+*/
+
+#include <Arduino.h>             //
+#include "constants.h"           // Griduino constants, colors, typedefs
+#include "model_breadcrumbs.h"   // breadcrumb trail
+
+// ========== class MapProjection ==============================
+class MapProjection {
+public:
+  PointGPS origin;          // lower left corner of the visible area
+  double degreesWide;       // longitude
+  double degreesHigh;       // latitude
+  Rect box;                 // screen area
+  float xPixelsPerDegree;   //
+  float yPixelsPerDegree;   //
+
+  MapProjection(const PointGPS vOrigin, double vWide, double vHigh, const Rect vBox)
+      : origin(vOrigin), degreesWide(vWide), degreesHigh(vHigh), box(vBox) {
+    xPixelsPerDegree = box.size.x / degreesWide;
+    yPixelsPerDegree = box.size.y / degreesHigh;
+  }
+
+  // smallest area with the same shape as a grid square (2:1) that holds
+  // the given corners, with a little room around them
+  static MapProjection fit(const PointGPS lowerLeft, const PointGPS upperRight, const Rect vBox) {
+    double wide = upperRight.lng - lowerLeft.lng;
+    double high = upperRight.lat - lowerLeft.lat;
+    double size = max(max(wide, 2.0 * high), 2.0 / 24 / 4);   // at least 1/4 of a 6-char subsquare
+    size *= 1.1;                                               // 5% margin on each side
+    PointGPS center{(lowerLeft.lat + upperRight.lat) / 2, (lowerLeft.lng + upperRight.lng) / 2};
+    PointGPS corner{center.lat - size / 4, center.lng - size / 2};
+    return MapProjection(corner, size, size / 2, vBox);
+  }
+
+  Point toScreen(const PointGPS loc) const {
+    Point result;
+    result.x = box.ul.x + (int)((loc.lng - origin.lng) * xPixelsPerDegree);
+    result.y = box.ul.y + box.size.y - (int)((loc.lat - origin.lat) * yPixelsPerDegree);
+    return result;
+  }
+
+  bool isVisible(const Point pixel) const {
+    return (pixel.x >= box.ul.x) && (pixel.x < box.ul.x + box.size.x) &&
+           (pixel.y >= box.ul.y) && (pixel.y < box.ul.y + box.size.y);
+  }
+};   // end class MapProjection
+
+// ========== class MapTrail ===================================
+class MapTrail {
+public:
+#define MAP_TRAIL_POINTS 300     // most crumbs to draw, fits one frame and the view arena
+#define MAP_TRAIL_UNITS  30000   // 16-bit offsets across the bounding box
+
+  struct MapPoint {
+    int16_t x, y;   // offset from lowerLeft, in units
+  };
+
+  PointGPS lowerLeft{0, 0};    // bounding box of the whole trail
+  PointGPS upperRight{0, 0};   //
+  int count       = 0;         // points kept
+  int crumbs      = 0;         // GPS crumbs in the trail
+  int step        = 1;         // kept every Nth crumb
+  uint32_t builds = 0;         // times the trail was walked
+
+  // walk the trail again only if it changed since the last build
+  void update(Breadcrumbs &trail) {
+    uint32_t key = trail.recordsAdded ^ ((uint32_t)trail.getHistoryCount() << 16);
+    if (builds == 0 || key != builtKey) {
+      build(trail);
+      builtKey = key;
+    }
+  }
+
+  void build(Breadcrumbs &trail) {
+    builds++;
+    // ----- first pass: bounding box
+    crumbs = 0;
+    for (Location *mark = trail.begin(); mark; mark = trail.next()) {
+      if (mark->isGPS()) {
+        if (crumbs == 0) {
+          lowerLeft = upperRight = mark->loc;
+        }
+        lowerLeft.lat  = min(lowerLeft.lat, mark->loc.lat);
+        lowerLeft.lng  = min(lowerLeft.lng, mark->loc.lng);
+        upperRight.lat = max(upperRight.lat, mark->loc.lat);
+        upperRight.lng = max(upperRight.lng, mark->loc.lng);
+        crumbs++;
+      }
+    }
+    step        = (crumbs + MAP_TRAIL_POINTS - 1) / MAP_TRAIL_POINTS;
+    step        = max(step, 1);
+    unitsPerLng = MAP_TRAIL_UNITS / max(upperRight.lng - lowerLeft.lng, 1e-6);
+    unitsPerLat = MAP_TRAIL_UNITS / max(upperRight.lat - lowerLeft.lat, 1e-6);
+
+    // ----- second pass: every Nth crumb, in units
+    count   = 0;
+    int nth = 0;
+    for (Location *mark = trail.begin(); mark && count < MAP_TRAIL_POINTS; mark = trail.next()) {
+      if (mark->isGPS() && (nth++ % step) == 0) {
+        points[count].x = (int16_t)((mark->loc.lng - lowerLeft.lng) * unitsPerLng);
+        points[count].y = (int16_t)((mark->loc.lat - lowerLeft.lat) * unitsPerLat);
+        count++;
+      }
+    }
+  }
+
+  // scale and offset for a projection, done once per zoom change
+  void setProjection(const MapProjection &proj) {
+    xScale  = (int32_t)(proj.xPixelsPerDegree / unitsPerLng * (1L << 24));   // pixels per unit, 8.24 fixed point
+    yScale  = (int32_t)(proj.yPixelsPerDegree / unitsPerLat * (1L << 24));
+    xOffset = proj.box.ul.x + (int)((lowerLeft.lng - proj.origin.lng) * proj.xPixelsPerDegree);
+    yOffset = proj.box.ul.y + proj.box.size.y - (int)((lowerLeft.lat - proj.origin.lat) * proj.yPixelsPerDegree);
+  }
+
+  Point toScreen(int index) const {
+    const MapPoint &pt = points[index];
+    Point result;
+    result.x = xOffset + (int)(((int64_t)pt.x * xScale) >> 24);
+    result.y = yOffset - (int)(((int64_t)pt.y * yScale) >> 24);
+    return result;
+  }
+
+protected:
+  MapPoint points[MAP_TRAIL_POINTS];   // every Nth crumb, oldest first
+  double unitsPerLng = 1.0;            //
+  double unitsPerLat = 1.0;            //
+  int32_t xScale = 0, yScale = 0;      // from setProjection()
+  int xOffset = 0, yOffset = 0;        //
+  uint32_t builtKey = 0;               // trail state at the last build
+};   // end class MapTrail
@@ -0,0 +1,130 @@
+// Please format this file with clang before check-in to GitHub
+/*
+  File:     memory_monitor.cpp - RAM usage report
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Implements "show memory". Example output:
+                Static RAM (.data + .bss) = 151234 bytes
+                Heap used = 2048 bytes, free = 31744 bytes
+                Stack high-water = 5120 bytes, never used = 28672 bytes
+                Breadcrumb trail = 136800 bytes for 2850 crumbs
+                Views = 4312 bytes for the active view, instead of 21472 bytes for all 23
+                Views saved 17160 bytes = 357 breadcrumbs, 12 views built since power-up
+                Never-used stack would hold 597 more crumbs, but keep a reserve for the heap
+*/
+
+#include <Arduino.h>             // for Serial
+#include <malloc.h>              // for mallinfo()
+#include "constants.h"           // Griduino constants, colors and typedefs
+#include "hardware.h"            // Griduino pin definitions
+#include "logger.h"              // conditional printing to Serial port
+#include "model_breadcrumbs.h"   // breadcrumb trail
+#include "memory_monitor.h"      // RAM usage
+#include "view_registry.h"       // only the active view is in RAM
+
+// ========== extern ===========================================
+extern Logger logger;       // Griduino.ino
+extern Breadcrumbs trail;   // Griduino.ino
+
+// ----- symbols from the linker script
+extern "C" {
+extern uint32_t __data_start__, __data_end__;
+extern uint32_t __bss_start__, __bss_end__;
+extern uint32_t __StackTop;
+#if defined(ARDUINO_ADAFRUIT_FEATHER_RP2040)
+extern uint32_t __StackBottom;
+#else
+char *sbrk(int incr);
+#endif
+}
+
+static uint32_t *stackFloor() {
+  // lowest address the stack is allowed to use
+#if defined(ARDUINO_ADAFRUIT_FEATHER_RP2040)
+  return &__StackBottom;
+#else
+  uintptr_t heapEnd = (uintptr_t)sbrk(0);   // stack may grow down to the current end of heap
+  return (uint32_t *)((heapEnd + 3) & ~3);
+#endif
+}
+
+void MemoryMonitor::paintStack() {
+  uint32_t here;   // our own stack frame is near the top of the stack
+  paintBottom  = stackFloor();
+  uint32_t *pp = paintBottom;
+  while (pp < &here - 16) {   // stay clear of our own frame
+    *pp++ = STACK_PAINT;
+  }
+}
+
+uint32_t *MemoryMonitor::lowestTouched() {
+  uint32_t *pp = stackFloor();   // heap may have grown since painting, so start from its current end
+  if (pp < paintBottom) {
+    pp = paintBottom;
+  }
+  while (pp < &__StackTop && *pp == STACK_PAINT) {
+    pp++;
+  }
+  return pp;
+}
+
+int MemoryMonitor::staticRAM() {
+  return ((uintptr_t)&__data_end__ - (uintptr_t)&__data_start__) + ((uintptr_t)&__bss_end__ - (uintptr_t)&__bss_start__);
+}
+
+int MemoryMonitor::heapUsed() {
+  struct mallinfo mi = mallinfo();
+  return mi.uordblks;
+}
+
+int MemoryMonitor::heapFree() {
+#if defined(ARDUINO_ADAFRUIT_FEATHER_RP2040)
+  return rp2040.getFreeHeap();
+#else
+  uint32_t here;
+  struct mallinfo mi = mallinfo();
+  return mi.fordblks + ((uintptr_t)&here - (uintptr_t)sbrk(0));   // freed blocks + gap between heap and stack
+#endif
+}
+
+int MemoryMonitor::stackHighWater() {
+  return (uintptr_t)&__StackTop - (uintptr_t)lowestTouched();
+}
+
+int MemoryMonitor::stackMargin() {
+  if (!paintBottom) {
+    return 0;   // paintStack() was not called
+  }
+  uint32_t *floor = stackFloor();
+  if (floor < paintBottom) {
+    floor = paintBottom;
+  }
+  return (uintptr_t)lowestTouched() - (uintptr_t)floor;
+}
+
+void MemoryMonitor::report() {
+  char msg[100];
+  snprintf(msg, sizeof(msg), "Static RAM (.data + .bss) = %d bytes", staticRAM());
+  logger.log(COMMAND, CONSOLE, msg);
+
+  snprintf(msg, sizeof(msg), "Heap used = %d bytes, free = %d bytes", heapUsed(), heapFree());
+  logger.log(COMMAND, CONSOLE, msg);
+
+  int margin = stackMargin();
+  snprintf(msg, sizeof(msg), "Stack high-water = %d bytes, never used = %d bytes", stackHighWater(), margin);
+  logger.log(COMMAND, CONSOLE, msg);
+
+  snprintf(msg, sizeof(msg), "Breadcrumb trail = %d bytes for %d crumbs", trail.totalSize, trail.capacity);
+  logger.log(COMMAND, CONSOLE, msg);
+
+  views.report(trail.recordSize);   // RAM that views would need if they were all global objects
+
+#if !defined(ARDUINO_ADAFRUIT_FEATHER_RP2040)
+  // on SAMD the trail and the stack share the same RAM, so unused stack is potential trail space
+  snprintf(msg, sizeof(msg), "Never-used stack would hold %d more crumbs, but keep a reserve for the heap",
+           margin / trail.recordSize);
+  logger.log(COMMAND, CONSOLE, msg);
+#endif
+}
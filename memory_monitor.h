@@ -0,0 +1,46 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     memory_monitor.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Measure RAM usage at runtime, so that big buffers like the breadcrumb
+            trail can be sized from measured headroom instead of trial and error.
+
+            At power-up, paintStack() fills the unused stack with a known pattern.
+            Later, the lowest address where the pattern was overwritten is the
+            deepest the stack has ever reached (its "high-water mark").
+
+            SAMD51:  heap grows up from the end of .bss, stack grows down from the
+                     top of RAM. The gap between them is free for both.
+            RP2040:  the heap has its own region, and the stack for core 0 is a
+                     separate 4 KB block (SCRATCH_Y) from __StackBottom to __StackTop.
+
+            The console command "show memory" prints everything.
+            For a per-module list of static RAM, run "memreport.py" on the linker's map file.
+*/
+
+#include <Arduino.h>   // for Serial
+
+// ========== class MemoryMonitor ==============================
+class MemoryMonitor {
+public:
+#define STACK_PAINT 0xA5A5A5A5   // unused stack contains this pattern
+
+  void paintStack();            // call once, first thing in setup()
+  int staticRAM();              // bytes in .data and .bss
+  int heapUsed();               // bytes allocated by malloc/new
+  int heapFree();               // bytes available for malloc/new
+  int stackHighWater();         // deepest stack usage ever seen, bytes
+  int stackMargin();            // bytes between deepest stack and heap that were never touched
+  void report();                // send all measurements to console
+
+protected:
+  uint32_t *paintBottom = nullptr;   // lowest painted address
+  uint32_t *lowestTouched();         // lowest stack address that was ever written
+
+};   // end class MemoryMonitor
+
+// ========== extern ===========================================
+extern MemoryMonitor memoryMonitor;   // Griduino.ino
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""
+  File:     memreport.py
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+
+  Purpose:  Static RAM budget, per module, from the linker's map file.
+            Lists bytes of .data (initialized) and .bss (zeroed) for each object file,
+            largest first, so you can see what to shrink before making the breadcrumb
+            trail bigger. Compare the total with "show memory" on the device.
+
+  Usage:    In the Arduino IDE, turn on "Show verbose output during compilation" to find
+            the build folder, then add "-Wl,-Map,griduino.map" to the linker flags, or
+            use arduino-cli:
+                arduino-cli compile --build-property "compiler.c.elf.extra_flags=-Wl,-Map,griduino.map"
+
+                python3 memreport.py path/to/griduino.map
+                python3 memreport.py path/to/griduino.map --top 10
+"""
+import argparse
+import os
+import re
+import sys
+from collections import defaultdict
+
+# input section lines look like this, sometimes split over two lines when the name is long:
+#  .bss.trail     0x20000f20     0x1d4d8 /tmp/arduino/sketch/Griduino.ino.cpp.o
+SECTION = re.compile(r'^\s*\.(data|bss)(\.\S*)?\s*(0x[0-9a-f]+)?\s*(0x[0-9a-f]+)?\s*(\S+)?\s*$')
+ADDR_SIZE_FILE = re.compile(r'^\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(\S+)\s*$')
+
+
+def module_name(path):
+    # archive members look like "libfoo.a(bar.o)"
+    m = re.match(r'.*?([^/\\]+\.a)\(([^)]+)\)$', path)
+    if m:
+        return '%s(%s)' % (m.group(1), m.group(2))
+    return os.path.basename(path)
+
+
+def parse(mapfile):
+    totals = defaultdict(lambda: {'data': 0, 'bss': 0})
+    in_memory_map = False
+    pending = None
+    with open(mapfile, 'r', errors='replace') as f:
+        for line in f:
+            if line.startswith('Linker script and memory map'):
+                in_memory_map = True
+                continue
+            if not in_memory_map:
+                continue
+            if pending:
+                m = ADDR_SIZE_FILE.match(line)
+                if m:
+                    size = int(m.group(2), 16)
+                    if int(m.group(1), 16) != 0 and size:
+                        totals[module_name(m.group(3))][pending] += size
+                pending = None
+                continue
+            m = SECTION.match(line)
+            if not m:
+                continue
+            kind, addr, size, obj = m.group(1), m.group(3), m.group(4), m.group(5)
+            if addr is None:
+                pending = kind   # name was too long, numbers are on the next line
+            elif size and obj and int(addr, 16) != 0:
+                totals[module_name(obj)][kind] += int(size, 16)
+    return totals
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Static RAM (.data + .bss) per module from a GCC map file')
+    parser.add_argument('mapfile', help='linker map file')
+    parser.add_argument('--top', type=int, default=0, help='show only the N largest modules')
+    args = parser.parse_args()
+
+    totals = parse(args.mapfile)
+    if not totals:
+        print('No .data or .bss sections found in %s' % args.mapfile)
+        return 1
+
+    rows = sorted(totals.items(), key=lambda kv: kv[1]['data'] + kv[1]['bss'], reverse=True)
+    if args.top:
+        rows = rows[:args.top]
+    print('%8s %8s %8s  %s' % ('.data', '.bss', 'total', 'module'))
+    for name, t in rows:
+        print('%8d %8d %8d  %s' % (t['data'], t['bss'], t['data'] + t['bss'], name))
+    data = sum(t['data'] for t in totals.values())
+    bss = sum(t['bss'] for t in totals.values())
+    print('%8d %8d %8d  %s' % (data, bss, data + bss, 'TOTAL (all modules)'))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -1,6 +1,6 @@
 #pragma once   // Please format this file with clang before check-in to GitHub
 /*
-  File:     morse_adc.h
+  File:     model_adc.h
 
   Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
   Hardware: John Vanderbeck, KM7O, Seattle, WA
@@ -9,26 +9,69 @@
             the Quectel GPS. If the battery falls below 1.6v then
             the GPS can no longer acquire satellites.
 
+            The controller calls update() on every pass through the main loop.
+            Every BATTERY_SAMPLE_MSEC it averages BATTERY_OVERSAMPLE readings of
+            the ADC and smooths the result, so the displayed voltage is steady.
+            Views read the cached value from readCoinBatteryVoltage().
+
+            Every BATTERY_HISTORY_HOURS the voltage goes into a small history,
+            saved in its own file. A straight line fitted through the history
+            gives the discharge rate, and predicts the days until the battery
+            reaches BAD_BATTERY_MAXIMUM. See "show battery".
+
   Note:     PCB v7+ has wiring to measure battery voltage.
             PCB v4 has no such sensor.
 
 */
 
+#include <Arduino.h>            //
+#include <TimeLib.h>            // time_t=seconds since Jan 1, 1970, https://github.com/PaulStoffregen/Time
+#include <Adafruit_ILI9341.h>   // TFT color display library, for battery colors
+#include "constants.h"          // Griduino constants, colors, typedefs
+#include "hardware.h"           // BATTERY_ADC
+#include "logger.h"             // conditional printing to Serial port
+#include "save_restore.h"       // Configuration data in nonvolatile RAM
+
+// ========== extern ===========================================
+extern Logger logger;   // Griduino.ino
+
+// ========== class BatteryReading =============================
+class BatteryReading {
+public:
+  float volts;   // averaged and smoothed
+  time_t time;   // in GMT, from realtime clock
+};
+
 // ========== class BatteryVoltage ==================================
 class BatteryVoltage {
-private:
-  int inputPin;
-  int coinBattery;                               // measured coin battery ADC sample (0..1024)
-  const float voltsPerSample = (3.3 / 1023.0);   // PCB v6+ circuit's reference voltage is Vcc = 3.3 volts
-
 public:
+#define BATTERY_FILE          CONFIG_FOLDER "/battery.cfg"   // must be 8.3 filename
+#define BATTERY_VERSION       "Battery v01"
+#define BATTERY_ADC_BITS      10                 // Arduino default, the touchscreen's thresholds assume it too
+#define BATTERY_ADC_MAX       ((1 << BATTERY_ADC_BITS) - 1)
+#define BATTERY_VREF          (3.3)              // PCB v6+ circuit's reference voltage is Vcc = 3.3 volts
+#define BATTERY_CALIBRATION   (1.000)            // uncalibrated; to correct, set to (meter volts / displayed volts)
+#define BATTERY_OVERSAMPLE    64                 // ADC readings averaged per sample, finer than one 10-bit step
+#define BATTERY_SAMPLE_MSEC   (10 * 1000)        // one averaged sample this often
+#define BATTERY_SMOOTHING     4                  // each new sample moves the displayed value 1/4 of the way
+#define BATTERY_HISTORY       64                 // days of history = BATTERY_HISTORY * BATTERY_HISTORY_HOURS / 24
+#define BATTERY_HISTORY_HOURS 12                 //
+#define BATTERY_MIN_TREND     4                  // fewer history readings than this has no trend
+
   // Griduino v7 uses Analog input pin A1 to measure 3v coin battery
   BatteryVoltage(int inputPin = A1) {}
   bool canReadBattery;
 
+  BatteryReading history[BATTERY_HISTORY] = {};   // oldest first, zero = unused
+  uint32_t samples = 0;                           // averaged samples since power-up
+
   void begin() {
     // TODO: figure out if this hardware can measure battery voltage
     // (PCB v4 cannot read coin battery, v7+ can measure it)
+    // The ADC resolution is left at 10 bits: analogReadResolution() changes it
+    // for every pin, and the touchscreen reads its pressure and position in 10 bits.
+    loadHistory();
+    sample();
   }
 
   uint16_t getBatteryColor(float v) {
@@ -41,15 +84,140 @@ public:
     }
   }
 
+  // cached voltage, no ADC reading
   float readCoinBatteryVoltage() {
-    const float analogRef     = 3.3;    // analog reference voltage
-    const uint16_t analogBits = 1024;   // ADC resolution is 10 bits = 2^10 = 1024
-
-    int coin_adc       = analogRead(BATTERY_ADC);
-    float coin_voltage = (float)coin_adc * analogRef / analogBits;
     // return GOOD_BATTERY_MINIMUM - 0.1;     // debug - show yellow icon
     // return WARNING_BATTERY_MINIMUM - 0.1;   // debug - show red icon
-    return coin_voltage;   // production release
+    return volts;   // production release
+  }
+
+  // ----- the schedule is determined by the Controller
+  // call on every pass through the main loop
+  // rightnow = GMT, or 0 if the clock is not set yet
+  // returns true if it read the ADC
+  bool update(time_t rightnow) {
+    if (samples > 0 && millis() - sampledAt < BATTERY_SAMPLE_MSEC) {
+      return false;
+    }
+    sample();
+    if (rightnow > 0 && rightnow - newest().time >= BATTERY_HISTORY_HOURS * SECS_PER_HOUR) {
+      rememberVoltage(volts, rightnow);
+      saveHistory();
+    }
+    return true;
+  }
+
+  // ----- discharge trend, from a least-squares line through the history
+  // returns volts per day, negative while discharging, 0 = not enough history
+  float slope() const {
+    int count = 0;
+    double sumX = 0, sumY = 0, sumXX = 0, sumXY = 0;
+    time_t latest = newest().time;
+    for (int ii = 0; ii < BATTERY_HISTORY; ii++) {
+      if (history[ii].time > 0) {
+        double days = (double)(history[ii].time - latest) / SECS_PER_DAY;   // zero or negative, keeps float precision
+        sumX += days;
+        sumY += history[ii].volts;
+        sumXX += days * days;
+        sumXY += days * history[ii].volts;
+        count++;
+      }
+    }
+    double spread = count * sumXX - sumX * sumX;
+    if (count < BATTERY_MIN_TREND || spread < 1e-6) {
+      return 0.0;
+    }
+    return (float)((count * sumXY - sumX * sumY) / spread);
+  }
+
+  // days until BAD_BATTERY_MAXIMUM at the current rate, -1 = unknown or not discharging
+  int daysToBad() const {
+    if (volts <= BAD_BATTERY_MAXIMUM) {
+      return 0;
+    }
+    float rate = slope();
+    if (rate >= 0.0) {
+      return -1;
+    }
+    float days = (volts - BAD_BATTERY_MAXIMUM) / -rate;
+    return (days < 9999) ? (int)days : 9999;
+  }
+
+  // ----- "show battery" console command
+  void report() {
+    char msg[96], sVolts[12], sSlope[12];
+    floatToCharArray(sVolts, sizeof(sVolts), volts, 3);
+    floatToCharArray(sSlope, sizeof(sSlope), slope() * 1000.0, 2);
+    int count = 0;
+    for (int ii = 0; ii < BATTERY_HISTORY; ii++) {
+      count += (history[ii].time > 0);
+    }
+    snprintf(msg, sizeof(msg), "Coin battery = %s v, from %lu samples of %d readings",
+             sVolts, (unsigned long)samples, BATTERY_OVERSAMPLE);
+    logger.log(COMMAND, CONSOLE, msg);
+    snprintf(msg, sizeof(msg), "Trend = %s mV/day from %d readings, %d days to bad (-1 = unknown)",
+             sSlope, count, daysToBad());
+    logger.log(COMMAND, CONSOLE, msg);
+  }
+
+  // ========== load/save history ================================
+  void loadHistory() {
+    SaveRestore config(BATTERY_FILE, BATTERY_VERSION);
+    BatteryReading saved[BATTERY_HISTORY];
+    if (config.readConfig((byte *)&saved, sizeof(saved))) {
+      memcpy(history, saved, sizeof(history));
+      logger.log(BATTERY, INFO, "Restored coin battery history");
+    }
+  }
+
+  void saveHistory() {
+    SaveRestore config(BATTERY_FILE, BATTERY_VERSION);
+    config.writeConfig((byte *)&history, sizeof(history));
+  }
+
+  // ----- interface for unit test, without reading hardware
+  void testSample(float vVolts) {
+    volts     = vVolts;
+    samples   = max(samples, (uint32_t)1);
+    sampledAt = millis();
+  }
+  void testRememberVoltage(float vVolts, time_t time) {
+    rememberVoltage(vVolts, time);
+  }
+  void clearHistory() {
+    memset(history, 0, sizeof(history));
+  }
+
+protected:
+  float volts        = 0.0;   // smoothed, see BATTERY_SMOOTHING
+  uint32_t sampledAt = 0;     // millis()
+
+  void sample() {
+    uint32_t sum = 0;
+    for (int ii = 0; ii < BATTERY_OVERSAMPLE; ii++) {
+      sum += analogRead(BATTERY_ADC);
+    }
+    float average = (float)sum / BATTERY_OVERSAMPLE * BATTERY_VREF * BATTERY_CALIBRATION / BATTERY_ADC_MAX;
+    if (samples == 0) {
+      volts = average;   // first sample, nothing to smooth
+    } else {
+      volts += (average - volts) / BATTERY_SMOOTHING;
+    }
+    samples++;
+    sampledAt = millis();
+  }
+
+  const BatteryReading &newest() const {
+    return history[BATTERY_HISTORY - 1];
+  }
+
+  void rememberVoltage(float vVolts, time_t time) {
+    // shift existing history to the left, same as the pressure history
+    for (int ii = 0; ii < BATTERY_HISTORY - 1; ii++) {
+      history[ii] = history[ii + 1];
+    }
+    history[BATTERY_HISTORY - 1].volts = vVolts;
+    history[BATTERY_HISTORY - 1].time  = time;
   }
 
 };   // end class BatteryVoltage
@@ -0,0 +1,138 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     model_altitude.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  One altitude from two sensors.
+
+            The barometer is fast and smooth but only knows altitude relative
+            to an unknown sea level pressure, which drifts with the weather.
+            GPS altitude is absolute but jumps around by tens of meters.
+
+            This complementary filter follows the barometer from moment to
+            moment, and slowly pulls its calibration toward GPS. The pull is
+            weaker when the fix is poor (high HDOP, few satellites) and stops
+            without a fix, so the barometer carries on alone through tunnels.
+
+              pressure altitude   = altitude at standard sea level pressure
+              offset             += (GPS - fused) * dt / tau     tau grows with HDOP^2
+              fused altitude      = pressure altitude + offset
+              climb rate          = smoothed d(pressure altitude)/dt
+
+            Since the offset is only a different sea level pressure,
+            sealevelPa() reports the calibration the filter has found.
+
+            The controller calls update() with each new barometer reading.
+            The altimeter view shows the result, and annotate() puts it into
+            breadcrumbs.
+*/
+
+#include <Arduino.h>      //
+#include "constants.h"    // Griduino constants, colors, typedefs
+#include "logger.h"       // conditional printing to Serial port
+#include "model_baro.h"   // barometric formula
+
+// ========== extern ===========================================
+extern Logger logger;   // Griduino.ino
+
+// ========== class AltitudeFusion =============================
+class AltitudeFusion {
+public:
+#define ALT_STANDARD_PASCALS (101325.0)   // standard atmosphere at sea level
+#define ALT_GPS_SECONDS      (120.0)      // time constant to follow GPS, at HDOP 1
+#define ALT_CLIMB_SECONDS    (4.0)        // smoothing of the climb rate
+#define ALT_MIN_SATELLITES   4            // fewer than this is not a 3D fix
+#define ALT_MAX_HDOP         (8.0)        // worse than this is ignored
+#define ALT_MIN_PASCALS      (30000.0)    // outside this range the barometer is broken or missing
+#define ALT_MAX_PASCALS      (110000.0)   //
+
+  float altitude   = 0;       // fused altitude, meters above MSL
+  float climbRate  = 0;       // vertical speed, meters/sec, up is positive
+  float offset     = 0;       // fused altitude minus pressure altitude, meters
+  bool calibrated  = false;   // true after the first good GPS altitude
+  bool valid       = false;   // true while the barometer gives sensible readings
+  uint32_t updates = 0;       // barometer readings seen
+
+  // ----- once per barometer reading
+  // msec   = when the pressure was read, millis()
+  // hdop   = horizontal dilution of precision, 0 = unknown
+  void update(float pascals, uint32_t msec, bool gpsFix, float gpsMeters, float hdop, int satellites) {
+    if (!(pascals > ALT_MIN_PASCALS && pascals < ALT_MAX_PASCALS)) {   // written so that NaN fails the test
+      valid = false;
+      return;
+    }
+    float pressureAltitude = BarometerModel::altitudeFromPressure(pascals, ALT_STANDARD_PASCALS);
+    float dt               = (valid && updates > 0) ? (msec - lastMillis) / 1000.0 : 0.0;
+    bool gpsGood           = gpsFix && satellites >= ALT_MIN_SATELLITES && hdop <= ALT_MAX_HDOP;
+
+    // ----- calibration, pulled toward GPS
+    if (gpsGood) {
+      if (!calibrated) {
+        offset     = gpsMeters - pressureAltitude;   // first fix, jump straight there
+        calibrated = true;
+        logger.logFloat(BARO, INFO, "Altitude filter calibrated to GPS, %s m", gpsMeters, 1);
+      } else if (dt > 0) {
+        float quality = (hdop > 0) ? max(hdop, 1.0f) : 2.0;   // unknown HDOP counts as mediocre
+        float gain    = min(dt / (ALT_GPS_SECONDS * quality * quality), 1.0f);
+        offset += gain * (gpsMeters - (pressureAltitude + offset));
+      }
+    }
+
+    // ----- climb rate, from the barometer only
+    if (dt > 0) {
+      float rate = (pressureAltitude - lastPressureAltitude) / dt;
+      climbRate += (dt / (ALT_CLIMB_SECONDS + dt)) * (rate - climbRate);
+    } else {
+      climbRate = 0;
+    }
+
+    altitude             = pressureAltitude + offset;
+    lastPressureAltitude = pressureAltitude;
+    lastPascals          = pascals;
+    lastMillis           = msec;
+    valid                = true;
+    updates++;
+  }
+
+  // sea level pressure that gives the fused altitude, Pascals
+  float sealevelPa() const {
+    return BarometerModel::sealevelFromAltitude(lastPascals, altitude);
+  }
+
+  // ----- put fused altitude and climb rate into a breadcrumb
+  // without a barometer, or before the first GPS altitude, the breadcrumb keeps the GPS altitude
+  void annotate(Location *loc) const {
+    if (valid && calibrated) {
+      loc->altitude  = altitude;
+      loc->climbRate = (int16_t)constrain(round(climbRate * 100.0), -32767, 32767);   // cm/sec
+    }
+  }
+
+  void reset() {
+    *this = AltitudeFusion();
+  }
+
+  // ----- "show baro" console command
+  void report() {
+    char msg[96], sAltitude[12], sClimb[12], sOffset[12], sSealevel[12];
+    floatToCharArray(sAltitude, sizeof(sAltitude), altitude, 1);
+    floatToCharArray(sClimb, sizeof(sClimb), climbRate, 2);
+    floatToCharArray(sOffset, sizeof(sOffset), offset, 1);
+    floatToCharArray(sSealevel, sizeof(sSealevel), sealevelPa(), 1);
+    snprintf(msg, sizeof(msg), "Fused altitude = %s m, climb = %s m/s, %s",
+             sAltitude, sClimb, !valid ? "no barometer" : (calibrated ? "calibrated" : "waiting for GPS"));
+    logger.log(COMMAND, CONSOLE, msg);
+    snprintf(msg, sizeof(msg), "Calibration = %s m, same as sea level pressure %s Pa", sOffset, sSealevel);
+    logger.log(COMMAND, CONSOLE, msg);
+  }
+
+protected:
+  float lastPressureAltitude = 0;   // meters
+  float lastPascals          = ALT_STANDARD_PASCALS;
+  uint32_t lastMillis        = 0;   //
+};   // end class AltitudeFusion
+
+// ========== extern ===========================================
+extern AltitudeFusion altFusion;   // Griduino.ino
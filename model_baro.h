@@ -9,6 +9,7 @@
          1. Constructor                               BarometerModel baroModel();
          2. Init hardware                             begin();
          3. Read barometer for ongoing display        baro.getBaroPressure();
+            Sample sensor on schedule, from main loop   baro.update();
          4. Read-and-save barometer for data logger   baro.logPressure( rightnow );
          5. Load history from NVR                     baro.loadHistory();
          6. Save history to NVR                       baro.saveHistory();
@@ -26,6 +27,15 @@
          Bosch BMP280 datasheet:    https://www.bosch-sensortec.com/media/boschsensortec/downloads/datasheets/bst-bmp280-ds001.pdf
          Bosch BMP388 datasheet:    https://www.bosch-sensortec.com/media/boschsensortec/downloads/datasheets/bst-bmp388-ds001.pdf
 
+  Sampling Service:
+         The sensor is configured once for oversampling, IIR filter and output data
+         rate, then read every BARO_SAMPLE_MSEC. Each read gets pressure and temperature
+         together and keeps them with a millis() timestamp. getBaroPressure(),
+         getTemperature() and getAltitude() return these cached values, so any number
+         of views can ask without adding bus traffic. Altitude is computed from the
+         cached pressure with the same formula the Adafruit libraries use.
+         The console command "show baro" reports bus reads per minute.
+
   Pressure History:
          This class is basically a data logger for barometric pressure.
          Q: How many data points should we store?
@@ -103,9 +113,9 @@ public:
   }
 #endif
   int bmp_cs;        // Chip Select for BMP388 / BMP390 hardware
-  float gPressure;   // pressure in Pascals
-  float inchesHg;    // same pressure in inHg
-  float celsius;     // internal case temperature
+  float gPressure = 0;   // pressure in Pascals, cached, see update()
+  float inchesHg  = 0;   // same pressure in inHg
+  float celsius   = 0;   // internal case temperature
 
 #define maxReadings 384                          // 384 = (4 readings/hour)*(24 hours/day)*(4 days)
 #define lastIndex   (maxReadings - 1)            // index to the last element in pressure array
@@ -138,12 +148,19 @@ public:
       // ----- Settings recommended by Bosch based on use case for "handheld device dynamic"
       // https://www.bosch-sensortec.com/media/boschsensortec/downloads/datasheets/bst-bmp388-ds001.pdf
       // Section 3.5 Filter Selection, page 17
-      /*
-      baro->setTemperatureOversampling(BMP3_NO_OVERSAMPLING);
-      baro->setPressureOversampling(BMP3_OVERSAMPLING_4X);
-      baro->setIIRFilterCoeff(BMP3_IIR_FILTER_COEFF_7);   // was 3, too busy
-      baro->setOutputDataRate(BMP3_ODR_50_HZ);
-      // logger.fencepost("model_baro.h", __LINE__);
+      // IIR coefficient is lower than Bosch suggests (7), since we only sample once a second
+#if defined(ARDUINO_ADAFRUIT_FEATHER_RP2040)
+      baro.setSampling(Adafruit_BMP280::MODE_NORMAL,       // measure continuously
+                       Adafruit_BMP280::SAMPLING_X2,       // temperature
+                       Adafruit_BMP280::SAMPLING_X16,      // pressure
+                       Adafruit_BMP280::FILTER_X4,         // IIR
+                       Adafruit_BMP280::STANDBY_MS_250);   // output data rate = 4 Hz
+#else
+      baro.setTemperatureOversampling(BMP3_OVERSAMPLING_2X);
+      baro.setPressureOversampling(BMP3_OVERSAMPLING_8X);
+      baro.setIIRFilterCoeff(BMP3_IIR_FILTER_COEFF_3);
+      baro.setOutputDataRate(BMP3_ODR_25_HZ);
+#endif
 
       /*****
         // ----- Settings from Adafruit example
@@ -164,13 +181,7 @@ public:
         // baro->setOutputDataRate(BMP3_ODR_50_HZ);
         *****/
 
-      // Get and discard the first data point
-      // Repeated because first reading is always bad, until iir oversampling buffers are populated
-      //     for (int ii = 0; ii < 4; ii++) {
-      //       baro->performReading();   // read hardware
-      //        delay(50);
-      //      }
-      //
+      sample();   // first cached reading, so nobody sees zero
     } else {
       logger.log(BARO, ERROR, "unable to initialize Bosch pressure sensor");
 #if defined(ARDUINO_ADAFRUIT_FEATHER_RP2040)
@@ -203,33 +214,85 @@ public:
     return rc;
   }
 
+  // ----- sampling service
+#define BARO_SAMPLE_MSEC 1000   // read the sensor this often
+
+  uint32_t sampledAt      = 0;   // millis() of the cached reading, 0 = none yet
+  uint32_t busReads       = 0;   // sensor reads since power-up
+  uint32_t readsPerMinute = 0;   // sensor reads in the last complete minute
+
+  // controller calls this on every pass through the main loop
+  // returns true if it read the sensor
+  bool update() {
+    if (sampledAt != 0 && millis() - sampledAt < BARO_SAMPLE_MSEC) {
+      return false;   // cached reading is fresh enough
+    }
+    sample();
+    return true;
+  }
+
+  // age of the cached reading, msec
+  uint32_t sampleAge() const {
+    return millis() - sampledAt;
+  }
+
   float getAltitude(float sealevelPa) {
     // input: sea level air pressure, Pascals
-    // returns: altitude, meters
-    return baro.readAltitude(sealevelPa / 100.0);
+    // returns: altitude, meters, from the cached pressure
+    update();
+    return altitudeFromPressure(gPressure, sealevelPa);
+  }
+
+  static float altitudeFromPressure(float pascals, float sealevelPa) {
+    // international barometric formula, same as Adafruit's readAltitude()
+    return 44330.0 * (1.0 - pow(pascals / sealevelPa, 0.1903));
+  }
+
+  static float sealevelFromAltitude(float pascals, float meters) {
+    // the same formula solved for sea level pressure
+    // returns: the sea level setting that makes this pressure read as the given altitude, Pascals
+    return pascals / pow(1.0 - meters / 44330.0, 1.0 / 0.1903);
   }
 
   float getTemperature() {
-    // updates: celsius (public class var)
-    // query temperature from the C++ object, Celsius, not the hardware
-    celsius = baro.readTemperature();
+    // returns: celsius (public class var) from the cached reading
+    update();
     return celsius;
   }
 
   float getBaroPressure() {
-    // returns: float Pascals
-    // updates: gPressure (public class var)
-    //          inchesHg  (public class var)
-    // continue anyway, for demo
-    gPressure = baro.readPressure();   // Pressure is returned in SI units of Pascals. 100 Pascals = 1 hPa = 1 millibar
-    inchesHg  = gPressure * INCHES_MERCURY_PER_PASCAL;
+    // returns: float Pascals from the cached reading
+    //          100 Pascals = 1 hPa = 1 millibar
+    update();
     return gPressure;
   }
 
+  // ----- "show baro" console command
+  void report() {
+    char msg[96], sPressure[12], sCelsius[12];
+    floatToCharArray(sPressure, sizeof(sPressure), gPressure, 1);
+    floatToCharArray(sCelsius, sizeof(sCelsius), celsius, 1);
+    snprintf(msg, sizeof(msg), "Pressure = %s Pa, temperature = %s C, read %lu msec ago",
+             sPressure, sCelsius, (unsigned long)sampleAge());
+    logger.log(COMMAND, CONSOLE, msg);
+    snprintf(msg, sizeof(msg), "Sensor reads = %lu, last minute = %lu, scheduled every %d msec",
+             (unsigned long)busReads, (unsigned long)readsPerMinute, BARO_SAMPLE_MSEC);
+    logger.log(COMMAND, CONSOLE, msg);
+  }
+
+  void testSample(float pascals, float degrees, uint32_t msec) {
+    // interface for unit test
+    // replace the cached reading without reading hardware
+    gPressure = pascals;
+    inchesHg  = gPressure * INCHES_MERCURY_PER_PASCAL;
+    celsius   = degrees;
+    sampledAt = msec;
+  }
+
   // the schedule is determined by the Controller
   // controller should call this every 15 minutes
   void logPressure(time_t rightnow) {
-    float pressure = getBaroPressure();                       // read
+    float pressure = getBaroPressure();                       // cached, no older than BARO_SAMPLE_MSEC
     rememberPressure(pressure, rightnow);                     // push onto stack
     logger.log(BARO, INFO, "logPressure(%s)", pressure, 1);   // debug
     saveHistory();                                            // write stack to NVR
@@ -272,6 +335,40 @@ public:
   }
 
 protected:
+  uint32_t minuteStart = 0;   // millis() when this minute of counting began
+  uint32_t minuteReads = 0;   // sensor reads so far this minute
+
+  void sample() {
+    // read pressure and temperature together, and time-stamp them
+#if defined(ARDUINO_ADAFRUIT_FEATHER_RP2040)
+    celsius   = baro.readTemperature();
+    gPressure = baro.readPressure();   // Pascals
+    countRead(3);                      // readPressure() reads temperature again, for compensation
+#else
+    if (baro.performReading()) {   // one burst for both values
+      celsius   = baro.temperature;
+      gPressure = baro.pressure;   // Pascals
+    }
+    countRead(1);
+#endif
+    inchesHg  = gPressure * INCHES_MERCURY_PER_PASCAL;
+    sampledAt = millis();
+    if (sampledAt == 0) {
+      sampledAt = 1;   // 0 means no reading yet
+    }
+  }
+
+  void countRead(int reads) {
+    uint32_t msec = millis();
+    if (msec - minuteStart >= 60 * 1000) {
+      readsPerMinute = minuteReads;
+      minuteReads    = 0;
+      minuteStart    = msec;
+    }
+    minuteReads += reads;
+    busReads += reads;
+  }
+
   void rememberPressure(float pascals, time_t time) {
     // interface for unit test
     // push the given barometer reading onto the stack (without reading hardware)
@@ -14,6 +14,8 @@
 #include "date_helper.h"         // date/time conversions
 #include "save_restore.h"        // Configuration data in nonvolatile RAM
 #include "model_breadcrumbs.h"   // breadcrumb trail
+#include "tracer.h"              // software tracer
+#include "perf_counters.h"       // performance counters
 
 // ========== extern ===========================================
 extern Logger logger;                                                                // Griduino.ino
@@ -50,7 +52,7 @@ void Breadcrumbs::dumpHistoryGPS(int limit) {
   snprintf(msg, sizeof(msg), "now() = %s GMT", sDate);   //
   logger.log(FILES, INFO, msg);                          //
 
-  logger.log(FILES, CONSOLE, "Record, Type, Date GMT, Time GMT, Grid, Lat, Long, Alt(m), Speed(mph), Direction(Degrees), Sats");
+  logger.log(FILES, CONSOLE, "Record, Type, Date GMT, Time GMT, Grid, Lat, Long, Alt(m), Speed(mph), Direction(Degrees), Sats, Climb(cm/s)");
   int ii         = 0;
   Location *item = begin();
   while (item) {
@@ -86,9 +88,9 @@ void Breadcrumbs::dumpHistoryGPS(int limit) {
 
     } else if (item->isGPS() || item->isAcquisitionOfSignal() || item->isLossOfSignal()) {
       // format for all GPS-type messages
-      //                           1   2   3   4   5   6   7   8   9  10  11
-      snprintf(out, sizeof(out), "%d, %s, %s, %s, %s, %s, %s, %s, %s, %s, %d",
-               ii, item->recordType, sDate, sTime, grid6, sLat, sLng, sAltitude, sSpeed, sDirection, nSats);
+      //                           1   2   3   4   5   6   7   8   9  10  11  12
+      snprintf(out, sizeof(out), "%d, %s, %s, %s, %s, %s, %s, %s, %s, %s, %d, %d",
+               ii, item->recordType, sDate, sTime, grid6, sLat, sLng, sAltitude, sSpeed, sDirection, nSats, item->climbRate);
 
     } else if (item->isCoinBatteryVoltage()) {
       char sVolts[12];
@@ -96,6 +98,16 @@ void Breadcrumbs::dumpHistoryGPS(int limit) {
       snprintf(out, sizeof(out), "%d, %s, %s, %s, %s",
                ii, item->recordType, sDate, sTime, sVolts);
 
+    } else if (item->isTimeToFirstFix()) {
+      // format for "time to first fix" message
+      snprintf(out, sizeof(out), "%d, %s, %s, %s, %s, %s sec, %s start, %d",
+               ii, item->recordType, sDate, sTime, grid6, sSpeed, (item->direction > 0.5) ? "warm" : "cold", nSats);
+
+    } else if (item->isFenceCrossing()) {
+      // format for "entered/exited geofence" message
+      snprintf(out, sizeof(out), "%d, %s, %s, %s, %s, %s, %s, fence %s",
+               ii, item->recordType, sDate, sTime, grid6, sLat, sLng, sSpeed);
+
     } else {
       // format for "should not happen" messages
       snprintf(out, sizeof(out), "%d, --> Type '%s' unknown: ", ii, item->recordType);
@@ -117,6 +129,8 @@ void Breadcrumbs::dumpHistoryGPS(int limit) {
 
 int Breadcrumbs::saveGPSBreadcrumbTrail() {   // returns 1=success, 0=failure
   // our breadcrumb trail file is CSV format -- you can open this Arduino file directly in a spreadsheet
+  TraceScope trace(eTraceSaveTrail);
+  PerfSaveTimer timer(perf.trailSaves);
   // dumpHistoryGPS();   // debug
 
   // delete old file and open new file
@@ -130,7 +144,7 @@ int Breadcrumbs::saveGPSBreadcrumbTrail() {   // returns 1=success, 0=failure
   config.writeLine(msg);
 
   // line 5: column headings
-  config.writeLine("Type, GMT Date, GMT Time, Grid, Latitude, Longitude, Altitude, MPH, Direction, Satellites");
+  config.writeLine("Type, GMT Date, GMT Time, Grid, Latitude, Longitude, Altitude, MPH, Direction, Satellites, Climb cm/sec");
 
   // line 6..x: date-time, grid6, latitude, longitude
   int ii              = 0;         // loop counter
@@ -171,9 +185,9 @@ int Breadcrumbs::saveGPSBreadcrumbTrail() {   // returns 1=success, 0=failure
 
     } else {
       // good data, write it to file
-      //                           1  2  3  4  5  6  7  8  9 10
-      snprintf(msg, sizeof(msg), "%s,%s,%s,%s,%s,%s,%s,%s,%s,%d",
-               loc->recordType, sDate, sTime, sGrid6, sLat, sLng, sAlt, sSpeed, sAngle, numSatellites);
+      //                           1  2  3  4  5  6  7  8  9 10 11
+      snprintf(msg, sizeof(msg), "%s,%s,%s,%s,%s,%s,%s,%s,%s,%d,%d",
+               loc->recordType, sDate, sTime, sGrid6, sLat, sLng, sAlt, sSpeed, sAngle, numSatellites, loc->climbRate);
       config.writeLine(msg);
     }
     ii++;
@@ -186,6 +200,63 @@ int Breadcrumbs::saveGPSBreadcrumbTrail() {   // returns 1=success, 0=failure
   return 1;   // success
 }
 
+// parse one line from the CSV file into a Location
+// parsing text must match same order in saveGPSBreadcrumbTrail()
+// "Type, GMT Date, GMT Time, Grid, Latitude, Longitude, Altitude, MPH, Direction, Satellites, Climb cm/sec"
+// Climb was added later, so it's optional and older files still load.
+// returns false if any field is missing or out of range, so a truncated or damaged
+// line is ignored instead of crashing at boot. Note: 'strtok' modifies csv_line.
+bool Breadcrumbs::parseBreadcrumb(char *csv_line, Location *loc) {
+  const char dateDelimiters[] = ",-/:";   // include "-" for YY-MM-DD or YY/MM/DD
+  const char comma[]          = ",";      // exclude "-" for -123.456
+  const int numFields         = 14;       // type, 6 date/time parts, grid, 6 numbers
+  char *field[numFields];
+  for (int ii = 0; ii < numFields; ii++) {
+    bool isDateTime = (ii >= 1 && ii <= 6);
+    field[ii]       = strtok((ii == 0) ? csv_line : NULL, isDateTime ? dateDelimiters : comma);
+    if (field[ii] == NULL) {
+      return false;   // line is too short
+    }
+  }
+
+  int iYear4  = atoi(field[1]);   // YYYY: actual calendar year
+  int iMonth  = atoi(field[2]);
+  int iDay    = atoi(field[3]);
+  int iHour   = atoi(field[4]);
+  int iMinute = atoi(field[5]);
+  int iSecond = atoi(field[6]);
+  if (iYear4 < 1970 || iYear4 > 1970 + 255 || iMonth < 1 || iMonth > 12 || iDay < 1 || iDay > 31 ||
+      iHour < 0 || iHour > 23 || iMinute < 0 || iMinute > 59 || iSecond < 0 || iSecond > 59) {
+    return false;
+  }
+  // field[7] is grid6, discard it, we always calc it from lat,long when needed
+  double fLatitude  = atof(field[8]);
+  double fLongitude = atof(field[9]);
+  float fAltitude   = atof(field[10]);   // meters
+  float fSpeed      = atof(field[11]);   // mph
+  float fDirection  = atof(field[12]);
+  int nSatellites   = atoi(field[13]);
+  char *climbField  = strtok(NULL, comma);
+  int nClimb        = climbField ? atoi(climbField) : 0;   // cm/sec
+  // written so that NaN fails the test
+  if (!(fLatitude >= -90.0 && fLatitude <= 90.0 && fLongitude >= -180.0 && fLongitude <= 180.0)) {
+    return false;
+  }
+  if (nSatellites < 0 || nSatellites > 255) {
+    return false;
+  }
+  if (nClimb < -32767 || nClimb > 32767) {
+    return false;
+  }
+
+  TimeElements tm{(uint8_t)iSecond, (uint8_t)iMinute, (uint8_t)iHour, 0, (uint8_t)iDay, (uint8_t)iMonth, (uint8_t)CalendarYrToTm(iYear4)};
+  PointGPS whereAmI{fLatitude, fLongitude};
+  *loc = Location{"xxx", whereAmI, makeTime(tm), (uint8_t)nSatellites, (int16_t)nClimb, fSpeed, fDirection, fAltitude};
+  strncpy(loc->recordType, field[0], sizeof(loc->recordType) - 1);
+  loc->recordType[sizeof(loc->recordType) - 1] = 0;
+  return Location::isValidRecordType(loc->recordType);
+}
+
 int Breadcrumbs::restoreGPSBreadcrumbTrail() {   // returns 1=success, 0=failure
   clearHistory();                                // clear breadcrumb memory
 
@@ -205,13 +276,15 @@ int Breadcrumbs::restoreGPSBreadcrumbTrail() {   // returns 1=success, 0=failure
   int csv_line_number = 0;
   int items_restored  = 0;
   char csv_line[256], original_line[256];
-  const char dateDelimiters[] = ",-/:";   // include "-" for YY-MM-DD or YY/MM/DD
-  const char comma[]          = ",";      // exclude "-" for -123.456
+  Location csvloc;
   int count;
   bool done = false;
-  while (count = config.readLine(csv_line, sizeof(csv_line)) && !done) {
+  while (!done) {
+    count = config.readLine(csv_line, sizeof(csv_line));
+
     // save line for possible console messages because 'strtok' will modify buffer
     strncpy(original_line, csv_line, sizeof(original_line));
+    original_line[sizeof(original_line) - 1] = 0;
 
     // process line according to # bytes read
     char msg[256];
@@ -224,36 +297,8 @@ int Breadcrumbs::restoreGPSBreadcrumbTrail() {   // returns 1=success, 0=failure
       logger.log(CONFIG, ERROR, ". File error %d", err);   // 1=write, 2=read
       done = true;
       break;
-    } else if (isValidBreadcrumb(original_line)) {
-      // parsing text must match same order in saveGPSBreadcrumbTrail()
-      // "Type, GMT Date, GMT Time, Grid, Latitude, Longitude, Altitude, MPH, Direction, Satellites"
-      char sType[4];
-      strncpy(sType, strtok(csv_line, comma), sizeof(sType));
-      int iYear4      = atoi(strtok(NULL, dateDelimiters));   // YYYY: actual calendar year
-      uint8_t iYear2  = CalendarYrToTm(iYear4);               // YY: offset from 1970
-      uint8_t iMonth  = atoi(strtok(NULL, dateDelimiters));
-      uint8_t iDay    = atoi(strtok(NULL, dateDelimiters));
-      uint8_t iHour   = atoi(strtok(NULL, dateDelimiters));
-      uint8_t iMinute = atoi(strtok(NULL, dateDelimiters));
-      uint8_t iSecond = atoi(strtok(NULL, dateDelimiters));
-      char sGrid[7];                                        // read grid6 and discard it, we use lat,long instead
-      strncpy(sGrid, strtok(NULL, comma), sizeof(sGrid));   // grid is not saved internally, we always calc it when needed
-      double fLatitude    = atof(strtok(NULL, comma));
-      double fLongitude   = atof(strtok(NULL, comma));
-      float fAltitude     = atof(strtok(NULL, comma));   // meters
-      float fSpeed        = atof(strtok(NULL, comma));   // mph
-      float fDirection    = atof(strtok(NULL, comma));
-      uint8_t nSatellites = atoi(strtok(NULL, comma));
-
+    } else if (isValidBreadcrumb(original_line) && parseBreadcrumb(csv_line, &csvloc)) {
       // save this value from CSV file into breadcrumb trail buffer
-      PointGPS whereAmI{fLatitude, fLongitude};
-
-      TimeElements tm{iSecond, iMinute, iHour, 0, iDay, iMonth, iYear2};
-      time_t csvTime = makeTime(tm);   // convert time elements into time_t
-
-      Location csvloc{"xxx", whereAmI, csvTime, nSatellites, fSpeed, fDirection, fAltitude};
-      strncpy(csvloc.recordType, sType, sizeof(sType));
-
       remember(csvloc);
       items_restored++;
     } else {
@@ -265,6 +310,7 @@ int Breadcrumbs::restoreGPSBreadcrumbTrail() {   // returns 1=success, 0=failure
     csv_line_number++;
   }
   logger.log(CONFIG, INFO, ". Restored %d breadcrumbs from %d lines in CSV file", items_restored, csv_line_number);
+  recordsAdded -= items_restored;   // restored items are not new breadcrumbs
 
   // The above "restore" always fills history[] from 0..N
   // Oldest allowed acceptable GPS date is Griduino's first release
@@ -313,7 +359,7 @@ int Breadcrumbs::restoreGPSBreadcrumbTrail() {   // returns 1=success, 0=failure
 }
 
 // ----- Beginning/end of each KML file -----
-const char *KML_PREFIX = "\r\n\
+const char KML_PREFIX[] = "\r\n\
 <?xml version=\"1.0\" encoding=\"UTF-8\"?>\r\n\
 <kml xmlns=\"http://www.opengis.net/kml/2.2\"\
  xmlns:gx=\"http://www.google.com/kml/ext/2.2\"\
@@ -355,29 +401,29 @@ const char *KML_PREFIX = "\r\n\
 \t\t</ListStyle>\r\n\
 \t</Style>\r\n";
 
-const char *KML_SUFFIX = "\
+const char KML_SUFFIX[] = "\
 </Document>\r\n\
 </kml>\r\n";
 
 // ----- Beginning/end of a pushpin in a KML file -----
-const char *PUSHPIN_PREFIX_PART1 = "\
+const char PUSHPIN_PREFIX_PART1[] = "\
 \t<Placemark>\r\n\
 \t\t<name>Start ";
 // PUSHPIN_PREFIX_PART2 contains the date "mm/dd/yy"
-const char *PUSHPIN_PREFIX_PART3 = "\
+const char PUSHPIN_PREFIX_PART3[] = "\
 </name>\r\n\
 \t\t<styleUrl>#m_ylw-pushpin0</styleUrl>\r\n\
 \t\t<Point>\r\n\
 \t\t\t<gx:drawOrder>1</gx:drawOrder>\r\n\
 \t\t\t<coordinates>";
 
-const char *PUSHPIN_SUFFIX = "</coordinates>\r\n\
+const char PUSHPIN_SUFFIX[] = "</coordinates>\r\n\
 \t\t</Point>\r\n\
 \t</Placemark>\r\n";
 
 // ----- Placemark template with timestamp -----
 // From: https://developers.google.com/static/kml/documentation/TimeStamp_example.kml
-const char *PLACE[7] = {
+const char *const PLACE[7] = {
     "\t<Placemark>\r\n",
     "\t\t<name>%s</name>\r\n",
     "\t\t<description>%04d-%02d-%02d %02d:%02d:%02d GMT <br/> %s mph, %s°, %s', %d sat</description>\r\n",
@@ -70,6 +70,12 @@
             2950     48 bytes  141,600 bytes   ok
             2980     48 bytes  143,040 bytes   ok
             3000     48 bytes  144,000 bytes   crash on "list files" command
+            2850     48 bytes  136,800 bytes   2024: views share one arena, see view_registry.h
+
+            The crash at 3000 was the stack running into the heap. Instead of trial
+            and error, exercise the deepest paths (list files, save trail, help) and
+            then run "show memory": it reports the stack high-water mark and how many
+            more crumbs would fit in the stack space that was never touched.
 
   Inspiration:
             https://embeddedartistry.com/blog/2017/05/17/creating-a-circular-buffer-in-c-and-c/
@@ -83,6 +89,7 @@
 #include "grid_helper.h"    // lat/long conversion routines
 #include "date_helper.h"    // date/time conversions
 #include "save_restore.h"   // Configuration data in nonvolatile RAM
+#include "fix_validator.h"  // plausibility checks on each GPS fix
 
 // ========== extern ===========================================
 extern Logger logger;   // Griduino.ino
@@ -93,13 +100,16 @@ extern Dates date;      // date_helper.h
 class Breadcrumbs {
 public:
   // Class member variables
-  const int totalSize  = sizeof(history);          // bytes
-  const int recordSize = sizeof(Location);         // bytes
-  const int capacity   = totalSize / recordSize;   // max number of records
-  int saveInterval     = 2;
+  const int totalSize    = sizeof(history);          // bytes
+  const int recordSize   = sizeof(Location);         // bytes
+  const int capacity     = totalSize / recordSize;   // max number of records
+  int saveInterval       = 2;
+  uint32_t recordsAdded  = 0;                        // new breadcrumbs since power-up, for "show perf"
+  FixValidator validator;                            // every live GPS fix is checked before it's remembered
+  void (*onRemember)(const Location &rec) = nullptr;  // sees each new breadcrumb, e.g. the trip engine
 
 private:
-  Location history[2500];   // remember a list of GPS coordinates and stuff
+  Location history[2850];   // remember a list of GPS coordinates and stuff, 2500 + RAM reclaimed from views
   bool full   = false;      //
   int head    = 0;          // index of next item to write = nextHistoryItem
   int tail    = 0;          // index of oldest item
@@ -110,6 +120,7 @@ private:
   const float noDirection    = -1.0;       // degrees from N
   const float noAltitude     = -1.0;       // meters above MSL
   const uint8_t noSatellites = 0;
+  const int16_t noClimb      = 0;          // cm/sec
 
 public:
   // ----- Initialization -----
@@ -121,6 +132,7 @@ public:
     for (uint ii = 0; ii < capacity; ii++) {
       history[ii].reset();
     }
+    validator.restart();   // next fix starts a new trail
     logger.log(CONFIG, INFO, "Breadcrumb trail history[%d] has been erased", capacity);
   }
 
@@ -152,7 +164,7 @@ public:
 
   // ----- Add or read records
   void rememberPUP() {   // save "power-up" event in the history buffer
-    Location pup{rPOWERUP, noLocation, now(), noSatellites, noSpeed, noDirection, noAltitude};
+    Location pup{rPOWERUP, noLocation, now(), noSatellites, noClimb, noSpeed, noDirection, noAltitude};
     remember(pup);
   }
 
@@ -166,38 +178,50 @@ public:
     remember(vLoc);
   }
 
-  void rememberBAT(float volts) {   // save "coin battery voltage" in history buffer
-    // all we have to do is save a float, so re-use the "speed" field
-    Location bat{rCOINBATTERYVOLTAGE, noLocation, now(), noSatellites, volts, noDirection, noAltitude};
-    strncpy(bat.recordType, rCOINBATTERYVOLTAGE, sizeof(bat.recordType));
-    remember(bat);
-  }
-
   void rememberFirstValidTime(time_t vTime, uint8_t vSats) {   // save "first valid time received from GPS"
     // "first valid time" can happen _without_ a satellite fix,
     // so the only data stored is the GMT timestamp
-    Location fvt{rFIRSTVALIDTIME, noLocation, vTime, vSats, noSpeed, noDirection, noAltitude};
+    Location fvt{rFIRSTVALIDTIME, noLocation, vTime, vSats, noClimb, noSpeed, noDirection, noAltitude};
     remember(fvt);
   }
 
+  void rememberTFF(PointGPS vLoc, time_t vTime, uint8_t vSats, int vSeconds, bool vWarmStart) {   // save "time to first fix"
+    // re-use the "speed" field for seconds since power-up, and "direction" for 1=warm start, 0=cold start
+    Location tff{rTIMETOFIRSTFIX, vLoc, vTime, vSats, noClimb, (float)vSeconds, vWarmStart ? 1.0f : 0.0f, noAltitude};
+    remember(tff);
+  }
+
+  void rememberFence(Location vLoc, int vFence, bool vEntered) {   // save "entered/exited geofence" in history buffer
+    // re-use the "speed" field for the fence number, see "show fences"
+    strncpy(vLoc.recordType, vEntered ? rFENCEENTER : rFENCEEXIT, sizeof(vLoc.recordType));
+    vLoc.speed = (float)vFence;
+    remember(vLoc);
+  }
+
   const TimeElements GRIDUINO_FIRST_RELEASE{0, 0, 0, 0, FIRST_RELEASE_DAY, FIRST_RELEASE_MONTH, FIRST_RELEASE_YEAR - 1970};
 
-  void rememberGPS(Location vLoc) {
+  void rememberGPS(Location vLoc, float vHDOP = 0.0) {
     // our GPS receiver can generate bogus locations in case of buffer overrun
-    // identifiable by a timestamp in the year 2000 and latitude==longitude
-    // so ignore readings that occurred before Griduino was built
-    time_t cutoff = makeTime(GRIDUINO_FIRST_RELEASE);
-    if (vLoc.timestamp > cutoff) {
+    // identifiable by a timestamp in the year 2000 and latitude==longitude,
+    // or by an impossible jump, so every live fix goes through the validator
+    // vHDOP = horizontal dilution of precision, 0 = unknown
+    time_t cutoff    = makeTime(GRIDUINO_FIRST_RELEASE);
+    FixReason reason = validator.check(vLoc, vHDOP, cutoff);
+    if (reason == eFixAccepted) {
       strncpy(vLoc.recordType, rGPS, sizeof(vLoc.recordType));
       remember(vLoc);
-    } else {
+    } else if (reason == eFixBeforeRelease) {
       vLoc.printLocation("Bogus GPS date is before our first release and is ignored");
+    } else {
+      logger.log(GPS_SETUP, WARNING, "GPS fix ignored: %s", FixValidator::reasonName(reason));
     }
   }
 
+  // synthetic trails for tests and benchmarks, these skip the motion checks
+
   void rememberGPS(PointGPS vLoc, time_t vTime, uint8_t vSats, float vSpeedMPH, float vDirection, float vAltitudeMeters) {
     time_t cutoff = makeTime(GRIDUINO_FIRST_RELEASE);
-    Location gps{rGPS, vLoc, vTime, vSats, vSpeedMPH, vDirection, vAltitudeMeters};
+    Location gps{rGPS, vLoc, vTime, vSats, noClimb, vSpeedMPH, vDirection, vAltitudeMeters};
     if (vTime > cutoff) {
       remember(gps);
     } else {
@@ -210,6 +234,10 @@ protected:
     // so that we can display it as a breadcrumb trail
     history[head] = vLoc;
     advance_pointer();
+    recordsAdded++;
+    if (onRemember) {
+      onRemember(vLoc);
+    }
   }
 
 public:
@@ -250,6 +278,8 @@ public:
 
   void dumpHistoryKML();   // print Keyhole Markup Language trail to console
 
+  bool parseBreadcrumb(char *csv_line, Location *loc);   // parse one CSV line, returns false if malformed
+
   // ----- Internal helpers
 private:
   bool isValidBreadcrumb(const char *original_line) {
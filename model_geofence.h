@@ -0,0 +1,530 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     model_geofence.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Alert when the vehicle crosses into or out of an area on the map,
+            such as a county line, a contest area or an exclusion zone.
+
+            Fences are circles and polygons, read from a text file on flash
+            at power-up, or with the "load fences" command. Example:
+                # lines starting with '#' are comments
+                circle,HOME,47.6062,-122.3321,0.5      name, center lat/long, radius in miles
+                polygon,KITSAP                         name, then one vertex per line
+                47.90,-122.75
+                47.40,-122.80
+                47.40,-122.50
+                47.90,-122.55
+                end
+            Names are short because they are sent in Morse code.
+
+            Each fence is listed in a bucket for every 4-char grid square
+            its bounding box touches. The buckets are one sorted table of
+            (square, fence) pairs. A fix is tested only against the fences in
+            its own square's bucket; any fence that reaches into the square
+            is listed there, so the squares around it need not be searched.
+            Then the bounding box, and only then the circle or polygon.
+
+            check() compares the fences we're inside now with the previous
+            fix, and queues an enter or exit event for each difference.
+            The controller announces each event and logs it as a breadcrumb.
+
+            Memory comes from the heap, once per load: loadFences() counts the
+            fences and vertices in the file first, and buildIndex() sizes the
+            index from their bounding boxes. Without a fence file it uses none.
+            Nothing is allocated while driving.
+
+            A fence may cross the antimeridian. Its west edge is kept in
+            -180..180 and its east edge may go past 180, so east > west always;
+            a fix west of the fence is moved 360 degrees east to be tested.
+*/
+
+#include <Arduino.h>           //
+#include "constants.h"         // Griduino constants, colors, typedefs
+#include "logger.h"            // conditional printing to Serial port
+#include "grid_helper.h"       // lat/long conversion routines
+#include "save_restore.h"      // Configuration data in nonvolatile RAM
+
+// ========== extern ===========================================
+extern Logger logger;   // Griduino.ino
+extern Grids grid;      // grid_helper.h
+
+// ========== class Geofence ===================================
+class Geofence {
+public:
+#define GEOFENCE_FILE         CONFIG_FOLDER "/fences.csv"   // must be 8.3 filename
+#define GEOFENCE_MAX_FENCES   256                           // circles and polygons in one file
+#define GEOFENCE_MAX_INSIDE   16                            // fences we can be inside at once
+#define GEOFENCE_MAX_EVENTS   8                             // waiting to be announced
+#define GEOFENCE_NAME_SIZE    12                            // including null
+#define NO_SQUARE             0xFFFF                        // no bucket looked up yet
+
+  struct Fence {
+    float south, west, north, east;   // bounding box, degrees, west < east even across the antimeridian
+    uint16_t firstVertex;             // index into vertices[]
+    uint16_t numVertices;             // 0 = circle, centered in its bounding box
+    char name[GEOFENCE_NAME_SIZE];    //
+  };
+  struct Event {
+    uint16_t fence;   // index into fences[]
+    bool entered;     // true=enter, false=exit
+  };
+
+  // ----- statistics, for "show fences"
+  uint32_t checks = 0;   // fixes checked
+  uint32_t tests  = 0;   // fences tested against a fix, after the bucket lookup
+
+  int numFences() const {
+    return fenceCount;
+  }
+  const Fence &fence(int ii) const {
+    return fences[ii];
+  }
+  int numInside() const {
+    return insideCount;
+  }
+
+  // ----- memory for the fences, from the heap
+  // returns false, and holds no fences, if there is not enough
+  bool reserve(int vFences, int vVertices) {
+    release();
+    if (vFences > 0) {
+      fences   = (Fence *)malloc(vFences * sizeof(Fence));
+      vertices = (Vertex *)malloc(max(vVertices, 1) * sizeof(Vertex));
+      if (!fences || !vertices) {
+        logger.log(FILES, ERROR, "Not enough memory for %d geofences", vFences);
+        release();
+        return false;
+      }
+      maxFences   = vFences;
+      maxVertices = vVertices;
+    }
+    return true;
+  }
+  void release() {
+    free(fences);
+    free(vertices);
+    free(bucket);
+    fences    = nullptr;
+    vertices  = nullptr;
+    bucket    = nullptr;
+    maxFences = maxVertices = maxBucket = 0;
+    clear();
+  }
+  int bytesUsed() const {
+    return maxFences * sizeof(Fence) + maxVertices * sizeof(Vertex) + maxBucket * sizeof(BucketEntry);
+  }
+
+  void clear() {
+    fenceCount = vertexCount = bucketCount = 0;
+    insideCount = eventCount = 0;
+    open        = false;
+    sorted      = true;
+    lastSquare  = NO_SQUARE;
+    lastFix     = PointGPS{0, 0};
+  }
+
+  // ----- build fences, from the file or from unit tests
+  bool addCircle(const char *name, const PointGPS center, float radiusMiles) {
+    if (!startFence(name)) {
+      return false;
+    }
+    float dLat     = radiusMiles / grid.calcDistanceLat(0.0, 1.0, false);
+    float dLng     = radiusMiles / grid.calcDistanceLong(center.lat, 0.0, 1.0, false);
+    Fence &ff      = fences[fenceCount];
+    ff.south       = center.lat - dLat;
+    ff.north       = center.lat + dLat;
+    ff.west        = center.lng - dLng;
+    ff.east        = center.lng + dLng;
+    ff.firstVertex = vertexCount;
+    ff.numVertices = 0;
+    return finishFence();
+  }
+  bool beginPolygon(const char *name) {
+    if (!startFence(name)) {
+      return false;
+    }
+    Fence &ff      = fences[fenceCount];
+    ff.firstVertex = vertexCount;
+    ff.numVertices = 0;
+    open           = true;
+    return true;
+  }
+  bool addVertex(const PointGPS pt) {
+    if (!open || vertexCount >= maxVertices) {
+      return false;
+    }
+    Fence &ff  = fences[fenceCount];
+    double lng = pt.lng;
+    if (ff.numVertices == 0) {
+      ff.south = ff.north = pt.lat;
+      ff.west = ff.east = lng;
+    } else {
+      // keep each edge shorter than half way around the world,
+      // so a polygon across the antimeridian stays in one piece
+      float first = vertices[ff.firstVertex].lng;
+      if (lng - first > 180.0) {
+        lng -= 360.0;
+      } else if (lng - first < -180.0) {
+        lng += 360.0;
+      }
+    }
+    ff.south = min(ff.south, (float)pt.lat);
+    ff.north = max(ff.north, (float)pt.lat);
+    ff.west  = min(ff.west, (float)lng);
+    ff.east  = max(ff.east, (float)lng);
+    vertices[vertexCount++] = Vertex{(float)pt.lat, (float)lng};
+    ff.numVertices++;
+    return true;
+  }
+  bool endPolygon() {
+    if (!open) {
+      return false;
+    }
+    open = false;
+    if (fences[fenceCount].numVertices < 3) {
+      vertexCount = fences[fenceCount].firstVertex;   // not a polygon, drop it
+      return false;
+    }
+    return finishFence();
+  }
+
+  // ----- one line of the fence file, returns false if it's not understood
+  bool parseLine(char *line) {
+    char *word = strtok(line, ", \t");
+    if (!word || word[0] == '#') {
+      return true;   // blank or comment
+    }
+    if (strcmp(word, "circle") == 0) {
+      char *name = strtok(nullptr, ", \t");
+      double lat, lng, miles;
+      if (name && nextNumber(&lat) && nextNumber(&lng) && nextNumber(&miles) && miles > 0) {
+        return addCircle(name, PointGPS{lat, lng}, miles);
+      }
+      return false;
+    }
+    if (strcmp(word, "polygon") == 0) {
+      char *name = strtok(nullptr, ", \t");
+      return name && beginPolygon(name);
+    }
+    if (strcmp(word, "end") == 0) {
+      return endPolygon();
+    }
+    double lat, lng;
+    if (isValidNumber(word) && nextNumber(&lng)) {
+      lat = atof(word);
+      return addVertex(PointGPS{lat, lng});
+    }
+    return false;
+  }
+
+  int loadFences() {
+    // returns number of fences loaded
+    release();
+    SaveRestoreStrings config(GEOFENCE_FILE, "");
+    if (!config.open(GEOFENCE_FILE, "r")) {
+      logger.log(FILES, INFO, "No geofences, file %s not found", GEOFENCE_FILE);
+      return 0;
+    }
+    // first pass: count fences and vertices, to know how much memory to ask for
+    char line[128];
+    int wantFences = 0, wantVertices = 0;
+    while (config.readLine(line, sizeof(line)) > 0) {
+      char *word = strtok(line, ", \t");
+      if (word && (strcmp(word, "circle") == 0 || strcmp(word, "polygon") == 0)) {
+        wantFences++;
+      } else if (word && isValidNumber(word)) {
+        wantVertices++;
+      }
+      line[0] = 0;
+    }
+    config.close();
+    if (!reserve(min(wantFences, GEOFENCE_MAX_FENCES), wantVertices) || !config.open(GEOFENCE_FILE, "r")) {
+      return 0;
+    }
+
+    // second pass: build them
+    int lineNumber = 0;
+    while (config.readLine(line, sizeof(line)) > 0) {
+      lineNumber++;
+      if (!parseLine(line)) {
+        logger.log(FILES, WARNING, "Geofence line %d ignored", lineNumber);
+      }
+      line[0] = 0;
+    }
+    config.close();
+    if (open) {
+      endPolygon();   // missing "end" on the last polygon
+    }
+    buildIndex();
+    char msg[80];
+    snprintf(msg, sizeof(msg), "Loaded %d geofences with %d vertices, %d bytes", fenceCount, vertexCount, bytesUsed());
+    logger.log(FILES, INFO, msg);
+    return fenceCount;
+  }
+
+  // ----- containment, without the index
+  bool contains(int ii, const PointGPS pt) const {
+    const Fence &ff = fences[ii];
+    double lng      = (pt.lng < ff.west) ? pt.lng + 360.0 : pt.lng;   // same side of the antimeridian as the fence
+    if (pt.lat < ff.south || pt.lat > ff.north || lng < ff.west || lng > ff.east) {
+      return false;
+    }
+    if (ff.numVertices == 0) {
+      PointGPS center{(ff.south + ff.north) / 2.0, (ff.west + ff.east) / 2.0};
+      double radius = (ff.north - ff.south) / 2.0 * grid.calcDistanceLat(0.0, 1.0, false);
+      return grid.calcDistance(center.lat, center.lng, pt.lat, lng, false) <= radius;
+    }
+    // even-odd rule: count edges crossed by a ray going east
+    // each edge includes its south end and excludes its north end,
+    // so a ray through a vertex is counted once, or twice at a peak
+    bool inside        = false;
+    const Vertex *poly = &vertices[ff.firstVertex];
+    for (int aa = 0, bb = ff.numVertices - 1; aa < ff.numVertices; bb = aa++) {
+      if ((poly[aa].lat > pt.lat) != (poly[bb].lat > pt.lat)) {
+        double crossLng = poly[aa].lng + (pt.lat - poly[aa].lat) * (poly[bb].lng - poly[aa].lng) / (poly[bb].lat - poly[aa].lat);
+        if (lng < crossLng) {
+          inside = !inside;
+        }
+      }
+    }
+    return inside;
+  }
+
+  // ----- once per fix
+  void check(const PointGPS pt) {
+    if (pt.lat == lastFix.lat && pt.lng == lastFix.lng) {
+      return;   // not moving, nothing can change
+    }
+    lastFix = pt;
+    checks++;
+    if (!sorted) {
+      buildIndex();
+    }
+
+    // fences in this square's bucket, found once per square
+    uint16_t square = grid.squareIndex(pt.lat, pt.lng);
+    if (square != lastSquare) {
+      bucketFirst = lowerBound(square);
+      bucketLast  = bucketFirst;
+      while (bucketLast < bucketCount && bucket[bucketLast].square == square) {
+        bucketLast++;
+      }
+      lastSquare = square;
+    }
+
+    uint16_t now[GEOFENCE_MAX_INSIDE];
+    int nowCount = 0;
+    for (int ii = bucketFirst; ii < bucketLast && nowCount < GEOFENCE_MAX_INSIDE; ii++) {
+      tests++;
+      if (contains(bucket[ii].fence, pt)) {
+        now[nowCount++] = bucket[ii].fence;
+      }
+    }
+
+    for (int ii = 0; ii < insideCount; ii++) {
+      if (!isListed(inside[ii], now, nowCount)) {
+        addEvent(inside[ii], false);
+      }
+    }
+    for (int ii = 0; ii < nowCount; ii++) {
+      if (!isListed(now[ii], inside, insideCount)) {
+        addEvent(now[ii], true);
+      }
+    }
+    memcpy(inside, now, nowCount * sizeof(now[0]));
+    insideCount = nowCount;
+  }
+
+  bool nextEvent(Event &event) {
+    // oldest first, returns false when there are none
+    if (eventCount == 0) {
+      return false;
+    }
+    event = events[0];
+    eventCount--;
+    memmove(&events[0], &events[1], eventCount * sizeof(events[0]));
+    return true;
+  }
+
+  // ----- sort the index, after adding fences
+  // called by loadFences(), and by check() if fences were added since
+  void buildIndex() {
+    int entries = 0;
+    for (int ii = 0; ii < fenceCount; ii++) {
+      entries += countSquares(fences[ii]);
+    }
+    if (entries > maxBucket) {
+      free(bucket);
+      bucket    = (BucketEntry *)malloc(entries * sizeof(BucketEntry));
+      maxBucket = bucket ? entries : 0;
+    }
+    bucketCount = 0;
+    if (!bucket && entries > 0) {
+      logger.log(FILES, ERROR, "Not enough memory for the geofence index, %d entries", entries);
+    } else {
+      for (int ii = 0; ii < fenceCount; ii++) {
+        addSquares(ii);
+      }
+    }
+    qsort(bucket, bucketCount, sizeof(bucket[0]), compareEntries);
+    sorted     = true;
+    lastSquare = NO_SQUARE;
+  }
+
+  void report() {
+    char msg[100];
+    snprintf(msg, sizeof(msg), "Geofences = %d, vertices = %d, index = %d, using %d bytes",
+             fenceCount, vertexCount, bucketCount, bytesUsed());
+    logger.log(COMMAND, CONSOLE, msg);
+    for (int ii = 0; ii < fenceCount; ii++) {
+      const Fence &ff = fences[ii];
+      snprintf(msg, sizeof(msg), "%3d %-11s %s %d vertices%s", ii, ff.name,
+               ff.numVertices ? "polygon" : "circle ", ff.numVertices,
+               isListed(ii, inside, insideCount) ? ", inside" : "");
+      logger.log(COMMAND, CONSOLE, msg);
+    }
+    unsigned long perFix = checks ? (tests + checks / 2) / checks : 0;
+    snprintf(msg, sizeof(msg), "Checked %lu fixes, tested %lu fences, %lu per fix",
+             (unsigned long)checks, (unsigned long)tests, perFix);
+    logger.log(COMMAND, CONSOLE, msg);
+  }
+
+protected:
+  struct Vertex {
+    float lat, lng;
+  };
+  struct BucketEntry {
+    uint16_t square;   // grid.squareIndex()
+    uint16_t fence;    // index into fences[]
+  };
+
+  Fence *fences       = nullptr;   // maxFences of them, see reserve()
+  Vertex *vertices    = nullptr;   // maxVertices, all polygons together
+  BucketEntry *bucket = nullptr;   // maxBucket (square, fence) pairs, sorted by square
+  int maxFences       = 0;
+  int maxVertices     = 0;
+  int maxBucket       = 0;
+  int fenceCount      = 0;
+  int vertexCount     = 0;
+  int bucketCount     = 0;
+  bool open           = false;   // polygon is still getting vertices
+  bool sorted         = true;    // bucket[] is in order
+
+  uint16_t inside[GEOFENCE_MAX_INSIDE];   // fences we're inside, as of the last fix
+  int insideCount = 0;
+  Event events[GEOFENCE_MAX_EVENTS];      // waiting to be announced, oldest first
+  int eventCount = 0;
+
+  PointGPS lastFix{0, 0};            // last fix checked
+  uint16_t lastSquare = NO_SQUARE;   // and its bucket
+  int bucketFirst = 0, bucketLast = 0;
+
+  bool startFence(const char *name) {
+    if (open) {
+      endPolygon();   // missing "end"
+    }
+    if (fenceCount >= maxFences) {
+      logger.log(FILES, ERROR, "Too many geofences, room for %d", maxFences);
+      return false;
+    }
+    strncpy(fences[fenceCount].name, name, GEOFENCE_NAME_SIZE - 1);
+    fences[fenceCount].name[GEOFENCE_NAME_SIZE - 1] = 0;
+    return true;
+  }
+
+  bool finishFence() {
+    // move a fence that starts west of -180 around the world, so west is in -180..180
+    Fence &ff = fences[fenceCount];
+    if (ff.west < -180.0) {
+      ff.west += 360.0;
+      ff.east += 360.0;
+      for (int ii = 0; ii < ff.numVertices; ii++) {
+        vertices[ff.firstVertex + ii].lng += 360.0;
+      }
+    }
+    fenceCount++;
+    sorted = false;   // buildIndex() lists it in the bucket of every square it touches
+    return true;
+  }
+
+  // ----- 4-char squares under a bounding box, as in grid.squareIndex()
+  // columns past 180 degrees east wrap around to -180
+  static int firstCol(const Fence &ff) {
+    return (int)floor((ff.west + 180.0) / 2.0);
+  }
+  static int numCols(const Fence &ff) {
+    return min((int)floor((ff.east + 180.0) / 2.0) - firstCol(ff) + 1, 180);
+  }
+  static int firstRow(const Fence &ff) {
+    return constrain((int)floor(ff.south + 90.0), 0, 179);
+  }
+  static int numRows(const Fence &ff) {
+    return constrain((int)floor(ff.north + 90.0), 0, 179) - firstRow(ff) + 1;
+  }
+  static int countSquares(const Fence &ff) {
+    return numCols(ff) * numRows(ff);
+  }
+  void addSquares(int ii) {
+    const Fence &ff = fences[ii];
+    for (int col = 0; col < numCols(ff); col++) {
+      int column = (firstCol(ff) + col) % 180;
+      for (int row = 0; row < numRows(ff); row++) {
+        bucket[bucketCount++] = BucketEntry{(uint16_t)(column * 180 + firstRow(ff) + row), (uint16_t)ii};
+      }
+    }
+  }
+
+  static int compareEntries(const void *aa, const void *bb) {
+    return (int)((const BucketEntry *)aa)->square - (int)((const BucketEntry *)bb)->square;
+  }
+
+  int lowerBound(uint16_t square) const {
+    int lo = 0, hi = bucketCount;
+    while (lo < hi) {
+      int mid = (lo + hi) / 2;
+      if (bucket[mid].square < square) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  static bool isListed(uint16_t ff, const uint16_t *list, int count) {
+    for (int ii = 0; ii < count; ii++) {
+      if (list[ii] == ff) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void addEvent(uint16_t ff, bool entered) {
+    if (eventCount >= GEOFENCE_MAX_EVENTS) {
+      logger.log(GPS_SETUP, WARNING, "Geofence event dropped: %s", fences[ff].name);
+      return;
+    }
+    events[eventCount++] = Event{ff, entered};
+  }
+
+  static bool isValidNumber(const char *word) {
+    char *end;
+    strtod(word, &end);
+    return end != word && *end == 0;
+  }
+  static bool nextNumber(double *value) {
+    char *word = strtok(nullptr, ", \t");
+    if (!word || !isValidNumber(word)) {
+      return false;
+    }
+    *value = atof(word);
+    return true;
+  }
+};   // end class Geofence
+
+// ========== extern ===========================================
+extern Geofence geofence;   // Griduino.ino
@@ -24,6 +24,7 @@
 #include "grid_helper.h"         // lat/long conversion routines
 #include "date_helper.h"         // date/time conversions
 #include "save_restore.h"        // Configuration data in nonvolatile RAM
+#include "nmea_reader.h"         // fix snapshot from core 1, with DUAL_CORE
 
 // ========== extern ===========================================
 extern Adafruit_GPS GPS;    // Griduino.ino
@@ -31,6 +32,9 @@ extern Breadcrumbs trail;   // model of breadcrumb trail
 extern Logger logger;       // Griduino.ino
 extern Grids grid;          // grid_helper.h
 extern Dates date;          // date_helper.h
+#if defined(DUAL_CORE)
+extern NmeaReader nmeaReader;   // Griduino.ino
+#endif
 
 // ========== constants ========================================
 // These initial values are displayed until GPS gets provides better info
@@ -48,6 +52,7 @@ public:
   time_t gTimestamp   = 0;       // date/time of GPS reading
   bool gHaveGPSfix    = false;   // true = GPS.fix() = whether or not gLatitude/gLongitude is valid
   uint8_t gSatellites = 0;       // number of satellites in use
+  float gHDOP         = 0.0;     // horizontal dilution of precision, 0 = unknown
   float gSpeed        = 0.0;     // current speed over ground in MPH
   float gAngle        = 0.0;     // direction of travel, degrees from true north
   bool gMetric        = false;   // distance reported in miles(false), kilometers(true)
@@ -93,7 +98,7 @@ public:
 
   // ========== load/save config setting =========================
   const char MODEL_FILE[25] = CONFIG_FOLDER "/gpsmodel.cfg";   // CONFIG_FOLDER
-  const char MODEL_VERS[15] = "GPS Data v3";                   // <-- always change version when changing model data
+  const char MODEL_VERS[15] = "GPS Data v4";                   // <-- always change version when changing model data
 
   // ----- save entire C++ object to non-volatile memory as binary object -----
   int save() {   // returns 1=success, 0=failure
@@ -134,18 +139,31 @@ public:
   }
 
   // pick'n pluck values from the restored instance
-  void copyFrom(const Model from) {
-    gLatitude      = from.gLatitude;        // GPS position, floating point, decimal degrees
-    gLongitude     = from.gLongitude;       // GPS position, floating point, decimal degrees
-    gAltitude      = from.gAltitude;        // Altitude in meters above MSL
+  // the file might be damaged, so values that no GPS could report are left unchanged
+  void copyFrom(const Model &from) {
+    if (isValidLatLong(from.gLatitude, from.gLongitude)) {
+      gLatitude  = from.gLatitude;    // GPS position, floating point, decimal degrees
+      gLongitude = from.gLongitude;   // GPS position, floating point, decimal degrees
+    }
+    if (from.gAltitude > -1000.0 && from.gAltitude < 100000.0) {   // written so that NaN fails the test
+      gAltitude = from.gAltitude;                                     // Altitude in meters above MSL
+    }
     gTimestamp     = from.gTimestamp;       // date/time of GPS reading
     gHaveGPSfix    = false;                 // assume no fix yet
     gSatellites    = 0;                     // assume no satellites yet
+    gHDOP          = 0.0;                   // assume precision unknown
     gSpeed         = 0.0;                   // assume speed unknown
     gAngle         = 0.0;                   // assume direction of travel unknown
     gMetric        = from.gMetric;          // distance report in miles/kilometers
-    gTimeZone      = from.gTimeZone;        // offset from GMT to local time
     compare4digits = from.compare4digits;   // true=4 digit, false=6 digit comparisons
+    if (from.gTimeZone >= -12 && from.gTimeZone <= 14) {
+      gTimeZone = from.gTimeZone;   // offset from GMT to local time
+    }
+  }
+
+  static bool isValidLatLong(double lat, double lng) {
+    // written so that NaN fails the test
+    return (lat >= -90.0 && lat <= 90.0 && lng >= -180.0 && lng <= 180.0);
   }
 
   // given a GPS reading in NMEA format, create a "time_t" timestamp
@@ -161,27 +179,46 @@ public:
   }
 
   // read GPS hardware
-  virtual void getGPS() {                  // "virtual" allows derived class MockModel to replace it
-    if (GPS.fix) {                         // DO NOT use "GPS.fix" anywhere else in the program,
-                                           // or the simulated position in MockModel won't work correctly
-      gLatitude  = GPS.latitudeDegrees;    // double-precision float
-      gLongitude = GPS.longitudeDegrees;   //
-      gAltitude  = GPS.altitude;           // Altitude in meters above MSL
+  virtual void getGPS() {   // "virtual" allows derived class MockModel to replace it
+#if defined(DUAL_CORE)
+    GpsFix snapshot;
+    if (nmeaReader.latestFix.read(&snapshot)) {   // parsed on core 1, see nmea_reader.h
+      readGPS(snapshot);
+    }
+#else
+    readGPS(GPS);
+#endif
+  }
+
+protected:
+  // copy the parsed NMEA results into the model
+  // the source is the GPS hardware, a parse-only instance in ReplayModel,
+  // or the GpsFix snapshot from core 1, which has the same field names
+  template <typename Source>
+  void readGPS(const Source &source) {
+    if (source.fix) {                         // DO NOT use "GPS.fix" anywhere else in the program,
+                                              // or the simulated position in MockModel won't work correctly
+      gLatitude  = source.latitudeDegrees;    // double-precision float
+      gLongitude = source.longitudeDegrees;   //
+      gAltitude  = source.altitude;           // Altitude in meters above MSL
       // save timestamp as compact 4-byte integer (number of seconds since Jan 1 1970)
       // using https://github.com/PaulStoffregen/Time
       // NMEA sentences contain only the last two digits of year, so add the century
-      gTimestamp  = NMEAtoTime_t(GPS.year, GPS.month, GPS.day, GPS.hour, GPS.minute, GPS.seconds);
+      gTimestamp  = NMEAtoTime_t(source.year, source.month, source.day, source.hour, source.minute, source.seconds);
       gHaveGPSfix = true;
     } else {
       gHaveGPSfix = false;
     }
 
     // read hardware regardless of GPS signal acquisition
-    gSatellites = GPS.satellites;
-    gSpeed      = GPS.speed * mphPerKnots;
-    gAngle      = GPS.angle;
+    gSatellites = source.satellites;
+    gHDOP       = source.HDOP;
+    gSpeed      = source.speed * mphPerKnots;
+    gAngle      = source.angle;
   }
 
+public:
+
   // the Model will update its internal state on a schedule determined by the Controller
   void processGPS() {
     getGPS();        // read the hardware for location
@@ -197,6 +234,7 @@ public:
 
     vLoc->timestamp     = gTimestamp;
     vLoc->numSatellites = gSatellites;
+    vLoc->climbRate     = 0;   // GPS alone doesn't know, see AltitudeFusion::annotate()
     vLoc->speed         = gSpeed;
     vLoc->direction     = gAngle;
     vLoc->altitude      = gAltitude;
@@ -349,6 +387,9 @@ private:
     logger.fencepost("model_gps.h", "getGPS()", __LINE__);  // debug
     // send GPS statistics from the Adafruit_GPS library (not from our own data in our model)
     // to serial console for desktop debugging
+    if (!logger.enabled(GPS_SETUP, DEBUG)) {
+      return;   // don't spend time formatting messages that won't be sent
+    }
     char sDate[21];   // strlen("0000-00-00  hh:mm:ss") = 20
     getCurrentDateTime(sDate);
 
@@ -364,8 +405,8 @@ private:
       floatToCharArray(sAngle, sizeof(sAngle), GPS.angle, 0);
       floatToCharArray(sAlt, sizeof(sAlt), gAltitude, 1);
 
-      snprintf(msg, sizeof(msg), "   Loc(%s,%s) Quality(%d) Sats(%d) Speed(%s knots) Angle(%s) Alt(%d)",
-              sLat, sLong, (int)GPS.fixquality, sSpeed, sAngle, sAlt);
+      snprintf(msg, sizeof(msg), "   Loc(%s,%s) Quality(%d) Sats(%d) Speed(%s knots) Angle(%s) Alt(%s)",
+              sLat, sLong, (int)GPS.fixquality, (int)GPS.satellites, sSpeed, sAngle, sAlt);
       logger.log(GPS_SETUP, DEBUG, msg);
     }
   }
@@ -399,7 +440,8 @@ public:
     gAltitude  = GPS.altitude;   // Altitude in meters above MSL
 
     // read hardware regardless of GPS signal acquisition
-    gSatellites = GPS.satellites;
+    gSatellites = 0;     // unknown, the simulated position has nothing to do with the satellites
+    gHDOP       = 0.0;   // unknown, for the same reason
     gSpeed      = GPS.speed * mphPerKnots;
     gAngle      = GPS.angle;
     gTimestamp  = now();
@@ -0,0 +1,267 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     model_replay.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  A derived Model that replays a recorded NMEA log instead of reading
+            the GPS receiver. Unlike MockModel's synthetic paths, this reproduces
+            real drives including signal loss and bogus year-2000 fixes.
+
+            Each sentence goes through the real Adafruit_GPS parser (a parse-only
+            instance, so the receiver's own state is untouched) and then through
+            the same Model::readGPS() as live data.
+
+            Data source:
+              1. a text file on flash, REPLAY_FILE, e.g. a saved console log of
+                 "start nmea" output or any GPS logger's NMEA file. Lines without
+                 a '$' are ignored and text before the '$' is stripped.
+              2. an array of sentences in memory, for unit tests.
+
+            Timing:
+              Sentence times come from the hhmmss field of RMC and GGA sentences.
+              speedup = 1.0 replays in real time, 100.0 replays 100x faster.
+              speedup = 0 is "step mode": each getGPS() consumes exactly one
+              second of recorded data, which makes tests deterministic.
+
+            The file stays open from beginFile() until the end of the data or
+            stop(). Other file operations remount the flash file system, but
+            that does not disturb a file that is only being read.
+*/
+
+#include <Arduino.h>        //
+#include <Adafruit_GPS.h>   // "Ultimate GPS" library, used here as parser only
+#include "constants.h"      // Griduino constants, colors, typedefs
+#include "logger.h"         // conditional printing to Serial port
+#include "model_gps.h"      // Model of a GPS for model-view-controller
+#include "save_restore.h"   // Configuration data in nonvolatile RAM
+
+// ========== extern ===========================================
+extern Logger logger;   // Griduino.ino
+
+// ========== constants ========================================
+#define REPLAY_FILE CONFIG_FOLDER "/replay.txt"   // must be 8.3 filename
+
+// ========== class ReplayModel ================================
+class ReplayModel : public Model {
+public:
+  // ----- statistics, for regression tests
+  uint32_t sentencesParsed = 0;   // accepted by parser
+  uint32_t sentencesFailed = 0;   // rejected by parser, e.g. bad checksum
+  uint32_t stepsReplayed   = 0;   // number of distinct timestamps consumed
+  bool finished            = false;   // true = reached end of data
+
+  // start replaying a file on flash, returns 1=success, 0=failure
+  int beginFile(const char *filename, float vSpeedup) {
+    restart(vSpeedup);
+    if (!replayFile.open(filename, "r")) {
+      logger.log(GPS_SETUP, ERROR, "Replay file not found: %s", filename);
+      finished = true;
+      return 0;
+    }
+    fileOpen = true;
+    logger.log(GPS_SETUP, INFO, "Replaying at speed %dx", (int)vSpeedup);
+    return 1;
+  }
+
+  // start replaying an array of sentences, e.g. a unit test
+  void beginArray(const char *const *vSentences, int vCount, float vSpeedup) {
+    restart(vSpeedup);
+    sentences    = vSentences;
+    numSentences = vCount;
+  }
+
+  // stop replaying, e.g. the user chose another data source
+  void stop() {
+    closeFile();
+    finished = true;
+  }
+
+  // read SIMULATED GPS hardware
+  void getGPS() {
+    pump();
+    readGPS(replayGPS);
+  }
+
+  // timestamp of the most recent fix, msec since midnight of first day
+  uint32_t replayTime() const {
+    return currentTime;
+  }
+
+  void report() {
+    char msg[100];
+    snprintf(msg, sizeof(msg), "Replay: %lu sentences parsed, %lu failed, %lu seconds replayed%s",
+             (unsigned long)sentencesParsed, (unsigned long)sentencesFailed, (unsigned long)stepsReplayed,
+             finished ? ", finished" : "");
+    logger.log(GPS_SETUP, CONSOLE, msg);
+  }
+
+protected:
+#define REPLAY_LINE_SIZE 100          // longest NMEA sentence is 82 characters
+#define REPLAY_NO_TIME   0xFFFFFFFF   // sentence has no timestamp, e.g. GSA and GSV
+
+  Adafruit_GPS replayGPS;   // parse-only, does not touch the serial port
+  float speedup = 1.0;      // 0 = step mode
+
+  // ----- data source
+  SaveRestoreStrings replayFile{REPLAY_FILE, ""};   // open while replaying from flash
+  bool fileOpen                = false;     // false = replay from array
+  const char *const *sentences = nullptr;   // array of sentences
+  int numSentences             = 0;         //
+  int nextSentence             = 0;         //
+
+  // ----- replay clock, all times are msec of recorded data
+  char pending[REPLAY_LINE_SIZE];      // next sentence, read but not yet parsed
+  bool havePending          = false;   //
+  uint32_t pendingTime      = 0;       // time of next sentence, or REPLAY_NO_TIME
+  uint32_t firstTime        = 0;       // time of first timed sentence, or REPLAY_NO_TIME
+  uint32_t currentTime      = 0;       // time of most recent timed sentence, or REPLAY_NO_TIME
+  uint32_t prevRawTime      = 0;       // msec since midnight, to detect midnight rollover
+  uint32_t dayOffset        = 0;       // msec added after each midnight
+  unsigned long startMillis = 0;       // local clock at first timed sentence
+
+  void restart(float vSpeedup) {
+    closeFile();
+    speedup              = vSpeedup;
+    sentencesParsed      = 0;
+    sentencesFailed      = 0;
+    stepsReplayed        = 0;
+    finished             = false;
+    sentences            = nullptr;
+    numSentences         = 0;
+    nextSentence         = 0;
+    havePending          = false;
+    firstTime            = REPLAY_NO_TIME;
+    currentTime          = REPLAY_NO_TIME;
+    prevRawTime          = 0;
+    dayOffset            = 0;
+    replayGPS.fix        = false;
+    replayGPS.satellites = 0;
+    replayGPS.HDOP       = 0.0;
+  }
+
+  // feed every sentence that is due into the parser
+  void pump() {
+    if (finished) {
+      return;
+    }
+    bool stepped = false;
+    while (true) {
+      if (!havePending) {
+        if (!readNext()) {
+          closeFile();
+          finished = true;
+          logger.log(GPS_SETUP, INFO, "Replay finished");
+          report();
+          break;
+        }
+      }
+
+      if (pendingTime != REPLAY_NO_TIME) {
+        if (firstTime == REPLAY_NO_TIME) {
+          firstTime   = pendingTime;
+          startMillis = millis();
+        }
+        if (pendingTime != currentTime) {
+          // sentence starts a new second of recorded data, is it due yet?
+          if (speedup <= 0) {
+            if (stepped) {
+              break;   // step mode: one second per call
+            }
+          } else {
+            uint32_t replayElapsed = (uint32_t)((millis() - startMillis) * speedup);
+            if (pendingTime - firstTime > replayElapsed) {
+              break;   // not due yet
+            }
+          }
+          currentTime = pendingTime;
+          stepped     = true;
+          stepsReplayed++;
+        }
+      }
+
+      if (replayGPS.parse(pending)) {
+        sentencesParsed++;
+      } else {
+        sentencesFailed++;
+      }
+      havePending = false;
+    }
+  }
+
+  void closeFile() {
+    if (fileOpen) {
+      replayFile.close();
+      fileOpen = false;
+    }
+  }
+
+  // read next sentence into 'pending', returns false at end of data
+  bool readNext() {
+    char line[REPLAY_LINE_SIZE];
+    while (true) {
+      if (fileOpen) {
+        if (replayFile.readLine(line, sizeof(line)) <= 0) {
+          return false;
+        }
+      } else if (sentences && nextSentence < numSentences) {
+        strncpy(line, sentences[nextSentence++], sizeof(line) - 1);
+        line[sizeof(line) - 1] = 0;
+      } else {
+        return false;
+      }
+
+      // accept console log lines such as "12345 $GPRMC,..." by starting at the '$'
+      char *dollar = strchr(line, '$');
+      if (dollar) {
+        strncpy(pending, dollar, sizeof(pending) - 1);
+        pending[sizeof(pending) - 1] = 0;
+        trimTrailingSpaces(pending);
+        pendingTime = sentenceTime(pending);
+        havePending = true;
+        return true;
+      }
+    }
+  }
+
+  void trimTrailingSpaces(char *text) {
+    int len = strlen(text);
+    while (len > 0 && isspace(text[len - 1])) {
+      text[--len] = 0;
+    }
+  }
+
+  // extract "hhmmss.sss" from RMC or GGA as msec, or REPLAY_NO_TIME for other sentences
+  uint32_t sentenceTime(const char *nmea) {
+    // e.g. "$GPRMC,123519.000,A,4807.038,N,..." where talker ID may be GP, GN, GL, etc
+    if (strlen(nmea) < 14 || (strncmp(nmea + 3, "RMC,", 4) != 0 && strncmp(nmea + 3, "GGA,", 4) != 0)) {
+      return REPLAY_NO_TIME;
+    }
+    const char *hms = nmea + 7;
+    for (int ii = 0; ii < 6; ii++) {
+      if (!isdigit(hms[ii])) {
+        return REPLAY_NO_TIME;
+      }
+    }
+    uint32_t hh  = (hms[0] - '0') * 10 + (hms[1] - '0');
+    uint32_t mm  = (hms[2] - '0') * 10 + (hms[3] - '0');
+    uint32_t ss  = (hms[4] - '0') * 10 + (hms[5] - '0');
+    uint32_t raw = ((hh * 60 + mm) * 60 + ss) * 1000;
+    if (hms[6] == '.') {
+      // MediaTek receivers send ".500" but others send ".5" or ".50", so scale each digit
+      uint32_t scale = 100;
+      for (const char *pp = hms + 7; isdigit(*pp) && scale > 0; pp++) {
+        raw += (*pp - '0') * scale;
+        scale /= 10;
+      }
+    }
+
+    if (firstTime != REPLAY_NO_TIME && raw + SECS_PER_DAY * 1000 / 2 < prevRawTime) {
+      dayOffset += SECS_PER_DAY * 1000;   // recording crossed midnight GMT
+    }
+    prevRawTime = raw;
+    return raw + dayOffset;
+  }
+
+};   // end class ReplayModel
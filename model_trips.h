@@ -0,0 +1,278 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     model_trips.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Split the breadcrumb trail into trips, with statistics for each.
+
+            A trip ends at power-up, after a gap of TRIP_STOP_SECONDS between
+            GPS breadcrumbs, or after standing still for TRIP_STOP_SECONDS.
+            The next trip starts when the vehicle moves again, from the
+            place where it was parked.
+
+            Statistics are updated as each breadcrumb arrives, so the cost
+            per crumb is fixed and the breadcrumb trail is never re-read:
+              distance, moving time, average and max speed,
+              distinct 4-char grids visited, and altitude climbed.
+
+            The last TRIP_TABLE_SIZE trips are saved in a small file when a
+            trip ends, and every TRIP_SAVE_CRUMBS crumbs during a trip.
+
+            The controller passes every new breadcrumb to observe(); see
+            Breadcrumbs::onRemember. The trips view shows them, and the console
+            command "dump trips" exports them as CSV.
+*/
+
+#include <Arduino.h>           //
+#include "constants.h"         // Griduino constants, colors, typedefs
+#include "logger.h"            // conditional printing to Serial port
+#include "grid_helper.h"       // lat/long conversion routines
+#include "date_helper.h"       // date/time conversions
+#include "format_helper.h"     // fixedToChars
+#include "save_restore.h"      // Configuration data in nonvolatile RAM
+
+// ========== extern ===========================================
+extern Logger logger;   // Griduino.ino
+extern Grids grid;      // grid_helper.h
+extern Dates date;      // date_helper.h
+
+// ========== struct TripRecord ================================
+// one row of the trip table, small enough to keep many and save them all
+struct TripRecord {
+  time_t start;              // GMT
+  time_t end;                // GMT, latest crumb so far
+  float miles;               // distance along the breadcrumbs
+  float maxMPH;              //
+  float climbMeters;         // total altitude gained
+  uint32_t movingSeconds;    // time spent above TRIP_MOVING_MPH
+  uint16_t crumbs;           // GPS breadcrumbs in this trip
+  uint16_t grids;            // distinct 4-char grids
+  char startGrid[7];         // 6-char grid where the trip started
+  bool open;                 // still adding crumbs
+
+  float averageMPH() const {
+    return movingSeconds ? (miles * 3600.0 / movingSeconds) : 0.0;
+  }
+};
+
+// ========== class TripEngine =================================
+class TripEngine {
+public:
+#define TRIP_FILE         CONFIG_FOLDER "/trips.cfg"   // must be 8.3 filename
+#define TRIP_VERSION      "Trips v01"
+#define TRIP_TABLE_SIZE   16          // trips kept and saved
+#define TRIP_STOP_SECONDS (20 * 60)   // a stop this long ends a trip
+#define TRIP_MOVING_MPH   3.0         // slower than this is standing still
+#define TRIP_CLIMB_METERS 5.0         // ignore altitude wobble smaller than this
+#define TRIP_SAVE_CRUMBS  25          // save an open trip this often
+#define TRIP_MAX_GRIDS    32          // distinct grids counted per trip
+
+  bool autosave = true;   // false for unit tests
+
+  // ----- the one entry point, once per breadcrumb
+  void observe(const Location &rec) {
+    if (rec.isPUP()) {
+      closeTrip(0);
+      haveLast     = false;
+      stoppedSince = 0;
+      return;
+    }
+    if (!rec.isGPS()) {
+      return;   // AOS, LOS, battery, etc
+    }
+
+    bool moving = rec.speed >= TRIP_MOVING_MPH;
+    long dt     = haveLast ? (long)(rec.timestamp - last.timestamp) : -1;
+    bool gap    = (dt < 0 || dt > TRIP_STOP_SECONDS);
+    if (gap) {
+      closeTrip(0);   // ends at its latest crumb
+      stoppedSince = 0;
+    }
+
+    if (!isOpen()) {
+      if (moving) {
+        startTrip(gap ? rec : last);   // begin where the vehicle was parked
+      }
+    }
+    if (isOpen() && !gap) {
+      addCrumb(rec, dt, moving);
+    }
+
+    // standing still for a long time also ends a trip
+    if (moving) {
+      stoppedSince = 0;
+    } else if (stoppedSince == 0) {
+      stoppedSince = rec.timestamp;
+    } else if (isOpen() && rec.timestamp - stoppedSince >= TRIP_STOP_SECONDS) {
+      closeTrip(stoppedSince);
+    }
+
+    last     = rec;
+    haveLast = true;
+  }
+
+  // ----- read the table, 0 = newest
+  int numTrips() const {
+    return count;
+  }
+  const TripRecord *trip(int back) const {
+    if (back < 0 || back >= count) {
+      return nullptr;
+    }
+    return &table[(newest + TRIP_TABLE_SIZE - back) % TRIP_TABLE_SIZE];
+  }
+  bool isOpen() const {
+    return count > 0 && table[newest].open;
+  }
+
+  void clear() {
+    count  = 0;
+    newest = TRIP_TABLE_SIZE - 1;
+    if (autosave) {
+      saveConfig();
+    }
+  }
+
+  // ----- USB export, oldest first
+  void dump() {
+    logger.print("Trip,Start GMT,End GMT,Start grid,Miles,Moving minutes,Average mph,Max mph,Climb meters,Grids,Crumbs,Open\n");
+    for (int back = count - 1; back >= 0; back--) {
+      const TripRecord *tt = trip(back);
+      char sStart[24], sEnd[24], sMiles[12], sAvg[12], sMax[12];
+      date.datetimeToString(sStart, sizeof(sStart), tt->start);
+      date.datetimeToString(sEnd, sizeof(sEnd), tt->end);
+      fixedToChars(sMiles, sizeof(sMiles), tt->miles, 1);
+      fixedToChars(sAvg, sizeof(sAvg), tt->averageMPH(), 1);
+      fixedToChars(sMax, sizeof(sMax), tt->maxMPH, 1);
+      char msg[160];
+      snprintf(msg, sizeof(msg), "%d,%s,%s,%s,%s,%lu,%s,%s,%d,%d,%d,%d\n",
+               count - back, sStart, sEnd, tt->startGrid, sMiles, (unsigned long)(tt->movingSeconds / 60),
+               sAvg, sMax, (int)round(tt->climbMeters), tt->grids, tt->crumbs, tt->open);
+      logger.print(msg);
+    }
+  }
+
+  // ----- persistence, same as other settings
+  void loadConfig() {
+    SaveRestore config(TRIP_FILE, TRIP_VERSION);
+    Saved saved;
+    if (config.readConfig((byte *)&saved, sizeof(saved))) {
+      if (saved.count >= 0 && saved.count <= TRIP_TABLE_SIZE && saved.newest >= 0 && saved.newest < TRIP_TABLE_SIZE) {
+        memcpy(table, saved.table, sizeof(table));
+        count  = saved.count;
+        newest = saved.newest;
+        logger.log(CONFIG, INFO, "Restored %d trips", count);
+      }
+    }
+  }
+  void saveConfig() {
+    SaveRestore config(TRIP_FILE, TRIP_VERSION);
+    Saved saved;
+    memcpy(saved.table, table, sizeof(table));
+    saved.count  = count;
+    saved.newest = newest;
+    config.writeConfig((byte *)&saved, sizeof(saved));
+  }
+
+protected:
+  TripRecord table[TRIP_TABLE_SIZE];   // ring, newest at table[newest]
+  int count  = 0;                      // trips in table
+  int newest = TRIP_TABLE_SIZE - 1;    // index of latest trip
+
+  struct Saved {
+    TripRecord table[TRIP_TABLE_SIZE];
+    int count;
+    int newest;
+  };
+
+  // ----- state of the open trip, not saved
+  Location last;                        // previous GPS crumb
+  bool haveLast        = false;         //
+  time_t stoppedSince  = 0;             // first crumb below TRIP_MOVING_MPH, 0 = moving
+  float altitudeRef    = 0.0;           // lowest altitude since the last counted climb
+  uint16_t gridSet[TRIP_MAX_GRIDS];     // 4-char grids seen, hashed, 0 = empty
+  int unsaved          = 0;             // crumbs since the last save
+
+  void startTrip(const Location &from) {
+    newest = (newest + 1) % TRIP_TABLE_SIZE;
+    count  = min(count + 1, TRIP_TABLE_SIZE);
+
+    TripRecord &tt   = table[newest];
+    tt.start         = from.timestamp;
+    tt.end           = from.timestamp;
+    tt.miles         = 0.0;
+    tt.maxMPH        = from.speed;
+    tt.climbMeters   = 0.0;
+    tt.movingSeconds = 0;
+    tt.crumbs        = 1;
+    tt.grids         = 0;
+    tt.open          = true;
+    grid.calcLocator(tt.startGrid, from.loc.lat, from.loc.lng, 6);
+
+    altitudeRef = from.altitude;
+    memset(gridSet, 0, sizeof(gridSet));
+    countGrid(tt, from.loc);
+    unsaved = 0;
+  }
+
+  void addCrumb(const Location &rec, long dt, bool moving) {
+    TripRecord &tt = table[newest];
+    tt.miles += grid.calcDistance(last.loc.lat, last.loc.lng, rec.loc.lat, rec.loc.lng, false);
+    if (moving) {
+      tt.movingSeconds += dt;
+    }
+    tt.maxMPH = max(tt.maxMPH, rec.speed);
+    if (rec.altitude < altitudeRef) {
+      altitudeRef = rec.altitude;
+    } else if (rec.altitude - altitudeRef >= TRIP_CLIMB_METERS) {
+      tt.climbMeters += rec.altitude - altitudeRef;
+      altitudeRef = rec.altitude;
+    }
+    countGrid(tt, rec.loc);
+    tt.end = rec.timestamp;
+    tt.crumbs++;
+
+    if (++unsaved >= TRIP_SAVE_CRUMBS && autosave) {
+      saveConfig();
+      unsaved = 0;
+    }
+  }
+
+  void closeTrip(time_t endTime) {
+    // endTime = 0 to end at the latest crumb
+    if (!isOpen()) {
+      return;
+    }
+    TripRecord &tt = table[newest];
+    if (endTime) {
+      tt.end = endTime;
+    }
+    tt.open = false;
+    logger.log(GPS_SETUP, INFO, "Trip ended after %d crumbs in %d grids", tt.crumbs, tt.grids);
+    if (autosave) {
+      saveConfig();
+    }
+  }
+
+  void countGrid(TripRecord &tt, const PointGPS loc) {
+    // small open-addressing set of 4-char grids, 0 = empty slot
+    uint16_t code = grid.squareIndex(loc.lat, loc.lng) + 1;
+    int slot      = code % TRIP_MAX_GRIDS;
+    for (int ii = 0; ii < TRIP_MAX_GRIDS; ii++, slot = (slot + 1) % TRIP_MAX_GRIDS) {
+      if (gridSet[slot] == code) {
+        return;   // seen it
+      }
+      if (gridSet[slot] == 0) {
+        gridSet[slot] = code;
+        tt.grids++;
+        return;
+      }
+    }
+    // set is full, stop counting
+  }
+};   // end class TripEngine
+
+// ========== extern ===========================================
+extern TripEngine trips;   // Griduino.ino
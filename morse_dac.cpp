@@ -267,14 +267,18 @@ void DACMorseSender::setMessage(const String newMessage) {
 }
 
 void DACMorseSender::sendBlocking() {
+  sendBlocking(message.c_str());
+}
+
+void DACMorseSender::sendBlocking(const char *text) {
   logger.logFloat(AUDIO, INFO, "Sending morse %s wpm", wpm, 1);
   if (dacSampleTime < 1) {
     // note "delayMicroseconds()" only works reliably down to 3 usec
     logger.log(AUDIO, ERROR, "DAC dacSampleTime < 1 usec. Did you call setup()?");
   }
 
-  for (int ii = 0; ii < message.length(); ii++) {
-    send(message.charAt(ii));
+  for (const char *pp = text; *pp; pp++) {
+    send(*pp);
   }
   send_word_space();
 }
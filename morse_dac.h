@@ -34,6 +34,7 @@ public:
   }
   void setMessage(const String newMessage) {}
   void sendBlocking() {}
+  void sendBlocking(const char *text) {}
   void unit_test() {}
   void dump() {}
   void send_dit() {}
@@ -94,6 +95,11 @@ public:
    */
   void sendBlocking();
 
+  /**
+   * Send the given text, without copying it into a String first.
+   */
+  void sendBlocking(const char *text);
+
   /**
    * Deprecated: use these for unit test
    */
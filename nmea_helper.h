@@ -0,0 +1,77 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     nmea_helper.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Build and check NMEA and PMTK sentences.
+
+            Every sentence ends in "*hh" where hh is the XOR of all characters
+            between '$' and '*'. Hand-typed checksums in string literals are easy
+            to get wrong, and the GPS receiver silently ignores a command with a
+            bad checksum, so commands are built here with the checksum computed:
+                char cmd[NMEA_MAX_LENGTH];
+                Nmea::makeSentence(cmd, sizeof(cmd), "PMTK220,%d", 100);
+                --> "$PMTK220,100*2F"
+*/
+
+#include <Arduino.h>   // for snprintf
+
+// ========== class Nmea =======================================
+class Nmea {
+public:
+#define NMEA_MAX_LENGTH 83   // longest legal sentence is 82 characters, plus null
+
+  // XOR of all characters after '$' and before '*' (or end of string)
+  static uint8_t checksum(const char *sentence) {
+    const char *pp = sentence;
+    if (*pp == '$') {
+      pp++;
+    }
+    uint8_t sum = 0;
+    while (*pp && *pp != '*') {
+      sum ^= (uint8_t)*pp++;
+    }
+    return sum;
+  }
+
+  // true if the sentence has "*hh" and it matches the computed checksum
+  static bool isChecksumValid(const char *sentence) {
+    if (sentence[0] != '$') {
+      return false;
+    }
+    const char *star = strchr(sentence, '*');
+    if (!star || !isxdigit(star[1]) || !isxdigit(star[2])) {
+      return false;
+    }
+    char hex[3] = {star[1], star[2], 0};
+    return strtol(hex, nullptr, 16) == checksum(sentence);
+  }
+
+  // printf-style body without '$' or '*', e.g. makeSentence(buf, len, "PMTK300,%d,0,0,0,0", 100)
+  // returns length of the finished sentence, or 0 if it didn't fit
+  static int makeSentence(char *result, int maxlen, const char *format, ...) {
+    if (maxlen < 5) {
+      return 0;
+    }
+    result[0] = '$';
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(result + 1, maxlen - 1, format, args);
+    va_end(args);
+    if (len < 0 || len + 5 > maxlen) {   // '$' + body + "*hh" + null
+      result[0] = 0;
+      return 0;
+    }
+    snprintf(result + 1 + len, maxlen - 1 - len, "*%02X", checksum(result));
+    return len + 4;
+  }
+
+  // true if this is a sentence of the given type, for any talker ID, e.g. isType(nmea, "RMC")
+  static bool isType(const char *sentence, const char *type) {
+    // "$GPRMC,..." or "$GNRMC,..." or "$GLRMC,..."
+    return sentence[0] == '$' && strlen(sentence) > 6 && strncmp(sentence + 3, type, 3) == 0 && sentence[6] == ',';
+  }
+
+};   // end class Nmea
@@ -0,0 +1,220 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     nmea_reader.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Read the GPS serial port and parse each fix on the RP2040's second core.
+
+            On a single core, the serial port is only emptied between the
+            other jobs of the main loop. A slow screen update or a save to
+            flash lets the receive buffer fill, and NMEA characters are lost
+            (see nmeaBufferFull in "show perf").
+
+            With DUAL_CORE defined, core 1 empties the serial port. It
+            collects characters into sentences, checks each checksum, and
+            passes good sentences to core 0 through a lock-free queue. It also
+            parses each RMC and GGA sentence itself and publishes the newest
+            fix through a Seqlock. Model::getGPS() on core 0 reads that fix
+            snapshot instead of the GPS object, so the position, speed and
+            satellites shown by the views all come from one consistent fix.
+
+              core 1:  Serial1 --> add() --> checksum --> lines (SpscQueue)
+                                                     \--> fixParser --> latestFix (Seqlock)
+              core 0:  lines --> nextSentence() --> GPS.parse() --> clock, first fix, fix rate
+                       latestFix --> Model::getGPS() --> model --> views
+
+            Core 0 still parses every sentence too, for the things that read
+            the GPS object directly: setting the clock, time to first fix,
+            and counting the fix rate. The model, views, console and storage
+            stay on core 0.
+
+            Core 1's counters are published through a second Seqlock, so
+            "show cores" on core 0 always reports a consistent set.
+
+            SpscQueue and Seqlock are stress tested on two desktop threads
+            under ThreadSanitizer, see extras/host_test/inter_core_stress.cpp.
+*/
+
+#include <Arduino.h>        //
+#include <Adafruit_GPS.h>   // "Ultimate GPS" library, parse-only on core 1
+#include "logger.h"         // conditional printing to Serial port
+#include "nmea_helper.h"    // NMEA sentence checksums
+#include "inter_core.h"     // SpscQueue and Seqlock
+
+// ========== extern ===========================================
+extern Logger logger;   // Griduino.ino
+
+// ========== struct NmeaLine ==================================
+struct NmeaLine {
+  char text[NMEA_MAX_LENGTH];   // one sentence, without CR/LF
+};
+
+// ========== struct GpsFix ====================================
+// the fields of Adafruit_GPS that Model::readGPS() copies, with the same names,
+// so the model can read either one
+struct GpsFix {
+  bool fix;                  // true = lat/long are valid
+  double latitudeDegrees;    //
+  double longitudeDegrees;   //
+  float altitude;            // meters above MSL
+  float speed;               // knots
+  float angle;               // degrees from N
+  float HDOP;                // horizontal dilution of precision
+  uint8_t satellites;        //
+  uint8_t year;              // last two digits
+  uint8_t month;             //
+  uint8_t day;               //
+  uint8_t hour;              // GMT
+  uint8_t minute;            //
+  uint8_t seconds;           //
+};
+
+// ========== struct NmeaReaderStats ===========================
+// everything core 1 counts, published as a set
+struct NmeaReaderStats {
+  uint32_t chars;         // characters read from the serial port
+  uint32_t sentences;     // good sentences queued for core 0
+  uint32_t badChecksum;   // rejected by the checksum
+  uint32_t tooLong;       // longer than NMEA_MAX_LENGTH, rejected
+  uint32_t dropped;       // lost because core 0 fell behind
+  uint32_t bufferFull;    // times the serial receive buffer was found full, not characters lost
+  uint32_t maxDepth;      // most sentences waiting for core 0
+  uint32_t fixes;         // RMC and GGA parsed and published in latestFix
+};
+
+// ========== class NmeaReader =================================
+class NmeaReader {
+public:
+#define NMEA_QUEUE_SIZE 32   // sentences waiting for core 0, over a second of 10 Hz fixes
+
+  SpscQueue<NmeaLine, NMEA_QUEUE_SIZE> lines;   // core 1 --> core 0
+  Seqlock<GpsFix> latestFix;                    // core 1 --> core 0, see Model::getGPS()
+  Seqlock<NmeaReaderStats> published;           // core 1 --> core 0
+
+  // ----- core 1: empty the serial port
+  void poll(Stream &port) {
+#ifdef SERIAL_BUFFER_SIZE
+    if (port.available() >= SERIAL_BUFFER_SIZE - 1) {
+      stats.bufferFull++;   // receive buffer is full, so incoming NMEA characters are being dropped
+    }
+#endif
+    bool finished = false;
+    while (port.available()) {
+      finished |= add((char)port.read());
+    }
+    if (finished) {
+      publish();
+    }
+  }
+
+  // ----- core 1: one character from the receiver
+  // returns true at the end of a sentence, good or bad
+  bool add(char cc) {
+    stats.chars++;
+    if (cc == '$') {
+      length   = 0;   // start of sentence, forget any partial one
+      overlong = false;
+    }
+    if (cc == '\n') {
+      return finish();
+    }
+    if (cc == '\r') {
+      return false;
+    }
+    if (length < NMEA_MAX_LENGTH - 1) {
+      partial[length++] = cc;
+    } else {
+      overlong = true;
+    }
+    return false;
+  }
+
+  // ----- core 1: make the counters visible to core 0
+  void publish() {
+    stats.dropped = lines.dropped();
+    published.write(stats);
+  }
+
+  // ----- core 0: next good sentence, if any
+  bool nextSentence(NmeaLine *line) {
+    return lines.pop(line);
+  }
+
+  // ----- core 0: "show cores" console command
+  void report() {
+    NmeaReaderStats copy;
+    if (!published.read(&copy)) {
+      logger.log(COMMAND, CONSOLE, "Core 1 is busy, try again");
+      return;
+    }
+    char msg[120];
+    snprintf(msg, sizeof(msg), "Core 1 read %lu chars, queued %lu sentences, %d waiting, at most %lu",
+             (unsigned long)copy.chars, (unsigned long)copy.sentences, lines.depth(), (unsigned long)copy.maxDepth);
+    logger.log(COMMAND, CONSOLE, msg);
+    snprintf(msg, sizeof(msg), "Rejected %lu bad checksums, %lu too long, dropped %lu, serial buffer found full %lu times",
+             (unsigned long)copy.badChecksum, (unsigned long)copy.tooLong,
+             (unsigned long)copy.dropped, (unsigned long)copy.bufferFull);
+    logger.log(COMMAND, CONSOLE, msg);
+    snprintf(msg, sizeof(msg), "Published %lu fixes to the model", (unsigned long)copy.fixes);
+    logger.log(COMMAND, CONSOLE, msg);
+  }
+
+protected:
+  NmeaReaderStats stats = {};      // owned by core 1, see publish()
+  char partial[NMEA_MAX_LENGTH];   // sentence so far
+  int length    = 0;               //
+  bool overlong = false;           // ran out of room, so the sentence is no good
+  Adafruit_GPS fixParser;          // parse-only, does not touch the serial port
+
+  // ----- core 1: parse a position sentence and publish the fix it completes
+  void parseFix(char *sentence) {
+    if (!Nmea::isType(sentence, "RMC") && !Nmea::isType(sentence, "GGA")) {
+      return;
+    }
+    if (!fixParser.parse(sentence)) {
+      return;
+    }
+    GpsFix snapshot;
+    snapshot.fix              = fixParser.fix;
+    snapshot.latitudeDegrees  = fixParser.latitudeDegrees;
+    snapshot.longitudeDegrees = fixParser.longitudeDegrees;
+    snapshot.altitude         = fixParser.altitude;
+    snapshot.speed            = fixParser.speed;
+    snapshot.angle            = fixParser.angle;
+    snapshot.HDOP             = fixParser.HDOP;
+    snapshot.satellites       = fixParser.satellites;
+    snapshot.year             = fixParser.year;
+    snapshot.month            = fixParser.month;
+    snapshot.day              = fixParser.day;
+    snapshot.hour             = fixParser.hour;
+    snapshot.minute           = fixParser.minute;
+    snapshot.seconds          = fixParser.seconds;
+    latestFix.write(snapshot);
+    stats.fixes++;
+  }
+
+  bool finish() {
+    if (length == 0) {
+      return false;   // blank line
+    }
+    NmeaLine line;
+    memcpy(line.text, partial, length);
+    line.text[length] = 0;
+    length            = 0;
+    if (overlong) {
+      stats.tooLong++;
+      overlong = false;
+    } else if (!Nmea::isChecksumValid(line.text)) {
+      stats.badChecksum++;
+    } else {
+      if (lines.push(line)) {
+        stats.sentences++;
+        stats.maxDepth = max(stats.maxDepth, (uint32_t)lines.depth());
+      }
+      parseFix(line.text);   // after push(), which took its own copy
+    }
+    return true;
+  }
+};   // end class NmeaReader
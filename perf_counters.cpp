@@ -0,0 +1,81 @@
+// Please format this file with clang before check-in to GitHub
+/*
+  File:     perf_counters.cpp - performance counter reports
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+*/
+
+#include <Arduino.h>             // for Serial
+#include <Adafruit_ILI9341.h>    // TFT color display library
+#include "constants.h"           // Griduino constants, colors and typedefs
+#include "logger.h"              // conditional printing to Serial port
+#include "model_breadcrumbs.h"   // breadcrumb trail
+#include "perf_counters.h"       // performance counters
+
+// ========== extern ===========================================
+extern Logger logger;                // Griduino.ino
+extern Adafruit_ILI9341 tft;         // Griduino.ino
+extern Breadcrumbs trail;            // Griduino.ino
+extern void setFontSize(int font);   // TextField.cpp
+
+// ----- helper
+static void reportSaves(const char *name, const SaveStats &stats) {
+  char msg[80];
+  uint32_t average = stats.count ? (stats.totalMillis / stats.count) : 0;
+  snprintf(msg, sizeof(msg), "%s saves = %lu, average = %lu msec, slowest = %lu msec",
+           name, (unsigned long)stats.count, (unsigned long)average, (unsigned long)stats.maxMillis);
+  logger.log(COMMAND, CONSOLE, msg);
+}
+
+void PerfCounters::report() {
+  char msg[80];
+  snprintf(msg, sizeof(msg), "Main loop passes = %lu, slowest = %lu usec",
+           (unsigned long)loopCount, (unsigned long)loopMaxMicros);
+  logger.log(COMMAND, CONSOLE, msg);
+
+  for (int ii = 0; ii < PERF_BUCKETS; ii++) {
+    if (loopHistogram[ii]) {
+      unsigned long lo = (ii == 0) ? 0 : (1UL << ii);
+      unsigned long hi = (1UL << (ii + 1)) - 1;
+      snprintf(msg, sizeof(msg), "   %8lu .. %8lu usec: %lu", lo, hi, (unsigned long)loopHistogram[ii]);
+      logger.log(COMMAND, CONSOLE, msg);
+    }
+  }
+
+  snprintf(msg, sizeof(msg), "NMEA parsed = %lu, failed = %lu, fixes lost = %lu",
+           (unsigned long)nmeaParsed, (unsigned long)nmeaFailed, (unsigned long)nmeaFixesLost);
+  logger.log(COMMAND, CONSOLE, msg);
+  snprintf(msg, sizeof(msg), "Serial receive buffer found full = %lu times", (unsigned long)nmeaBufferFull);
+  logger.log(COMMAND, CONSOLE, msg);
+
+  snprintf(msg, sizeof(msg), "Breadcrumbs recorded = %lu", (unsigned long)trail.recordsAdded);
+  logger.log(COMMAND, CONSOLE, msg);
+
+  reportSaves("Breadcrumb trail", trailSaves);
+  reportSaves("Config file", configSaves);
+
+  logger.log(COMMAND, CONSOLE, "Screen updates by view ID:");
+  for (int ii = 0; ii < PERF_MAX_VIEWS; ii++) {
+    if (viewUpdates[ii]) {
+      snprintf(msg, sizeof(msg), "   [%2d] = %lu", ii, (unsigned long)viewUpdates[ii]);
+      logger.log(COMMAND, CONSOLE, msg);
+    }
+  }
+}
+
+void PerfCounters::showOverlay() {
+  // called once per second, shows loop rate and worst loop time
+  // Note: this changes the current font, which is fine for views that specify a font for each TextField
+  char msg[48];
+  snprintf(msg, sizeof(msg), "%5lu loops/s %4lu ms max %3lu fixes lost ",
+           (unsigned long)(loopCount - prevCount), (unsigned long)(loopMaxMicros / 1000), (unsigned long)nmeaFixesLost);
+  setFontSize(eFONTSYSTEM);
+  tft.setTextSize(1);
+  tft.setTextColor(cWARN, ILI9341_BLACK);
+  tft.setCursor(2, gScreenHeight - 10);
+  tft.print(msg);
+
+  prevCount = loopCount;
+}
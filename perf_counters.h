@@ -0,0 +1,127 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     perf_counters.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Always-on performance counters. Everything here is a few integer
+            additions, cheap enough to leave in production builds.
+
+            1. Histogram of main loop iteration times, in log2 buckets of microseconds:
+                  bucket[0] = 0..1 us, bucket[1] = 2..3 us, bucket[n] = 2^n .. 2^(n+1)-1 us
+            2. NMEA sentences parsed, failed checksum/parse, and fixes lost,
+               i.e. RMC sentences that never arrived, found from gaps in the
+               receiver's timestamps. Also the times the serial receive buffer
+               was found full, which is usually why they were lost.
+            3. Breadcrumbs recorded
+            4. Saves to flash, with count, total and worst duration
+            5. Screen updates per view
+
+            The console command "show perf" reports everything, and
+            "show perf overlay" adds a one-line summary to the bottom of the screen.
+*/
+
+#include <Arduino.h>   // for micros()
+
+// ========== struct SaveStats =================================
+struct SaveStats {
+  uint32_t count       = 0;   // number of saves
+  uint32_t totalMillis = 0;   // sum of all durations
+  uint32_t maxMillis   = 0;   // slowest save
+
+  void add(uint32_t msec) {
+    count++;
+    totalMillis += msec;
+    if (msec > maxMillis) {
+      maxMillis = msec;
+    }
+  }
+};
+
+// ========== class PerfCounters ===============================
+class PerfCounters {
+public:
+#define PERF_BUCKETS   24   // 2^24 us = 16 seconds, anything slower goes in the last bucket
+#define PERF_MAX_VIEWS 32   // indexed by screenID
+
+  // ----- main loop
+  uint32_t loopHistogram[PERF_BUCKETS] = {0};
+  uint32_t loopCount     = 0;
+  uint32_t loopMaxMicros = 0;
+
+  // ----- GPS
+  uint32_t nmeaParsed     = 0;   // sentences parsed successfully
+  uint32_t nmeaFailed     = 0;   // sentences rejected by parser (bad checksum, unknown type)
+  uint32_t nmeaFixesLost  = 0;   // RMC sentences that never arrived, from gaps in their timestamps
+  uint32_t nmeaBufferFull = 0;   // loop passes that found the serial receive buffer full;
+                                 // some characters were probably lost, but not how many
+
+  // ----- saves to flash memory
+  SaveStats trailSaves;    // breadcrumb trail CSV file
+  SaveStats configSaves;   // all other config files
+
+  // ----- screen
+  uint32_t viewUpdates[PERF_MAX_VIEWS] = {0};
+  bool overlay = false;   // true = show summary on screen, see "show perf overlay"
+
+  // call once at the top of each pass through loop()
+  void startLoop() {
+    uint32_t nowMicros = micros();
+    if (loopCount > 0) {
+      uint32_t elapsed = nowMicros - loopStart;   // unsigned difference survives wrap-around
+      loopHistogram[bucket(elapsed)]++;
+      if (elapsed > loopMaxMicros) {
+        loopMaxMicros = elapsed;
+      }
+    }
+    loopStart = nowMicros;
+    loopCount++;
+  }
+
+  void countViewUpdate(int screenID) {
+    if (screenID >= 0 && screenID < PERF_MAX_VIEWS) {
+      viewUpdates[screenID]++;
+    }
+  }
+
+  static int bucket(uint32_t usec) {
+    int bb = 31 - __builtin_clz(usec | 1);   // floor(log2(usec))
+    return (bb < PERF_BUCKETS) ? bb : PERF_BUCKETS - 1;
+  }
+
+  void clear() {
+    bool keepOverlay = overlay;
+    *this            = PerfCounters();
+    overlay          = keepOverlay;
+  }
+
+  void report();        // send all counters to console
+  void showOverlay();   // one-line summary at bottom of screen
+
+protected:
+  uint32_t loopStart = 0;
+  uint32_t prevCount = 0;   // loopCount at the last overlay, reset by clear()
+
+};   // end class PerfCounters
+
+// ========== extern ===========================================
+extern PerfCounters perf;   // Griduino.ino
+
+// ========== scoped timer for saves ===========================
+// Example:  int saveSomething() {
+//             PerfSaveTimer timer(perf.configSaves);
+//             ...
+//           }
+class PerfSaveTimer {
+public:
+  PerfSaveTimer(SaveStats &vStats)
+      : stats(vStats), start(millis()) {}
+  ~PerfSaveTimer() {
+    stats.add(millis() - start);
+  }
+
+protected:
+  SaveStats &stats;
+  uint32_t start;
+};   // end class PerfSaveTimer
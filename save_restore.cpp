@@ -30,6 +30,8 @@
 #include "constants.h"           // Griduino constants and colors
 #include "save_restore.h"        // class definition
 #include "logger.h"              // conditional printing to Serial port
+#include "tracer.h"              // software tracer
+#include "perf_counters.h"       // performance counters
 #include <SPI.h>                 // Serial Peripheral Interface
 #include <SdFat.h>               // SDRAM File Allocation Table filesystem
 #include <Adafruit_SPIFlash.h>   // for FAT filesystems on SPI flash chips.
@@ -83,38 +85,53 @@ int SaveRestore::readConfig(byte *pData, const unsigned int sizeData) {
   logger.log(FILES, DEBUG, ". Current position in file: %d", readFile.position());
   logger.log(FILES, DEBUG, ". Available data remaining to read: %d", readFile.available());
 
+  // a damaged or truncated file must never be copied into our caller's object,
+  // so every field must be read in full and the file must be exactly the expected size
+  if (readFile.size() != sizeof(fqFilename) + sizeof(sVersion) + sizeData) {
+    logger.log(FILES, ERROR, "unexpected file size, %s", fqFilename);
+    readFile.close();
+    return 0;
+  }
+
   // read first field (filename) from config file...
   char temp[sizeof(fqFilename)];   // buffer size is as large as our largest member variable
   int count = readFile.read(temp, sizeof(fqFilename));
   logger.dumpHex(FILES, DEBUG, "fqFilename", temp, sizeof(fqFilename));   // debug
-  if (count == -1) {
+  if (count != sizeof(fqFilename)) {
     logger.log(FILES, ERROR, "failed to read first field, %s", fqFilename);
+    readFile.close();
     return 0;
   }
+  temp[sizeof(temp) - 1] = 0;   // in case file contains garbage
 
   // verify first field (filename) stored inside file exactly matches expected
   if (strcmp(temp, this->fqFilename) != 0) {
     logger.log(FILES, ERROR, "unexpected filename, %s", temp);
+    readFile.close();
     return 0;
   }
 
   // read second field (version string) from config file...
   count = readFile.read(temp, sizeof(sVersion));
   logger.dumpHex(FILES, DEBUG, "sVersion", temp, sizeof(sVersion));   // debug
-  if (count == -1) {
+  if (count != sizeof(sVersion)) {
     logger.log(FILES, ERROR, "failed to read version number, %s", fqFilename);
+    readFile.close();
     return 0;
   }
+  temp[sizeof(sVersion) - 1] = 0;   // in case file contains garbage
   // verify second field (version string) stored in file exactly matches expected
   if (strcmp(temp, this->sVersion) != 0) {
     logger.log(FILES, ERROR, "Error, unexpected version, got (%s) and expected(%s)", temp, this->sVersion);
+    readFile.close();
     return 0;
   }
   // data looks good, read third field (setting) and use its value
   count = readFile.read(pData, sizeData);
   logger.dumpHex(FILES, DEBUG, "pData", (char *)pData, sizeData);   // debug
-  if (count == -1) {
+  if (count != (int)sizeData) {
     logger.log(FILES, ERROR, "failed to read integer value from %s", fqFilename);
+    readFile.close();
     return 0;
   }
 
@@ -136,6 +153,8 @@ int SaveRestore::writeConfig(const byte *pData, const unsigned int sizeData) {
   // initialize configuration file in file system, called by setup() if needed
   // assumes this is Feather M4 Express with 2 MB Quad-SPI flash memory
   // returns 1=success, 0=failure
+  TraceScope trace(eTraceSaveConfig);
+  PerfSaveTimer timer(perf.configSaves);
   logger.log(FILES, INFO, "Writing file: %s", fqFilename);
 
   int result = openFlash();   // open file system and report errors
@@ -0,0 +1,276 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     touch_events.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Touchscreen driver that turns pressure and position into gestures.
+
+            The main loop calls update() on every pass, and the resistive
+            panel is read when the next TOUCH_SAMPLE_MSEC sample is due. Each
+            sample goes through:
+
+              1. pressure hysteresis     press > START_TOUCH_PRESSURE, release < END_TOUCH_PRESSURE
+              2. debounce                TOUCH_PRESS_SAMPLES in a row to start, TOUCH_RELEASE_SAMPLES to end
+              3. position filter         only firm samples count, smoothed against jitter
+              4. gesture classifier      tap, long press, or swipe left/right/up/down
+
+            Gestures go into a small queue that the controller drains once
+            per pass through the main loop. A swipe left or right changes
+            views without having to hit the small arrow in the corner.
+
+            Limitation: sampling is polled, not driven by a timer interrupt,
+            because the panel's X+ and Y- lines are pins 24 and 25 on the
+            Feather M4, the SPI bus shared with the display; reading the panel
+            in the middle of a screen update would garble it. So no samples are
+            taken while the loop is blocked, e.g. sending Morse code or saving
+            to flash. A press that is still held afterwards is seen; a tap
+            that begins and ends inside the blocking call is lost. Gesture
+            timing is only as steady as the loop.
+
+            GestureClassifier knows nothing about the hardware, so the unit
+            test replays recorded touch traces through it: tap, long press,
+            swipes, and contact bounce at both ends of a press. That test
+            runs on the device with "run modeltest", and on the desktop with
+            the rest of the unit tests in extras/host_test.
+*/
+
+#include <Arduino.h>                 //
+#include <Resistive_Touch_Screen.h>   // Touchscreen built in to 3.2" Adafruit TFT display
+#include "constants.h"               // Griduino constants, colors, typedefs
+#include "hardware.h"                // touchscreen calibration
+#include "logger.h"                  // conditional printing to Serial port
+
+// ========== extern ===========================================
+extern Logger logger;   // Griduino.ino
+
+// ----- alias names for gestures
+enum TouchGesture {
+  eNoGesture = 0,
+  eTap,          // short press in one place
+  eLongPress,    // held in one place, reported while still held
+  eSwipeLeft,    // finger moved right-to-left
+  eSwipeRight,   //
+  eSwipeUp,      //
+  eSwipeDown,    //
+};
+
+// ========== struct TouchEvent ================================
+struct TouchEvent {
+  TouchGesture gesture;   //
+  Point at;               // screen coords where the finger first landed
+  uint32_t msec;          // millis() when the gesture was recognized
+};
+
+// ========== class GestureClassifier ==========================
+class GestureClassifier {
+public:
+#define TOUCH_PRESS_SAMPLES   2     // firm samples in a row to start a press
+#define TOUCH_RELEASE_SAMPLES 3     // light samples in a row to end a press
+#define TOUCH_SLOP_PIXELS     12    // movement smaller than this is still a tap
+#define TOUCH_SWIPE_PIXELS    60    // movement at least this far is a swipe
+#define TOUCH_LONG_MSEC       700   // held this long without moving is a long press
+#define TOUCH_SWIPE_MSEC      800   // slower than this is a drag, not a swipe
+
+  // ----- one sample of the panel
+  // pressure = raw pressure, larger is firmer, 0 = not touched
+  // returns a finished gesture, or eNoGesture
+  TouchGesture add(int pressure, Point where, uint32_t msec) {
+    bool firm  = pressure > START_TOUCH_PRESSURE;
+    bool light = pressure < END_TOUCH_PRESSURE;
+
+    if (!pressed) {
+      pressCount = firm ? pressCount + 1 : 0;
+      if (pressCount == 1) {
+        startMillis = msec;   // finger landed on the first firm sample, not the last
+      }
+      if (pressCount >= TOUCH_PRESS_SAMPLES) {
+        pressed      = true;
+        longReported = false;
+        releaseCount = 0;
+        start        = where;
+        current      = where;
+      }
+      return eNoGesture;
+    }
+
+    // ----- pressed
+    releaseCount = light ? releaseCount + 1 : 0;
+    if (releaseCount >= TOUCH_RELEASE_SAMPLES) {
+      pressed    = false;
+      pressCount = 0;
+      return classify(msec);
+    }
+    if (firm) {
+      // a resistive panel reads nonsense positions when lightly touched,
+      // so only firm samples move the point, and then only half way
+      current.x += (where.x - current.x) / 2;
+      current.y += (where.y - current.y) / 2;
+    }
+    if (!longReported && !moved() && msec - startMillis >= TOUCH_LONG_MSEC) {
+      longReported = true;
+      return eLongPress;
+    }
+    return eNoGesture;
+  }
+
+  bool isPressed() const {
+    return pressed;
+  }
+  Point startPoint() const {
+    return start;
+  }
+
+  void reset() {
+    *this = GestureClassifier();
+  }
+
+protected:
+  bool pressed         = false;   // debounced state
+  bool longReported    = false;   // already reported this press as a long press
+  int pressCount       = 0;       // firm samples in a row
+  int releaseCount     = 0;       // light samples in a row
+  uint32_t startMillis = 0;       //
+  Point start          = {0, 0};  // where the press began
+  Point current        = {0, 0};  // filtered position
+
+  bool moved() const {
+    return abs(current.x - start.x) >= TOUCH_SLOP_PIXELS || abs(current.y - start.y) >= TOUCH_SLOP_PIXELS;
+  }
+
+  TouchGesture classify(uint32_t msec) const {
+    int dx = current.x - start.x;
+    int dy = current.y - start.y;
+    if (!moved()) {
+      return longReported ? eNoGesture : eTap;   // a long press was already reported
+    }
+    if (msec - startMillis > TOUCH_SWIPE_MSEC) {
+      return eNoGesture;   // slow drag
+    }
+    if (abs(dx) >= abs(dy)) {
+      if (abs(dx) < TOUCH_SWIPE_PIXELS) {
+        return eNoGesture;
+      }
+      return (dx < 0) ? eSwipeLeft : eSwipeRight;
+    } else {
+      if (abs(dy) < TOUCH_SWIPE_PIXELS) {
+        return eNoGesture;
+      }
+      return (dy < 0) ? eSwipeUp : eSwipeDown;
+    }
+  }
+};   // end class GestureClassifier
+
+// ========== class TouchEvents ================================
+class TouchEvents {
+public:
+#define TOUCH_SAMPLE_MSEC 10   // 100 samples/second
+#define TOUCH_QUEUE_SIZE  8    // more than enough for one slow pass through the main loop
+
+  GestureClassifier classifier;   //
+  uint32_t samples = 0;           // panel readings since power-up
+  uint32_t dropped = 0;           // events lost to a full queue
+  uint32_t counts[eSwipeDown + 1] = {0};   // events of each kind
+
+  // ----- call on every pass through the main loop
+  // reads the panel when the next sample is due
+  void update(Resistive_Touch_Screen &panel, int width, int height, int rotation) {
+    uint32_t rightnow = millis();
+    if ((int32_t)(rightnow - nextSample) < 0) {
+      return;   // not yet
+    }
+    nextSample += TOUCH_SAMPLE_MSEC;
+    if ((int32_t)(rightnow - nextSample) >= 0) {
+      nextSample = rightnow + TOUCH_SAMPLE_MSEC;   // fell behind, e.g. a save to flash, so don't catch up
+    }
+    TSPoint raw = panel.getPoint();
+    add(raw.z, mapTouchToScreen(raw, width, height, rotation), rightnow);
+  }
+
+  // ----- one sample, from the panel or from a unit test
+  void add(int pressure, Point where, uint32_t msec) {
+    samples++;
+    TouchGesture gesture = classifier.add(pressure, where, msec);
+    if (gesture != eNoGesture) {
+      push(TouchEvent{gesture, classifier.startPoint(), msec});
+    }
+  }
+
+  // ----- the controller drains the queue
+  bool pop(TouchEvent *event) {
+    if (head == tail) {
+      return false;
+    }
+    *event = queue[tail];
+    tail   = (tail + 1) % TOUCH_QUEUE_SIZE;
+    return true;
+  }
+
+  // ----- convert raw readings to screen pixels
+  // calibrated in landscape, same as examples/Altimeter/Altimeter.ino
+  static Point mapTouchToScreen(TSPoint raw, int width, int height, int rotation) {
+    Point landscape;
+    bool portrait = (rotation == PORTRAIT || rotation == FLIPPED_PORTRAIT);
+    int wide      = portrait ? height : width;   // size of the screen in landscape
+    int high      = portrait ? width : height;
+    landscape.x   = map(raw.y, X_MIN_OHMS, X_MAX_OHMS, 0, wide);
+    landscape.y   = map(raw.x, Y_MAX_OHMS, Y_MIN_OHMS, 0, high);
+
+    Point screen;
+    switch (rotation) {
+    case PORTRAIT:
+      screen = {high - landscape.y, landscape.x};
+      break;
+    case FLIPPED_PORTRAIT:
+      screen = {landscape.y, wide - landscape.x};
+      break;
+    case FLIPPED_LANDSCAPE:
+      screen = {wide - landscape.x, high - landscape.y};
+      break;
+    case LANDSCAPE:
+    default:
+      screen = landscape;
+      break;
+    }
+    return screen;
+  }
+
+  // ----- "show touch" console command
+  void report() {
+    char msg[96];
+    snprintf(msg, sizeof(msg), "Touch: %lu samples every %d msec, %lu events dropped",
+             (unsigned long)samples, TOUCH_SAMPLE_MSEC, (unsigned long)dropped);
+    logger.log(COMMAND, CONSOLE, msg);
+    snprintf(msg, sizeof(msg), "Taps %lu, long presses %lu, swipes left %lu, right %lu, up %lu, down %lu",
+             (unsigned long)counts[eTap], (unsigned long)counts[eLongPress],
+             (unsigned long)counts[eSwipeLeft], (unsigned long)counts[eSwipeRight],
+             (unsigned long)counts[eSwipeUp], (unsigned long)counts[eSwipeDown]);
+    logger.log(COMMAND, CONSOLE, msg);
+  }
+
+  void reset() {
+    classifier.reset();
+    head = tail = 0;
+  }
+
+protected:
+  TouchEvent queue[TOUCH_QUEUE_SIZE];   // ring, one slot always empty
+  int head            = 0;              // next slot to fill
+  int tail            = 0;              // next slot to drain
+  uint32_t nextSample = 0;              // millis()
+
+  void push(const TouchEvent &event) {
+    counts[event.gesture]++;
+    int next = (head + 1) % TOUCH_QUEUE_SIZE;
+    if (next == tail) {
+      dropped++;   // keep the older events, they happened first
+      return;
+    }
+    queue[head] = event;
+    head        = next;
+  }
+};   // end class TouchEvents
+
+// ========== extern ===========================================
+extern TouchEvents touchEvents;   // Griduino.ino
@@ -0,0 +1,80 @@
+// Please format this file with clang before check-in to GitHub
+/*
+  File:     tracer.cpp - software tracer output
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Start the cycle counter and send the trace ring to the console.
+            Example output, one line per event:
+                {"traceEvents":[
+                {"name":"model update","ph":"B","ts":1234.567,"pid":1,"tid":1,"args":{"arg":0}},
+                {"name":"model update","ph":"E","ts":1301.250,"pid":1,"tid":1,"args":{"arg":0}},
+                {}]}
+*/
+
+#include <Arduino.h>    // for Serial
+#include "constants.h"  // Griduino constants, colors and typedefs
+#include "logger.h"     // conditional printing to Serial port
+#include "tracer.h"     // software tracer
+
+// ========== extern ===========================================
+extern Logger logger;   // Griduino.ino
+
+// ----- names for Chrome trace viewer, MUST be in same order as enum TraceID
+const char *traceNames[numTraceIDs] = {
+    "gps parse",      // eTraceGpsParse
+    "model update",   // eTraceModelUpdate
+    "view update",    // eTraceViewUpdate
+    "view start",     // eTraceViewStart
+    "save trail",     // eTraceSaveTrail
+    "save config",    // eTraceSaveConfig
+    "audio",          // eTraceAudio
+    "command",        // eTraceCommand
+};
+
+void Tracer::begin() {
+#if defined(SAMD_SERIES)
+  // enable the Cortex-M4 cycle counter
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+#ifdef SCOPE_OUTPUT
+  pinMode(SCOPE_OUTPUT, OUTPUT);   // optional oscilloscope output
+#endif
+}
+
+void Tracer::dump() {
+#if defined(SAMD_SERIES)
+  const uint32_t ticksPerMicrosecond = F_CPU / 1000000;   // cycle counter
+#else
+  const uint32_t ticksPerMicrosecond = 1;   // micros()
+#endif
+  bool wasEnabled = enabled;
+  enabled         = false;   // don't trace ourselves while sending
+
+  logger.print("{\"traceEvents\":[\n");
+  uint64_t elapsed = 0;   // ticks since oldest event
+  int index        = (head - count) & (TRACE_RING_SIZE - 1);
+  uint32_t prev    = ring[index].ticks;
+  for (int ii = 0; ii < count; ii++) {
+    const TraceEvent &ev = ring[index];
+    elapsed += (uint32_t)(ev.ticks - prev);   // unsigned difference survives counter wrap-around
+    prev = ev.ticks;
+
+    uint32_t usec = elapsed / ticksPerMicrosecond;
+    uint32_t frac = (elapsed % ticksPerMicrosecond) * 1000 / ticksPerMicrosecond;
+    const char *name = (ev.id < numTraceIDs) ? traceNames[ev.id] : "?";
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%lu.%03lu,\"pid\":1,\"tid\":1,\"args\":{\"arg\":%d}},\n",
+             name, ev.phase, (unsigned long)usec, (unsigned long)frac, ev.arg);
+    logger.print(msg);
+    index = (index + 1) & (TRACE_RING_SIZE - 1);
+  }
+  logger.print("{}]}\n");   // empty object lets every event line end with a comma
+  logger.log(COMMAND, CONSOLE, "%d events, %d overwritten", count, dropped);
+
+  enabled = wasEnabled;
+}
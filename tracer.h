@@ -0,0 +1,115 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     tracer.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Lightweight software tracer for performance measurements in the field.
+            This replaces the oscilloscope on SCOPE_OUTPUT, so no extra hardware is needed.
+
+            Code of interest is wrapped in a scoped marker:
+                {
+                  TraceScope trace(eTraceModelUpdate);   // begin
+                  model->processGPS();
+                }                                        // end, when 'trace' goes out of scope
+
+            Each begin/end is an 8-byte event in a fixed RAM ring. The ring always
+            holds the most recent events. The console command "trace dump" sends them
+            as Chrome trace JSON; save console output to a file and open it with
+            chrome://tracing or https://ui.perfetto.dev
+
+            Timestamps come from the DWT cycle counter on SAMD51 (120 MHz, wraps every 35 seconds)
+            and from micros() elsewhere. Only differences between consecutive events are
+            used, so wrap-around is harmless as long as something is traced more often than that.
+*/
+
+#include <Arduino.h>   // for micros()
+
+// ----- Trace markers
+enum TraceID {
+  eTraceGpsParse = 0,   // parse one NMEA sentence
+  eTraceModelUpdate,    // model->processGPS()
+  eTraceViewUpdate,     // pView->updateScreen(), arg = screenID
+  eTraceViewStart,      // pView->startScreen(), arg = screenID
+  eTraceSaveTrail,      // write breadcrumb trail to flash
+  eTraceSaveConfig,     // write one config file to flash
+  eTraceAudio,          // Morse code or speech announcement
+  eTraceCommand,        // console command
+  numTraceIDs,          // array size
+};
+
+struct TraceEvent {
+  uint32_t ticks;   // cycle counter or microseconds
+  uint8_t id;       // enum TraceID
+  uint8_t phase;    // 'B' = begin, 'E' = end
+  uint16_t arg;     // optional detail, e.g. screenID
+};
+
+class Tracer {
+public:
+#define TRACE_RING_SIZE 256   // number of events, must be a power of two
+
+  bool enabled     = true;
+  uint32_t dropped = 0;   // number of oldest events overwritten
+
+  void begin();     // start the cycle counter
+  void dump();      // send ring to console as Chrome trace JSON
+  void clear() {
+    head = count = 0;
+  }
+
+  uint32_t ticks() {
+#if defined(SAMD_SERIES)
+    return DWT->CYCCNT;
+#else
+    return micros();
+#endif
+  }
+
+  void record(TraceID id, char phase, uint16_t arg) {
+    if (enabled) {
+      TraceEvent &ev = ring[head];
+      ev.ticks       = ticks();
+      ev.id          = id;
+      ev.phase       = phase;
+      ev.arg         = arg;
+      head           = (head + 1) & (TRACE_RING_SIZE - 1);
+      if (count < TRACE_RING_SIZE) {
+        count++;
+      } else {
+        dropped++;
+      }
+#ifdef SCOPE_OUTPUT
+      if (id == eTraceViewUpdate) {
+        digitalWrite(SCOPE_OUTPUT, (phase == 'B') ? HIGH : LOW);   // optional oscilloscope output
+      }
+#endif
+    }
+  }
+
+protected:
+  TraceEvent ring[TRACE_RING_SIZE];
+  uint16_t head  = 0;   // next event to write
+  uint16_t count = 0;   // number of valid events in ring
+
+};   // end class Tracer
+
+// ========== extern ===========================================
+extern Tracer tracer;   // Griduino.ino
+
+// ========== scoped marker ====================================
+class TraceScope {
+public:
+  TraceScope(TraceID vID, uint16_t vArg = 0)
+      : id(vID), arg(vArg) {
+    tracer.record(id, 'B', arg);
+  }
+  ~TraceScope() {
+    tracer.record(id, 'E', arg);
+  }
+
+protected:
+  TraceID id;
+  uint16_t arg;
+};   // end class TraceScope
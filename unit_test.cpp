@@ -7,6 +7,7 @@
 */
 
 #include <Arduino.h>             // for Serial
+#include <malloc.h>              // for mallinfo()
 #include "constants.h"           // Griduino constants and colors
 #include "Adafruit_ILI9341.h"    // TFT color display library
 #include "morse_dac.h"           // Morse code
@@ -14,10 +15,25 @@
 #include "logger.h"              // conditional printing to Serial port
 #include "model_breadcrumbs.h"   // breadcrumb trail
 #include "model_gps.h"           // Class Model (for model-view-controller)
+#include "model_replay.h"        // Model that replays a recorded NMEA log
+#include "gps_rate.h"            // optional 5 or 10 Hz GPS fixes
+#include "gnss_stats.h"          // satellites per constellation
+#include "warm_start.h"          // position hint for faster first fix
+#include "nmea_helper.h"         // NMEA sentence checksums
 #include "TextField.h"           // Optimize TFT display text for proportional fonts
+#include "glyph_atlas.h"         // giant grid name drawn as horizontal runs
+#include "map_projection.h"      // lat/long to screen at any scale
+#include "model_trips.h"         // trips and their statistics
+#include "model_geofence.h"      // county lines, contest areas and exclusion zones
+#include "model_baro.h"          // Model of a barometer that stores 3-day history
+#include "model_altitude.h"      // barometer and GPS altitude, fused
+#include "model_adc.h"           // coin battery voltage and its trend
+#include "touch_events.h"        // touchscreen gestures
+#include "nmea_reader.h"         // lock-free queue and seqlock between cores
 #include "view.h"                // Base class for all views
 #include "grid_helper.h"         // lat/long conversion routines
 #include "date_helper.h"         // date/time conversions
+#include "format_helper.h"       // number to text without the heap
 
 // ========== extern ===========================================
 extern void setFontSize(int font);   // TextField.cpp
@@ -27,15 +43,31 @@ extern void clearScreen();           // Griduino.ino
 extern Adafruit_ILI9341 tft;             // Griduino.ino
 extern DACMorseSender dacMorse;          // Morse code
 extern Model *model;                     // "model" portion of model-view-controller
-extern ViewGrid gridView;                // Griduino.ino
+extern int grid_view;                    // Griduino.ino
 extern Logger logger;                    // Griduino.ino
 extern Breadcrumbs trail;                // model of breadcrumb trail
+extern BarometerModel baroModel;         // singleton instance of the barometer model
 extern void showDefaultTouchTargets();   // Griduino.ino
 extern Grids grid;                       // grid_helper.h
 extern Dates date;                       // date_helper.h
 
 TextField txtTest("test", 1, 21, ILI9341_WHITE);
 
+// ----- compare a number against a range
+//       returns 1 and logs both, with the caller's line number, if it's outside
+int testRange(const char *name, double actual, double low, double high, int line, int places = 2) {
+  if (actual >= low && actual <= high) {
+    return 0;
+  }
+  char sActual[16], sLow[16], sHigh[16], msg[120];
+  fixedToChars(sActual, sizeof(sActual), actual, places);
+  fixedToChars(sLow, sizeof(sLow), low, places);
+  fixedToChars(sHigh, sizeof(sHigh), high, places);
+  snprintf(msg, sizeof(msg), "[%d] %s is %s, expected %s to %s <-- Unequal", line, name, sActual, sLow, sHigh);
+  logger.log(FILES, CONSOLE, msg);
+  return 1;
+}
+
 // =============================================================
 // Testing routines in view_grid_crossings.h
 // This relies on "TimeLib.h" which uses "time_t" to represent time.
@@ -44,8 +76,7 @@ TextField txtTest("test", 1, 21, ILI9341_WHITE);
 // time_t is typecast to 'unsigned long int', our compiler guarantees at least 32 bits
 // https://github.com/PaulStoffregen/Time
 
-#include "view_grid_crossings.h"              // List of time spent in each grid
-extern ViewGridCrossings gridCrossingsView;   // view_grid_crossings.h
+#include "view_grid_crossings.h"   // List of time spent in each grid
 
 // =============================================================
 int testNMEAtime(const time_t expected, uint8_t yr, uint8_t mo, uint8_t day,
@@ -112,7 +143,7 @@ int testTimeDiff(const char *sExpected, time_t time1, time_t time2) {
   long int nDays    = (time2 - time1) / SECS_PER_DAY;
 
   char sActual[16] = "todo";
-  gridCrossingsView.calcTimeDiff(sActual, sizeof(sActual), time1, time2);
+  ViewGridCrossings::calcTimeDiff(sActual, sizeof(sActual), time1, time2);
 
   Serial.print("Time difference from ");
   Serial.print(time1);
@@ -494,7 +525,8 @@ int verifyBreadCrumbs() {
   trail.saveInterval = 20;   // default 2 is too often, 100 is not often enough
 
   // initialize the canvas that we will draw upon
-  gridView.startScreen();   // clear and draw normal screen
+  ViewGrid gridView(&tft, grid_view);   // only 32 bytes, its text fields are in view_grid.cpp
+  gridView.startScreen();              // clear and draw normal screen
   txtTest.print();
   txtTest.dirty = true;
   txtTest.print();
@@ -534,7 +566,8 @@ int verifyBreadCrumbTrail1() {
   int r = 0;
 
   // initialize the canvas to draw on
-  gridView.startScreen();   // clear and draw normal screen
+  ViewGrid gridView(&tft, grid_view);   // only 32 bytes, its text fields are in view_grid.cpp
+  gridView.startScreen();              // clear and draw normal screen
   txtTest.dirty = true;
   txtTest.print();
 
@@ -596,7 +629,8 @@ int verifyBreadCrumbTrail2(int howMany) {
   int r = 0;
 
   // initialize the canvas to draw on
-  gridView.startScreen();   // clear and draw normal screen
+  ViewGrid gridView(&tft, grid_view);   // only 32 bytes, its text fields are in view_grid.cpp
+  gridView.startScreen();              // clear and draw normal screen
   txtTest.dirty = true;     // paint big "Test" in upper left
   txtTest.print();
 
@@ -725,6 +759,1381 @@ int verifyComputingGridLines() {
   return r;
 }
 // =============================================================
+// verify deferred logging keeps records in RAM until drained
+int verifyDeferredLog() {
+  logger.fencepost("unittest.cpp", "verifyDeferredLog", __LINE__);
+  int fails       = 0;
+  LogMode oldMode = logger.logMode;
+  bool oldLevel   = logger.printLevel[INFO].enabled;
+  bool oldSystem  = logger.printSystem[FILES].enabled;
+
+  logger.printLevel[INFO].enabled   = true;
+  logger.printSystem[FILES].enabled = true;
+
+  if (!logger.setMode(LOG_DEFERRED)) {
+    // this build has no ring, so deferred mode must stay off
+    if (logger.logMode != LOG_DIRECT) {
+      Serial.println("Deferred mode was accepted without a ring <-- Unequal");
+      fails++;
+    }
+    logger.printLevel[INFO].enabled   = oldLevel;
+    logger.printSystem[FILES].enabled = oldSystem;
+    return fails;
+  }
+  uint32_t dropped = logger.recordsDropped;
+  logger.log(FILES, INFO, "deferred text");
+  logger.log(FILES, INFO, "deferred int %d, %d", 12, 34);
+  logger.logTwoFloats(FILES, INFO, "deferred floats %s, %s", 1.5, 1, 2.25, 2);
+  if (logger.pending() == 0) {
+    Serial.println("Deferred records were not saved <-- Unequal");
+    fails++;
+  }
+  logger.drain(3);   // expected output: the three lines above
+  if (logger.pending() != 0) {
+    Serial.println("Deferred records were not drained <-- Unequal");
+    fails++;
+  }
+
+  // text longer than a record holds is cut short, and says so
+  char longText[200];
+  memset(longText, 'x', sizeof(longText) - 1);
+  longText[sizeof(longText) - 1] = 0;
+  logger.log(FILES, INFO, longText);   // expected output: x's ending in "..."
+  if (logger.pending() != LOG_HEADER_SIZE + (LOG_RECORD_SIZE - LOG_HEADER_SIZE) / 2) {
+    Serial.println("Long text was not cut to fit one record <-- Unequal");
+    fails++;
+  }
+  logger.drain(1);
+
+  // overfill the ring, which must count the losses instead of blocking
+  for (int ii = 0; ii < LOG_RING_SIZE; ii++) {
+    logger.log(FILES, INFO, "overflow %d", ii);
+  }
+  if (logger.recordsDropped == dropped) {
+    Serial.println("Full ring did not count dropped records <-- Unequal");
+    fails++;
+  }
+  logger.setMode(oldMode);   // flushes the overflow test messages
+
+  logger.printLevel[INFO].enabled   = oldLevel;
+  logger.printSystem[FILES].enabled = oldSystem;
+  return fails;
+}
+// =============================================================
+// verify the breadcrumb ring buffer in RAM, without painting or saving
+int verifyBreadcrumbRing() {
+  logger.fencepost("unittest.cpp", "verifyBreadcrumbRing", __LINE__);
+  int fails = 0;
+
+  const TimeElements validDate{0, 0, 12, 0, 1, 6, (2023 - 1970)};   // June 1, 2023
+  const TimeElements bogusDate{0, 0, 12, 0, 1, 1, (2000 - 1970)};   // GPS buffer overrun
+  const time_t validTime = makeTime(validDate);
+  const time_t bogusTime = makeTime(bogusDate);
+  PointGPS here{47.5, -122.5};   // CN87
+
+  trail.clearHistory();
+  for (int ii = 0; ii < 10; ii++) {
+    trail.rememberGPS(here, validTime + ii, 5, 10.0, 45.0, 123.0);
+  }
+  if (trail.getHistoryCount() != 10) {
+    logger.log(FILES, CONSOLE, "Expected 10 breadcrumbs, actual %d <-- Unequal", trail.getHistoryCount());
+    fails++;
+  }
+
+  trail.rememberGPS(here, bogusTime, 5, 10.0, 45.0, 123.0);   // must be ignored
+  if (trail.getHistoryCount() != 10) {
+    logger.log(FILES, CONSOLE, "Bogus year-2000 breadcrumb was not ignored <-- Unequal");
+    fails++;
+  }
+
+  // overfill the ring, the oldest entries must be overwritten
+  for (int ii = 0; ii < trail.capacity; ii++) {
+    trail.rememberGPS(here, validTime + 100 + ii, 5, 10.0, 45.0, 123.0);
+  }
+  if (trail.getHistoryCount() != trail.capacity) {
+    logger.log(FILES, CONSOLE, "Expected %d breadcrumbs, actual %d <-- Unequal", trail.capacity, trail.getHistoryCount());
+    fails++;
+  }
+
+  int count     = 0;
+  Location *loc = trail.begin();
+  if (loc->timestamp != validTime + 100) {
+    logger.log(FILES, CONSOLE, "Oldest breadcrumb was not overwritten <-- Unequal");
+    fails++;
+  }
+  while (loc) {
+    count++;
+    loc = trail.next();
+  }
+  if (count != trail.capacity) {
+    logger.log(FILES, CONSOLE, "Iterated %d breadcrumbs, expected %d <-- Unequal", count, trail.capacity);
+    fails++;
+  }
+
+  trail.clearHistory();
+  return fails;
+}
+// =============================================================
+// verify the map projection, and the map's integer copy of the trail
+int testScreenPoint(Point actual, int xx, int yy, int slop, int line) {
+  if (abs(actual.x - xx) <= slop && abs(actual.y - yy) <= slop) {
+    return 0;
+  }
+  char msg[80];
+  snprintf(msg, sizeof(msg), "[%d] Expected (%d,%d), actual (%d,%d) <-- Unequal", line, xx, yy, actual.x, actual.y);
+  logger.log(FILES, CONSOLE, msg);
+  return 1;
+}
+
+int verifyMapProjection() {
+  logger.fencepost("unittest.cpp", "verifyMapProjection", __LINE__);
+  int fails = 0;
+
+  // same box as the grid view, CN87
+  const Rect gridBox{{70, 26}, {180, 160}};
+  MapProjection cn87(PointGPS{47.0, -124.0}, 2.0, 1.0, gridBox);
+  fails += testScreenPoint(cn87.toScreen(PointGPS{47.0, -124.0}), 70, 186, 0, __LINE__);   // lower left
+  fails += testScreenPoint(cn87.toScreen(PointGPS{48.0, -122.0}), 250, 26, 0, __LINE__);   // upper right
+  fails += testScreenPoint(cn87.toScreen(PointGPS{47.5, -123.0}), 160, 106, 0, __LINE__);  // center
+
+  // fit a trail and its copy in integers
+  const TimeElements validDate{0, 0, 12, 0, 1, 6, (2023 - 1970)};   // June 1, 2023
+  const time_t validTime = makeTime(validDate);
+  MapTrail testMapTrail;   // the map view's integer copy
+  trail.clearHistory();
+  for (int ii = 0; ii < 50; ii++) {
+    PointGPS loc{47.2 + ii * 0.004, -123.5 + ii * 0.01};
+    trail.rememberGPS(loc, validTime + ii, 5, 10.0, 45.0, 123.0);
+  }
+  testMapTrail.update(trail);
+  testMapTrail.update(trail);   // unchanged trail must not be walked again
+  if (testMapTrail.count != 50 || testMapTrail.crumbs != 50 || testMapTrail.builds != 1) {
+    logger.log(FILES, CONSOLE, "Map trail kept %d of %d crumbs <-- Unequal", testMapTrail.count, testMapTrail.crumbs);
+    fails++;
+  }
+  MapProjection fitted = MapProjection::fit(testMapTrail.lowerLeft, testMapTrail.upperRight, gridBox);
+  testMapTrail.setProjection(fitted);
+  int ii        = 0;
+  Location *loc = trail.begin();
+  while (loc && ii < testMapTrail.count) {
+    Point expected = fitted.toScreen(loc->loc);
+    if (!fitted.isVisible(expected)) {
+      logger.log(FILES, CONSOLE, "Breadcrumb %d is outside the fitted map", ii);
+      fails++;
+    }
+    fails += testScreenPoint(testMapTrail.toScreen(ii), expected.x, expected.y, 1, __LINE__);
+    ii++;
+    loc = trail.next();
+  }
+
+  // a long trail is thinned
+  for (int jj = 0; jj < 2 * MAP_TRAIL_POINTS; jj++) {
+    PointGPS loc{47.5, -122.5 + jj * 0.0001};
+    trail.rememberGPS(loc, validTime + 100 + jj, 5, 10.0, 45.0, 123.0);
+  }
+  testMapTrail.update(trail);
+  if (testMapTrail.count > MAP_TRAIL_POINTS || testMapTrail.step < 2 || testMapTrail.builds != 2) {
+    logger.log(FILES, CONSOLE, "Long trail was not thinned, kept %d with step %d", testMapTrail.count, testMapTrail.step);
+    fails++;
+  }
+
+  trail.clearHistory();
+  return fails;
+}
+// =============================================================
+// verify trip segmentation and statistics, fed one breadcrumb at a time
+int verifyTrips() {
+  logger.fencepost("unittest.cpp", "verifyTrips", __LINE__);
+  int fails = 0;
+  TripEngine testTrips;
+  testTrips.autosave = false;   // keep the user's trip table
+  testTrips.clear();
+
+  const TimeElements validDate{0, 0, 12, 0, 1, 6, (2023 - 1970)};   // June 1, 2023
+  time_t stamp = makeTime(validDate);
+  PointGPS loc{47.5, -122.2};   // CN87, 3 miles from CN97
+  const PointGPS start = loc;
+  testTrips.observe(Location{rPOWERUP, loc, stamp, 0, 0, 0.0, 0.0, 0.0});
+
+  // parked, then 30 minutes east at 30 mph and 2 meters up per minute, one crumb per minute
+  for (int ii = 0; ii < 3; ii++) {
+    testTrips.observe(Location{rGPS, loc, stamp += 60, 6, 0, 0.0, 0.0, 100.0});
+  }
+  float degreesPerHalfMile = 0.5 / grid.calcDistanceLong(loc.lat, 0.0, 1.0, false);
+  for (int ii = 1; ii <= 30; ii++) {
+    loc.lng += degreesPerHalfMile;
+    float speed = (ii == 10) ? 45.0 : 30.0;
+    testTrips.observe(Location{rGPS, loc, stamp += 60, 6, 0, speed, 90.0, (float)(100 + 2 * ii)});
+  }
+  if (testTrips.numTrips() != 1 || !testTrips.isOpen()) {
+    logger.log(FILES, CONSOLE, "Expected one open trip, actual %d", testTrips.numTrips());
+    fails++;
+  }
+
+  // stopped for half an hour ends the trip where it stopped
+  time_t parked = stamp + 60;
+  for (int ii = 0; ii < 30; ii++) {
+    testTrips.observe(Location{rGPS, loc, stamp += 60, 6, 0, 0.0, 0.0, 160.0});
+  }
+  const TripRecord *first = testTrips.trip(0);
+  if (testTrips.isOpen() || !first || first->end != parked) {
+    logger.log(FILES, CONSOLE, "Long stop did not end the trip");
+    return fails + 1;
+  }
+  fails += testRange("Trip miles", first->miles, 14.9, 15.1, __LINE__);
+  fails += testRange("Trip moving minutes", first->movingSeconds / 60, 30, 30, __LINE__);
+  fails += testRange("Trip average mph", first->averageMPH(), 29.9, 30.1, __LINE__);
+  fails += testRange("Trip max mph", first->maxMPH, 45.0, 45.0, __LINE__);
+  fails += testRange("Trip climb meters", first->climbMeters, 55.0, 60.0, __LINE__);
+  fails += testRange("Trip grids", first->grids, 2, 2, __LINE__);
+  fails += testRange("Trip crumbs", first->crumbs, 31, 61, __LINE__);
+  char grid6[7];
+  grid.calcLocator(grid6, start.lat, start.lng, 6);
+  if (first->start != makeTime(validDate) + 3 * 60 || strcmp(first->startGrid, grid6) != 0) {
+    logger.log(FILES, CONSOLE, "Trip should start at the parked crumb in %s, not %s", grid6, first->startGrid);
+    fails++;
+  }
+
+  // moving again starts a second trip, power-up ends it
+  testTrips.observe(Location{rGPS, loc, stamp += 60, 6, 0, 20.0, 90.0, 160.0});
+  testTrips.observe(Location{rPOWERUP, loc, stamp += 60, 0, 0, 0.0, 0.0, 0.0});
+  // a long gap between crumbs also separates trips
+  testTrips.observe(Location{rGPS, loc, stamp += 7200, 6, 0, 20.0, 90.0, 160.0});
+  if (testTrips.numTrips() != 3 || !testTrips.isOpen() || testTrips.trip(1)->open || testTrips.trip(2)->miles != first->miles) {
+    logger.log(FILES, CONSOLE, "Expected three trips with the newest open, actual %d", testTrips.numTrips());
+    fails++;
+  }
+
+  // the table keeps only the newest trips
+  for (int ii = 0; ii < TRIP_TABLE_SIZE; ii++) {
+    testTrips.observe(Location{rGPS, loc, stamp += 7200, 6, 0, 20.0, 90.0, 160.0});
+  }
+  if (testTrips.numTrips() != TRIP_TABLE_SIZE || testTrips.trip(TRIP_TABLE_SIZE) != nullptr) {
+    logger.log(FILES, CONSOLE, "Trip table has %d trips, expected %d", testTrips.numTrips(), TRIP_TABLE_SIZE);
+    fails++;
+  }
+  return fails;
+}
+// =============================================================
+// verify geofence containment near vertices, the file format, and the bucket index
+int testFence(int fence, double lat, double lng, bool expected, int line) {
+  if (geofence.contains(fence, PointGPS{lat, lng}) == expected) {
+    return 0;
+  }
+  char sLat[12], sLng[12], msg[100];
+  fixedToChars(sLat, sizeof(sLat), lat, 5);
+  fixedToChars(sLng, sizeof(sLng), lng, 5);
+  snprintf(msg, sizeof(msg), "[%d] Fence %s at %s, %s should be %s <-- Unequal", line,
+           geofence.fence(fence).name, sLat, sLng, expected ? "inside" : "outside");
+  logger.log(FILES, CONSOLE, msg);
+  return 1;
+}
+
+int verifyGeofence() {
+  logger.fencepost("unittest.cpp", "verifyGeofence", __LINE__);
+  int fails = 0;
+  const double e = 0.0001;   // about 30 feet
+
+  // ----- square, diamond, U-shape and circle
+  geofence.reserve(4, 16);
+  char lines[][40] = {
+      "# test fences",
+      "polygon,BOX", "47.0,-122.2", "47.0,-122.0", "47.1,-122.0", "47.1,-122.2", "end",
+      "polygon,DIAMOND", "47.5,-122.5", "47.6,-122.4", "47.5,-122.3", "47.4,-122.4", "end",
+      "polygon,U", "47.2,-122.9", "47.2,-122.6", "47.4,-122.6", "47.4,-122.7",
+      "47.3,-122.7", "47.3,-122.8", "47.4,-122.8", "47.4,-122.9", "end",
+      "circle,HOME,47.7,-122.3,1.0",
+  };
+  for (char *line : lines) {
+    if (!geofence.parseLine(line)) {
+      logger.log(FILES, CONSOLE, "Geofence line not understood: %s", line);
+      fails++;
+    }
+  }
+  char bad[][40] = {"circle,BAD,abc,-122.3,1.0", "circle,BAD,47.7,-122.3,-1", "47.0", "end", "square,X"};
+  for (char *line : bad) {
+    if (geofence.parseLine(line)) {
+      logger.log(FILES, CONSOLE, "Geofence line should be rejected: %s", line);
+      fails++;
+    }
+  }
+  if (geofence.numFences() != 4) {
+    logger.log(FILES, CONSOLE, "Expected 4 geofences, actual %d", geofence.numFences());
+    return fails + 1;
+  }
+
+  // clang-format off
+  fails += testFence(0, 47.0 + e, -122.2 + e, true,  __LINE__);   // just inside each corner
+  fails += testFence(0, 47.1 - e, -122.0 - e, true,  __LINE__);
+  fails += testFence(0, 47.0 - e, -122.2 + e, false, __LINE__);   // just outside
+  fails += testFence(0, 47.0 + e, -122.2 - e, false, __LINE__);
+  fails += testFence(0, 47.1 + e, -122.0 - e, false, __LINE__);
+  fails += testFence(1, 47.5,     -122.45,    true,  __LINE__);   // ray goes through the east vertex
+  fails += testFence(1, 47.5,     -122.55,    false, __LINE__);   // ray goes through both side vertices
+  fails += testFence(1, 47.6 - e, -122.4,     true,  __LINE__);   // below the top vertex
+  fails += testFence(1, 47.6 + e, -122.4,     false, __LINE__);   // above it
+  fails += testFence(1, 47.5,     -122.3 + e, false, __LINE__);   // beside the east vertex
+  fails += testFence(2, 47.35,    -122.75,    false, __LINE__);   // in the notch of the U
+  fails += testFence(2, 47.35,    -122.85,    true,  __LINE__);   // in its arms
+  fails += testFence(2, 47.35,    -122.65,    true,  __LINE__);
+  fails += testFence(2, 47.3 - e, -122.75,    true,  __LINE__);   // just below the notch
+  fails += testFence(3, 47.7 + 0.9 / 69.09, -122.3, true,  __LINE__);   // 0.9 miles north of center
+  fails += testFence(3, 47.7 + 1.1 / 69.09, -122.3, false, __LINE__);   // 1.1 miles north
+  // clang-format on
+
+  // ----- a circle and a polygon across the antimeridian, found through the index
+  geofence.reserve(2, 4);
+  geofence.addCircle("DATELINE", PointGPS{-16.0, 179.95}, 10.0);   // Fiji
+  geofence.beginPolygon("WRAP");
+  geofence.addVertex(PointGPS{50.0, 179.0});
+  geofence.addVertex(PointGPS{50.0, -179.0});
+  geofence.addVertex(PointGPS{52.0, -179.0});
+  geofence.addVertex(PointGPS{52.0, 179.0});
+  geofence.endPolygon();
+  // clang-format off
+  fails += testFence(0, -16.0,  179.99, true,  __LINE__);   // either side of the line
+  fails += testFence(0, -16.0, -179.99, true,  __LINE__);
+  fails += testFence(0, -16.0, -179.70, false, __LINE__);   // east of the circle
+  fails += testFence(1,  51.0,  179.50, true,  __LINE__);
+  fails += testFence(1,  51.0, -179.50, true,  __LINE__);
+  fails += testFence(1,  51.0,    0.0,  false, __LINE__);   // not the long way around
+  fails += testFence(1,  51.0, -178.50, false, __LINE__);
+  // clang-format on
+  Geofence::Event crossed;
+  geofence.check(PointGPS{-16.0, -179.99});
+  if (!geofence.nextEvent(crossed) || crossed.fence != 0 || !crossed.entered) {
+    logger.log(FILES, CONSOLE, "Geofence index missed a fence across the antimeridian");
+    fails++;
+  }
+
+  // ----- hundreds of fences, the index must agree with testing every fence
+  const int manyFences = 250;
+  geofence.reserve(manyFences, manyFences / 2 * 3);
+  for (int ii = 0; ii < manyFences; ii++) {
+    PointGPS center{46.6 + (ii % 10) * 0.3, -124.4 + (ii / 10) * 0.5};   // 10 x 25 fences, CN86 to DN49
+    char name[8];
+    snprintf(name, sizeof(name), "F%d", ii);
+    if (ii % 2) {
+      geofence.beginPolygon(name);
+      geofence.addVertex(PointGPS{center.lat - 0.1, center.lng - 0.15});
+      geofence.addVertex(PointGPS{center.lat - 0.1, center.lng + 0.15});
+      geofence.addVertex(PointGPS{center.lat + 0.1, center.lng});
+      geofence.endPolygon();
+    } else {
+      geofence.addCircle(name, center, 8.0);
+    }
+  }
+  bool inside[manyFences] = {false};
+  int mismatches = 0, crossings = 0;
+  uint32_t tests      = geofence.tests;
+  const int numFixes  = 1200;
+  unsigned long start = micros();
+  unsigned long spent = 0;
+  for (int ii = 0; ii < numFixes; ii++) {
+    PointGPS fix{46.6 + ii * 0.0023, -124.4 + ii * 0.0105 + 0.05 * sin(ii / 10.0)};   // wiggle east through the fences
+    unsigned long before = micros();
+    geofence.check(fix);
+    Geofence::Event event;
+    while (geofence.nextEvent(event)) {
+      inside[event.fence] = event.entered;
+      crossings++;
+    }
+    spent += micros() - before;
+    for (int ff = 0; ff < geofence.numFences(); ff++) {
+      if (inside[ff] != geofence.contains(ff, fix)) {
+        mismatches++;
+      }
+    }
+  }
+  unsigned long perFix = spent / numFixes;
+  float testsPerFix    = (float)(geofence.tests - tests) / numFixes;
+  char sTests[12], msg[100];
+  fixedToChars(sTests, sizeof(sTests), testsPerFix, 1);
+  snprintf(msg, sizeof(msg), "%d fences, %d crossings, %lu usec and %s fences tested per fix, %lu msec total",
+           geofence.numFences(), crossings, perFix, sTests, (micros() - start) / 1000);
+  logger.log(FILES, CONSOLE, msg);
+  if (geofence.numFences() != manyFences || mismatches || crossings < 10 || testsPerFix > 25) {
+    logger.log(FILES, CONSOLE, "Geofence index disagrees %d times with testing every fence", mismatches);
+    fails++;
+  }
+
+  geofence.loadFences();   // put back user's fences
+  return fails;
+}
+// =============================================================
+// verify the barometer serves cached readings without reading the sensor again
+int verifyBaroSampling() {
+  logger.fencepost("unittest.cpp", "verifyBaroSampling", __LINE__);
+  int fails = 0;
+
+  // ----- altitude formula, standard atmosphere
+  fails += testRange("Baro sea level", BarometerModel::altitudeFromPressure(101325.0, 101325.0), -0.1, 0.1, __LINE__);
+  fails += testRange("Baro 1000 m", BarometerModel::altitudeFromPressure(89874.6, 101325.0), 995.0, 1005.0, __LINE__);
+  fails += testRange("Baro 3000 m", BarometerModel::altitudeFromPressure(70108.5, 101325.0), 2985.0, 3015.0, __LINE__);
+
+  // ----- a fresh cached reading is served to everyone, with no sensor reads
+  baroModel.testSample(89874.6, 21.5, millis());
+  uint32_t reads = baroModel.busReads;
+  for (int ii = 0; ii < 100; ii++) {
+    baroModel.getBaroPressure();
+    baroModel.getTemperature();
+    baroModel.getAltitude(101325.0);
+    baroModel.update();
+  }
+  fails += testRange("Baro pressure", baroModel.getBaroPressure(), 89874.5, 89874.7, __LINE__);
+  fails += testRange("Baro inHg", baroModel.inchesHg, 26.53, 26.55, __LINE__);
+  fails += testRange("Baro celsius", baroModel.getTemperature(), 21.49, 21.51, __LINE__);
+  fails += testRange("Baro altitude", baroModel.getAltitude(101325.0), 995.0, 1005.0, __LINE__);
+  fails += testRange("Baro sensor reads", baroModel.busReads - reads, 0, 0, __LINE__);
+
+  // ----- a stale reading is replaced by one from the sensor
+  baroModel.testSample(89874.6, 21.5, millis() - BARO_SAMPLE_MSEC - 1);
+  fails += testRange("Baro update", baroModel.update(), 1, 1, __LINE__);
+  fails += testRange("Baro sensor reads", baroModel.busReads - reads, 1, 3, __LINE__);
+  fails += testRange("Baro age", baroModel.sampleAge(), 0, BARO_SAMPLE_MSEC, __LINE__);
+  return fails;
+}
+// =============================================================
+// verify sea level calibration and the barometer + GPS altitude filter
+float pressureAt(float meters) {
+  // standard atmosphere, Pascals
+  return 101325.0 * pow(1.0 - meters / 44330.0, 1.0 / 0.1903);
+}
+
+int verifyAltitudeFusion() {
+  logger.fencepost("unittest.cpp", "verifyAltitudeFusion", __LINE__);
+  int fails = 0;
+
+  // ----- closed-form sea level pressure is the inverse of the altitude formula
+  float sealevel = BarometerModel::sealevelFromAltitude(95000.0, 500.0);
+  fails += testRange("Baro inverse", BarometerModel::altitudeFromPressure(95000.0, sealevel), 499.9, 500.1, __LINE__);
+  fails += testRange("Baro standard", BarometerModel::sealevelFromAltitude(pressureAt(1000.0), 1000.0), 101320.0, 101330.0, __LINE__);
+
+  // ----- first good fix calibrates at once
+  AltitudeFusion testFusion;
+  uint32_t msec = 1000;
+  testFusion.update(pressureAt(100.0), msec, true, 150.0, 1.0, 8);
+  fails += testRange("Baro calibrated", testFusion.calibrated, 1, 1, __LINE__);
+  fails += testRange("Baro first", testFusion.altitude, 149.9, 150.1, __LINE__);
+
+  // ----- climb at 1 m/sec for a minute, GPS agrees
+  for (int ii = 1; ii <= 60; ii++) {
+    testFusion.update(pressureAt(100.0 + ii), msec += 1000, true, 150.0 + ii, 1.0, 8);
+  }
+  fails += testRange("Baro climbing", testFusion.altitude, 209.0, 211.0, __LINE__);
+  fails += testRange("Baro climb rate", testFusion.climbRate, 0.95, 1.05, __LINE__);
+  Location crumb;
+  crumb.altitude = 0;
+  testFusion.annotate(&crumb);
+  fails += testRange("Baro crumb altitude", crumb.altitude, 209.0, 211.0, __LINE__);
+  fails += testRange("Baro crumb climb", crumb.climbRate, 95, 105, __LINE__);
+
+  // ----- hold still, GPS disagrees by 20 m: a good fix pulls hard, a poor fix gently
+  for (int ii = 0; ii < 600; ii++) {
+    testFusion.update(pressureAt(160.0), msec += 1000, true, 230.0, 1.0, 8);
+  }
+  fails += testRange("Baro good fix", testFusion.altitude, 228.5, 230.5, __LINE__);
+  fails += testRange("Baro level", testFusion.climbRate, -0.01, 0.01, __LINE__);
+  for (int ii = 0; ii < 600; ii++) {
+    testFusion.update(pressureAt(160.0), msec += 1000, true, 250.0, 4.0, 8);
+  }
+  fails += testRange("Baro poor fix", testFusion.altitude, 233.0, 238.0, __LINE__);
+  float before = testFusion.altitude;
+  for (int ii = 0; ii < 600; ii++) {
+    testFusion.update(pressureAt(160.0), msec += 1000, false, 0.0, 0.0, 0);
+  }
+  fails += testRange("Baro no fix", testFusion.altitude, before - 0.01, before + 0.01, __LINE__);
+
+  // ----- calibration as a sea level pressure gives back the fused altitude
+  fails += testRange("Baro sea level", BarometerModel::altitudeFromPressure(pressureAt(160.0), testFusion.sealevelPa()),
+                     before - 0.1, before + 0.1, __LINE__);
+
+  // ----- no barometer, breadcrumbs keep their GPS altitude
+  testFusion.update(0.0, msec += 1000, true, 230.0, 1.0, 8);
+  fails += testRange("Baro valid", testFusion.valid, 0, 0, __LINE__);
+  crumb.altitude  = 123.0;
+  crumb.climbRate = 0;
+  testFusion.annotate(&crumb);
+  fails += testRange("Baro GPS altitude", crumb.altitude, 123.0, 123.0, __LINE__);
+
+  // ----- climb rate in the breadcrumb file is optional
+  char withClimb[]    = "GPS,2023-06-01,12:34:56,CN87us,47.75191,-122.32951,120.0,55.0,90.0,7,-152";
+  char withoutClimb[] = "GPS,2023-06-01,12:34:56,CN87us,47.75191,-122.32951,120.0,55.0,90.0,7";
+  char tooSteep[]     = "GPS,2023-06-01,12:34:56,CN87us,47.75191,-122.32951,120.0,55.0,90.0,7,99999";
+  fails += testRange("Baro parse climb", trail.parseBreadcrumb(withClimb, &crumb), 1, 1, __LINE__);
+  fails += testRange("Baro climb column", crumb.climbRate, -152, -152, __LINE__);
+  fails += testRange("Baro parse old", trail.parseBreadcrumb(withoutClimb, &crumb), 1, 1, __LINE__);
+  fails += testRange("Baro no climb column", crumb.climbRate, 0, 0, __LINE__);
+  fails += testRange("Baro parse steep", trail.parseBreadcrumb(tooSteep, &crumb), 0, 0, __LINE__);
+  return fails;
+}
+// =============================================================
+// verify the coin battery trend and its prediction, without reading the ADC
+int verifyBatteryTrend() {
+  logger.fencepost("unittest.cpp", "verifyBatteryTrend", __LINE__);
+  int fails = 0;
+  const TimeElements validDate{0, 0, 12, 0, 1, 6, (2023 - 1970)};   // June 1, 2023
+  time_t stamp = makeTime(validDate);
+
+  // ----- too little history has no trend
+  BatteryVoltage testBattery;
+  testBattery.clearHistory();
+  testBattery.testSample(2.900);
+  for (int ii = 0; ii < BATTERY_MIN_TREND - 1; ii++) {
+    testBattery.testRememberVoltage(2.900 - 0.001 * ii, stamp += 12 * SECS_PER_HOUR);
+  }
+  fails += testRange("Battery days, short history", testBattery.daysToBad(), -1, -1, __LINE__, 3);
+
+  // ----- 2 mV per day for a month, with some noise
+  testBattery.clearHistory();
+  for (int ii = 0; ii < 60; ii++) {
+    float noise = (ii % 3 - 1) * 0.003;
+    testBattery.testRememberVoltage(2.960 - 0.001 * ii + noise, stamp += 12 * SECS_PER_HOUR);
+  }
+  fails += testRange("Battery mV/day", testBattery.slope() * 1000.0, -2.1, -1.9, __LINE__, 3);
+  fails += testRange("Battery days", testBattery.daysToBad(), 440, 460, __LINE__, 3);
+
+  // ----- the history ring keeps only the newest readings
+  for (int ii = 0; ii < BATTERY_HISTORY; ii++) {
+    testBattery.testRememberVoltage(2.900, stamp += 12 * SECS_PER_HOUR);
+  }
+  fails += testRange("Battery flat", testBattery.slope() * 1000.0, -0.01, 0.01, __LINE__, 3);
+  fails += testRange("Battery days, flat", testBattery.daysToBad(), -1, -1, __LINE__, 3);
+
+  // ----- already bad
+  testBattery.testSample(BAD_BATTERY_MAXIMUM - 0.1);
+  fails += testRange("Battery days, bad", testBattery.daysToBad(), 0, 0, __LINE__, 3);
+  return fails;
+}
+// =============================================================
+// verify the touch gesture classifier by replaying recorded touch traces
+// each trace is one sample every TOUCH_SAMPLE_MSEC: {msec, pressure, {x,y}}
+struct TouchSample {
+  uint16_t msec;
+  int16_t pressure;
+  Point at;
+};
+static TouchEvents testTouch;       // static, to leave the real queue alone
+static TouchEvent lastTouchEvent;   // newest event from replayTouchTrace()
+
+// a quick tap with a little jitter, and a light sample at a crazy position on the way up
+const TouchSample traceTap[] = {
+    {0, 0, {0, 0}},         {10, 120, {3, 310}},     {20, 260, {101, 98}},   {30, 310, {99, 102}},
+    {40, 330, {102, 101}},  {50, 300, {98, 100}},    {60, 180, {100, 99}},   {70, 40, {12, 220}},
+    {80, 0, {0, 0}},        {90, 0, {0, 0}},         {100, 0, {0, 0}},
+};
+// contact bounce: one firm sample is not a press
+const TouchSample traceBounce[] = {
+    {0, 0, {0, 0}}, {10, 240, {200, 50}}, {20, 30, {0, 0}}, {30, 0, {0, 0}}, {40, 250, {210, 60}}, {50, 0, {0, 0}},
+};
+// release bounce: two light samples in the middle of a tap do not split it in two
+const TouchSample traceReleaseBounce[] = {
+    {0, 0, {0, 0}},         {10, 280, {200, 150}},   {20, 300, {201, 151}},  {30, 310, {200, 149}},
+    {40, 20, {0, 0}},       {50, 30, {0, 0}},        {60, 300, {199, 150}},  {70, 290, {200, 150}},
+    {80, 0, {0, 0}},        {90, 0, {0, 0}},         {100, 0, {0, 0}},
+};
+// finger dragged from the right side toward the left, about 300 msec
+const TouchSample traceSwipeLeft[] = {
+    {0, 0, {0, 0}},         {10, 230, {262, 121}},   {20, 290, {258, 120}},  {30, 310, {246, 122}},
+    {40, 320, {228, 119}},  {50, 330, {205, 123}},   {60, 320, {182, 121}},  {70, 310, {160, 124}},
+    {80, 320, {140, 122}},  {90, 300, {121, 125}},   {100, 310, {104, 124}}, {110, 300, {92, 126}},
+    {120, 290, {84, 125}},  {130, 280, {80, 125}},   {140, 260, {79, 126}},  {150, 240, {79, 125}},
+    {160, 40, {30, 200}},   {170, 0, {0, 0}},        {180, 0, {0, 0}},       {190, 0, {0, 0}},
+};
+
+// press at one point, move in a straight line for holdMsec, then release
+int makeTouchTrace(TouchSample *trace, Point from, Point to, int holdMsec) {
+  int steps = holdMsec / TOUCH_SAMPLE_MSEC;
+  int count = 0;
+  for (int ii = 0; ii <= steps; ii++) {
+    Point at       = {from.x + (to.x - from.x) * ii / steps, from.y + (to.y - from.y) * ii / steps};
+    trace[count++] = {(uint16_t)(ii * TOUCH_SAMPLE_MSEC), 300, at};
+  }
+  for (int ii = 1; ii <= TOUCH_RELEASE_SAMPLES; ii++) {
+    trace[count++] = {(uint16_t)((steps + ii) * TOUCH_SAMPLE_MSEC), 0, {0, 0}};
+  }
+  return count;
+}
+
+int replayTouchTrace(const TouchSample *trace, int count, uint32_t msec) {
+  for (int ii = 0; ii < count; ii++) {
+    testTouch.add(trace[ii].pressure, trace[ii].at, msec + trace[ii].msec);
+  }
+  TouchEvent event;
+  int events = 0;
+  while (testTouch.pop(&event)) {
+    lastTouchEvent = event;
+    events++;
+  }
+  return events;
+}
+
+int testTouchGesture(const char *name, int events, TouchGesture expected, int line) {
+  if (expected == eNoGesture && events == 0) {
+    return 0;
+  }
+  if (events == 1 && lastTouchEvent.gesture == expected) {
+    return 0;
+  }
+  char msg[100];
+  snprintf(msg, sizeof(msg), "[%d] Touch %s gave %d events, last %d, expected gesture %d <-- Unequal",
+           line, name, events, (int)lastTouchEvent.gesture, (int)expected);
+  logger.log(FILES, CONSOLE, msg);
+  return 1;
+}
+
+int verifyTouchGestures() {
+  logger.fencepost("unittest.cpp", "verifyTouchGestures", __LINE__);
+  int fails    = 0;
+  uint32_t now = 100000;   // arbitrary millis()
+  testTouch.reset();
+
+  // ----- recorded traces
+  int events = replayTouchTrace(traceTap, sizeof(traceTap) / sizeof(traceTap[0]), now += 1000);
+  fails += testTouchGesture("tap", events, eTap, __LINE__);
+  if (abs(lastTouchEvent.at.x - 100) > 3 || abs(lastTouchEvent.at.y - 100) > 3) {
+    logger.log(FILES, CONSOLE, "Tap should be near (100,100), actual (%d,%d)", lastTouchEvent.at.x, lastTouchEvent.at.y);
+    fails++;
+  }
+  events = replayTouchTrace(traceBounce, sizeof(traceBounce) / sizeof(traceBounce[0]), now += 1000);
+  fails += testTouchGesture("bounce", events, eNoGesture, __LINE__);
+  events = replayTouchTrace(traceReleaseBounce, sizeof(traceReleaseBounce) / sizeof(traceReleaseBounce[0]), now += 1000);
+  fails += testTouchGesture("release bounce", events, eTap, __LINE__);
+  events = replayTouchTrace(traceSwipeLeft, sizeof(traceSwipeLeft) / sizeof(traceSwipeLeft[0]), now += 1000);
+  fails += testTouchGesture("swipe left", events, eSwipeLeft, __LINE__);
+
+  // ----- made-up traces, up to 1500 msec
+  static TouchSample trace[200];
+  int count = makeTouchTrace(trace, {60, 120}, {260, 110}, 250);
+  fails += testTouchGesture("swipe right", replayTouchTrace(trace, count, now += 1000), eSwipeRight, __LINE__);
+  count = makeTouchTrace(trace, {160, 40}, {165, 200}, 250);
+  fails += testTouchGesture("swipe down", replayTouchTrace(trace, count, now += 1000), eSwipeDown, __LINE__);
+  count = makeTouchTrace(trace, {160, 200}, {150, 30}, 250);
+  fails += testTouchGesture("swipe up", replayTouchTrace(trace, count, now += 1000), eSwipeUp, __LINE__);
+  count = makeTouchTrace(trace, {160, 120}, {163, 118}, 1200);
+  fails += testTouchGesture("long press", replayTouchTrace(trace, count, now += 2000), eLongPress, __LINE__);
+  count = makeTouchTrace(trace, {260, 120}, {60, 120}, 1500);
+  fails += testTouchGesture("slow drag", replayTouchTrace(trace, count, now += 2000), eNoGesture, __LINE__);
+  count = makeTouchTrace(trace, {100, 100}, {130, 100}, 100);
+  fails += testTouchGesture("short wiggle", replayTouchTrace(trace, count, now += 1000), eNoGesture, __LINE__);
+
+  // ----- a full queue keeps the oldest events
+  uint32_t dropped = testTouch.dropped;
+  count            = makeTouchTrace(trace, {100, 100}, {100, 100}, 50);
+  for (int ii = 0; ii < TOUCH_QUEUE_SIZE + 2; ii++) {
+    now += 1000;
+    for (int jj = 0; jj < count; jj++) {
+      testTouch.add(trace[jj].pressure, trace[jj].at, now + trace[jj].msec);
+    }
+  }
+  events = replayTouchTrace(trace, 0, now);
+  if (events != TOUCH_QUEUE_SIZE - 1 || testTouch.dropped != dropped + 3) {
+    logger.log(FILES, CONSOLE, "Full touch queue kept %d events, dropped %d", events, (int)(testTouch.dropped - dropped));
+    fails++;
+  }
+  return fails;
+}
+// =============================================================
+// verify the lock-free queue, seqlock and NMEA reader used between the RP2040's cores
+// both "cores" run here on one, so this checks the logic, not the timing
+// see extras/host_test/inter_core_stress.cpp for the same queue and seqlock on two threads
+
+int verifyInterCore() {
+  logger.fencepost("unittest.cpp", "verifyInterCore", __LINE__);
+  int fails = 0;
+
+  // ----- queue keeps order, holds N-1 items, and drops the newest when full
+  SpscQueue<int, 4> queue;
+  int item  = 0;
+  int added = 0;
+  for (int ii = 1; ii <= 5; ii++) {
+    added += queue.push(ii);
+  }
+  if (added != 3 || queue.dropped() != 2 || queue.depth() != 3) {
+    logger.log(FILES, CONSOLE, "Queue added %d items, expected 3, dropped %d", added, (int)queue.dropped());
+    fails++;
+  }
+  for (int ii = 1; ii <= 3; ii++) {
+    if (!queue.pop(&item) || item != ii) {
+      logger.log(FILES, CONSOLE, "Queue gave %d, expected %d", item, ii);
+      fails++;
+    }
+  }
+  for (int ii = 0; ii < 10; ii++) {   // wrap around the ring
+    queue.push(ii);
+    if (!queue.pop(&item) || item != ii) {
+      logger.log(FILES, CONSOLE, "Queue after wrap gave %d, expected %d", item, ii);
+      fails++;
+    }
+  }
+  if (queue.pop(&item) || queue.depth() != 0) {
+    logger.log(FILES, CONSOLE, "Queue should be empty");
+    fails++;
+  }
+
+  // ----- seqlock returns the latest whole struct, of a size that is not a multiple of 4
+  struct Odd {
+    uint16_t count;
+    char text[7];
+  };
+  Seqlock<Odd> lock;
+  Odd value = {0, ""};
+  if (lock.version() != 0 || !lock.read(&value) || value.count != 0) {
+    logger.log(FILES, CONSOLE, "Seqlock should start empty");
+    fails++;
+  }
+  lock.write(Odd{1, "first"});
+  lock.write(Odd{2, "second"});
+  if (!lock.read(&value) || value.count != 2 || strcmp(value.text, "second") != 0 || lock.version() != 2) {
+    logger.log(FILES, CONSOLE, "Seqlock read %s, expected second", value.text);
+    fails++;
+  }
+
+  // ----- reader splits characters into sentences and rejects bad ones
+  const char *stream = "GA,1234*00\r\n"   // tail of a sentence from before power-up
+                       "$GPRMC,194509.000,A,4042.6142,N,07400.4168,W,2.03,221.11,160412,,,A*77\r\n"
+                       "$GPGGA,194509.000,4042.6142,N,07400.4168,W,1,07,1.2,9.9,M,-34.2,M,,*69\r\n"
+                       "$GPRMC,bad,checksum*12\r\n"
+                       "$PMTK001,220,3*30\r\n";
+  NmeaReader testReader;
+  for (const char *pp = stream; *pp; pp++) {
+    testReader.add(*pp);
+  }
+  testReader.publish();
+  NmeaLine line;
+  int good = 0;
+  while (testReader.nextSentence(&line)) {
+    good++;
+  }
+  NmeaReaderStats stats;
+  if (good != 3 || !testReader.published.read(&stats) || stats.sentences != 3 || stats.badChecksum != 2 || stats.chars != strlen(stream)) {
+    logger.log(FILES, CONSOLE, "NMEA reader queued %d sentences, expected 3", good);
+    fails++;
+  }
+
+  // ----- core 0 falls behind: the oldest sentences are kept
+  for (int ii = 0; ii < NMEA_QUEUE_SIZE + 2; ii++) {
+    for (const char *pp = "$PMTK001,220,3*30\r\n"; *pp; pp++) {
+      testReader.add(*pp);
+    }
+  }
+  testReader.publish();
+  good = 0;
+  while (testReader.nextSentence(&line)) {
+    good++;
+  }
+  if (good != NMEA_QUEUE_SIZE - 1 || !testReader.published.read(&stats) || stats.dropped != 3) {
+    logger.log(FILES, CONSOLE, "NMEA reader kept %d sentences, dropped %d", good, (int)stats.dropped);
+    fails++;
+  }
+  return fails;
+}
+
+// =============================================================
+// Core 1 parses RMC and GGA itself and publishes the fix through a Seqlock,
+// which Model::getGPS() reads with DUAL_CORE. This needs the real Adafruit_GPS parser.
+class SnapshotModel : public Model {
+public:
+  void readSnapshot(const GpsFix &fix) {
+    readGPS(fix);
+  }
+};
+
+int verifyFixSnapshot() {
+  logger.fencepost("unittest.cpp", "verifyFixSnapshot", __LINE__);
+  int fails = 0;
+
+  const char *stream = "$GPRMC,194509.000,A,4042.6142,N,07400.4168,W,2.03,221.11,160412,,,A*77\r\n"
+                       "$GPGGA,194509.000,4042.6142,N,07400.4168,W,1,07,1.2,9.9,M,-34.2,M,,*69\r\n"
+                       "$PMTK001,220,3*30\r\n";   // not a fix
+  NmeaReader testReader;
+  for (const char *pp = stream; *pp; pp++) {
+    testReader.add(*pp);
+  }
+  testReader.publish();
+  NmeaReaderStats stats;
+  if (!testReader.published.read(&stats) || stats.fixes != 2 || testReader.latestFix.version() != 2) {
+    logger.log(FILES, CONSOLE, "Core 1 published %d fixes, expected 2", (int)testReader.latestFix.version());
+    fails++;
+  }
+
+  GpsFix fix = {};
+  if (!testReader.latestFix.read(&fix)) {
+    logger.log(FILES, CONSOLE, "Fix snapshot could not be read");
+    fails++;
+  }
+  fails += testRange("Snapshot fix", fix.fix, 1, 1, __LINE__);
+  fails += testRange("Snapshot latitude", fix.latitudeDegrees, 40.7102, 40.7103, __LINE__, 4);
+  fails += testRange("Snapshot longitude", fix.longitudeDegrees, -74.0070, -74.0069, __LINE__, 4);
+  fails += testRange("Snapshot altitude", fix.altitude, 9.8, 10.0, __LINE__);   // from GGA
+  fails += testRange("Snapshot satellites", fix.satellites, 7, 7, __LINE__);    // from GGA
+  fails += testRange("Snapshot day", fix.day, 16, 16, __LINE__);                // from RMC
+
+  // ----- the model reads the snapshot the same way as the GPS object
+  SnapshotModel testModel;
+  testModel.readSnapshot(fix);
+  fails += testRange("Snapshot model fix", testModel.gHaveGPSfix, 1, 1, __LINE__);
+  fails += testRange("Snapshot model latitude", testModel.gLatitude, 40.7102, 40.7103, __LINE__, 4);
+  fails += testRange("Snapshot model satellites", testModel.gSatellites, 7, 7, __LINE__);
+  return fails;
+}
+// =============================================================
+// verify replaying recorded NMEA through the real parser and model
+int testReplayGrid(ReplayModel &replay, const char *sExpected, int line) {
+  char grid4[5];
+  grid.calcLocator(grid4, replay.gLatitude, replay.gLongitude, 4);
+  if (strcmp(grid4, sExpected) == 0 && replay.gHaveGPSfix) {
+    return 0;
+  }
+  char msg[80];
+  snprintf(msg, sizeof(msg), "[%d] Expected %s, actual %s, fix %d <-- Unequal", line, sExpected, grid4, replay.gHaveGPSfix);
+  logger.log(FILES, CONSOLE, msg);
+  return 1;
+}
+
+int verifyReplay() {
+  logger.fencepost("unittest.cpp", "verifyReplay", __LINE__);
+  int fails = 0;
+
+  // four seconds of recorded data: CN87, crossing into CN97, a bogus year-2000 fix, loss of signal
+  static const char *const nmea[] = {
+      "$GPRMC,120000.000,A,4730.0000,N,12300.0000,W,0.00,90.00,010623,,,A*40",
+      "$GPGGA,120000.000,4730.0000,N,12300.0000,W,1,08,0.90,100.0,M,-17.0,M,,*56",
+      "$GPGSA,A,3,01,02,03,,,,,,,,,,1.5,0.9,1.2*00",   // bad checksum
+      "$GPRMC,120001.000,A,4730.0000,N,12154.0000,W,55.00,90.00,010623,,,A*72",
+      "12345 $GPGGA,120001.000,4730.0000,N,12154.0000,W,1,09,0.90,110.0,M,-17.0,M,,*54",   // from console log
+      "$GPRMC,120002.000,A,4730.0000,N,12150.0000,W,55.00,90.00,010100,,,A*73",
+      "$GPRMC,120003.000,V,,,,,0.00,0.00,010623,,,N*4B",
+  };
+  ReplayModel replay;
+  replay.beginArray(nmea, sizeof(nmea) / sizeof(nmea[0]), 0);   // step mode
+
+  replay.getGPS();   // 12:00:00
+  fails += testReplayGrid(replay, "CN87", __LINE__);
+  int crossings = replay.enteredNewGrid4() ? 1 : 0;
+
+  replay.getGPS();   // 12:00:01
+  fails += testReplayGrid(replay, "CN97", __LINE__);
+  crossings += replay.enteredNewGrid4() ? 1 : 0;
+  if (crossings != 2 || replay.gSatellites != 9) {
+    logger.log(FILES, CONSOLE, "Expected 2 crossings and 9 satellites, actual %d and %d <-- Unequal", crossings, replay.gSatellites);
+    fails++;
+  }
+
+  replay.getGPS();   // 12:00:02 in year 2000, must not be remembered
+  trail.clearHistory();
+  Location bogus;
+  replay.makeLocation(&bogus);
+  trail.rememberGPS(bogus);
+  if (trail.getHistoryCount() != 0) {
+    logger.log(FILES, CONSOLE, "Bogus year-2000 fix was remembered <-- Unequal");
+    fails++;
+  }
+
+  replay.getGPS();   // 12:00:03
+  if (replay.gHaveGPSfix || !replay.finished) {
+    logger.log(FILES, CONSOLE, "Expected loss of signal at end of data <-- Unequal");
+    fails++;
+  }
+  if (replay.stepsReplayed != 4 || replay.sentencesFailed != 1) {
+    logger.log(FILES, CONSOLE, "Expected 4 seconds and 1 failure, actual %d and %d <-- Unequal",
+               (int)replay.stepsReplayed, (int)replay.sentencesFailed);
+    fails++;
+  }
+
+  // fractions of a second with fewer than three digits, as sent by some receivers
+  static const char *const fractions[] = {
+      "$GPRMC,120000.5,A,4730.0000,N,12300.0000,W,0.00,90.00,010623,,,A*45",
+      "$GPRMC,120000.75,A,4730.0000,N,12300.0000,W,0.00,90.00,010623,,,A*72",
+  };
+  replay.beginArray(fractions, 2, 0);
+  replay.getGPS();
+  uint32_t half = replay.replayTime();
+  replay.getGPS();
+  uint32_t threeQuarters = replay.replayTime();
+  if (half != 43200500 || threeQuarters != 43200750) {
+    logger.log(FILES, CONSOLE, "Expected msec 500 and 750, actual %d and %d <-- Unequal",
+               (int)(half % 1000), (int)(threeQuarters % 1000));
+    fails++;
+  }
+  return fails;
+}
+// =============================================================
+// verify every fix at 10 Hz goes through parser, model and grid detector, and that gaps are counted
+// two seconds eastbound at 87 mph, crossing from CN87us into CN87vs
+const char *const nmea10Hz[] = {
+    "$GPRMC,123456.000,A,4745.6000,N,12215.0360,W,87.0,90.0,010623,,,A*7F",
+    "$GPRMC,123456.100,A,4745.6000,N,12215.0324,W,87.0,90.0,010623,,,A*7E",
+    "$GPRMC,123456.200,A,4745.6000,N,12215.0288,W,87.0,90.0,010623,,,A*7A",
+    "$GPRMC,123456.300,A,4745.6000,N,12215.0252,W,87.0,90.0,010623,,,A*7C",
+    "$GPRMC,123456.400,A,4745.6000,N,12215.0216,W,87.0,90.0,010623,,,A*7B",
+    "$GPRMC,123456.500,A,4745.6000,N,12215.0180,W,87.0,90.0,010623,,,A*76",
+    "$GPRMC,123456.600,A,4745.6000,N,12215.0144,W,87.0,90.0,010623,,,A*7D",
+    "$GPRMC,123456.700,A,4745.6000,N,12215.0108,W,87.0,90.0,010623,,,A*74",
+    "$GPRMC,123456.800,A,4745.6000,N,12215.0072,W,87.0,90.0,010623,,,A*77",
+    "$GPRMC,123456.900,A,4745.6000,N,12215.0036,W,87.0,90.0,010623,,,A*76",
+    "$GPRMC,123457.000,A,4745.6000,N,12215.0000,W,87.0,90.0,010623,,,A*7B",
+    "$GPRMC,123457.100,A,4745.6000,N,12214.9964,W,87.0,90.0,010623,,,A*79",
+    "$GPRMC,123457.200,A,4745.6000,N,12214.9928,W,87.0,90.0,010623,,,A*72",
+    "$GPRMC,123457.300,A,4745.6000,N,12214.9892,W,87.0,90.0,010623,,,A*73",
+    "$GPRMC,123457.400,A,4745.6000,N,12214.9856,W,87.0,90.0,010623,,,A*7C",
+    "$GPRMC,123457.500,A,4745.6000,N,12214.9820,W,87.0,90.0,010623,,,A*7C",
+    "$GPRMC,123457.600,A,4745.6000,N,12214.9784,W,87.0,90.0,010623,,,A*7E",
+    "$GPRMC,123457.700,A,4745.6000,N,12214.9748,W,87.0,90.0,010623,,,A*7F",
+    "$GPRMC,123457.800,A,4745.6000,N,12214.9712,W,87.0,90.0,010623,,,A*7F",
+    "$GPRMC,123457.900,A,4745.6000,N,12214.9676,W,87.0,90.0,010623,,,A*7D",
+};
+const int num10Hz = sizeof(nmea10Hz) / sizeof(nmea10Hz[0]);
+
+int testHighRate(ReplayModel &testReplay, const char *const *nmea, int count, int expectedFixes, int expectedDropped, int line) {
+  GpsRate rate;   // local, so the receiver's statistics are untouched
+  rate.hz = 10;
+  testReplay.beginArray(nmea, count, 0);   // step mode: one fix per getGPS()
+
+  int crossings = 0;
+  int fixes     = 0;
+  while (!testReplay.finished) {
+    testReplay.getGPS();   // parser -> model
+    rate.onFix(testReplay.replayTime());
+    bool crossed = testReplay.enteredNewGrid6();   // detector, same as loop()
+    if (crossed && fixes > 0) {
+      crossings++;   // loop() would save the trail here, but a test must not touch the user's file
+    }
+    Location whereAmI;
+    testReplay.makeLocation(&whereAmI);
+    trail.rememberGPS(whereAmI);
+    fixes++;
+  }
+
+  if (fixes == expectedFixes && (int)rate.fixes == expectedFixes && (int)rate.fixesDropped == expectedDropped && crossings == 1) {
+    return 0;
+  }
+  char msg[120];
+  snprintf(msg, sizeof(msg), "[%d] Expected %d fixes, %d dropped, 1 crossing; actual %d, %d, %d <-- Unequal",
+           line, expectedFixes, expectedDropped, fixes, (int)rate.fixesDropped, crossings);
+  logger.log(FILES, CONSOLE, msg);
+  return 1;
+}
+
+int verifyHighRate() {
+  logger.fencepost("unittest.cpp", "verifyHighRate", __LINE__);
+  int fails = 0;
+  ReplayModel testReplay;
+  trail.clearHistory();
+
+  // every fix is processed
+  fails += testHighRate(testReplay, nmea10Hz, num10Hz, num10Hz, 0, __LINE__);
+
+  // two fixes lost, e.g. serial buffer overrun
+  const char *lossy[num10Hz];
+  int count = 0;
+  for (int ii = 0; ii < num10Hz; ii++) {
+    if (ii != 5 && ii != 6) {
+      lossy[count++] = nmea10Hz[ii];
+    }
+  }
+  fails += testHighRate(testReplay, lossy, count, num10Hz - 2, 2, __LINE__);
+
+  // commands to the receiver must have correct checksums
+  char cmd[NMEA_MAX_LENGTH];
+  Nmea::makeSentence(cmd, sizeof(cmd), "PMTK220,%d", 100);
+  if (strcmp(cmd, "$PMTK220,100*2F") != 0 || !Nmea::isChecksumValid(nmea10Hz[0]) || GpsRate::chooseBaud(5) != 38400 || GpsRate::chooseBaud(10) != 57600) {
+    logger.log(FILES, CONSOLE, "PMTK command \"%s\" or baud rate <-- Unequal", cmd);
+    fails++;
+  }
+
+  trail.clearHistory();
+  return fails;
+}
+// =============================================================
+// verify satellite statistics from a multi-constellation receiver
+const char *const nmeaGnss[] = {
+    "$GPGSV,2,1,07,02,45,120,40,05,30,200,36,12,60,310,44,15,10,050,*7F",
+    "$GPGSV,2,2,07,18,20,090,30,24,55,250,42,29,05,180,*4F",
+    "$GLGSV,1,1,03,65,40,100,38,72,25,300,34,81,15,020,*52",
+    "$GAGSV,1,1,01,301,50,140,39*61",
+    "$GNGSA,A,3,02,05,12,18,24,,,,,,,,1.6,0.9,1.3,1*36",
+    "$GNGSA,A,3,65,72,,,,,,,,,,,1.6,0.9,1.3,2*38",
+    "$GLGSV,1,1,03,65,40,100,99,72,25,300,99,81,15,020,*51",   // bad checksum
+};
+int testGnssCounts(const GnssCounts &actual, int sys, int inView, int used, int snr, int line) {
+  if (actual.inView[sys] == inView && actual.used[sys] == used && actual.snr[sys] == snr) {
+    return 0;
+  }
+  char msg[128];
+  snprintf(msg, sizeof(msg), "[%d] %s expected %d/%d/%d, actual %d/%d/%d <-- Unequal",
+           line, GnssStats::systemName(sys), inView, used, snr, actual.inView[sys], actual.used[sys], actual.snr[sys]);
+  logger.log(FILES, CONSOLE, msg);
+  return 1;
+}
+int verifyGnssStats() {
+  logger.fencepost("unittest.cpp", "verifyGnssStats", __LINE__);
+  int fails = 0;
+  GnssStats stats;   // local instance, leaves the receiver's statistics alone
+
+  int accepted = 0;
+  for (unsigned int ii = 0; ii < sizeof(nmeaGnss) / sizeof(nmeaGnss[0]); ii++) {
+    if (stats.parse(nmeaGnss[ii])) {
+      accepted++;
+    }
+  }
+  if (accepted != 6) {
+    logger.log(FILES, CONSOLE, "Expected 6 sentences, actual %d <-- Unequal", accepted);
+    fails++;
+  }
+
+  // in view, used in fix, average SNR of satellites being tracked
+  GnssCounts counts = stats.current();
+  fails += testGnssCounts(counts, eGNSS_GPS, 7, 5, 38, __LINE__);       // (40+36+44+30+42)/5
+  fails += testGnssCounts(counts, eGNSS_GLONASS, 3, 2, 36, __LINE__);   // (38+34)/2, not 99
+  fails += testGnssCounts(counts, eGNSS_GALILEO, 1, 0, 39, __LINE__);
+  fails += testGnssCounts(counts, eGNSS_BEIDOU, 0, 0, 0, __LINE__);
+
+  // RMC is not a satellite sentence
+  if (stats.parse(nmea10Hz[0])) {
+    logger.log(FILES, CONSOLE, "RMC was parsed as satellite data <-- Unequal");
+    fails++;
+  }
+  return fails;
+}
+// =============================================================
+// verify bogus fixes are kept out of the breadcrumb trail
+// a 60 mph drive with one fix every 2 seconds, and one corruption of each kind
+const char *const nmeaCorrupt[] = {
+    "$GPRMC,120000.000,A,4745.0000,N,12224.0000,W,52.1,90.0,010623,,,A*73",
+    "$GPGGA,120000.000,4745.0000,N,12224.0000,W,1,08,0.9,100.0,M,-17.0,M,,*63",
+    "$GPRMC,120002.000,A,4745.0000,N,12223.9570,W,52.1,90.0,010623,,,A*7D",
+    "$GPGGA,120002.000,4745.0000,N,12223.9570,W,1,08,0.9,100.0,M,-17.0,M,,*6D",
+    "$GPRMC,120004.000,A,4745.0000,N,12223.9141,W,52.1,90.0,010623,,,A*7D",
+    "$GPGGA,120004.000,4745.0000,N,12223.9141,W,1,08,0.9,100.0,M,-17.0,M,,*6D",
+    "$GPRMC,120006.000,A,4600.0000,N,12223.8711,W,52.1,90.0,010623,,,A*7D",
+    "$GPGGA,120006.000,4600.0000,N,12223.8711,W,1,08,0.9,100.0,M,-17.0,M,,*6D",   // 120 miles south
+    "$GPRMC,120008.000,A,4745.0000,N,12223.8282,W,52.1,90.0,010623,,,A*7C",
+    "$GPGGA,120008.000,4745.0000,N,12223.8282,W,1,08,0.9,100.0,M,-17.0,M,,*6C",
+    "$GPRMC,120010.000,A,4500.0000,N,04500.0000,E,52.1,90.0,010623,,,A*65",
+    "$GPGGA,120010.000,4500.0000,N,04500.0000,E,1,08,0.9,100.0,M,-17.0,M,,*75",   // lat==long
+    "$GPRMC,120012.000,A,4745.0000,N,12223.7422,W,52.1,90.0,010623,,,A*74",
+    "$GPGGA,120012.000,4745.0000,N,12223.7422,W,1,08,25.0,100.0,M,-17.0,M,,*5A",   // HDOP
+    "$GPRMC,120014.000,A,4745.0000,N,12223.6993,W,52.1,90.0,010623,,,A*74",
+    "$GPGGA,120014.000,4745.0000,N,12223.6993,W,1,02,0.9,100.0,M,-17.0,M,,*6E",   // 2 satellites
+    "$GPRMC,120004.000,A,4745.0000,N,12223.9141,W,52.1,90.0,010623,,,A*7D",
+    "$GPGGA,120004.000,4745.0000,N,12223.9141,W,1,08,0.9,100.0,M,-17.0,M,,*6D",   // stale, replayed from earlier
+    "$GPRMC,120018.000,A,4745.0000,N,12223.6134,W,52.1,90.0,010623,,,A*7D",
+    "$GPGGA,120018.000,4745.0000,N,12223.6134,W,1,08,0.9,100.0,M,-17.0,M,,*6D",   // remembered twice
+    "$GPRMC,120020.000,A,4745.0000,N,12223.1838,W,52.1,90.0,010623,,,A*74",
+    "$GPGGA,120020.000,4745.0000,N,12223.1838,W,1,08,0.9,100.0,M,-17.0,M,,*64",   // 0 to 600 mph in 2 seconds
+    "$GPRMC,120022.000,A,4745.0000,N,12223.5274,W,52.1,90.0,010623,,,A*70",
+    "$GPGGA,120022.000,4745.0000,N,12223.5274,W,1,08,0.9,100.0,M,-17.0,M,,*60",
+};
+int verifyFixValidator() {
+  logger.fencepost("unittest.cpp", "verifyFixValidator", __LINE__);
+  int fails = 0;
+
+  // counters belong to the live trail, so compare differences
+  FixValidator &validator = trail.validator;
+  uint32_t before[FIX_REASONS];
+  memcpy(before, validator.rejected, sizeof(before));
+  uint32_t acceptedBefore = validator.accepted;
+
+  ReplayModel testReplay;
+  trail.clearHistory();
+  testReplay.beginArray(nmeaCorrupt, sizeof(nmeaCorrupt) / sizeof(nmeaCorrupt[0]), 0);   // step mode
+  int step = 0;
+  while (!testReplay.finished) {
+    testReplay.getGPS();
+    if (!testReplay.gHaveGPSfix) {
+      continue;   // end of data
+    }
+    Location whereAmI;
+    testReplay.makeLocation(&whereAmI);
+    trail.rememberGPS(whereAmI, testReplay.gHDOP);
+    if (step == 9) {
+      trail.rememberGPS(whereAmI, testReplay.gHDOP);   // same fix again, e.g. autolog timer without a new fix
+    }
+    step++;
+  }
+
+  // six good fixes, and every corruption is counted exactly once
+  if (trail.getHistoryCount() != 6 || validator.accepted - acceptedBefore != 6) {
+    logger.log(FILES, CONSOLE, "Expected 6 breadcrumbs, actual %d and %d <-- Unequal",
+               trail.getHistoryCount(), (int)(validator.accepted - acceptedBefore));
+    fails++;
+  }
+  for (int ii = eFixBadLatLong; ii < FIX_REASONS; ii++) {   // all but "before release"
+    if (validator.rejected[ii] - before[ii] != 1) {
+      char msg[80];
+      snprintf(msg, sizeof(msg), "Expected 1 rejected for %s, actual %d <-- Unequal",
+               FixValidator::reasonName(ii), (int)(validator.rejected[ii] - before[ii]));
+      logger.log(FILES, CONSOLE, msg);
+      fails++;
+    }
+  }
+
+  // nothing outside the real drive got through
+  Location *loc = trail.begin();
+  while (loc) {
+    if (loc->loc.lat < 47.74 || loc->loc.lat > 47.76) {
+      logger.log(FILES, CONSOLE, "Bogus breadcrumb at line %d <-- Unequal", __LINE__);
+      fails++;
+    }
+    loc = trail.next();
+  }
+
+  // receiver clock steps back an hour: after FIX_MAX_REJECTS stale fixes, start over
+  FixValidator clockStep;
+  Location fix;
+  fix.reset();
+  fix.loc           = PointGPS{47.75, -122.40};
+  fix.timestamp     = 1685622896;   // 2023-06-01 12:34:56
+  fix.numSatellites = 8;
+  clockStep.check(fix, 0.9, 0);
+  int rejects = 0;
+  for (int ii = 1; ii <= FIX_MAX_REJECTS + 1; ii++) {
+    fix.timestamp = 1685622896 - SECS_PER_HOUR + ii;
+    rejects += (clockStep.check(fix, 0.9, 0) == eFixStale) ? 1 : 0;
+  }
+  if (rejects != FIX_MAX_REJECTS || clockStep.accepted != 2) {
+    char msg[80];
+    snprintf(msg, sizeof(msg), "Clock step: expected %d stale and 2 accepted, actual %d and %d <-- Unequal",
+             FIX_MAX_REJECTS, rejects, (int)clockStep.accepted);
+    logger.log(FILES, CONSOLE, msg);
+    fails++;
+  }
+
+  trail.clearHistory();
+  return fails;
+}
+// =============================================================
+// seed corpus for parsers, taken from real gpshistory.csv and NMEA log files
+const char *const seedCSV[] = {
+    "GPS,2023-06-01,12:34:56,CN87us,47.75191,-122.32951,120.0,55.0,90.0,7",
+    "PUP,2023-06-01,12:30:00,JJ00aa,-1.00000,-1.00000,-1.0,-1.0,-1.0,0",
+    "TIM,2023-06-01,12:30:12,JJ00aa,-1.00000,-1.00000,-1.0,-1.0,-1.0,3",
+    "LOS,2023-06-01,13:02:41,CN87ts,47.77622,-122.40712,98.2,0.0,0.0,2",
+    "AOS,2023-06-01,13:04:05,CN87ts,47.77623,-122.40710,98.4,2.1,171.5,5",
+    "BAT,2023-06-01,14:00:00,JJ00aa,-1.00000,-1.00000,-1.0,3.1,-1.0,0",
+};
+const char *const seedNMEA[] = {
+    "$GPRMC,120000.000,A,4730.0000,N,12300.0000,W,0.00,90.00,010623,,,A*40",
+    "$GPGGA,120000.000,4730.0000,N,12300.0000,W,1,08,0.90,100.0,M,-17.0,M,,*56",
+    "$GPRMC,120001.000,A,4730.0000,N,12154.0000,W,55.00,90.00,010623,,,A*72",
+    "$GPGGA,120001.000,4730.0000,N,12154.0000,W,1,09,0.90,110.0,M,-17.0,M,,*54",
+    "$GPRMC,120003.000,V,,,,,0.00,0.00,010623,,,N*4B",
+};
+
+// verify malformed input is rejected, these are regression tests for crashes found by "run fuzztest"
+int testBreadcrumbParse(const char *csv, bool expected, int line) {
+  char buffer[256];
+  strncpy(buffer, csv, sizeof(buffer) - 1);
+  buffer[sizeof(buffer) - 1] = 0;
+  Location loc;
+  bool actual = trail.parseBreadcrumb(buffer, &loc);
+  if (actual == expected) {
+    return 0;
+  }
+  char msg[256];
+  snprintf(msg, sizeof(msg), "[%d] Expected %d, actual %d from \"%s\" <-- Unequal", line, expected, actual, csv);
+  logger.log(FILES, CONSOLE, msg);
+  return 1;
+}
+
+// verify warm start commands to the receiver
+int testWarmStart(double lat, double lng, float alt, TimeElements tm, const char *expected, int line) {
+  char actual[NMEA_MAX_LENGTH];
+  WarmStart::makeCommand(actual, sizeof(actual), lat, lng, alt, makeTime(tm));
+  if (strcmp(actual, expected) == 0 && Nmea::isChecksumValid(actual)) {
+    return 0;
+  }
+  char msg[256];
+  snprintf(msg, sizeof(msg), "[%d] Expected \"%s\", actual \"%s\" <-- Unequal", line, expected, actual);
+  logger.log(FILES, CONSOLE, msg);
+  return 1;
+}
+int verifyWarmStart() {
+  logger.fencepost("unittest.cpp", "verifyWarmStart", __LINE__);
+  int fails = 0;
+
+  // clang-format off
+  //                       lat         long       alt     sec,min,hr,wday,day,mon,year-1970
+  fails += testWarmStart(47.75191,  -122.32951, 120.0, {56, 34, 12, 0,  1,  5, 2024-1970},
+                         "$PMTK741,47.751910,-122.329510,120,2024,05,01,12,34,56*30", __LINE__);
+  fails += testWarmStart(-33.856784, 151.215297, -4.6, {59, 59, 23, 0, 31, 12, 2023-1970},
+                         "$PMTK741,-33.856784,151.215297,-5,2023,12,31,23,59,59*15", __LINE__);
+  // clang-format on
+
+  // time to first fix is a breadcrumb, so it must survive a save and restore
+  fails += testBreadcrumbParse("TFF,2024-05-01,12:35:20,CN87us,47.75191,-122.32951,-1.0,24.0,1.0,6", true, __LINE__);
+  return fails;
+}
+int verifyGlyphAtlas() {
+  logger.fencepost("unittest.cpp", "verifyGlyphAtlas", __LINE__);
+  int fails = 0;
+  GlyphAtlas atlas(getFont(eFONTBIG));
+
+  // the cell must hold every character of a grid name
+  const char gridChars[] = "ABCDEFGHIJKLMNOPQRSTUVWXabcdefghijklmnopqrstuvwx0123456789";
+  for (const char *pc = gridChars; *pc; pc++) {
+    const GFXglyph *glyph = atlas.getGlyph(*pc);
+    if (!glyph || glyph->yOffset < atlas.top || glyph->yOffset + glyph->height > atlas.bottom) {
+      logger.log(FILES, CONSOLE, "Glyph '%c' does not fit the atlas cell", *pc);
+      fails++;
+    }
+  }
+  if (atlas.top >= 0 || atlas.textWidth("") != 0 || atlas.textWidth("CNCN") != 2 * atlas.textWidth("CN")) {
+    logger.log(FILES, CONSOLE, "Atlas metrics top(%d) width(%d) are wrong", atlas.top, atlas.textWidth("CN"));
+    fails++;
+  }
+  if (atlas.textWidth("CN\x01") != atlas.textWidth("CN")) {
+    logger.log(FILES, CONSOLE, "Character outside the font should have no width");
+    fails++;
+  }
+
+  // same text is not redrawn, new text is
+  GlyphField field(atlas, "CN87", 101, 101, cGRIDNAME);
+  field.print("CN87");
+  uint32_t runs = atlas.runs;
+  field.print("CN87");
+  if (atlas.runs != runs) {
+    logger.log(FILES, CONSOLE, "Unchanged grid name was redrawn");
+    fails++;
+  }
+  field.print("CN88");
+  if (atlas.runs == runs) {
+    logger.log(FILES, CONSOLE, "Changed grid name was not redrawn");
+    fails++;
+  }
+  return fails;
+}
+int verifyMalformedInput() {
+  logger.fencepost("unittest.cpp", "verifyMalformedInput", __LINE__);
+  int r = 0;
+
+  // clang-format off
+  r += testBreadcrumbParse(seedCSV[0], true, __LINE__);
+  r += testBreadcrumbParse(seedCSV[1], true, __LINE__);
+  r += testBreadcrumbParse("GPS,2023-06-01,12:34:56", false, __LINE__);                                      // truncated
+  r += testBreadcrumbParse("GPS,2023-06-01,12:34:56,CN87us,47.75191", false, __LINE__);                      // truncated
+  r += testBreadcrumbParse("GPS,,,,,,,,,", false, __LINE__);                                                 // empty fields
+  r += testBreadcrumbParse("GPS", false, __LINE__);                                                          //
+  r += testBreadcrumbParse("GPS,2023-13-01,12:34:56,CN87us,47.75191,-122.32951,120.0,55.0,90.0,7", false, __LINE__);   // month
+  r += testBreadcrumbParse("GPS,2023-06-01,12:34:56,CN87us,95.0,-122.32951,120.0,55.0,90.0,7", false, __LINE__);       // latitude
+  r += testBreadcrumbParse("GPS,2023-06-01,12:34:56,CN87us,nan,-122.32951,120.0,55.0,90.0,7", false, __LINE__);        // not a number
+  r += testBreadcrumbParse("SPU,2023-06-01,12:34:56,CN87us,47.75191,-122.32951,120.0,55.0,90.0,7", false, __LINE__);   // type
+  // clang-format on
+
+  // record types must be whole 3-char entries of rVALIDATE
+  if (Location::isValidRecordType("") || Location::isValidRecordType("SPU") || !Location::isValidRecordType(rGPS)) {
+    logger.log(FILES, CONSOLE, "isValidRecordType() accepted a partial match <-- Unequal");
+    r++;
+  }
+
+  // a damaged model file must not put the model somewhere impossible
+  Model damaged;
+  damaged.gLatitude = NAN;
+  damaged.gTimeZone = 1234;
+  Model target;
+  target.copyFrom(damaged);
+  if (target.gLatitude != 0.0 || target.gTimeZone != -7) {
+    logger.log(FILES, CONSOLE, "Model::copyFrom() accepted damaged values <-- Unequal");
+    r++;
+  }
+
+  // console commands
+  char cmd[24] = "\r\nhelp\r\n";
+  removeCRLF(cmd);
+  if (strcmp(cmd, "help") != 0) {
+    logger.log(FILES, CONSOLE, "removeCRLF() result \"%s\" <-- Unequal", cmd);
+    r++;
+  }
+  return r;
+}
+// =============================================================
+// verify heap-free formatting is identical to String() and snprintf()
+int testFixed(double value, int places, int line) {
+  char sExpected[34], sActual[34];
+  String(value, places).toCharArray(sExpected, sizeof(sExpected));   // the old way
+  fixedToChars(sActual, sizeof(sActual), value, places);
+  if (strcmp(sExpected, sActual) != 0) {
+    char msg[100];
+    snprintf(msg, sizeof(msg), "[%d] String() \"%s\", fixedToChars() \"%s\" <-- Unequal", line, sExpected, sActual);
+    logger.log(FILES, CONSOLE, msg);
+    return 1;
+  }
+  return 0;
+}
+
+int testDateFormat(time_t tm, int line) {
+  int r = 0;
+  char sExpected[24], sActual[24];
+  snprintf(sExpected, sizeof(sExpected), "%04d-%d-%d %02d:%02d:%02d",   // the old way
+           year(tm), month(tm), day(tm), hour(tm), minute(tm), second(tm));
+  date.datetimeToString(sActual, sizeof(sActual), tm);
+  r += strcmp(sExpected, sActual) ? 1 : 0;
+
+  snprintf(sExpected, sizeof(sExpected), "%04d-%02d-%02d", year(tm), month(tm), day(tm));
+  date.dateToString(sActual, sizeof(sActual), tm);
+  r += strcmp(sExpected, sActual) ? 1 : 0;
+
+  snprintf(sExpected, sizeof(sExpected), "%02d:%02d:%02d", hour(tm), minute(tm), second(tm));
+  date.timeToString(sActual, sizeof(sActual), tm);
+  r += strcmp(sExpected, sActual) ? 1 : 0;
+
+  if (r) {
+    logger.log(FILES, CONSOLE, "[%d] date/time formatting differs from snprintf <-- Unequal", line);
+  }
+  return r;
+}
+
+int verifyFormatting() {
+  logger.fencepost("unittest.cpp", "verifyFormatting", __LINE__);
+  int r = 0;
+
+  // clang-format off
+  r += testFixed(0.0, 0, __LINE__);          // " 0" has a leading space, same as dtostrf()
+  r += testFixed(5.0, 0, __LINE__);          //
+  r += testFixed(-5.0, 0, __LINE__);         //
+  r += testFixed(0.5, 0, __LINE__);          // ties round to even
+  r += testFixed(2.5, 0, __LINE__);          //
+  r += testFixed(0.125, 2, __LINE__);        //
+  r += testFixed(1.005, 2, __LINE__);        // 1.005 is really 1.00499999...
+  r += testFixed(-0.04, 1, __LINE__);        // "-0.0"
+  r += testFixed(47.75191, 5, __LINE__);     // breadcrumb latitude
+  r += testFixed(-122.32951, 5, __LINE__);   // breadcrumb longitude
+  r += testFixed(101325.37, 4, __LINE__);    // pressure
+  r += testFixed(1.0e17, 1, __LINE__);       // too big for fast path
+  r += testFixed(NAN, 2, __LINE__);          //
+  // clang-format on
+
+  // sweep the ranges we actually use
+  uint32_t seed = 12345;
+  for (int ii = 0; ii < 2000; ii++) {
+    seed         = seed * 1103515245 + 12345;   // simple LCG, repeatable
+    double value = ((int32_t)seed) / 1.0e7;     // about -214 .. +214
+    r += testFixed(value, ii % 6, __LINE__);
+  }
+
+  // clang-format off
+  r += testDateFormat(0, __LINE__);            // 1970-01-01
+  r += testDateFormat(1685622896, __LINE__);   // 2023-06-01 12:34:56
+  r += testDateFormat(1703980799, __LINE__);   // 2023-12-30 23:59:59
+  r += testDateFormat(4102444800, __LINE__);   // 2100-01-01
+  // clang-format on
+
+  // long run: the heap must not change at all
+  struct mallinfo before = mallinfo();
+  char sFloat[16], sDate[24];
+  for (int ii = 0; ii < 10000; ii++) {
+    floatToCharArray(sFloat, sizeof(sFloat), ii * 0.37, ii % 6);
+    date.datetimeToString(sDate, sizeof(sDate), 1685622896 + ii * 61);
+  }
+  struct mallinfo after = mallinfo();
+  if (after.uordblks != before.uordblks || after.arena != before.arena) {
+    logger.log(FILES, CONSOLE, "Formatting used %d bytes of heap <-- Unequal", after.uordblks - before.uordblks);
+    r++;
+  }
+  return r;
+}
+// =============================================================
 void countDown(int iSeconds) {
   logger.print("Wait ");
   setFontSize(0);
@@ -741,6 +2150,64 @@ void countDown(int iSeconds) {
   }
   logger.println();
 }
+// ================ test list ==================================
+// Every model test, in the order they run. Add new tests here.
+// "run modeltest" and "run unittest" run logicSuites and deviceSuites;
+// the desktop build in extras/host_test runs logicSuites and flashSuites.
+typedef int (*TestSuite)();
+#define NUM_SUITES(list) (sizeof(list) / sizeof(list[0]))
+
+// ----- no hardware
+static const TestSuite logicSuites[] = {
+    verifyNMEAtime,             // verify conversions from GPS' time (NMEA) to time_t
+    verifyCalcTimeDiff,         // verify human-friendly time intervals
+    verifyDerivingGridSquare,   // verify deriving grid square from lat-long coordinates
+    verifyComputingDistance,    // verify computing distance
+    verifyComputingGridLines,   // verify finding grid lines on E and W
+    verifyBreadcrumbRing,       // verify breadcrumb ring buffer
+    verifyDeferredLog,          // verify deferred logging ring
+    verifyMalformedInput,       // verify parsers reject damaged input
+    verifyFormatting,           // verify heap-free number and date formatting
+    verifyGnssStats,            // verify satellite counts per constellation
+    verifyWarmStart,            // verify position hint command to receiver
+    verifyMapProjection,        // verify map zoom levels and trail copy
+    verifyTrips,                // verify trip segmentation and statistics
+    verifyGeofence,             // verify geofence containment and index
+    verifyBaroSampling,         // verify cached barometer readings
+    verifyAltitudeFusion,       // verify barometer and GPS altitude filter
+    verifyBatteryTrend,         // verify coin battery discharge prediction
+    verifyTouchGestures,        // verify tap, long press and swipe from touch traces
+    verifyInterCore,            // verify queue and seqlock between RP2040 cores
+};
+
+// ----- need the real Adafruit_GPS parser, which the desktop build does not have
+static const TestSuite deviceSuites[] = {
+    verifyReplay,         // verify NMEA replay through parser and model
+    verifyHighRate,       // verify 10 Hz fixes through parser, model and detector
+    verifyFixValidator,   // verify bogus fixes stay out of breadcrumb trail
+    verifyFixSnapshot,    // verify core 1's fix snapshot through parser and model
+};
+
+// ----- overwrite the user's files on the device, so only the desktop runs them
+static const TestSuite flashSuites[] = {
+    verifySaveRestoreVolume,     // verify save/restore an integer setting in SDRAM
+    verifySaveRestoreArray,      // verify save/restore an array in SDRAM
+    verifySaveRestoreGPSModel,   // verify save/restore GPS model state in SDRAM
+};
+
+static int runSuites(const TestSuite *suites, int count) {
+  int f = 0;
+  for (int ii = 0; ii < count; ii++) {
+    f += suites[ii]();
+  }
+  return f;
+}
+int runModelSuites() {
+  return runSuites(logicSuites, NUM_SUITES(logicSuites)) + runSuites(deviceSuites, NUM_SUITES(deviceSuites));
+}
+int runHostSuites() {
+  return runSuites(logicSuites, NUM_SUITES(logicSuites)) + runSuites(flashSuites, NUM_SUITES(flashSuites));
+}
 // ================ main unit test =============================
 void runUnitTest() {
   tft.fillScreen(ILI9341_BLACK);
@@ -758,6 +2225,8 @@ void runUnitTest() {
   tft.setCursor(0, tft.height() - 12);   // move to bottom row
   tft.print("  --Open console monitor to see unit test results--");
   delay(1000);
+  auto observer    = trail.onRemember;   // test crumbs are not a real trip
+  trail.onRemember = nullptr;
 
   int f = 0;
   /*****
@@ -784,6 +2253,8 @@ void runUnitTest() {
   countDown(15);                          //
   f += verifyRestoreTrail(howMany);       // restore GPS route from non-volatile memory
   countDown(15);                          //
+  f += runModelSuites();                  // every test in the model test below
+  f += verifyGlyphAtlas();                // verify giant grid name cell and redraw
   /*****
   f += verifyDerivingGridSquare();    // verify deriving grid square from lat-long coordinates
   countDown(5);                       //
@@ -794,6 +2265,7 @@ void runUnitTest() {
   trail.clearHistory();             // clean up our mess after unit test
   trail.rememberPUP();              //
   trail.saveGPSBreadcrumbTrail();   // erase unit test from log file
+  trail.onRemember = observer;
 
   logger.fencepost("unittest.cpp", "End Unit Test", __LINE__);
   if (f) {
@@ -803,3 +2275,196 @@ void runUnitTest() {
     logger.log(FILES, CONSOLE, "100% successful");
   }
 }
+// ================ model test =================================
+// Fast subset of the unit tests that needs no display, no delays and no human.
+// Exercises models and helpers only: grid_helper, date_helper, Model, Breadcrumbs and Logger.
+// The breadcrumb trail is saved first and restored afterward, so this is safe in the field.
+// Most of these also run on a desktop, see extras/host_test; the ones that need
+// the real GPS parser run only here.
+int runModelTest() {
+  logger.fencepost("unittest.cpp", "Start Model Test", __LINE__);
+  unsigned long startTime = millis();
+  trail.saveGPSBreadcrumbTrail();   // keep user's trail safe from our tests
+  auto observer    = trail.onRemember;   // test crumbs are not a real trip
+  trail.onRemember = nullptr;
+
+  int f = runModelSuites();
+
+  trail.restoreGPSBreadcrumbTrail();   // put back user's trail
+  trail.onRemember = observer;
+
+  logger.fencepost("unittest.cpp", "End Model Test", __LINE__);
+  if (f) {
+    logger.log(FILES, CONSOLE, "====================");
+    logger.log(FILES, CONSOLE, "%d failures", f);
+  } else {
+    logger.log(FILES, CONSOLE, "100%% successful in %d msec", (int)(millis() - startTime));
+  }
+  return f;
+}
+// ================ fuzz test ==================================
+// Mutation fuzzing of everything that parses outside data: breadcrumb CSV lines,
+// NMEA sentences, the binary model file and console commands.
+// Each input is a seed with random damage. A crash shows up as a reboot; copy the
+// last "fuzz" line from the console into verifyMalformedInput() as a regression test.
+// The random sequence is repeatable, so a failure can be reproduced with the same seed.
+// This is a fixed-budget fuzzer that runs on the device. The breadcrumb parser also
+// has a coverage-guided libFuzzer target on the desktop, extras/host_test/fuzz_breadcrumbs.cpp.
+static void mutate(char *buffer, int size) {
+  int len = strlen(buffer);
+  switch (random(6)) {
+  case 0:   // truncate
+    buffer[random(len + 1)] = 0;
+    break;
+  case 1:   // flip one bit
+    if (len) {
+      buffer[random(len)] ^= (1 << random(7));
+    }
+    break;
+  case 2:   // replace one character with a delimiter or digit
+    if (len) {
+      const char interesting[] = ",,--::..*$09 ";
+      buffer[random(len)] = interesting[random(sizeof(interesting) - 1)];
+    }
+    break;
+  case 3:   // delete one character
+    if (len) {
+      int pos = random(len);
+      memmove(&buffer[pos], &buffer[pos + 1], len - pos);
+    }
+    break;
+  case 4:   // duplicate the tail, making the input longer
+    if (len && len < size / 2) {
+      int pos = random(len);
+      strncat(buffer, &buffer[pos], size - len - 1);
+    }
+    break;
+  case 5:   // random printable bytes
+    for (int ii = 0; ii < len; ii++) {
+      if (random(8) == 0) {
+        buffer[ii] = 32 + random(95);
+      }
+    }
+    break;
+  }
+}
+
+int fuzzBreadcrumbs(int iterations) {
+  logger.fencepost("unittest.cpp", "fuzzBreadcrumbs", __LINE__);
+  int accepted = 0, fails = 0;
+  for (int ii = 0; ii < iterations; ii++) {
+    char buffer[256], original[256];
+    strncpy(buffer, seedCSV[random(sizeof(seedCSV) / sizeof(seedCSV[0]))], sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = 0;
+    int rounds = 1 + random(4);
+    for (int jj = 0; jj < rounds; jj++) {
+      mutate(buffer, sizeof(buffer));
+    }
+    strncpy(original, buffer, sizeof(original));
+
+    Location loc;
+    if (trail.parseBreadcrumb(buffer, &loc)) {
+      accepted++;
+      if (!Model::isValidLatLong(loc.loc.lat, loc.loc.lng) || !Location::isValidRecordType(loc.recordType)) {
+        char msg[300];
+        snprintf(msg, sizeof(msg), "fuzz CSV accepted bad line \"%s\" <-- Unequal", original);
+        logger.log(FILES, CONSOLE, msg);
+        fails++;
+      }
+    }
+  }
+  logger.log(FILES, CONSOLE, ". %d of %d damaged CSV lines were accepted", accepted, iterations);
+  return fails;
+}
+
+int fuzzNMEA(int iterations) {
+  logger.fencepost("unittest.cpp", "fuzzNMEA", __LINE__);
+  const int batchSize = 8;
+  static char sentences[batchSize][REPLAY_LINE_SIZE];
+  static const char *batch[batchSize];
+  static ReplayModel replay;   // static, to keep parser buffers off the stack
+  int fixes = 0;
+  for (int ii = 0; ii < iterations; ii += batchSize) {
+    for (int jj = 0; jj < batchSize; jj++) {
+      strncpy(sentences[jj], seedNMEA[random(sizeof(seedNMEA) / sizeof(seedNMEA[0]))], REPLAY_LINE_SIZE - 1);
+      sentences[jj][REPLAY_LINE_SIZE - 1] = 0;
+      mutate(sentences[jj], REPLAY_LINE_SIZE);
+      batch[jj] = sentences[jj];
+    }
+    replay.beginArray(batch, batchSize, 0);
+    while (!replay.finished) {
+      replay.getGPS();
+      if (replay.gHaveGPSfix) {
+        fixes++;
+      }
+    }
+  }
+  logger.log(FILES, CONSOLE, ". %d fixes from %d damaged NMEA sentences", fixes, iterations);
+  return 0;   // success means no crash
+}
+
+int fuzzModelFile(int iterations) {
+  logger.fencepost("unittest.cpp", "fuzzModelFile", __LINE__);
+  int fails = 0;
+  for (int ii = 0; ii < iterations; ii++) {
+    // same as Model::restore() reading a damaged file into its temp buffer, but without the file
+    Model damaged;
+    byte *pData      = (byte *)&damaged.gLatitude;   // skip vtable pointer, copyFrom() never uses it
+    int numBytes     = (byte *)&damaged.compare4digits - pData + 1;
+    int numMutations = 1 + random(8);
+    for (int jj = 0; jj < numMutations; jj++) {
+      pData[random(numBytes)] = random(256);
+    }
+    Model target;
+    target.copyFrom(damaged);
+    if (!Model::isValidLatLong(target.gLatitude, target.gLongitude) || target.gTimeZone < -12 || target.gTimeZone > 14) {
+      logger.log(FILES, CONSOLE, "fuzz model file accepted bad value <-- Unequal");
+      fails++;
+    }
+  }
+  return fails;
+}
+
+int fuzzCommands(int iterations) {
+  logger.fencepost("unittest.cpp", "fuzzCommands", __LINE__);
+  // only the text handling is fuzzed, since random commands could erase the user's files
+  int fails = 0;
+  for (int ii = 0; ii < iterations; ii++) {
+    char cmd[24];
+    for (unsigned int jj = 0; jj < sizeof(cmd) - 1; jj++) {
+      const char interesting[] = "\r\n \t help";
+      cmd[jj] = interesting[random(sizeof(interesting) - 1)];
+    }
+    cmd[random(sizeof(cmd))] = 0;
+    cmd[sizeof(cmd) - 1]     = 0;
+    removeCRLF(cmd);
+    if (strpbrk(cmd, "\r\n")) {
+      logger.log(FILES, CONSOLE, "fuzz removeCRLF() left a CR or LF <-- Unequal");
+      fails++;
+    }
+  }
+  return fails;
+}
+
+int runFuzzTest() {
+  const long seed = 20230601;
+  logger.fencepost("unittest.cpp", "Start Fuzz Test", __LINE__);
+  logger.log(FILES, CONSOLE, ". Random seed %d", (int)seed);
+  unsigned long startTime = millis();
+  randomSeed(seed);
+
+  int f = 0;
+  f += fuzzBreadcrumbs(2000);   // damaged breadcrumb CSV lines
+  f += fuzzNMEA(1000);          // damaged NMEA sentences through parser and model
+  f += fuzzModelFile(1000);     // damaged binary model file
+  f += fuzzCommands(1000);      // damaged console commands
+
+  logger.fencepost("unittest.cpp", "End Fuzz Test", __LINE__);
+  if (f) {
+    logger.log(FILES, CONSOLE, "====================");
+    logger.log(FILES, CONSOLE, "%d failures", f);
+  } else {
+    logger.log(FILES, CONSOLE, "100%% successful in %d msec", (int)(millis() - startTime));
+  }
+  return f;
+}
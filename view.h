@@ -39,6 +39,7 @@ public:
       : tft(vtft), screenID(vid), background(0x000)   // default black background
   {
   }
+  virtual ~View() {}   // views are built and destroyed in place, see view_registry.h
 
   /**
    * Called on every pass through main()
@@ -15,7 +15,10 @@
             Show comparison of Barometric result to GPS result.
             - Barometer reading requires frequent calibration with a known altitude or sea level pressure.
             - GPS result can vary by a few hundred feet depending on satellites overhead.
-            Use the touchscreen to enter your current sea-level barometer setting.
+            Use the touchscreen to enter your current sea-level barometer setting,
+            or touch "Sync" to solve for the setting that matches GPS.
+            Once GPS has an altitude, the second prompt shows the fused
+            barometer and GPS altitude with its climb rate (model_altitude.h).
             As much as possible, this module uses Pascals (not hPa).
 
             +-------------------------------------------+
@@ -26,7 +29,7 @@
             | GPS (5#):       123.4 feet            | n |. . .yRow2
             |                                       | c |
             | Enter local sea level pressure        +--+|
-            | Accuracy depends on your input            |
+            | Fused 125 ft, climb +120 ft/min           |
             |                                           |
             +-------+       30.150 inHg         +-------+
             |   ^   |       1016.7 hPa          |   v   |
@@ -41,6 +44,7 @@
 #include "logger.h"             // conditional printing to Serial port
 #include "model_gps.h"          // Model of a GPS for model-view-controller
 #include "model_baro.h"         // Model of a barometer that stores 3-day history
+#include "model_altitude.h"     // barometer and GPS altitude, fused
 #include "TextField.h"          // Optimize TFT display text for proportional fonts
 #include "view.h"               // Base class for all views
 
@@ -48,6 +52,7 @@
 extern Logger logger;              // Griduino.ino
 extern Model *model;               // "model" portion of model-view-controller
 extern BarometerModel baroModel;   // singleton instance of the barometer model
+extern AltitudeFusion altFusion;   // Griduino.ino
 
 extern void showDefaultTouchTargets();   // Griduino.ino
 
@@ -210,42 +215,33 @@ protected:
   }
 
   void syncBarometerToGPS() {
-    int count          = 0;                                   // loop counter for debug
-    float baroAltitude = baroModel.getAltitude(sealevelPa);   // meters
-    float gpsAltitude  = model->gAltitude;                    // meters
-
-    if (baroAltitude < gpsAltitude) {
-      logger.log(BARO, DEBUG, "~~> Barometer's altitude is lower than GPS' altitude.");
-      logger.logTwoFloats(BARO, DEBUG, ". INCREASE sea level pressure from %s Pa in steps of %s Pa", sealevelPa, 1, delta(), 2);
-
-      // loop using _increasing_ pressure until altitudes match
-      while (baroAltitude < model->gAltitude) {
-        sealevelPa += delta();
-        if (++count > 1000)
-          break;   // avoid infinite loop
-        baroAltitude = baroModel.getAltitude(sealevelPa);
-      }
-    } else {
-      logger.log(BARO, DEBUG, "~~> Barometer's altitude is higher than GPS' altitude.");
-      logger.logTwoFloats(BARO, DEBUG, ". DECREASE sea level pressure from %s Pa in steps of %s Pa", sealevelPa, 1, delta(), 2);
-
-      // loop using _decreasing_ pressure until altitudes match
-      while (baroAltitude > gpsAltitude) {
-        sealevelPa -= delta();
-        if (++count > 1000)
-          break;   // avoid infinite loop
-        baroAltitude = baroModel.getAltitude(sealevelPa);
-      }
-    }
-
-    logger.logTwoFloats(BARO, DEBUG, ". Altimeter synchronized to GPS at %s Pa, %s steps", sealevelPa, 1, count, 0);
+    // solve the barometric formula for the sea level pressure that matches GPS, in one step
+    float pascals = baroModel.getBaroPressure();
+    sealevelPa    = BarometerModel::sealevelFromAltitude(pascals, model->gAltitude);
 
-    char msg[128], sPressure[12];
+    char msg[128], sPressure[12], sAltitude[12];
     floatToCharArray(sPressure, sizeof(sPressure), sealevelPa, 1);
-    snprintf(msg, sizeof(msg), ". Altimeter synchronized to GPS at %s Pa, %d steps", sPressure, count);
+    floatToCharArray(sAltitude, sizeof(sAltitude), model->gAltitude, 1);
+    snprintf(msg, sizeof(msg), ". Altimeter synchronized to GPS at %s Pa, %s m", sPressure, sAltitude);
     logger.log(BARO, DEBUG, msg);
   }
 
+  void showFusedAltitude() {
+    // barometer and GPS together, see model_altitude.h
+    if (!altFusion.valid || !altFusion.calibrated) {
+      txtAltimeter[ePrompt2].print("Accuracy depends on your input.");
+      return;
+    }
+    float scale       = model->gMetric ? 1.0 : feetPerMeters;
+    const char *sUnit = model->gMetric ? "m" : "ft";
+    const char *sRate = model->gMetric ? "m/min" : "ft/min";
+    char msg[48];
+    snprintf(msg, sizeof(msg), "Fused %d %s, climb %+d %s",
+             (int)round(altFusion.altitude * scale), sUnit,
+             (int)round(altFusion.climbRate * 60.0 * scale), sRate);
+    txtAltimeter[ePrompt2].print(msg);
+  }
+
 };   // end class ViewAltimeter
 
 // ============== implement public interface ================
@@ -256,7 +252,7 @@ void ViewAltimeter::updateScreen() {
   showTimeOfDay();
 
   // read altitude from barometer and GPS, and display everything
-  float pascals = baroModel.getBaroPressure();   // get pressure, causing BMP3XX to take a fresh reading from sensor
+  float pascals = baroModel.getBaroPressure();   // cached reading, see BARO_SAMPLE_MSEC
 
   char msg[16];   // strlen("12,345.6 meters") = 15
 
@@ -283,16 +279,21 @@ void ViewAltimeter::updateScreen() {
     txtAltimeter[eGpsValue].print(gpsFeet, 0);
   }
 
+  showFusedAltitude();
+
   // show sea level pressure
   // english: inches Mercury
   float pressureInHg = sealevelPa * INCHES_MERCURY_PER_PASCAL;
-  String sFloat      = String(pressureInHg, 3) + " inHg";
-  txtAltimeter[eSealevelEnglish].print(sFloat);
+  char sFloat[12], sText[24];
+  floatToCharArray(sFloat, sizeof(sFloat), pressureInHg, 3);
+  snprintf(sText, sizeof(sText), "%s inHg", sFloat);
+  txtAltimeter[eSealevelEnglish].print(sText);
 
   // metric: hecto Pascal
   float pressureHPa = sealevelPa / 100;
-  sFloat            = String(pressureHPa, 1) + " hPa";
-  txtAltimeter[eSealevelMetric].print(sFloat);
+  floatToCharArray(sFloat, sizeof(sFloat), pressureHPa, 1);
+  snprintf(sText, sizeof(sText), "%s hPa", sFloat);
+  txtAltimeter[eSealevelMetric].print(sText);
 
 }   // end updateScreen
 
@@ -11,6 +11,7 @@
             green above 2.4 volts
             yellow below 2.4 volts
             red below 1.8 volts
+            Days left come from the discharge trend in model_adc.h.
 
             +-----------------------------------+
             | *     Coin Battery Voltage      > |...yRow1
@@ -19,6 +20,7 @@
             |   |         | 3.0                 |...y30
             |   | ####### |           2.951     |...yVolts
             |   | ####### | 2.5       volts     |...y25
+            |   | ####### |         90 days left|...DAYS_LEFT
             |   | ####### |                     |
             |   | ####### | 2.0                 |...y20
             |   | ####### |                     |
@@ -41,7 +43,7 @@
 extern Logger logger;                                                                // Griduino.ino
 void floatToCharArray(char *result, int maxlen, double fValue, int decimalPlaces);   // Griduino.ino
 extern BatteryVoltage gpsBattery;                                                    // model_adc.h
-extern void selectNewView(int cmd);                                                  // Griduino.ino
+extern void requestNewView(int cmd);                                                 // Griduino.ino
 extern int goto_next_view;                                                           // Griduino.ino
 
 // ========== class ViewBattery =================================
@@ -84,12 +86,13 @@ protected:
     VOLTS,
     GMT_DATE,
     GMT_TIME,
-    GMT
+    GMT,
+    DAYS_LEFT,
   };
 
   // ----- static + dynamic screen text
   // clang-format off
-#define nBatteryValues 7
+#define nBatteryValues 8
   TextField txtValues[nBatteryValues] = {
       {"Coin Battery Voltage",-1, yRow1, cTITLE,  ALIGNCENTER,  eFONTSMALLEST}, // [TITLE] view title, centered
       {"CR2032",        66, 206,    cLABEL,  ALIGNLEFT,   eFONTSMALLEST},   // [CELL_TYPE]
@@ -98,6 +101,7 @@ protected:
       {"Apr 26, 2021", 130, yRow9,  cFAINT,  ALIGNRIGHT,  eFONTSMALLEST},   // [GMT_DATE]
       {"02:34:56",     148, yRow9,  cFAINT,  ALIGNLEFT,   eFONTSMALLEST},   // [GMT_TIME]
       {"GMT",          232, yRow9,  cFAINT,  ALIGNLEFT,   eFONTSMALLEST},   // [GMT]
+      {"",          xVolts, yVolts+2*space, cFAINT, ALIGNLEFT, eFONTSMALLEST},  // [DAYS_LEFT]
   };
   // clang-format on
 
@@ -129,6 +133,16 @@ void ViewBattery::updateScreen() {
   floatToCharArray(sVolts, sizeof(sVolts), coin_voltage, 3);
   txtValues[MEASUREMENT].print(sVolts);
 
+  // predicted life, from the discharge trend
+  int days = gpsBattery.daysToBad();
+  char sDays[24];
+  if (days < 0) {
+    sDays[0] = 0;   // not enough history yet
+  } else {
+    snprintf(sDays, sizeof(sDays), "%d days left", days);
+  }
+  txtValues[DAYS_LEFT].print(sDays);
+
   // ----- update bar graph
   int percent = (int)((coin_voltage - 1.5) / (3.5 - 1.5) * 100);
   int y0      = map(percent, 0, 100, gyLR, gyUL);
@@ -160,7 +174,7 @@ void ViewBattery::updateScreen() {
 
 void ViewBattery::startScreen() {
   if (!gpsBattery.canReadBattery) {   // if we CANNOT read the battery
-    selectNewView(goto_next_view);    // advance to next normal user view
+    requestNewView(goto_next_view);   // advance to next normal user view
     return;
   }
 
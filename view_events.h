@@ -87,8 +87,9 @@ struct DefinedEvent {
 };
 
 // ======= some interesting target events for count up/down display ========
+// constexpr, so the events and their text stay in flash
 
-DefinedEvent aug_microwave{
+constexpr DefinedEvent aug_microwave{
     // Time until August ARRL 10 HGz & Up Contest
     // "Third full weekend of August and September"
     // http://www.arrl.org/10-ghz-up
@@ -101,7 +102,7 @@ DefinedEvent aug_microwave{
     {0, 0, 13, 1, 19, 8, 2023 - 1970},
 };
 
-DefinedEvent sept_vhf{
+constexpr DefinedEvent sept_vhf{
     // Time until Sept VHF Contest
     // "Second full weekend in September"
     // http://www.arrl.org/september-vhf
@@ -114,7 +115,7 @@ DefinedEvent sept_vhf{
     {0, 0, 18, 1, 9, 9, 2023 - 1970},
 };
 
-DefinedEvent june_vhf{
+constexpr DefinedEvent june_vhf{
     // Time until June VHF Contest
     // "Second full weekend in June"
     // http://www.arrl.org/june-vhf
@@ -127,7 +128,7 @@ DefinedEvent june_vhf{
     {0, 0, 18, 1, 10, 6, 2023 - 1970},
 };
 
-DefinedEvent groundhog{
+constexpr DefinedEvent groundhog{
     // Number of "Groundhog Days"
     DAYS_SINCE,
     HIDE_HMS,
@@ -138,7 +139,7 @@ DefinedEvent groundhog{
     {0, 0, 7, 1, 1, 2, 2020 - 1970},   // Use the day before Feb 2, so the counter includes "Groundhog Day #1" on 2/2/2020
 };
 
-DefinedEvent halloween{
+constexpr DefinedEvent halloween{
     // Time until Halloween Trick'r Treaters knock on door
     COUNTDOWN_TO,
     SHOW_HMS,
@@ -149,7 +150,7 @@ DefinedEvent halloween{
     {0, 0, 7 + 18, 1, 31, 10, 2023 - 1970},   // 6pm Halloween in Pacific time (encoded in GMT by adding 7 hours)
 };
 
-DefinedEvent christmas{
+constexpr DefinedEvent christmas{
     // Time until Christmas Eve
     COUNTDOWN_TO,
     SHOW_HMS,
@@ -160,7 +161,7 @@ DefinedEvent christmas{
     {0, 0, 7 + 0, 1, 25, 12, 2023 - 1970},   // Midnight in Pacific time (encoded in GMT by adding 7 hours)
 };
 
-DefinedEvent valentines{
+constexpr DefinedEvent valentines{
     // Time until Valentines Day
     COUNTDOWN_TO,
     SHOW_HMS,
@@ -172,7 +173,7 @@ DefinedEvent valentines{
 };
 
 // ---- list of target events
-DefinedEvent eventList[] = {
+constexpr DefinedEvent eventList[] = {
     aug_microwave,
     sept_vhf,
     sept_vhf,
@@ -184,7 +185,7 @@ DefinedEvent eventList[] = {
 };
 
 // ----- choose target event
-DefinedEvent target = eventList[0];
+const DefinedEvent *target = &eventList[0];
 
 // ========== class ViewEvents ===================================
 class ViewEvents : public View {
@@ -256,7 +257,7 @@ protected:
   // advance to show next date event counter
   void nextDateEvent() {
     whichEvent = (whichEvent + 1) % (sizeof(eventList) / sizeof(eventList[0]));
-    target     = eventList[whichEvent];
+    target     = &eventList[whichEvent];
 
     char msg[64];
     snprintf(msg, sizeof(msg), ". Changed event to #%d, %d", whichEvent, eventList[whichEvent].line3);
@@ -298,11 +299,11 @@ void ViewEvents::updateScreen() {
 
   time_t adjustment = model->gTimeZone * SECS_PER_HOUR;
 
-  time_t date1local = makeTime(target.eventGMT);
+  time_t date1local = makeTime(target->eventGMT);
   time_t date2local = makeTime(todaysDate);
 
   time_t elapsed;
-  if (target.countup) {
+  if (target->countup) {
     elapsed = (date2local - date1local);   // e.g. "days SINCE target date"
   } else {
     elapsed = (date1local - date2local);   // e.g. "days UNTIL target date"
@@ -356,12 +357,12 @@ void ViewEvents::startScreen() {
   showScreenCenterline();                          // optionally draw visual alignment bar
 
   // ----- draw page title
-  txtDate[TITLE1].print(target.line1);
-  txtDate[TITLE2].print(target.line2);
-  txtDate[TITLE3].print(target.line3);
+  txtDate[TITLE1].print(target->line1);
+  txtDate[TITLE2].print(target->line2);
+  txtDate[TITLE3].print(target->line3);
 
   // ----- draw giant fields
-  if (target.show_HMS) {
+  if (target->show_HMS) {
     txtDate[COUNTTIME].setColor(cTEXTCOLOR);   // show the elapsed h:m:s
   } else {
     txtDate[COUNTTIME].setColor(cBACKGROUND);   // make invisible the elapsed h:m:s
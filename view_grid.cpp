@@ -34,6 +34,8 @@
 #include "model_baro.h"          // Model of a barometer that measures temperature
 #include "model_adc.h"           // Model of analog-digital converter
 #include "TextField.h"           // Optimize TFT display text for proportional fonts
+#include "glyph_atlas.h"         // giant grid name drawn as horizontal runs
+#include "map_projection.h"      // lat/long to screen at any scale
 #include "view.h"                // Base class for all views
 
 // ========== extern ===========================================
@@ -55,6 +57,11 @@ const int gMarginY = 26;   // and position text relative to this outline
 
 // ========== helpers ==========================================
 
+// the grid square's place on the screen, shared by everything that plots on it
+MapProjection gridProjection(const PointGPS origin) {
+  return MapProjection(origin, gridWidthDegrees, gridHeightDegrees, Rect{{gMarginX, gMarginY}, {gBoxWidth, gBoxHeight}});
+}
+
 void drawGridOutline() {
   tft.drawRect(gMarginX, gMarginY, gBoxWidth, gBoxHeight, ILI9341_CYAN);
 }
@@ -63,7 +70,7 @@ void drawGridOutline() {
 // these are names for the array indexes, must be named in same order as array below
 // clang-format off
 enum txtIndex {
-  GRID4=0, GRID6, LATLONG, 
+  LATLONG=0,
   COINBATT,   ALTITUDE,   NUMSAT,     TEMPERATURE,
   N_COMPASS,  S_COMPASS,  E_COMPASS,  W_COMPASS,
   N_DISTANCE, S_DISTANCE, E_DISTANCE, W_DISTANCE,
@@ -72,46 +79,64 @@ enum txtIndex {
 };
 
     // ----- dynamic screen text
-TextField txtGrid[] = {
-  //         text      x,y     color
-  TextField("CN77",  101,101,  cGRIDNAME),      // GRID4: center of screen
-  TextField("tt",    138,141,  cGRIDNAME),      // GRID6: center of screen
-  TextField("47.1234,-123.4567", 4,223, cSTATUS), // LATLONG: left-adj on bottom row
-  TextField("1.23v", 316,171,  cSTATUS, ALIGNRIGHT),  // COINBATT: just above altitude
-  TextField("123'",   62,196,  cSTATUS, ALIGNRIGHT),  // ALTITUDE: just above bottom row
-  TextField("99#",   313,221,  cSTATUS, ALIGNRIGHT),  // NUMSAT: lower right corner
-  TextField("75F",   313,196,  cSTATUS, ALIGNRIGHT),  // TEMPERATURE
-  TextField( "N",    156, 47,  cCOMPASS ),      // N_COMPASS: centered left-right
-  TextField( "S",    156,181,  cCOMPASS ),      // S_COMPASS
-  TextField( "E",    232,114,  cCOMPASS ),      // E_COMPASS: centered top-bottom
-  TextField( "W",     73,114,  cCOMPASS ),      // W_COMPASS
-  TextField("17.1",  180, 20,  cDISTANCE),      // N_DISTANCE
-  TextField("52.0",  180,207,  cDISTANCE),      // S_DISTANCE
-  TextField("13.2",  256,130,  cDISTANCE),      // E_DISTANCE
-  TextField("79.7",    0,130,  cDISTANCE),      // W_DISTANCE
-  TextField("CN88",  102, 20,  cGRIDNAME),      // N_GRIDNAME
-  TextField("CN86",  102,207,  cGRIDNAME),      // S_GRIDNAME
-  TextField("CN97",  256,102,  cGRIDNAME),      // E_GRIDNAME
-  TextField("CN77",    0,102,  cGRIDNAME),      // W_GRIDNAME
-  TextField("48",     56, 44,  cBOXDEGREES, ALIGNRIGHT),  // N_BOX_LAT
-  TextField("47",     56,190,  cBOXDEGREES, ALIGNRIGHT),  // S_BOX_LAT
-  TextField("122",   243, 20,  cBOXDEGREES),              // E_BOX_LONG
-  TextField("124",    72, 20,  cBOXDEGREES, ALIGNRIGHT),  // W_BOX_LONG
+// the layout is constexpr so it stays in flash, see FixedTextField in TextField.h
+constexpr TextLayout gridLayout[] = {
+  //  text                 x,y     color         align         font
+  {"47.1234,-123.4567",   4,223, cSTATUS,     ALIGNLEFT,   eFONTUNSPEC},  // LATLONG: left-adj on bottom row
+  {"1.23v",             316,171, cSTATUS,     ALIGNRIGHT,  eFONTUNSPEC},  // COINBATT: just above altitude
+  {"123'",               62,196, cSTATUS,     ALIGNRIGHT,  eFONTUNSPEC},  // ALTITUDE: just above bottom row
+  {"99#",               313,221, cSTATUS,     ALIGNRIGHT,  eFONTUNSPEC},  // NUMSAT: lower right corner
+  {"75F",               313,196, cSTATUS,     ALIGNRIGHT,  eFONTUNSPEC},  // TEMPERATURE
+  {"N",                 156, 47, cCOMPASS,    ALIGNLEFT,   eFONTUNSPEC},  // N_COMPASS: centered left-right
+  {"S",                 156,181, cCOMPASS,    ALIGNLEFT,   eFONTUNSPEC},  // S_COMPASS
+  {"E",                 232,114, cCOMPASS,    ALIGNLEFT,   eFONTUNSPEC},  // E_COMPASS: centered top-bottom
+  {"W",                  73,114, cCOMPASS,    ALIGNLEFT,   eFONTUNSPEC},  // W_COMPASS
+  {"17.1",              180, 20, cDISTANCE,   ALIGNLEFT,   eFONTUNSPEC},  // N_DISTANCE
+  {"52.0",              180,207, cDISTANCE,   ALIGNLEFT,   eFONTUNSPEC},  // S_DISTANCE
+  {"13.2",              256,130, cDISTANCE,   ALIGNLEFT,   eFONTUNSPEC},  // E_DISTANCE
+  {"79.7",                0,130, cDISTANCE,   ALIGNLEFT,   eFONTUNSPEC},  // W_DISTANCE
+  {"CN88",              102, 20, cGRIDNAME,   ALIGNLEFT,   eFONTUNSPEC},  // N_GRIDNAME
+  {"CN86",              102,207, cGRIDNAME,   ALIGNLEFT,   eFONTUNSPEC},  // S_GRIDNAME
+  {"CN97",              256,102, cGRIDNAME,   ALIGNLEFT,   eFONTUNSPEC},  // E_GRIDNAME
+  {"CN77",                0,102, cGRIDNAME,   ALIGNLEFT,   eFONTUNSPEC},  // W_GRIDNAME
+  {"48",                 56, 44, cBOXDEGREES, ALIGNRIGHT,  eFONTUNSPEC},  // N_BOX_LAT
+  {"47",                 56,190, cBOXDEGREES, ALIGNRIGHT,  eFONTUNSPEC},  // S_BOX_LAT
+  {"122",               243, 20, cBOXDEGREES, ALIGNLEFT,   eFONTUNSPEC},  // E_BOX_LONG
+  {"124",                72, 20, cBOXDEGREES, ALIGNRIGHT,  eFONTUNSPEC},  // W_BOX_LONG
+};
+FixedTextField txtGrid[] = {
+  gridLayout[LATLONG], gridLayout[COINBATT], gridLayout[ALTITUDE], gridLayout[NUMSAT],
+  gridLayout[TEMPERATURE], gridLayout[N_COMPASS], gridLayout[S_COMPASS], gridLayout[E_COMPASS],
+  gridLayout[W_COMPASS], gridLayout[N_DISTANCE], gridLayout[S_DISTANCE], gridLayout[E_DISTANCE],
+  gridLayout[W_DISTANCE], gridLayout[N_GRIDNAME], gridLayout[S_GRIDNAME], gridLayout[E_GRIDNAME],
+  gridLayout[W_GRIDNAME], gridLayout[N_BOX_LAT], gridLayout[S_BOX_LAT], gridLayout[E_BOX_LONG],
+  gridLayout[W_BOX_LONG],
+};
+const int numTextGrid = sizeof(txtGrid)/sizeof(txtGrid[0]);
+
+    // ----- giant grid name, see glyph_atlas.h
+enum gridNameIndex { GRID4=0, GRID6 };
+GlyphAtlas bigFont(getFont(eFONTBIG));
+GlyphField txtGridName[] = {
+  //                  text      x,y     color
+  GlyphField(bigFont, "CN77",  101,101,  cGRIDNAME),      // GRID4: center of screen
+  GlyphField(bigFont, "tt",    138,141,  cGRIDNAME),      // GRID6: center of screen
 };
-const int numTextGrid = sizeof(txtGrid)/sizeof(TextField);
 // clang-format on
 
-void drawGridName(String newGridName) {
+void drawGridName(const char *newGridName) {
   // huge lettering of current grid square
   // two lines: "CN87" and "us" below it
 
-  setFontSize(24);
-
-  String grid1_4 = newGridName.substring(0, 4);
-  String grid5_6 = newGridName.substring(4, 6);
+  char grid1_4[5] = "";
+  char grid5_6[3] = "";
+  strncpy(grid1_4, newGridName, 4);
+  if (strlen(newGridName) > 4) {
+    strncpy(grid5_6, newGridName + 4, 2);
+  }
 
-  txtGrid[GRID4].print(grid1_4);
-  txtGrid[GRID6].print(grid5_6);
+  txtGridName[GRID4].print(grid1_4);   // draws its own background, no erase pass
+  txtGridName[GRID6].print(grid5_6);
 }
 
 void drawPositionLL(double fLat, double fLong) {
@@ -208,10 +233,10 @@ void drawBoxLatLong() {
 
   int radius = 3;
   // draw "degree" symbol at:       x                        y        r     color
-  tft.drawCircle(txtGrid[N_BOX_LAT].x + 7, txtGrid[N_BOX_LAT].y - 14, radius, cBOXDEGREES);   // draw circle to represent "degrees"
-  tft.drawCircle(txtGrid[S_BOX_LAT].x + 7, txtGrid[S_BOX_LAT].y - 14, radius, cBOXDEGREES);
-  // t.drawCircle(txtGrid[E_BOX_LONG].x+7, txtGrid[E_BOX_LONG].y-14, radius, cBOXDEGREES); // no room for "degrees" on ALIGNLEFT number?
-  tft.drawCircle(txtGrid[W_BOX_LONG].x + 7, txtGrid[W_BOX_LONG].y - 14, radius, cBOXDEGREES);
+  tft.drawCircle(gridLayout[N_BOX_LAT].x + 7, gridLayout[N_BOX_LAT].y - 14, radius, cBOXDEGREES);   // draw circle to represent "degrees"
+  tft.drawCircle(gridLayout[S_BOX_LAT].x + 7, gridLayout[S_BOX_LAT].y - 14, radius, cBOXDEGREES);
+  // t.drawCircle(gridLayout[E_BOX_LONG].x+7, gridLayout[E_BOX_LONG].y-14, radius, cBOXDEGREES); // no room for "degrees" on ALIGNLEFT number?
+  tft.drawCircle(gridLayout[W_BOX_LONG].x + 7, gridLayout[W_BOX_LONG].y - 14, radius, cBOXDEGREES);
 }
 
 void drawNeighborGridNames() {
@@ -285,27 +310,19 @@ void translateGPStoScreen(Point *result, const PointGPS loc, const PointGPS orig
   //                    :                  :
   // Longitude =    degreesX   degreesX+gWidthDegrees
 
-  result->x = -1;   // assume result is off-screen
-  result->y = -1;
-
-  const float xPixelsPerDegree = gBoxWidth / gridWidthDegrees;     // one grid square = 2.0 degrees wide E-W
-  const float yPixelsPerDegree = gBoxHeight / gridHeightDegrees;   // one grid square = 1.0 degrees high N-S
-
-  result->x = gMarginX + (int)((loc.lng - origin.lng) * xPixelsPerDegree);
-  result->y = gMarginY + gBoxHeight - (int)((loc.lat - origin.lat) * yPixelsPerDegree);
+  *result = gridProjection(origin).toScreen(loc);
 }
 // =============================================================
 void plotRoute(Breadcrumbs *trail, const PointGPS origin) {
   // show route track using history saved in bread crumb trail
 
   Point prevPixel{0, 0};   // keep track of previous dot plotted
+  const MapProjection proj = gridProjection(origin);
 
   Location *mark = trail->begin();
   while (mark) {   // loop through Location[] array of history
     if (!mark->isEmpty()) {
-      Point screen;
-      PointGPS spot{mark->loc.lat, mark->loc.lng};
-      translateGPStoScreen(&screen, spot, origin);
+      Point screen = proj.toScreen(mark->loc);
 
       // erase a few dots around this to make it more visible
       // but! which dots to erase depend on what direction we're moving
@@ -449,11 +466,6 @@ void plotCurrentPosition(const PointGPS loc, const PointGPS origin) {
 void ViewGrid::updateScreen() {
   // called on every pass through main()
 
-#ifdef SCOPE_OUTPUT                   // start output interval for oscilloscope
-  pinMode(SCOPE_OUTPUT, OUTPUT);      // debug - mostly unused pin on rp2040
-  digitalWrite(SCOPE_OUTPUT, HIGH);   // debug - output for oscilloscope
-#endif
-
   // coordinates of lower-left corner of currently displayed grid square
   PointGPS gridOrigin{grid.nextGridLineSouth(model->gLatitude), grid.nextGridLineWest(model->gLongitude)};
 
@@ -465,18 +477,13 @@ void ViewGrid::updateScreen() {
   drawAltitude();                                        // height above sea level
   drawCoinBatteryVoltage();                              // coin battery voltage
   drawNumSatellites();                                   // number of satellites
-  drawTemperature(baroModel.getTemperature());           // query temperature from the C++ object, which is updated only by "performReading()"
+  drawTemperature(baroModel.getTemperature());           // cached temperature, read together with pressure
   drawPositionLL(model->gLatitude, model->gLongitude);   // lat-long of current position
   // drawCompassPoints();              // show N-S-E-W compass points (disabled, it makes the screen too busy)
   // drawBoxLatLong();                 // show coordinates of box (disabled, it makes the screen too busy)
   drawNeighborGridNames();                       // show 4-digit names of nearby squares
   drawNeighborDistances();                       // this is the main goal of the whole project
   plotCurrentPosition(myLocation, gridOrigin);   // show current pushpin
-
-#ifdef SCOPE_OUTPUT
-  digitalWrite(SCOPE_OUTPUT, LOW);   // end output interval for oscilloscope
-  delay(1);                          // debug
-#endif
 }
 
 void ViewGrid::startScreen() {
@@ -484,6 +491,9 @@ void ViewGrid::startScreen() {
   this->clearScreen(this->background);          // clear screen
   txtGrid[0].setBackground(this->background);   // set background for all TextFields in this view
   TextField::setTextDirty(txtGrid, numTextGrid);
+  for (GlyphField &field : txtGridName) {
+    field.dirty = true;
+  }
 
   double lngMiles = grid.calcDistanceLong(model->gLatitude, 0.0, minLong, false);
   double latMiles = grid.calcDistanceLat(0.0, minLat, false);   // arg3 'false' for miles (not km)
@@ -122,8 +122,8 @@ public:
 
   // human friendly "elapsed time" helper
   // from time1 to time2 (where time1 <= time2)
-  // this method is 'public' so it is callable from unit tests
-  void calcTimeDiff(char *msg, int sizeMsg, time_t time1, time_t time2) {
+  // this method is 'public' and 'static' so it is callable from unit tests without a view
+  static void calcTimeDiff(char *msg, int sizeMsg, time_t time1, time_t time2) {
     int timeDiff = time2 - time1;   // seconds
     if (timeDiff < SECS_PER_MIN) {
       // ------------------------------------------
@@ -0,0 +1,299 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     view_map.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Breadcrumb trail at several zoom levels.
+            Touch the map to zoom out; after the whole trail it wraps around
+            to the 6-character subsquare again.
+
+            +-----------------------------------+
+            | *       Map CN87us              > |...yRow1
+            |      +---------------------+      |...box.ul.y
+            |      |   . . . .           |      |
+            |      |          . . []     |      |
+            |      |                     |      |
+            |      +---------------------+      |
+            | 3x3 squares     300 of 2850 crumbs|...yRow2
+            +------:---------------------:------+
+                 box.ul.x          box.ul.x + box.size.x
+
+            Zoom levels:
+              6-char subsquare   5' x 2.5'
+              4-char square      2 x 1 degrees, same area as the grid view
+              3x3 squares        the square and its 8 neighbors
+              Whole trail        fits the bounding box of the trail
+
+            The trail is copied into a MapTrail (map_projection.h) when the view
+            starts and whenever a breadcrumb is added. A long trail is thinned
+            to MAP_TRAIL_POINTS. Changing the zoom reuses the copy.
+
+            The map is redrawn when the trail changes, and also when the
+            visible area moves, e.g. the vehicle crossed into the next
+            subsquare. The zoom level is saved in MapSetting, so it survives
+            leaving the view and turning the power off.
+*/
+
+#include <Arduino.h>
+#include <Adafruit_ILI9341.h>    // TFT color display library
+#include "constants.h"           // Griduino constants and colors
+#include "logger.h"              // conditional printing to Serial port
+#include "grid_helper.h"         // lat/long conversion routines
+#include "model_gps.h"           // Model of a GPS for model-view-controller
+#include "model_breadcrumbs.h"   // breadcrumb trail
+#include "map_projection.h"      // lat/long to screen at any scale
+#include "TextField.h"           // Optimize TFT display text for proportional fonts
+#include "view.h"                // Base class for all views
+
+// ========== extern ===========================================
+extern Logger logger;                    // Griduino.ino
+extern Grids grid;                       // grid_helper.h
+extern Model *model;                     // "model" portion of model-view-controller
+extern Breadcrumbs trail;                // Griduino.ino
+extern void showDefaultTouchTargets();   // Griduino.ino
+
+// ----- alias names for zoom levels
+enum ZoomLevel {
+  ZOOM_SUBSQUARE = 0,   // 6-char
+  ZOOM_SQUARE,          // 4-char
+  ZOOM_NEIGHBORS,       // 3x3 squares
+  ZOOM_TRAIL,           // bounding box of trail
+  NUM_ZOOM_LEVELS,
+};
+
+// ========== class MapSetting =================================
+// The setting outlives the view, which exists only while it's on screen
+class MapSetting {
+public:
+  int zoom = ZOOM_SQUARE;   // power-on default
+
+  void loadConfig();
+  void saveConfig();
+};   // end class MapSetting
+
+extern MapSetting mapSetting;   // Griduino.ino
+
+// ========== class ViewMap ====================================
+class ViewMap : public View {
+public:
+  // ---------- public interface ----------
+  // This derived class must implement the public interface:
+  ViewMap(Adafruit_ILI9341 *vtft, int vid)   // ctor
+      : View{vtft, vid} {
+    background = cBACKGROUND;   // every view can have its own background color
+  }
+  void updateScreen();
+  void startScreen();
+  bool onTouch(Point touch);
+
+protected:
+  // ---------- local data for this derived class ----------
+  // color scheme: see constants.h
+  int zoom = ZOOM_SQUARE;       // copy of mapSetting.zoom
+  MapTrail trailMap;            // trail in screen-ready integers
+  uint32_t drawnBuild = 0;      // trailMap.builds at the last full redraw
+  PointGPS drawnOrigin{0, 0};   // lower left corner at the last full redraw
+  double drawnWide = 0;         // degrees of longitude at the last full redraw
+  Point vehicle{-1, -1};        // where the vehicle icon was drawn
+  const int vehicleSize = 8;    // pixels
+
+  // ========== text screen layout ===================================
+  const int yRow1 = 18;
+  const int yRow2 = 230;
+
+  // canvas for the map, 9:8 like the grid view's 180x160 box
+  const Rect box{{61, 30}, {198, 176}};
+
+  enum txtIndex {
+    TITLE = 0,
+    ZOOMNAME,
+    POINTS,
+  };
+
+  // clang-format off
+#define nMapValues 3
+  TextField txtValues[nMapValues] = {
+      {"Map",   -1, yRow1, cTITLE,  ALIGNCENTER, eFONTSMALLEST},   // [TITLE]
+      {"",       4, yRow2, cLABEL,  ALIGNLEFT,   eFONTSMALLEST},   // [ZOOMNAME]
+      {"",     316, yRow2, cLABEL,  ALIGNRIGHT,  eFONTSMALLEST},   // [POINTS]
+  };
+  // clang-format on
+
+  MapProjection projection() {
+    // visible area for the current zoom level, around the current position
+    double lat = model->gLatitude;
+    double lng = model->gLongitude;
+    PointGPS square{grid.nextGridLineSouth(lat), grid.nextGridLineWest(lng)};
+    switch (zoom) {
+    case ZOOM_SUBSQUARE:
+      return MapProjection(PointGPS{grid.nextGrid6South(lat), grid.nextGrid6West(lng)},
+                           gridWidthDegrees / 24, gridHeightDegrees / 24, box);
+    case ZOOM_NEIGHBORS:
+      return MapProjection(PointGPS{square.lat - gridHeightDegrees, square.lng - gridWidthDegrees},
+                           3 * gridWidthDegrees, 3 * gridHeightDegrees, box);
+    case ZOOM_TRAIL:
+      if (trailMap.crumbs > 0) {
+        return MapProjection::fit(trailMap.lowerLeft, trailMap.upperRight, box);
+      }
+      break;   // no trail yet, show the grid square
+    }
+    return MapProjection(square, gridWidthDegrees, gridHeightDegrees, box);
+  }
+
+  void drawGridLines(const MapProjection &proj) {
+    // 4-char grid lines, if they are not too crowded
+    if (proj.degreesWide / gridWidthDegrees > 12) {
+      return;
+    }
+    float west  = grid.nextGridLineEast(proj.origin.lng);
+    float south = grid.nextGridLineNorth(proj.origin.lat);
+    for (double lng = west; lng < proj.origin.lng + proj.degreesWide; lng += gridWidthDegrees) {
+      Point pt = proj.toScreen(PointGPS{proj.origin.lat, lng});
+      tft->drawFastVLine(pt.x, box.ul.y, box.size.y, cFAINTER);
+    }
+    for (double lat = south; lat < proj.origin.lat + proj.degreesHigh; lat += gridHeightDegrees) {
+      Point pt = proj.toScreen(PointGPS{lat, proj.origin.lng});
+      tft->drawFastHLine(box.ul.x, pt.y, box.size.x, cFAINTER);
+    }
+  }
+
+  static bool isInside(const Point pt, const Rect &area) {
+    return (pt.x >= area.ul.x) && (pt.x < area.ul.x + area.size.x) &&
+           (pt.y >= area.ul.y) && (pt.y < area.ul.y + area.size.y);
+  }
+
+  void drawTrail(const Rect *area = nullptr) {
+    // plot the cached points, or only those inside the given area
+    Point prev{-1, -1};
+    for (int ii = 0; ii < trailMap.count; ii++) {
+      Point pt = trailMap.toScreen(ii);
+      if (pt.x == prev.x && pt.y == prev.y) {
+        continue;   // zoomed out, many crumbs land on the same pixel
+      }
+      prev = pt;
+      if (isInside(pt, box) && (!area || isInside(pt, *area))) {
+        tft->drawPixel(pt.x, pt.y, cBREADCRUMB);
+      }
+    }
+  }
+
+  void drawVehicle(const MapProjection &proj) {
+    Point car = (model->gLatitude != 0.0) ? proj.toScreen(PointGPS{model->gLatitude, model->gLongitude}) : Point{-1, -1};
+    if (!proj.isVisible(car)) {
+      car = Point{-1, -1};
+    }
+    if (car.x == vehicle.x && car.y == vehicle.y) {
+      return;   // icon has not moved a pixel
+    }
+    if (vehicle.x >= 0) {
+      // erase old icon, then restore the trail underneath it
+      Rect old{{vehicle.x - vehicleSize / 2, vehicle.y - vehicleSize / 2}, {vehicleSize, vehicleSize}};
+      tft->drawRect(old.ul.x, old.ul.y, old.size.x, old.size.y, this->background);
+      drawTrail(&old);
+    }
+    if (car.x >= 0) {
+      tft->drawRect(car.x - vehicleSize / 2, car.y - vehicleSize / 2, vehicleSize, vehicleSize, cVEHICLE);
+    }
+    vehicle = car;
+  }
+
+  bool isMoved(const MapProjection &proj) const {
+    // the visible area is not the one on screen, e.g. crossed into the next subsquare
+    return proj.origin.lat != drawnOrigin.lat || proj.origin.lng != drawnOrigin.lng || proj.degreesWide != drawnWide;
+  }
+
+  void drawMap() {
+    // full redraw of the canvas, after a zoom change, a new breadcrumb, or a move to a new area
+    MapProjection proj = projection();
+    trailMap.setProjection(proj);
+    drawnOrigin = proj.origin;
+    drawnWide   = proj.degreesWide;
+
+    tft->fillRect(box.ul.x, box.ul.y, box.size.x, box.size.y, this->background);
+    drawGridLines(proj);
+    tft->drawRect(box.ul.x - 1, box.ul.y - 1, box.size.x + 2, box.size.y + 2, ILI9341_CYAN);
+    drawTrail();
+    vehicle = Point{-1, -1};
+    drawVehicle(proj);
+    drawnBuild = trailMap.builds;
+
+    static const char *const zoomNames[NUM_ZOOM_LEVELS] = {"6-char subsquare", "4-char square", "3x3 squares", "Whole trail"};
+    txtValues[ZOOMNAME].print(zoomNames[zoom]);
+
+    char msg[40];
+    snprintf(msg, sizeof(msg), "%d of %d crumbs", trailMap.count, trailMap.crumbs);
+    txtValues[POINTS].print(msg);
+  }
+
+};   // end class ViewMap
+
+// ============== implement public interface ================
+void ViewMap::updateScreen() {
+  // called on every pass through main()
+  char grid6[7];
+  grid.calcLocator(grid6, model->gLatitude, model->gLongitude, 6);
+  char title[16];
+  snprintf(title, sizeof(title), "Map %s", grid6);
+  txtValues[TITLE].print(title);
+
+  trailMap.update(trail);   // walks the trail only if a breadcrumb was added
+  MapProjection proj = projection();
+  if (trailMap.builds != drawnBuild || isMoved(proj)) {
+    drawMap();
+  } else {
+    drawVehicle(proj);
+  }
+}
+
+void ViewMap::startScreen() {
+  // called once each time this view becomes active
+  this->clearScreen(this->background);             // clear screen
+  txtValues[0].setBackground(this->background);    // set background for all TextFields in this view
+  TextField::setTextDirty(txtValues, nMapValues);   // make sure all fields get re-printed on screen change
+
+  drawAllIcons();              // draw gear (settings) and arrow (next screen)
+  showDefaultTouchTargets();   // optionally draw boxes around button-touch area
+  showScreenBorder();          // optionally outline visible area
+
+  zoom = constrain(mapSetting.zoom, 0, NUM_ZOOM_LEVELS - 1);
+  trailMap.update(trail);
+  drawMap();
+  updateScreen();   // update UI immediately, don't wait for the main loop to eventually get around to it
+}
+
+bool ViewMap::onTouch(Point touch) {
+  if (isInside(touch, box)) {
+    zoom = (zoom + 1) % NUM_ZOOM_LEVELS;
+    logger.log(CONFIG, INFO, "->->-> Map zoom level %d", zoom);
+    drawMap();   // same cached points, new scale
+    mapSetting.zoom = zoom;
+    mapSetting.saveConfig();
+    return true;
+  }
+  return false;   // true=handled, false=controller will run default action
+}
+
+// ========== load/save config setting =========================
+#define MAP_CONFIG_FILE    CONFIG_FOLDER "/mapzoom.cfg"
+#define MAP_CONFIG_VERSION "Map Zoom v01"
+
+// ----- load from SDRAM -----
+void MapSetting::loadConfig() {
+  SaveRestore config(MAP_CONFIG_FILE, MAP_CONFIG_VERSION);
+  int tempZoom = 0;
+  int result   = config.readConfig((byte *)&tempZoom, sizeof(tempZoom));
+  if (result) {
+    zoom = constrain(tempZoom, 0, NUM_ZOOM_LEVELS - 1);
+    logger.log(CONFIG, INFO, "Loaded map zoom level from NVR: %d", zoom);
+  } else {
+    logger.log(CONFIG, ERROR, "Failed to load map zoom level, re-initializing file");
+    saveConfig();
+  }
+}
+// ----- save to SDRAM -----
+void MapSetting::saveConfig() {
+  SaveRestore config(MAP_CONFIG_FILE, MAP_CONFIG_VERSION);
+  config.writeConfig((byte *)&zoom, sizeof(zoom));
+}
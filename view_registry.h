@@ -0,0 +1,189 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     view_registry.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Build each view only while it's on the screen.
+
+            Every view carries its own TextField and FunctionButton arrays,
+            which add up to many kilobytes for all views together. But only
+            one view is shown at a time. So instead of a global object for
+            every view, the active view is constructed in one shared arena
+            when it's selected, and destroyed right after its endScreen().
+            The arena is the size of the largest view; the RAM this saves
+            went to the breadcrumb trail. "show memory" reports both.
+
+            Griduino.ino has a table with one row per view, in VIEW_INDEX order:
+                factory                 size                    next view     next settings view
+                {makeView<ViewGrid>,    sizeof(ViewGrid),       MAP_VIEW,     CFG_VOLUME},
+            The table is constexpr, so it lives in flash, and the arena size
+            is computed from it at compile time.
+
+            Settings that must outlive their view, such as volume or audio type,
+            are in small classes beside the view, e.g. VolumeSetting in cfg_volume.h.
+
+            Text labels are string constants in flash, and each TextField keeps
+            only its position and the state it needs to redraw (see TextField.h).
+            The registry counts the fields each view builds, so "show views"
+            can report the RAM that saved per view, measured with sizeof() on
+            this processor against the members TextField used to have.
+
+            A view must never destroy itself. From inside its own methods,
+            a view calls requestNewView() instead of selectNewView(), and the
+            controller switches views after the view's method has returned.
+*/
+
+#include <Arduino.h>            //
+#include <new>                  // placement new
+#include <Adafruit_ILI9341.h>   // TFT color display library
+#include "constants.h"          // Griduino constants, colors, typedefs
+#include "logger.h"             // conditional printing to Serial port
+#include "TextField.h"          // Optimize TFT display text for proportional fonts
+#include "view.h"               // Base class for all views
+
+// ========== extern ===========================================
+extern Logger logger;   // Griduino.ino
+
+// ========== view factory =====================================
+typedef View *(*ViewFactory)(void *arena, Adafruit_ILI9341 *vtft, int vid);
+
+// construct a view in place, e.g. makeView<ViewGrid>
+template <class T>
+View *makeView(void *arena, Adafruit_ILI9341 *vtft, int vid) {
+  return new (arena) T(vtft, vid);
+}
+
+// one row of the navigation table
+struct ViewEntry {
+  ViewFactory create;   // builds this view in the arena
+  uint16_t size;        // bytes
+  int8_t next;          // where the "next view" arrow goes
+  int8_t nextSetting;   // where the "settings" gear goes
+};
+
+// compile-time arena size, e.g. largestView(table, count)
+constexpr int largerOf(int a, int b) {
+  return (a > b) ? a : b;
+}
+constexpr int largestView(const ViewEntry *table, int count) {
+  return (count == 0) ? 0 : largerOf(table[0].size, largestView(table + 1, count - 1));
+}
+constexpr int sumOfViews(const ViewEntry *table, int count) {
+  return (count == 0) ? 0 : table[0].size + sumOfViews(table + 1, count - 1);
+}
+
+// ========== class ViewRegistry ===============================
+class ViewRegistry {
+public:
+#define NO_VIEW_REQUEST    -1   // nothing requested by requestNewView()
+#define REGISTRY_MAX_VIEWS 32   // room in textFields[]
+#define NOT_BUILT_YET      -1   // view has not been on the screen since power-up
+
+  const int arenaSize;   // bytes for the one active view
+  const int totalSize;   // bytes if every view was a global object
+  const int count;       // number of views
+  uint32_t built = 0;    // views constructed since power-up
+
+  ViewRegistry(const ViewEntry *vTable, int vCount, void *vArena, int vArenaSize)
+      : arenaSize(vArenaSize), totalSize(sumOfViews(vTable, vCount)), count(vCount),
+        table(vTable), arena(vArena) {
+    for (int ii = 0; ii < REGISTRY_MAX_VIEWS; ii++) {
+      textFields[ii] = NOT_BUILT_YET;
+    }
+  }
+
+  // destroy the active view, if any, and build the requested one in its place
+  // the caller has already given the departing view its endScreen()
+  View *activate(int vid, Adafruit_ILI9341 *vtft) {
+    if (vid < 0 || vid >= count || vid >= REGISTRY_MAX_VIEWS || table[vid].size > arenaSize) {
+      logger.log(CONFIG, ERROR, "Cannot build view %d", vid);
+      return active;   // keep the current view
+    }
+    if (active) {
+      active->~View();
+      active = nullptr;
+    }
+    uint16_t before = TextField::constructed;
+    active          = table[vid].create(arena, vtft, vid);
+    textFields[vid] = (int8_t)(TextField::constructed - before);
+    built++;
+    return active;
+  }
+
+  int nextView(int vid) const {
+    return (vid >= 0 && vid < count) ? table[vid].next : NO_VIEW_REQUEST;
+  }
+  int prevView(int vid) const {
+    // walk around the ring of normal views until it comes back to vid
+    int walk = nextView(vid);
+    for (int ii = 0; ii < count && walk != NO_VIEW_REQUEST; ii++) {
+      int after = nextView(walk);
+      if (after == vid) {
+        return walk;
+      }
+      walk = after;
+    }
+    return NO_VIEW_REQUEST;   // not in the ring, e.g. a settings view
+  }
+  int nextSetting(int vid) const {
+    return (vid >= 0 && vid < count) ? table[vid].nextSetting : NO_VIEW_REQUEST;
+  }
+
+  // ----- deferred switch, for a view that wants to leave
+  void request(int cmd) {
+    pending = cmd;
+  }
+  int takeRequest() {
+    int cmd = pending;
+    pending = NO_VIEW_REQUEST;
+    return cmd;
+  }
+
+  void report(int bytesPerCrumb) {
+    char msg[100];
+    int saved = totalSize - arenaSize;
+    snprintf(msg, sizeof(msg), "Views = %d bytes for the active view, instead of %d bytes for all %d",
+             arenaSize, totalSize, count);
+    logger.log(COMMAND, CONSOLE, msg);
+    snprintf(msg, sizeof(msg), "Views saved %d bytes = %d breadcrumbs, %lu views built since power-up",
+             saved, saved / bytesPerCrumb, (unsigned long)built);
+    logger.log(COMMAND, CONSOLE, msg);
+  }
+
+  // one line per view, e.g. "View 3: 2140 bytes, 19 text fields, saved 1520 bytes"
+  void reportViews() {
+    char msg[100];
+    int fieldSaving = (int)sizeof(TextFieldBefore) - (int)sizeof(TextField);
+    int total       = 0;
+    for (int vid = 0; vid < count && vid < REGISTRY_MAX_VIEWS; vid++) {
+      if (textFields[vid] == NOT_BUILT_YET) {
+        snprintf(msg, sizeof(msg), "View %d: %d bytes, not shown since power-up", vid, table[vid].size);
+      } else {
+        int saved = textFields[vid] * fieldSaving;
+        total += saved;
+        snprintf(msg, sizeof(msg), "View %d: %d bytes, %d text fields, saved %d bytes",
+                 vid, table[vid].size, textFields[vid], saved);
+      }
+      logger.log(COMMAND, CONSOLE, msg);
+    }
+    snprintf(msg, sizeof(msg), "Text fields are %d bytes each, instead of %d, saved %d bytes in views shown so far",
+             (int)sizeof(TextField), (int)sizeof(TextFieldBefore), total);
+    logger.log(COMMAND, CONSOLE, msg);
+    snprintf(msg, sizeof(msg), "Text fields with a layout table in flash are %d bytes each",
+             (int)sizeof(FixedTextField));
+    logger.log(COMMAND, CONSOLE, msg);
+  }
+
+protected:
+  const ViewEntry *table;             // navigation table, one row per view
+  void *arena;                        // storage for the active view
+  View *active = nullptr;             // constructed in arena
+  int pending  = NO_VIEW_REQUEST;     // from requestNewView()
+  int8_t textFields[REGISTRY_MAX_VIEWS];       // TextFields built by each view, or NOT_BUILT_YET
+
+};   // end class ViewRegistry
+
+// ========== extern ===========================================
+extern ViewRegistry views;   // Griduino.ino
@@ -21,6 +21,9 @@
             | 0  | X      X      X      X    |  |...yRow0   red
             |    +---------------------------+  |...yBot
             |   19:10  19:15  19:20  19:25      |
+
+            The second header line shows satellites used by each system,
+            e.g. "G7 R4 E2" for 7 GPS, 4 GLONASS, 2 Galileo. See gnss_stats.h
             +-:-::---------------------------:--+
               : :xLeft                       xRight
          labelX valueX
@@ -32,6 +35,7 @@
 #include "logger.h"                      // conditional printing to Serial port
 #include "date_helper.h"                 // date/time conversions
 #include "view.h"                        // Base class for all views
+#include "gnss_stats.h"                  // per-constellation satellite statistics
 #include "Embedded_Template_Library.h"   // Required for any etl import using Arduino IDE
 #include "etl/circular_buffer.h"         // Embedded Template Library
 
@@ -42,8 +46,27 @@ extern Dates date;   // for "datetimeToString()", Griduino.ino
 struct satCountItem {
   time_t tm;   // seconds since Jan 1, 1970
   int numSats;
+  GnssCounts gnss;   // per-constellation satellites and SNR
 };
 
+// ========== class SatCountHistory ============================
+// The history outlives the view, which exists only while it's on screen
+class SatCountHistory {
+public:
+  etl::circular_buffer<satCountItem, 19> cbSats;
+  bool graphRefreshRequested = true;   // true = new data arrived in circular buffer, refresh the bar graph
+
+  // pushes a value to the back of the circular buffer
+  void push(time_t tm, int nSats, const GnssCounts &counts) {
+    // nSats = random(0, 19);   // unit test: this replaces measurements with something to scroll across the screen
+    satCountItem item = {tm, nSats, counts};
+    cbSats.push(item);
+    graphRefreshRequested = true;
+  }
+};   // end class SatCountHistory
+
+extern SatCountHistory satCountHistory;   // Griduino.ino
+
 // ========== class ViewSatCount =================================
 class ViewSatCount : public View {
 public:
@@ -57,21 +80,11 @@ public:
   void startScreen();
   bool onTouch(Point touch);
 
-  etl::circular_buffer<satCountItem, 19> cbSats;
-  etl::circular_buffer<satCountItem, 19>::iterator cbIter;
-
-  // pushes a value to the back of the circular buffer
-  void push(time_t tm, int nSats) {
-    // nSats = random(0, 19);   // unit test: this replaces measurements with something to scroll across the screen
-    satCountItem item = {tm, nSats};
-    cbSats.push(item);
-    graphRefreshRequested = true;
-  }
-
 protected:
   // ---------- local data for this derived class ----------
   // color scheme: see constants.h
-  bool graphRefreshRequested;   // true = new data arrived in circular buffer, refresh the bar graph
+  etl::circular_buffer<satCountItem, 19> &cbSats = satCountHistory.cbSats;
+  etl::circular_buffer<satCountItem, 19>::iterator cbIter;
 
   // ========== text screen layout ===================================
 
@@ -108,6 +121,7 @@ protected:
     eNumSat,
     eTimeHHMM,
     eTimeSS,
+    eSystems,
     TEN,
     EIGHT,
     SIX,
@@ -118,13 +132,14 @@ protected:
 
   // ----- static + dynamic screen text
   // clang-format off
-#define nSatCountValues 11
+#define nSatCountValues 12
   TextField txtValues[nSatCountValues] = {
       {"Satellites", -1, yRow1,cTITLE,         ALIGNCENTER, eFONTSMALLEST},   // [TITLE] view title, centered
       {"mm-dd",    60, 18,     cWARN,          ALIGNLEFT,  eFONTSMALLEST},    // [eDate]
       {"0#",       60, 36,     cWARN,          ALIGNLEFT,  eFONTSMALLEST},    // [eNumSat]
       {"hh:mm",   276, 18,     cWARN,          ALIGNRIGHT, eFONTSMALLEST},    // [eTimeHHMM]
       {"ss",      276, 36,     cWARN,          ALIGNRIGHT, eFONTSMALLEST},    // [eTimeSS]
+      {"",         -1, 36,     cLABEL,         ALIGNCENTER, eFONTSMALLEST},   // [eSystems]
       {"10+",  labelX, yRow10, ILI9341_GREEN,  ALIGNLEFT,  eFONTSMALLEST},    // [TEN]
       {" 8",   labelX, yRow8,  ILI9341_GREEN,  ALIGNLEFT,  eFONTSMALLEST},    // [EIGHT]
       {" 6",   labelX, yRow6,  ILI9341_GREEN,  ALIGNLEFT,  eFONTSMALLEST},    // [SIX]
@@ -200,6 +215,22 @@ protected:
 
     snprintf(msg, sizeof(msg), "%02d", ss);
     txtValues[eTimeSS].print(msg);
+
+    showSystems();
+  }
+
+  void showSystems() {
+    // satellites used by each constellation, e.g. "G7 R4 E2"
+    static const char letter[GNSS_SYSTEMS] = {'G', 'R', 'E', 'C', 'J'};   // NMEA 4.1 system letters
+    GnssCounts counts = gnss.current();
+    char msg[24]      = "";
+    int len           = 0;
+    for (int ii = 0; ii < GNSS_SYSTEMS; ii++) {
+      if (counts.used[ii]) {
+        len += snprintf(msg + len, sizeof(msg) - len, "%s%c%d", len ? " " : "", letter[ii], counts.used[ii]);
+      }
+    }
+    txtValues[eSystems].print(msg);
   }
 
 };   // end class ViewSatCount
@@ -210,8 +241,8 @@ void ViewSatCount::updateScreen() {
   showTimeOfDay();
 
   // called on every pass through main(), but only update bar graph once/2second
-  if (graphRefreshRequested) {
-    graphRefreshRequested = false;
+  if (satCountHistory.graphRefreshRequested) {
+    satCountHistory.graphRefreshRequested = false;
 
     // erase the canvas
     tft->fillRect(xLeft, yTop, (xRight - xLeft), (yBot - yTop), this->background);
@@ -268,7 +299,7 @@ void ViewSatCount::startScreen() {
     txtValues[ii].print();
   }
 
-  graphRefreshRequested = true;
+  satCountHistory.graphRefreshRequested = true;
   updateScreen();   // update UI immediately, don't wait for the main loop to eventually get around to it
 }
 
@@ -22,7 +22,7 @@
             Main code is not aware of how "screen 1" looks, nor does it
             request any particular implementation.
   Griduino.ino:
-            ViewScreen1       screen1View(&tft, SCREEN1_VIEW);
+            {makeView<ViewScreen1>, sizeof(ViewScreen1), HELP_VIEW, CFG_VOLUME},   // [SCREEN1_VIEW]
 
   Implementation:
             We can independently write anything we want in this module.
@@ -73,7 +73,7 @@
 // ========== extern ===========================================
 extern Logger logger;                    // Griduino.ino
 extern void showDefaultTouchTargets();   // Griduino.ino
-extern void selectNewView(int cmd);      // Griduino.ino
+extern void requestNewView(int cmd);     // Griduino.ino
 extern int goto_next_view;               // Griduino.ino
 extern int help_view;                    // Griduino.ino
 
@@ -103,7 +103,7 @@ protected:
 void ViewScreen1::updateScreen() {
   bool allDone = continueViewing();
   if (allDone) {                // all done with very first screen
-    selectNewView(help_view);   // switch to very second screen
+    requestNewView(help_view);   // switch to very second screen
   }
 }
 
@@ -118,7 +118,7 @@ void ViewScreen1::startScreen() {
 }
 
 bool ViewScreen1::onTouch(Point touch) {
-  selectNewView(goto_next_view);   // any touch anywhere, exit this time-wasting view
+  requestNewView(goto_next_view);   // any touch anywhere, exit this time-wasting view
   return true;                     // true=handled, false=controller uses default action
 }   // end onTouch()
 
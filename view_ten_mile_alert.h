@@ -401,16 +401,18 @@ bool ViewTenMileAlert::onTouch(Point touch) {
 // Save it here instead of the model, to keep the screen responsive.
 // Otherwise it's slow to save the whole GPS model.
 const char TEN_MILE_START[25]   = CONFIG_FOLDER "/ten_mile.cfg";   // must be 8.3 filename
-const char TEN_MILE_VERSION[15] = "Ten Mile v02";                  // <-- always change version when changing model data
+const char TEN_MILE_VERSION[15] = "Ten Mile v03";                  // <-- always change version when changing model data
 
 // ----- save user's starting point to non-volatile memory -----
+// only the starting point is saved, since the view itself is rebuilt each time it's shown
 void ViewTenMileAlert::saveConfig() {
   SaveRestore config(TEN_MILE_START, TEN_MILE_VERSION);
-  int rc = config.writeConfig((byte *)this, sizeof(ViewTenMileAlert));
+  double saved[2] = {startLat, startLong};
+  int rc          = config.writeConfig((byte *)saved, sizeof(saved));
   if (rc) {
-    logger.log(GPS_SETUP, INFO, "Success, Ten-Mile Alert object stored to SDRAM");
+    logger.log(GPS_SETUP, INFO, "Success, Ten-Mile Alert starting point stored to SDRAM");
   } else {
-    logger.log(GPS_SETUP, ERROR, "failed to save Ten Mile Alert object to SDRAM");
+    logger.log(GPS_SETUP, ERROR, "failed to save Ten Mile Alert starting point to SDRAM");
   }
 }
 
@@ -419,16 +421,12 @@ void ViewTenMileAlert::loadConfig() {
   // Load "Microwave Rover" settings from NVR
 
   SaveRestore config(TEN_MILE_START, TEN_MILE_VERSION);
-  ViewTenMileAlert temp(tft, 0);
-  int rc = config.readConfig((byte *)&temp, sizeof(temp));
+  double saved[2] = {startLat, startLong};
+  int rc          = config.readConfig((byte *)saved, sizeof(saved));
   if (rc) {
-    // warning: this can corrupt our object's data if something failed
-    // so we blob the bytes to a work area and copy individual values
     logger.log(CONFIG, INFO, ". Success, settings restored from SDRAM");
-
-    // pick'n pluck values from the restored instance
-    this->startLat  = temp.startLat;
-    this->startLong = temp.startLong;
+    this->startLat  = saved[0];
+    this->startLong = saved[1];
     logger.logFloat(CONFIG, INFO, "Loaded starting latitude: %s", this->startLat, 4);
     logger.logFloat(CONFIG, INFO, "Loaded starting longitude: %s", this->startLong, 4);
   } else {
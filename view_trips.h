@@ -0,0 +1,201 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     view_trips.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Summary of one trip from the trip engine (model_trips.h).
+            Opens on the newest trip; touch the screen for the next older one.
+
+            +-----------------------------------+
+            | *        Trip 3 of 5            > |...yRow1
+            |                                   |
+            |     Start:  2022-10-17 14:02:07   |...yRow2
+            |      From:  CN87us                |...yRow3
+            |  Distance:  42.7 mi               |...yRow4
+            |    Moving:  1 hr 07 min           |...yRow5
+            |     Speed:  38.2 avg, 61.0 max mph|...yRow6
+            |     Climb:  1150 ft in 3 grids    |...yRow7
+            |                                   |
+            | Driving now      Touch for older  |...yRow9
+            +-------------:---------------------+
+                      labelX  valueX
+*/
+
+#include <Arduino.h>
+#include <Adafruit_ILI9341.h>   // TFT color display library
+#include "constants.h"          // Griduino constants and colors
+#include "logger.h"             // conditional printing to Serial port
+#include "date_helper.h"        // date/time conversions
+#include "format_helper.h"      // number to text without the heap
+#include "model_gps.h"          // Model of a GPS for model-view-controller
+#include "model_trips.h"        // trips and their statistics
+#include "TextField.h"          // Optimize TFT display text for proportional fonts
+#include "view.h"               // Base class for all views
+
+// ========== extern ===========================================
+extern Logger logger;                    // Griduino.ino
+extern Dates date;                       // date_helper.h
+extern Model *model;                     // "model" portion of model-view-controller
+extern TripEngine trips;                 // Griduino.ino
+extern void showDefaultTouchTargets();   // Griduino.ino
+
+// ========== class ViewTrips ==================================
+class ViewTrips : public View {
+public:
+  // ---------- public interface ----------
+  // This derived class must implement the public interface:
+  ViewTrips(Adafruit_ILI9341 *vtft, int vid)   // ctor
+      : View{vtft, vid} {
+    background = cBACKGROUND;   // every view can have its own background color
+  }
+  void updateScreen();
+  void startScreen();
+  bool onTouch(Point touch);
+
+protected:
+  // ---------- local data for this derived class ----------
+  // color scheme: see constants.h
+  int back = 0;   // trip on the screen, 0 = newest
+
+  // ========== text screen layout ===================================
+
+  // vertical placement of text rows
+  const int space = 24;
+
+  const int yRow1 = 18;
+  const int yRow2 = yRow1 + space + 8;
+  const int yRow3 = yRow2 + space;
+  const int yRow4 = yRow3 + space;
+  const int yRow5 = yRow4 + space;
+  const int yRow6 = yRow5 + space;
+  const int yRow7 = yRow6 + space;
+  const int yRow9 = 230;   // "230" will match other views
+
+  const int labelX = 112;   // right-align labels, near their values
+  const int valueX = 124;   // left-align values
+
+  // touch here for the next older trip, clear of the gear and arrow icons
+  Rect areaTrip{{0, yRow1 + 12}, {320, yRow7 - yRow1}};
+
+  // ----- screen text
+  // names for the array indexes, must be named in same order as array below
+  enum txtIndex {
+    TITLE = 0,
+    START_LABEL,
+    START,
+    FROM_LABEL,
+    FROM,
+    DISTANCE_LABEL,
+    DISTANCE,
+    MOVING_LABEL,
+    MOVING,
+    SPEED_LABEL,
+    SPEED,
+    CLIMB_LABEL,
+    CLIMB,
+    STATE,
+    HINT,
+  };
+
+// ----- static + dynamic screen text
+// clang-format off
+#define nTripValues 15
+  TextField txtValues[nTripValues] = {
+      {"Trips",            -1, yRow1, cTITLE,  ALIGNCENTER, eFONTSMALLEST},   // [TITLE]
+      {"Start:",       labelX, yRow2, cLABEL,  ALIGNRIGHT,  eFONTSMALLEST},   // [START_LABEL]
+      {"",             valueX, yRow2, cVALUE,  ALIGNLEFT,   eFONTSMALLEST},   // [START]
+      {"From:",        labelX, yRow3, cLABEL,  ALIGNRIGHT,  eFONTSMALLEST},   // [FROM_LABEL]
+      {"",             valueX, yRow3, cVALUE,  ALIGNLEFT,   eFONTSMALLEST},   // [FROM]
+      {"Distance:",    labelX, yRow4, cLABEL,  ALIGNRIGHT,  eFONTSMALLEST},   // [DISTANCE_LABEL]
+      {"",             valueX, yRow4, cHIGHLIGHT, ALIGNLEFT, eFONTSMALLEST},  // [DISTANCE]
+      {"Moving:",      labelX, yRow5, cLABEL,  ALIGNRIGHT,  eFONTSMALLEST},   // [MOVING_LABEL]
+      {"",             valueX, yRow5, cVALUE,  ALIGNLEFT,   eFONTSMALLEST},   // [MOVING]
+      {"Speed:",       labelX, yRow6, cLABEL,  ALIGNRIGHT,  eFONTSMALLEST},   // [SPEED_LABEL]
+      {"",             valueX, yRow6, cVALUE,  ALIGNLEFT,   eFONTSMALLEST},   // [SPEED]
+      {"Climb:",       labelX, yRow7, cLABEL,  ALIGNRIGHT,  eFONTSMALLEST},   // [CLIMB_LABEL]
+      {"",             valueX, yRow7, cVALUE,  ALIGNLEFT,   eFONTSMALLEST},   // [CLIMB]
+      {"",                  4, yRow9, cFAINT,  ALIGNLEFT,   eFONTSMALLEST},   // [STATE]
+      {"Touch for older", 316, yRow9, cFAINT,  ALIGNRIGHT,  eFONTSMALLEST},   // [HINT]
+  };
+  // clang-format on
+
+  void showTrip(const TripRecord *tt) {
+    char msg[40];
+    snprintf(msg, sizeof(msg), "Trip %d of %d", trips.numTrips() - back, trips.numTrips());
+    txtValues[TITLE].print(msg);
+
+    date.datetimeToString(msg, sizeof(msg), tt->start, " GMT");
+    txtValues[START].print(msg);
+    txtValues[FROM].print(tt->startGrid);
+
+    // ----- distance and speed, in the user's units
+    float scale       = model->gMetric ? kmPerMile : 1.0;
+    const char *sUnit = model->gMetric ? "km" : "mi";
+    const char *sRate = model->gMetric ? "km/h" : "mph";
+    char sDist[12], sAvg[12], sMax[12];
+    fixedToChars(sDist, sizeof(sDist), tt->miles * scale, 1);
+    snprintf(msg, sizeof(msg), "%s %s", sDist, sUnit);
+    txtValues[DISTANCE].print(msg);
+
+    int minutes = tt->movingSeconds / 60;
+    snprintf(msg, sizeof(msg), "%d hr %02d min", minutes / 60, minutes % 60);
+    txtValues[MOVING].print(msg);
+
+    fixedToChars(sAvg, sizeof(sAvg), tt->averageMPH() * scale, 1);
+    fixedToChars(sMax, sizeof(sMax), tt->maxMPH * scale, 1);
+    snprintf(msg, sizeof(msg), "%s avg, %s max %s", sAvg, sMax, sRate);
+    txtValues[SPEED].print(msg);
+
+    int climb = (int)round(model->gMetric ? tt->climbMeters : tt->climbMeters * feetPerMeters);
+    snprintf(msg, sizeof(msg), "%d %s in %d grid%s", climb, model->gMetric ? "m" : "ft",
+             tt->grids, (tt->grids == 1) ? "" : "s");
+    txtValues[CLIMB].print(msg);
+
+    txtValues[STATE].print(tt->open ? "Driving now" : "");
+  }
+
+};   // end class ViewTrips
+
+// ============== implement public interface ================
+void ViewTrips::updateScreen() {
+  // called on every pass through main()
+  // TextField only redraws what changed, so an open trip updates as it grows
+  const TripRecord *tt = trips.trip(back);
+  if (tt) {
+    showTrip(tt);
+  } else {
+    txtValues[TITLE].print("No trips yet");
+  }
+}
+
+void ViewTrips::startScreen() {
+  // called once each time this view becomes active
+  this->clearScreen(this->background);               // clear screen
+  txtValues[0].setBackground(this->background);      // set background for all TextFields in this view
+  TextField::setTextDirty(txtValues, nTripValues);   // make sure all fields get re-printed on screen change
+
+  drawAllIcons();              // draw gear (settings) and arrow (next screen)
+  showDefaultTouchTargets();   // optionally draw box around default button-touch areas
+  showScreenBorder();          // optionally outline visible area
+
+  back = 0;   // newest trip first
+  if (trips.numTrips() > 0) {
+    for (int ii = START_LABEL; ii <= CLIMB_LABEL; ii += 2) {
+      txtValues[ii].print();
+    }
+    txtValues[HINT].print();
+  }
+  updateScreen();   // update UI immediately, don't wait for the main loop to eventually get around to it
+}
+
+bool ViewTrips::onTouch(Point touch) {
+  if (areaTrip.contains(touch) && trips.numTrips() > 1) {
+    back = (back + 1) % trips.numTrips();
+    logger.log(CONFIG, INFO, "->->-> Showing trip %d back", back);
+    updateScreen();
+    return true;
+  }
+  return false;   // true=handled, false=controller uses default action
+}   // end onTouch()
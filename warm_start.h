@@ -0,0 +1,95 @@
+#pragma once   // Please format this file with clang before check-in to GitHub
+/*
+  File:     warm_start.h
+
+  Software: Barry Hansen, K7BWH, barry@k7bwh.com, Seattle, WA
+  Hardware: John Vanderbeck, KM7O, Seattle, WA
+
+  Purpose:  Faster time to first fix, by telling the GPS receiver where it
+            was at power-down.
+
+            Without a hint, the receiver searches the whole sky at every
+            power-up. The model already saves our last position in gpsmodel.cfg,
+            so at boot we give that position and the current time to the
+            receiver with PMTK741 (MediaTek "set reference location and time"):
+                $PMTK741,47.751910,-122.329510,120,2024,05,01,12,34,56*hh
+
+            Griduino itself has no clock. The receiver's own RTC keeps time
+            while its coin battery is good, and reports it in RMC before it
+            has a fix. So the hint is sent at the first valid time, the same
+            moment the "TIM" breadcrumb is written. If the receiver already
+            has a fix by then, it's too late to help and nothing is sent.
+
+            The time to first fix is saved as a "TFF" breadcrumb, which says
+            whether the hint was sent, so the improvement shows up in the
+            breadcrumb trail across many power cycles.
+*/
+
+#include <Arduino.h>          //
+#include <Adafruit_GPS.h>     // "Ultimate GPS" library
+#include <TimeLib.h>          // time_t=seconds since Jan 1, 1970, https://github.com/PaulStoffregen/Time
+#include "constants.h"        // Griduino constants, colors, typedefs
+#include "logger.h"           // conditional printing to Serial port
+#include "nmea_helper.h"      // NMEA sentence checksums
+#include "format_helper.h"    // number to text without the heap
+
+// ========== extern ===========================================
+extern Adafruit_GPS GPS;   // Griduino.ino
+extern Logger logger;      // Griduino.ino
+
+// ========== class WarmStart ==================================
+class WarmStart {
+public:
+  bool sent = false;   // true = receiver was given our position at this power-up
+
+  // remember the position restored from gpsmodel.cfg, call once in setup()
+  void begin(double vLat, double vLng, float vAltitude, time_t vWhen) {
+    // a model that never had a fix is (0,0), which is useless as a hint
+    haveHint = (vWhen > 0) && (vLat != 0.0 || vLng != 0.0) && fabs(vLat) <= 90.0 && fabs(vLng) <= 180.0;
+    lat      = vLat;
+    lng      = vLng;
+    altitude = vAltitude;
+  }
+
+  // call at the first valid time from the receiver's RTC, returns true if the hint was sent
+  bool onFirstValidTime(time_t utc, bool haveFix) {
+    if (sent || !haveHint) {
+      return false;
+    }
+    if (haveFix) {
+      logger.log(GPS_SETUP, INFO, "Receiver already has a fix, warm start not needed");
+      return false;
+    }
+    char cmd[NMEA_MAX_LENGTH];
+    if (!makeCommand(cmd, sizeof(cmd), lat, lng, altitude, utc)) {
+      return false;
+    }
+    logger.log(GPS_SETUP, INFO, "Warm start from last known position:");
+    logger.log(GPS_SETUP, INFO, cmd);   // echo command to console
+    GPS.sendCommand(cmd);
+    sent = true;
+    return true;
+  }
+
+  // build "$PMTK741,lat,long,alt,YYYY,MM,DD,hh,mm,ss*hh", returns length or 0 on failure
+  static int makeCommand(char *result, int maxlen, double vLat, double vLng, float vAltitude, time_t utc) {
+    char sLat[14], sLng[14];
+    fixedToChars(sLat, sizeof(sLat), vLat, 6);   // about 0.1 meter, more than enough
+    fixedToChars(sLng, sizeof(sLng), vLng, 6);
+    TimeElements tm;
+    breakTime(utc, tm);
+    return Nmea::makeSentence(result, maxlen, "PMTK741,%s,%s,%d,%04d,%02d,%02d,%02d,%02d,%02d",
+                              sLat, sLng, (int)lround(vAltitude),
+                              tm.Year + 1970, tm.Month, tm.Day, tm.Hour, tm.Minute, tm.Second);
+  }
+
+protected:
+  bool haveHint   = false;   // true = restored position is usable
+  double lat      = 0.0;     // last known position, decimal degrees
+  double lng      = 0.0;     //
+  float altitude  = 0.0;     // meters above MSL
+
+};   // end class WarmStart
+
+// ========== extern ===========================================
+extern WarmStart warmStart;   // Griduino.ino